@@ -12,5 +12,6 @@
 #include <experimental/fundamental/v3/bits/bit_reference.hpp>
 #include <experimental/fundamental/v3/bits/bit_pointer.hpp>
 #include <experimental/fundamental/v3/bits/bit_iterator.hpp>
+#include <experimental/fundamental/v3/bits/bit_algorithm.hpp>
 
 #endif // header
@@ -8,5 +8,7 @@
 #define JASEL_EXPERIMENTAL_FLAT_MAP_HPP
 
 #include <experimental/fundamental/v3/flat_map/flat_map.hpp>
+#include <experimental/fundamental/v3/flat_map/flat_multimap.hpp>
+#include <experimental/fundamental/v3/flat_map/eytzinger_flat_map.hpp>
 
 #endif // header
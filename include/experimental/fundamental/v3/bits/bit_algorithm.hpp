@@ -0,0 +1,523 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Vicente J. Botet Escriba 2019.
+// Distributed under the Boost
+// Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or
+// copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//////////////////////////////////////////////////////////////////////////////
+
+/*
+ \file
+ \brief
+ The header \c <experimental/.../bits/bit_algorithm.hpp> defines overloads of some standard algorithms for ranges of
+ \c bit_iterator.
+
+ Instead of going through a \c bit_reference for each bit, they process the unaligned bits at the ends of the ranges
+ with masks and the words in between a word at a time.
+ They are hidden friends of \c bit_iterator, found by argument dependent lookup when called unqualified on
+ \c bit_iterator arguments, so that they don't hide the standard algorithms for other iterators.
+
+ The underlying iterators must be forward iterators; \c copy_backward, \c reverse, \c rotate and \c shift_right need
+ bidirectional ones.
+ */
+
+#ifndef JASEL_FUNDAMENTAL_V3_BITS_BIT_ALGORITHM_HPP
+#define JASEL_FUNDAMENTAL_V3_BITS_BIT_ALGORITHM_HPP
+
+#include <experimental/fundamental/v3/bits/binary_digits.hpp>
+#include <experimental/fundamental/v3/bits/bit_ops.hpp>
+#include <experimental/fundamental/v3/bits/bit_value.hpp>
+#include <experimental/fundamental/v3/bits/bit_reference.hpp>
+#include <experimental/fundamental/v3/bits/bit_pointer.hpp>
+#include <experimental/fundamental/v3/bits/bit_iterator.hpp>
+
+#include <experimental/fundamental/v2/config.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace std
+{
+namespace experimental
+{
+inline namespace fundamental_v3
+{
+  namespace bit_algorithm_detail
+  {
+    template <class W>
+    constexpr size_t digits() noexcept
+    {
+      return binary_digits<W>::value;
+    }
+
+    //! @par Returns:
+    //!   A word with the bits [pos, digits) set.
+    template <class W>
+    constexpr W mask_from(size_t pos) noexcept
+    {
+      return W(W(~W(0)) << pos);
+    }
+
+    //! @par Returns:
+    //!   A word with the bits [0, n) set, for n <= digits.
+    template <class W>
+    constexpr W mask_to(size_t n) noexcept
+    {
+      return (n >= digits<W>()) ? W(~W(0)) : W((W(1) << n) - 1);
+    }
+
+    //! @par Returns:
+    //!   x with the bits in m replaced by the ones of v.
+    template <class W>
+    constexpr W merge(W x, W v, W m) noexcept
+    {
+      return W((x & ~m) | (v & m));
+    }
+
+    //! @par Returns:
+    //!   The bits of x in the reverse order.
+    template <class W>
+    JASEL_CXX14_CONSTEXPR W reverse_bits(W x) noexcept
+    {
+      W m = W(~W(0));
+      for (size_t s = digits<W>() / 2; s > 0; s /= 2)
+      {
+        m = W(m ^ W(m << s));
+        x = W(((x >> s) & m) | (W(x << s) & ~m));
+      }
+      return x;
+    }
+
+    //! A bit position given by a word iterator and the position of the bit on the word.
+    template <class It>
+    struct cursor
+    {
+      using word_type = typename iterator_traits<It>::value_type;
+
+      It it;
+      size_t pos;
+
+      cursor(It i, size_t p) : it(i), pos(p) {}
+      explicit cursor(bit_iterator<It> i) : it(i.base()), pos(i.position()) {}
+
+      bit_iterator<It> base() const
+      {
+        return bit_iterator<It>(it, pos);
+      }
+
+      //! @par Returns:
+      //!   The n bits, 0 < n <= digits, starting at this position in the low bits of a word.
+      word_type get(size_t n) const
+      {
+        word_type x = word_type(*it >> pos);
+        if (pos + n > digits<word_type>())
+          x = word_type(x | (*std::next(it) << (digits<word_type>() - pos)));
+        return word_type(x & mask_to<word_type>(n));
+      }
+
+      //! Stores the low n bits of v, 0 < n <= digits, starting at this position.
+      void set(size_t n, word_type v) const
+      {
+        if (pos + n <= digits<word_type>())
+        {
+          *it = merge(*it, word_type(v << pos), word_type(mask_to<word_type>(n) << pos));
+        }
+        else
+        {
+          size_t const k = digits<word_type>() - pos;
+          *it = merge(*it, word_type(v << pos), mask_from<word_type>(pos));
+          It next = std::next(it);
+          *next = merge(*next, word_type(v >> k), mask_to<word_type>(n - k));
+        }
+      }
+
+      //! Moves n bits forward, n <= digits.
+      void advance(size_t n)
+      {
+        pos += n;
+        if (pos >= digits<word_type>())
+        {
+          pos -= digits<word_type>();
+          ++it;
+        }
+      }
+      //! Moves n bits backward, n <= digits.
+      void retreat(size_t n)
+      {
+        if (pos >= n)
+        {
+          pos -= n;
+        }
+        else
+        {
+          pos += digits<word_type>() - n;
+          --it;
+        }
+      }
+    };
+
+    template <class It>
+    cursor<It> make_cursor(bit_iterator<It> i)
+    {
+      return cursor<It>(i);
+    }
+
+    template <class It1, class It2>
+    struct same_word : integral_constant<bool, is_same<typename bit_iterator<It1>::word_type,
+                                                       typename bit_iterator<It2>::word_type>::value>
+    {
+    };
+
+    //! @par Returns:
+    //!   The number of bits set in [first, last).
+    template <class It>
+    size_t count_ones(bit_iterator<It> first, bit_iterator<It> last)
+    {
+      using W = typename bit_iterator<It>::word_type;
+      It f = first.base();
+      It const l = last.base();
+      if (f == l)
+        return size_t(bit_ops::popcount(W(*f & mask_from<W>(first.position()) & mask_to<W>(last.position()))));
+      size_t r = 0;
+      if (first.position() != 0)
+      {
+        r += size_t(bit_ops::popcount(W(*f & mask_from<W>(first.position()))));
+        ++f;
+      }
+      for (; f != l; ++f)
+        r += size_t(bit_ops::popcount(*f));
+      if (last.position() != 0)
+        r += size_t(bit_ops::popcount(W(*l & mask_to<W>(last.position()))));
+      return r;
+    }
+
+    //! The algorithms on the ranges of bit_iterator<It>, the friends of bit_iterator forward to them.
+    template <class It>
+    struct bit_algorithms
+    {
+      using iterator = bit_iterator<It>;
+      using difference_type = typename iterator::difference_type;
+      using W = typename iterator::word_type;
+
+      //! @par Returns:
+      //!   The number of bits in [first, last) equal to value.
+      static difference_type count(iterator first, iterator last, bit_value value)
+      {
+        if (first == last) return 0;
+        difference_type const ones = difference_type(count_ones(first, last));
+        return value ? ones : (last - first) - ones;
+      }
+
+      //! @par Returns:
+      //!   The first iterator i in [first, last) such that *i == value, or last if there is none.
+      static iterator find(iterator first, iterator last, bit_value value)
+      {
+        if (first == last) return last;
+        // the bits equal to value are the ones set in x ^ flip
+        W const flip = value ? W(0) : W(~W(0));
+        It f = first.base();
+        It const l = last.base();
+        W x = W((*f ^ flip) & mask_from<W>(first.position()));
+        if (f == l)
+        {
+          x = W(x & mask_to<W>(last.position()));
+          return (x != 0) ? iterator(f, size_t(bit_ops::countr_zero(x))) : last;
+        }
+        while (x == 0)
+        {
+          if (++f == l)
+          {
+            if (last.position() == 0) return last;
+            x = W((*f ^ flip) & mask_to<W>(last.position()));
+            if (x == 0) return last;
+            break;
+          }
+          x = W(*f ^ flip);
+        }
+        return iterator(f, size_t(bit_ops::countr_zero(x)));
+      }
+
+      //! @par Returns:
+      //!   The first iterator i in [first, last) such that *i != value, or last if there is none.
+      static iterator find_first_not(iterator first, iterator last, bit_value value)
+      {
+        return find(first, last, ~value);
+      }
+
+      //! @par Effects:
+      //!   Assigns value to the bits in [first, last).
+      static void fill(iterator first, iterator last, bit_value value)
+      {
+        if (first == last) return;
+        W const v = value ? W(~W(0)) : W(0);
+        It f = first.base();
+        It const l = last.base();
+        if (f == l)
+        {
+          *f = merge(*f, v, W(mask_from<W>(first.position()) & mask_to<W>(last.position())));
+          return;
+        }
+        if (first.position() != 0)
+        {
+          *f = merge(*f, v, mask_from<W>(first.position()));
+          ++f;
+        }
+        std::fill(f, l, v);
+        if (last.position() != 0)
+          *l = merge(*l, v, mask_to<W>(last.position()));
+      }
+
+      //! @par Requires:
+      //!   d_first is not in (first, last).
+      //! @par Effects:
+      //!   Copies the bits in [first, last) to [d_first, d_first + (last - first)), starting from first.
+      //! @par Returns:
+      //!   d_first + (last - first).
+      template <class OutIt>
+      static bit_iterator<OutIt> copy(iterator first, iterator last, bit_iterator<OutIt> d_first)
+      {
+        static_assert(same_word<It, OutIt>::value, "The word types must be the same");
+        constexpr size_t digits = bit_algorithm_detail::digits<W>();
+        size_t n = size_t(last - first);
+        auto s = make_cursor(first);
+        auto d = make_cursor(d_first);
+        if (s.pos == d.pos && n >= digits)
+        {
+          if (s.pos != 0)
+          {
+            size_t const k = digits - s.pos;
+            d.set(k, s.get(k));
+            s.advance(k);
+            d.advance(k);
+            n -= k;
+          }
+          size_t const words = n / digits;
+          It const s_last = std::next(s.it, typename iterator_traits<It>::difference_type(words));
+          d.it = std::copy(s.it, s_last, d.it);
+          s.it = s_last;
+          n -= words * digits;
+        }
+        else
+        {
+          for (; n >= digits; n -= digits)
+          {
+            d.set(digits, s.get(digits));
+            ++s.it;
+            ++d.it;
+          }
+        }
+        if (n != 0)
+        {
+          d.set(n, s.get(n));
+          d.advance(n);
+        }
+        return d.base();
+      }
+
+      //! @par Requires:
+      //!   d_last is not in (first, last].
+      //! @par Effects:
+      //!   Copies the bits in [first, last) to [d_last - (last - first), d_last), starting from last - 1.
+      //! @par Returns:
+      //!   d_last - (last - first).
+      template <class OutIt>
+      static bit_iterator<OutIt> copy_backward(iterator first, iterator last, bit_iterator<OutIt> d_last)
+      {
+        static_assert(same_word<It, OutIt>::value, "The word types must be the same");
+        constexpr size_t digits = bit_algorithm_detail::digits<W>();
+        size_t n = size_t(last - first);
+        auto s = make_cursor(last);
+        auto d = make_cursor(d_last);
+        if (s.pos == d.pos && n >= digits)
+        {
+          if (s.pos != 0)
+          {
+            size_t const k = s.pos;
+            s.retreat(k);
+            d.retreat(k);
+            d.set(k, s.get(k));
+            n -= k;
+          }
+          size_t const words = n / digits;
+          It const s_first = std::prev(s.it, typename iterator_traits<It>::difference_type(words));
+          d.it = std::copy_backward(s_first, s.it, d.it);
+          s.it = s_first;
+          n -= words * digits;
+        }
+        else
+        {
+          for (; n >= digits; n -= digits)
+          {
+            --s.it;
+            --d.it;
+            d.set(digits, s.get(digits));
+          }
+        }
+        if (n != 0)
+        {
+          s.retreat(n);
+          d.retreat(n);
+          d.set(n, s.get(n));
+        }
+        return d.base();
+      }
+
+      //! @par Returns:
+      //!   true if the bits in [first1, last1) are equal to the ones in [first2, first2 + (last1 - first1)).
+      template <class It2>
+      static bool equal(iterator first1, iterator last1, bit_iterator<It2> first2)
+      {
+        static_assert(same_word<It, It2>::value, "The word types must be the same");
+        constexpr size_t digits = bit_algorithm_detail::digits<W>();
+        size_t n = size_t(last1 - first1);
+        auto a = make_cursor(first1);
+        auto b = make_cursor(first2);
+        if (a.pos == b.pos && n >= digits)
+        {
+          if (a.pos != 0)
+          {
+            size_t const k = digits - a.pos;
+            if (a.get(k) != b.get(k)) return false;
+            a.advance(k);
+            b.advance(k);
+            n -= k;
+          }
+          for (; n >= digits; n -= digits)
+          {
+            if (*a.it != *b.it) return false;
+            ++a.it;
+            ++b.it;
+          }
+        }
+        else
+        {
+          for (; n >= digits; n -= digits)
+          {
+            if (a.get(digits) != b.get(digits)) return false;
+            ++a.it;
+            ++b.it;
+          }
+        }
+        return n == 0 || a.get(n) == b.get(n);
+      }
+
+      //! @par Requires:
+      //!   The two ranges do not overlap.
+      //! @par Effects:
+      //!   Exchanges the bits in [first1, last1) with the ones in [first2, first2 + (last1 - first1)).
+      //! @par Returns:
+      //!   first2 + (last1 - first1).
+      template <class It2>
+      static bit_iterator<It2> swap_ranges(iterator first1, iterator last1, bit_iterator<It2> first2)
+      {
+        static_assert(same_word<It, It2>::value, "The word types must be the same");
+        constexpr size_t digits = bit_algorithm_detail::digits<W>();
+        size_t n = size_t(last1 - first1);
+        auto a = make_cursor(first1);
+        auto b = make_cursor(first2);
+        if (a.pos == b.pos && n >= digits)
+        {
+          if (a.pos != 0)
+          {
+            size_t const k = digits - a.pos;
+            W const x = a.get(k);
+            a.set(k, b.get(k));
+            b.set(k, x);
+            a.advance(k);
+            b.advance(k);
+            n -= k;
+          }
+          size_t const words = n / digits;
+          It const a_last = std::next(a.it, typename iterator_traits<It>::difference_type(words));
+          b.it = std::swap_ranges(a.it, a_last, b.it);
+          a.it = a_last;
+          n -= words * digits;
+        }
+        else
+        {
+          for (; n >= digits; n -= digits)
+          {
+            W const x = a.get(digits);
+            a.set(digits, b.get(digits));
+            b.set(digits, x);
+            ++a.it;
+            ++b.it;
+          }
+        }
+        if (n != 0)
+        {
+          W const x = a.get(n);
+          a.set(n, b.get(n));
+          b.set(n, x);
+          b.advance(n);
+        }
+        return b.base();
+      }
+
+      //! @par Effects:
+      //!   Reverses the order of the bits in [first, last).
+      static void reverse(iterator first, iterator last)
+      {
+        constexpr size_t digits = bit_algorithm_detail::digits<W>();
+        size_t n = size_t(last - first);
+        auto l = make_cursor(first);
+        auto r = make_cursor(last);
+        // exchanges the k first bits with the k last ones reversed, until they meet
+        while (n > 1)
+        {
+          size_t const k = (std::min)(digits, n / 2);
+          r.retreat(k);
+          W const x = l.get(k);
+          l.set(k, W(reverse_bits(r.get(k)) >> (digits - k)));
+          r.set(k, W(reverse_bits(x) >> (digits - k)));
+          l.advance(k);
+          n -= 2 * k;
+        }
+      }
+
+      //! @par Effects:
+      //!   Exchanges the bits in [first, middle) and [middle, last).
+      //! @par Returns:
+      //!   first + (last - middle).
+      static iterator rotate(iterator first, iterator middle, iterator last)
+      {
+        if (first == middle) return last;
+        if (middle == last) return first;
+        reverse(first, middle);
+        reverse(middle, last);
+        reverse(first, last);
+        return first + (last - middle);
+      }
+
+      //! @par Effects:
+      //!   Moves the bits in [first + n, last) to [first, last - n); the last n bits are left unspecified.
+      //! @par Returns:
+      //!   last - n, or first if n >= last - first.
+      static iterator shift_left(iterator first, iterator last, difference_type n)
+      {
+        if (n <= 0) return last;
+        if (n >= last - first) return first;
+        return copy(first + n, last, first);
+      }
+
+      //! @par Effects:
+      //!   Moves the bits in [first, last - n) to [first + n, last); the first n bits are left unspecified.
+      //! @par Returns:
+      //!   first + n, or last if n >= last - first.
+      static iterator shift_right(iterator first, iterator last, difference_type n)
+      {
+        if (n <= 0) return first;
+        if (n >= last - first) return last;
+        return copy_backward(first, last - n, last);
+      }
+    };
+  }
+
+}}
+} // std
+
+#endif // header
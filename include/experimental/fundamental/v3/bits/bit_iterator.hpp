@@ -28,6 +28,7 @@
 #include <experimental/fundamental/v3/config/requires.hpp>
 
 #include <iosfwd>
+#include <iterator>
 
 namespace std
 {
@@ -35,6 +36,12 @@ namespace experimental
 {
 inline namespace fundamental_v3
 {
+  namespace bit_algorithm_detail
+  {
+    template <class Iterator>
+    struct bit_algorithms;
+  }
+
   template <class Iterator>
   class bit_iterator
   {
@@ -202,94 +209,152 @@ inline namespace fundamental_v3
       iterator_type _current;
       size_type _position;
 
-      // Non-member arithmetic operators
-      template <class T>
-      friend constexpr bit_iterator<T> operator+(
-          typename bit_iterator<T>::difference_type n,
-          const bit_iterator<T>& i
-      )
+      // Algorithms processing the bits a word at a time (see bit_algorithm.hpp)
+      private:
+      using _algorithms_t = bit_algorithm_detail::bit_algorithms<Iterator>;
+      public:
+      friend difference_type count(bit_iterator first, bit_iterator last, bit_value value)
       {
-          return i + n;
+          return _algorithms_t::count(first, last, value);
       }
-      template <class T, class U>
-      friend JASEL_CXX14_CONSTEXPR typename common_type<
-          typename bit_iterator<T>::difference_type,
-          typename bit_iterator<U>::difference_type
-      >::type operator-(
-          const bit_iterator<T>& lhs,
-          const bit_iterator<U>& rhs
-      )
+      friend bit_iterator find(bit_iterator first, bit_iterator last, bit_value value)
       {
-          using lhs_utype = typename bit_iterator<T>::word_type;
-          using rhs_utype = typename bit_iterator<U>::word_type;
-          using lhs_type = typename bit_iterator<T>::difference_type;
-          using rhs_type = typename bit_iterator<U>::difference_type;
-          using difference_type = typename common_type<lhs_type, rhs_type>::type;
-          constexpr difference_type lhs_digits = binary_digits<lhs_utype>::value;
-          constexpr difference_type rhs_digits = binary_digits<rhs_utype>::value;
-          constexpr difference_type digits = rhs_digits;
-          static_assert(lhs_digits == rhs_digits, "");
-          const difference_type main = lhs._current - rhs._current;
-          return main * digits + (lhs._position - rhs._position);
+          return _algorithms_t::find(first, last, value);
       }
-
-      // Comparison operators
-      public:
-      template <class T, class U>
-      friend constexpr bool operator==(
-          const bit_iterator<T>& lhs,
-          const bit_iterator<U>& rhs
-      )
+      friend bit_iterator find_first_not(bit_iterator first, bit_iterator last, bit_value value)
       {
-          return lhs._current == rhs._current && lhs._position == rhs._position;
+          return _algorithms_t::find_first_not(first, last, value);
       }
-      template <class T, class U>
-      friend constexpr bool operator!=(
-          const bit_iterator<T>& lhs,
-          const bit_iterator<U>& rhs
-      )
+      friend void fill(bit_iterator first, bit_iterator last, bit_value value)
       {
-          return lhs._current != rhs._current || lhs._position != rhs._position;
+          _algorithms_t::fill(first, last, value);
       }
-      template <class T, class U>
-      friend constexpr bool operator<(
-          const bit_iterator<T>& lhs,
-          const bit_iterator<U>& rhs
-      )
+      template <class OutIt>
+      friend bit_iterator<OutIt> copy(bit_iterator first, bit_iterator last, bit_iterator<OutIt> d_first)
       {
-          return lhs._current < rhs._current
-              || (lhs._current == rhs._current && lhs._position < rhs._position);
+          return _algorithms_t::copy(first, last, d_first);
       }
-      template <class T, class U>
-      friend constexpr bool operator<=(
-          const bit_iterator<T>& lhs,
-          const bit_iterator<U>& rhs
-      )
+      template <class OutIt>
+      friend bit_iterator<OutIt> copy_backward(bit_iterator first, bit_iterator last, bit_iterator<OutIt> d_last)
       {
-          return lhs._current < rhs._current
-              || (lhs._current == rhs._current && lhs._position <= rhs._position);
+          return _algorithms_t::copy_backward(first, last, d_last);
       }
-      template <class T, class U>
-      friend constexpr bool operator>(
-          const bit_iterator<T>& lhs,
-          const bit_iterator<U>& rhs
-      )
+      template <class It2>
+      friend bool equal(bit_iterator first1, bit_iterator last1, bit_iterator<It2> first2)
       {
-          return lhs._current > rhs._current
-              || (lhs._current == rhs._current && lhs._position > rhs._position);
+          return _algorithms_t::equal(first1, last1, first2);
       }
-      template <class T, class U>
-      friend constexpr bool operator>=(
-          const bit_iterator<T>& lhs,
-          const bit_iterator<U>& rhs
-      )
+      template <class It2>
+      friend bit_iterator<It2> swap_ranges(bit_iterator first1, bit_iterator last1, bit_iterator<It2> first2)
       {
-          return lhs._current > rhs._current
-              || (lhs._current == rhs._current && lhs._position >= rhs._position);
+          return _algorithms_t::swap_ranges(first1, last1, first2);
+      }
+      friend void reverse(bit_iterator first, bit_iterator last)
+      {
+          _algorithms_t::reverse(first, last);
+      }
+      friend bit_iterator rotate(bit_iterator first, bit_iterator middle, bit_iterator last)
+      {
+          return _algorithms_t::rotate(first, middle, last);
+      }
+      friend bit_iterator shift_left(bit_iterator first, bit_iterator last, difference_type n)
+      {
+          return _algorithms_t::shift_left(first, last, n);
+      }
+      friend bit_iterator shift_right(bit_iterator first, bit_iterator last, difference_type n)
+      {
+          return _algorithms_t::shift_right(first, last, n);
       }
   };
 
+  // Non-member arithmetic operators
+  template <class T>
+  constexpr bit_iterator<T> operator+(
+      typename bit_iterator<T>::difference_type n,
+      const bit_iterator<T>& i
+  )
+  {
+      return i + n;
+  }
+  template <class T, class U>
+  JASEL_CXX14_CONSTEXPR typename common_type<
+      typename bit_iterator<T>::difference_type,
+      typename bit_iterator<U>::difference_type
+  >::type operator-(
+      const bit_iterator<T>& lhs,
+      const bit_iterator<U>& rhs
+  )
+  {
+      using lhs_utype = typename bit_iterator<T>::word_type;
+      using rhs_utype = typename bit_iterator<U>::word_type;
+      using lhs_type = typename bit_iterator<T>::difference_type;
+      using rhs_type = typename bit_iterator<U>::difference_type;
+      using difference_type = typename common_type<lhs_type, rhs_type>::type;
+      constexpr difference_type lhs_digits = binary_digits<lhs_utype>::value;
+      constexpr difference_type rhs_digits = binary_digits<rhs_utype>::value;
+      constexpr difference_type digits = rhs_digits;
+      static_assert(lhs_digits == rhs_digits, "");
+      const difference_type main = difference_type(std::distance(rhs.base(), lhs.base()));
+      return main * digits + (difference_type(lhs.position()) - difference_type(rhs.position()));
+  }
+
+  // Comparison operators
+  template <class T, class U>
+  constexpr bool operator==(
+      const bit_iterator<T>& lhs,
+      const bit_iterator<U>& rhs
+  )
+  {
+      return lhs.base() == rhs.base() && lhs.position() == rhs.position();
+  }
+  template <class T, class U>
+  constexpr bool operator!=(
+      const bit_iterator<T>& lhs,
+      const bit_iterator<U>& rhs
+  )
+  {
+      return lhs.base() != rhs.base() || lhs.position() != rhs.position();
+  }
+  template <class T, class U>
+  constexpr bool operator<(
+      const bit_iterator<T>& lhs,
+      const bit_iterator<U>& rhs
+  )
+  {
+      return lhs.base() < rhs.base()
+          || (lhs.base() == rhs.base() && lhs.position() < rhs.position());
+  }
+  template <class T, class U>
+  constexpr bool operator<=(
+      const bit_iterator<T>& lhs,
+      const bit_iterator<U>& rhs
+  )
+  {
+      return lhs.base() < rhs.base()
+          || (lhs.base() == rhs.base() && lhs.position() <= rhs.position());
+  }
+  template <class T, class U>
+  constexpr bool operator>(
+      const bit_iterator<T>& lhs,
+      const bit_iterator<U>& rhs
+  )
+  {
+      return lhs.base() > rhs.base()
+          || (lhs.base() == rhs.base() && lhs.position() > rhs.position());
+  }
+  template <class T, class U>
+  constexpr bool operator>=(
+      const bit_iterator<T>& lhs,
+      const bit_iterator<U>& rhs
+  )
+  {
+      return lhs.base() > rhs.base()
+          || (lhs.base() == rhs.base() && lhs.position() >= rhs.position());
+  }
+
 }}
 } // std
 
+#include <experimental/fundamental/v3/bits/bit_algorithm.hpp>
+
 #endif // header
@@ -17,11 +17,17 @@
  but ensures that the implementation uses a specific representation. Currently std::bitset uses 64 bits  (the size of long long)
  // and several  related functions for representing and manipulating sets of indexes. We can say that
  \c bit_mask is the counterpart of \c std::bitset when the user forces the representation.
+
+ When \c N is greater than the digits of \c T the bits are stored in an array of \c T blocks, the bit \c pos being the
+ bit \c pos%digits of the block \c pos/digits. The operations are done a block at a time.
+
+ Defining JASEL_BIT_MASK_NO_SIMD disables the x86 vectorized paths.
  */
 
 #ifndef JASEL_FUNDAMENTAL_V3_BITS_BIT_MASK_HPP
 #define JASEL_FUNDAMENTAL_V3_BITS_BIT_MASK_HPP
 
+#include <array>
 #include <stdexcept>
 #include <iosfwd>
 #include <string>
@@ -32,7 +38,27 @@
 
 #include <experimental/fundamental/v2/config.hpp>
 #include <experimental/fundamental/v3/bits/bit_ops.hpp>
+#include <experimental/fundamental/v3/bits/set_bit_iterator.hpp>
+#include <experimental/fundamental/v3/type_traits/integer_sequence.hpp>
 #include <experimental/bit.hpp>
+#include <functional>
+#include <ostream>
+
+// The vectorized paths are used only at run time, which needs __builtin_is_constant_evaluated.
+#if !defined JASEL_BIT_MASK_NO_SIMD && (defined __GNUC__ || defined __clang__) && defined __has_builtin
+#if __has_builtin(__builtin_is_constant_evaluated)
+#if defined __AVX2__
+#define JASEL_BIT_MASK_AVX2
+#endif
+#if defined __SSE2__
+#define JASEL_BIT_MASK_SSE2
+#endif
+#endif
+#endif
+
+#if defined JASEL_BIT_MASK_SSE2
+#include <immintrin.h>
+#endif
 
 // todo: Add explicit conversions from bit_mask of different sizes
 
@@ -43,9 +69,7 @@
 
 // todo: Add P0125R0: is_subset_of and is_superset_of (is_proper_subset_of and is_proper_superset_of)
 
-// todo: Add n2050 iteration functions:
-// size_type find_first() const;
-// size_type find_next(size_type pos) const;
+// todo: Add the remaining n2050 iteration functions:
 // size_type find_last() const;
 // size_type find_prev(size_type pos) const;
 // size_type find_first_not() const;
@@ -64,6 +88,196 @@ inline namespace fundamental_v3
   struct pos_tag_t {}; //! tag used when passing the position to set in the constructor
   struct fill_tag_t {}; //! tag used when passing a value to fill in the constructor
   struct mask_tag_t {}; //! tag used when passing a mask to set in the constructor
+  struct blocks_tag_t {}; //! tag used when passing the blocks to copy in the constructor
+
+  namespace bit_mask_detail
+  {
+    template <class T>
+    constexpr size_t digits() noexcept
+    {
+      return size_t(std::numeric_limits<T>::digits);
+    }
+
+    //! The number of blocks of type T needed to store N bits.
+    template <size_t N, class T>
+    struct blocks : integral_constant<size_t, (N == 0) ? 1 : (N + digits<T>() - 1) / digits<T>()>
+    {
+    };
+
+    //! The significant bits of the last block.
+    template <size_t N, class T>
+    constexpr T last_block_mask() noexcept
+    {
+      return (N == 0) ? T(0)
+           : (N % digits<T>() == 0) ? T(~T(0))
+           : T((T(1) << (N % digits<T>())) - 1);
+    }
+
+    //! @par Returns:
+    //!   @c true if we are not evaluating a constant expression and the vectorized paths can be used.
+    inline JASEL_CXX14_CONSTEXPR bool use_simd() noexcept
+    {
+#if defined JASEL_BIT_MASK_SSE2
+      return !__builtin_is_constant_evaluated();
+#else
+      return false;
+#endif
+    }
+
+    namespace simd
+    {
+#if defined JASEL_BIT_MASK_SSE2
+      // The vector loops process the blocks by chunks of 16 or 32 bytes; the remaining blocks are left to the caller.
+      // Each one returns the position of the first block it hasn't checked, stopping at the first chunk that doesn't
+      // satisfy the predicate: the scalar loop of the caller restarts from there.
+
+      template <class T>
+      size_t none(T const* p, size_t n)
+      {
+        size_t i = 0;
+#if defined JASEL_BIT_MASK_AVX2
+        constexpr size_t per256 = 32 / sizeof(T);
+        for (; i + per256 <= n; i += per256)
+        {
+          __m256i const v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + i));
+          if (!_mm256_testz_si256(v, v)) return i;
+        }
+#endif
+        constexpr size_t per128 = 16 / sizeof(T);
+        __m128i const zero = _mm_setzero_si128();
+        for (; i + per128 <= n; i += per128)
+        {
+          __m128i const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i));
+          if (_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero)) != 0xFFFF) return i;
+        }
+        return i;
+      }
+
+      template <class T>
+      size_t all(T const* p, size_t n)
+      {
+        size_t i = 0;
+#if defined JASEL_BIT_MASK_AVX2
+        constexpr size_t per256 = 32 / sizeof(T);
+        __m256i const ones256 = _mm256_set1_epi32(-1);
+        for (; i + per256 <= n; i += per256)
+        {
+          __m256i const v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + i));
+          if (!_mm256_testc_si256(v, ones256)) return i;
+        }
+#endif
+        constexpr size_t per128 = 16 / sizeof(T);
+        __m128i const ones = _mm_set1_epi32(-1);
+        for (; i + per128 <= n; i += per128)
+        {
+          __m128i const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i));
+          if (_mm_movemask_epi8(_mm_cmpeq_epi8(v, ones)) != 0xFFFF) return i;
+        }
+        return i;
+      }
+
+      template <class T>
+      size_t equal(T const* p, T const* q, size_t n)
+      {
+        size_t i = 0;
+#if defined JASEL_BIT_MASK_AVX2
+        constexpr size_t per256 = 32 / sizeof(T);
+        for (; i + per256 <= n; i += per256)
+        {
+          __m256i const v = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + i)),
+                                             _mm256_loadu_si256(reinterpret_cast<__m256i const*>(q + i)));
+          if (!_mm256_testz_si256(v, v)) return i;
+        }
+#endif
+        constexpr size_t per128 = 16 / sizeof(T);
+        for (; i + per128 <= n; i += per128)
+        {
+          __m128i const v = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i)),
+                                           _mm_loadu_si128(reinterpret_cast<__m128i const*>(q + i)));
+          if (_mm_movemask_epi8(v) != 0xFFFF) return i;
+        }
+        return i;
+      }
+#endif
+    }
+
+    //! @par Returns:
+    //!   @c true if the n blocks starting at p are zero.
+    template <class T>
+    JASEL_CXX14_CONSTEXPR bool none(T const* p, size_t n) noexcept
+    {
+      size_t i = 0;
+#if defined JASEL_BIT_MASK_SSE2
+      if (use_simd()) i = simd::none(p, n);
+#endif
+      for (; i < n; ++i)
+        if (p[i] != 0) return false;
+      return true;
+    }
+
+    //! @par Returns:
+    //!   @c true if all the bits of the n blocks starting at p are set.
+    template <class T>
+    JASEL_CXX14_CONSTEXPR bool all(T const* p, size_t n) noexcept
+    {
+      size_t i = 0;
+#if defined JASEL_BIT_MASK_SSE2
+      if (use_simd()) i = simd::all(p, n);
+#endif
+      for (; i < n; ++i)
+        if (p[i] != T(~T(0))) return false;
+      return true;
+    }
+
+    //! @par Returns:
+    //!   @c true if the n blocks starting at p are equal to the ones starting at q.
+    template <class T>
+    JASEL_CXX14_CONSTEXPR bool equal(T const* p, T const* q, size_t n) noexcept
+    {
+      size_t i = 0;
+#if defined JASEL_BIT_MASK_SSE2
+      if (use_simd()) i = simd::equal(p, q, n);
+#endif
+      for (; i < n; ++i)
+        if (p[i] != q[i]) return false;
+      return true;
+    }
+
+    template <class T>
+    JASEL_CXX14_CONSTEXPR size_t count(T const* p, size_t n) noexcept
+    {
+      size_t r = 0;
+      for (size_t i = 0; i < n; ++i)
+        r += size_t(bit_ops::popcount(p[i]));
+      return r;
+    }
+
+    //! @par Returns:
+    //!   The position of the first bit set in the n blocks starting at p from the bit pos on, or @c n*digits if there is none.
+    template <class T>
+    JASEL_CXX14_CONSTEXPR size_t find_from(T const* p, size_t n, size_t pos) noexcept
+    {
+      size_t i = pos / digits<T>();
+      if (i >= n) return n * digits<T>();
+      T x = T(p[i] & T(T(~T(0)) << (pos % digits<T>())));
+      while (x == 0)
+      {
+        if (++i == n) return n * digits<T>();
+        x = p[i];
+      }
+      return i * digits<T>() + size_t(bit_ops::countr_zero(x));
+    }
+
+    //! Combines the hash of the n blocks starting at p.
+    template <class T>
+    size_t hash(T const* p, size_t n) noexcept
+    {
+      size_t h = std::hash<T>()(p[0]);
+      for (size_t i = 1; i < n; ++i)
+        h ^= std::hash<T>()(p[i]) + size_t(0x9e3779b9) + (h << 6) + (h >> 2);
+      return h;
+    }
+  }
 
     /**
       @tparam N the number of significant bits on the storage
@@ -96,9 +310,48 @@ inline namespace fundamental_v3
     template<size_t N, typename T>
     class bit_mask
     {
-      static constexpr unsigned int digits = std::numeric_limits<T>::digits;
+      static constexpr size_t digits = bit_mask_detail::digits<T>();
+      static constexpr size_t nblocks = bit_mask_detail::blocks<N, T>::value;
+
+      T blocks[nblocks];
 
-      T bits;
+      //! The significant bits of the block i.
+      static constexpr T block_mask(size_t i) noexcept
+      {
+        return (i + 1 == nblocks) ? bit_mask_detail::last_block_mask<N, T>() : T(~T(0));
+      }
+      template <size_t... I>
+      constexpr bit_mask(index_sequence<I...>, pos_tag_t, size_t pos) noexcept
+        : blocks{ T((pos / digits == I) ? bit_ops::single<T>(pos % digits) & block_mask(I) : 0)... }
+      {
+      }
+      template <size_t... I>
+      constexpr bit_mask(index_sequence<I...>, fill_tag_t, bool val) noexcept
+        : blocks{ T(val ? block_mask(I) : 0)... }
+      {
+      }
+      template <size_t... I>
+      constexpr bit_mask(index_sequence<I...>, mask_tag_t, T val) noexcept
+        : blocks{ T((I == 0) ? val & block_mask(I) : 0)... }
+      {
+      }
+      template <size_t... I>
+      constexpr bit_mask(index_sequence<I...>, blocks_tag_t, array<T, nblocks> const& b) noexcept
+        : blocks{ T(std::get<I>(b) & block_mask(I))... }
+      {
+      }
+      JASEL_CXX14_CONSTEXPR unsigned long long to_ullong_impl() const
+      {
+        unsigned long long r = 0;
+        for (size_t i = 0; i < nblocks; ++i)
+        {
+          if (blocks[i] == 0) continue;
+          if (i * digits >= size_t(std::numeric_limits<unsigned long long>::digits))
+            throw std::overflow_error("bit_mask");
+          r |= static_cast<unsigned long long>(blocks[i]) << (i * digits);
+        }
+        return r;
+      }
       // fixme: shouldn't we provide a function that checks the validity of a position?
       JASEL_MUTABLE_CONSTEXPR void check(size_t testing) const
       {
@@ -119,6 +372,11 @@ inline namespace fundamental_v3
 
       using reference = bit_reference<T>;
 
+      //! The type of the blocks storing the bits.
+      using block_type = T;
+      //! The number of blocks, @c N/digits rounded up.
+      static constexpr size_t block_count = nblocks;
+
       //fixme: If we want bit_mask to be a POD this constructor should be default
       // The user will need to use explicit zero-initialization.
       // bit_mask<5> bm {}
@@ -145,7 +403,7 @@ inline namespace fundamental_v3
       //! @par Pre-condition:
       //!   @code pos <= N @endcode
       explicit constexpr bit_mask(pos_tag_t, size_t pos)
-        : bits(bit_ops::single<T>(pos) & bit_ops::up_to<N,T>())
+        : bit_mask(make_index_sequence<nblocks>{}, pos_tag_t{}, pos)
       {
         //JASEL_EXPECTS(valid_position(pos));
       }
@@ -156,18 +414,29 @@ inline namespace fundamental_v3
       //! @par Throws:
       //!   Nothing
       explicit constexpr bit_mask(fill_tag_t, bool val) noexcept
-        : bits(val?bit_ops::up_to<N,T>():0)
+        : bit_mask(make_index_sequence<nblocks>{}, fill_tag_t{}, val)
       {
       }
 
       //! @par Effects:
       //!   Constructs an object of class \c bit_mask<>, initializing the
       //!   first \c N bit positions to the corresponding bit values in \c val.
+      //!   The bits not in the first block are set to zero.
       //! @par Throws:
       //!   Nothing
 
       explicit constexpr bit_mask(mask_tag_t, T val) noexcept
-        : bits(val & bit_ops::up_to<N,T>())
+        : bit_mask(make_index_sequence<nblocks>{}, mask_tag_t{}, val)
+      {
+      }
+
+      //! @par Effects:
+      //!   Constructs an object of class \c bit_mask<>, initializing its blocks to the ones of \c b.
+      //!   The bits beyond \c N are set to zero.
+      //! @par Throws:
+      //!   Nothing
+      explicit constexpr bit_mask(blocks_tag_t, array<T, nblocks> const& b) noexcept
+        : bit_mask(make_index_sequence<nblocks>{}, blocks_tag_t{}, b)
       {
       }
 
@@ -218,7 +487,8 @@ inline namespace fundamental_v3
       //!   Nothing
       JASEL_MUTABLE_CONSTEXPR bit_mask& operator&=(const bit_mask& rhs) noexcept
       {
-        bits &= rhs.bits;
+        for (size_t i = 0; i < nblocks; ++i)
+          blocks[i] &= rhs.blocks[i];
         return *this;
       }
 
@@ -231,7 +501,8 @@ inline namespace fundamental_v3
       //!   Nothing
       JASEL_MUTABLE_CONSTEXPR bit_mask& operator|=(const bit_mask& rhs) noexcept
       {
-        bits |= rhs.bits;
+        for (size_t i = 0; i < nblocks; ++i)
+          blocks[i] |= rhs.blocks[i];
         return *this;
       }
 
@@ -244,8 +515,8 @@ inline namespace fundamental_v3
       //!   Nothing
       JASEL_MUTABLE_CONSTEXPR bit_mask& operator^=(const bit_mask& rhs) noexcept
       {
-        bits ^= rhs.bits;
-        bits &= bit_ops::up_to<N,T>();
+        for (size_t i = 0; i < nblocks; ++i)
+          blocks[i] ^= rhs.blocks[i];
         return *this;
       }
 
@@ -259,8 +530,19 @@ inline namespace fundamental_v3
       //!   Nothing
       JASEL_MUTABLE_CONSTEXPR bit_mask& operator<<=(size_t pos) noexcept
       {
-        bits <<= pos;
-        bits &= bit_ops::up_to<N,T>();
+        if (pos >= N) return reset();
+        size_t const shift = pos / digits;
+        size_t const offset = pos % digits;
+        for (size_t i = nblocks; i-- > shift;)
+        {
+          T x = T(blocks[i - shift] << offset);
+          if (offset != 0 && i > shift)
+            x |= T(blocks[i - shift - 1] >> (digits - offset));
+          blocks[i] = x;
+        }
+        for (size_t i = 0; i < shift; ++i)
+          blocks[i] = 0;
+        blocks[nblocks - 1] &= block_mask(nblocks - 1);
         return *this;
       }
 
@@ -275,8 +557,18 @@ inline namespace fundamental_v3
 
       JASEL_MUTABLE_CONSTEXPR bit_mask& operator>>=(size_t pos) noexcept
       {
-        bits >>= pos;
-        //bits &= bit_ops::up_to<N,T>();
+        if (pos >= N) return reset();
+        size_t const shift = pos / digits;
+        size_t const offset = pos % digits;
+        for (size_t i = 0; i + shift < nblocks; ++i)
+        {
+          T x = T(blocks[i + shift] >> offset);
+          if (offset != 0 && i + shift + 1 < nblocks)
+            x |= T(blocks[i + shift + 1] << (digits - offset));
+          blocks[i] = x;
+        }
+        for (size_t i = nblocks - shift; i < nblocks; ++i)
+          blocks[i] = 0;
         return *this;
       }
 
@@ -284,8 +576,8 @@ inline namespace fundamental_v3
       //!   A count of the number of bits set in \c *this.
       constexpr std::size_t count() const noexcept
       {
-        // fixme
-        return static_cast<size_t>(bit_ops::popcount(bits));
+        return (nblocks == 1) ? static_cast<size_t>(bit_ops::popcount(blocks[0]))
+             : bit_mask_detail::count(blocks, nblocks);
       }
 
       //! @par Returns:
@@ -305,7 +597,7 @@ inline namespace fundamental_v3
       JASEL_CXX14_CONSTEXPR bool operator[](size_t pos) const
       {
         //JASEL_EXPECTS(valid_position(pos));
-        return bits & bit_ops::single<T>(pos);
+        return blocks[pos / digits] & bit_ops::single<T>(pos % digits);
       }
 
       //! @par Pre-condition:
@@ -324,7 +616,7 @@ inline namespace fundamental_v3
       JASEL_CXX14_CONSTEXPR reference operator[](size_t pos)
       {
         //JASEL_EXPECTS(valid_position(pos));
-        return reference(bits, pos);
+        return reference(blocks[pos / digits], pos % digits);
       }
       //! @par Effects:
       //!   Sets all bits in \c *this.
@@ -335,7 +627,8 @@ inline namespace fundamental_v3
 
       JASEL_MUTABLE_CONSTEXPR bit_mask& set() noexcept
       {
-        bits = T(~0) & bit_ops::up_to<N,T>();
+        for (size_t i = 0; i < nblocks; ++i)
+          blocks[i] = block_mask(i);
         return *this;
       }
 
@@ -349,8 +642,9 @@ inline namespace fundamental_v3
       JASEL_MUTABLE_CONSTEXPR bit_mask& set(size_t setting, bool value = true)
       {
         check(setting);
-        bits &= ~bit_ops::single<T>(setting);
-        bits |= (unsigned(value)<<setting); // fixme
+        T& block = blocks[setting / digits];
+        block = T(block & ~bit_ops::single<T>(setting % digits));
+        block = T(block | (T(value) << (setting % digits)));
         return *this;
       }
 
@@ -362,7 +656,8 @@ inline namespace fundamental_v3
       //!   Nothing
       JASEL_MUTABLE_CONSTEXPR bit_mask& reset() noexcept
       {
-        bits = T(0);
+        for (size_t i = 0; i < nblocks; ++i)
+          blocks[i] = T(0);
         return *this;
       }
 
@@ -376,7 +671,7 @@ inline namespace fundamental_v3
       JASEL_MUTABLE_CONSTEXPR bit_mask& reset(size_t resetting)
       {
         check(resetting);
-        bits &= ~bit_ops::single<T>(resetting);
+        blocks[resetting / digits] &= T(~bit_ops::single<T>(resetting % digits));
         return *this;
       }
 
@@ -388,8 +683,8 @@ inline namespace fundamental_v3
       //!   Nothing
       JASEL_MUTABLE_CONSTEXPR bit_mask& flip() noexcept
       {
-        bits = ~bits;
-        bits &= bit_ops::up_to<N,T>();
+        for (size_t i = 0; i < nblocks; ++i)
+          blocks[i] = T(~blocks[i] & block_mask(i));
         return *this;
       }
 
@@ -402,18 +697,33 @@ inline namespace fundamental_v3
       JASEL_MUTABLE_CONSTEXPR bit_mask& flip(size_t flipping)
       {
         check(flipping);
-        bits ^= bit_ops::single<T>(flipping);
-        bits &= bit_ops::up_to<N,T>();
-
+        blocks[flipping / digits] ^= bit_ops::single<T>(flipping % digits);
         return *this;
       }
 
       //! \c <tt>T</tt> conversion
       //! @par Returns:
       //!   \c x.
-      constexpr T to_integer() const noexcept
+      //! @par Throws:
+      //!   @c std::overflow_error if the integral value \c x corresponding to the
+      //!   bits in \c *this cannot be represented as type <tt>T</tt>.
+      constexpr T to_integer() const noexcept(nblocks == 1)
       {
-        return bits;
+        return (nblocks == 1 || bit_mask_detail::none(blocks + 1, nblocks - 1)) ? blocks[0]
+             : throw std::overflow_error("bit_mask");
+      }
+
+      //! @par Returns:
+      //!   A pointer to the first block storing the bits.
+      //! @par Remark:
+      //!   The bits beyond @c N are zero and must be kept to zero.
+      JASEL_CXX14_CONSTEXPR T* data() noexcept
+      {
+        return blocks;
+      }
+      constexpr T const* data() const noexcept
+      {
+        return blocks;
       }
 
       //! \c <tt>unsigned long</tt> conversion
@@ -423,17 +733,23 @@ inline namespace fundamental_v3
       //!   @c std::overflow_error if the integral value \c x corresponding to the
       //!   bits in \c *this cannot be represented as type <<tt>unsigned long</tt>.
 
-      constexpr unsigned long to_ulong() const noexcept
+      constexpr unsigned long to_ulong() const noexcept(nblocks == 1)
       {
-        return static_cast<unsigned long>(bits);
+        return (nblocks == 1) ? static_cast<unsigned long>(blocks[0])
+             : (to_ullong_impl() <= std::numeric_limits<unsigned long>::max())
+               ? static_cast<unsigned long>(to_ullong_impl())
+               : throw std::overflow_error("bit_mask");
       }
 
       //! \c <tt>unsigned long long</tt> conversion
       //! @par Returns:
       //! \c x.
-      constexpr unsigned long long to_ullong() const noexcept
+      //! @par Throws:
+      //!   @c std::overflow_error if the integral value \c x corresponding to the
+      //!   bits in \c *this cannot be represented as type <tt>unsigned long long</tt>.
+      constexpr unsigned long long to_ullong() const noexcept(nblocks == 1)
       {
-        return static_cast<unsigned long long>(bits);
+        return (nblocks == 1) ? static_cast<unsigned long long>(blocks[0]) : to_ullong_impl();
       }
 #if 0
 
@@ -468,28 +784,59 @@ inline namespace fundamental_v3
       JASEL_MUTABLE_CONSTEXPR bool test(size_t testing) const
       {
         check(testing);
-        return bits & bit_ops::single<T>(testing);
+        return blocks[testing / digits] & bit_ops::single<T>(testing % digits);
       }
 
       //! @par Returns:
       //!   <tt>count() == size()</tt>
       constexpr bool all() const noexcept
       {
-        return bits == bit_ops::up_to<N,T>();
+        return (nblocks == 1) ? blocks[0] == block_mask(0)
+             : bit_mask_detail::all(blocks, nblocks - 1) && blocks[nblocks - 1] == block_mask(nblocks - 1);
       }
 
       //! @par Returns:
       //!   <tt>count() != 0</tt>
       constexpr bool any() const noexcept
       {
-        return bits != 0;
+        return !none();
       }
 
       //! @par Returns:
       //!   <tt>count() == 0</tt>
       constexpr bool none() const noexcept
       {
-        return bits == 0;
+        return (nblocks == 1) ? blocks[0] == 0 : bit_mask_detail::none(blocks, nblocks);
+      }
+
+      //! @par Returns:
+      //!   The lowest position of a bit set in \c *this, or \c size() if there is none.
+      constexpr size_t find_first() const noexcept
+      {
+        return (nblocks == 1) ? (blocks[0] == 0 ? N : size_t(bit_ops::countr_zero(blocks[0])))
+             : find_from(0);
+      }
+
+      //! @par Returns:
+      //!   The lowest position greater than \c pos of a bit set in \c *this, or \c size() if there is none.
+      JASEL_CXX14_CONSTEXPR size_t find_next(size_t pos) const noexcept
+      {
+        return (pos + 1 >= N) ? N : find_from(pos + 1);
+      }
+
+      //! @par Returns:
+      //!   The range of the positions of the bits set in \c *this, in increasing order.
+      constexpr set_bit_range<T> set_bits() const noexcept
+      {
+        return set_bit_range<T>(blocks, nblocks);
+      }
+
+      //! @par Effects:
+      //!   Calls \c f(pos) for the position \c pos of each bit set in \c *this, in increasing order.
+      template <class F>
+      JASEL_CXX14_CONSTEXPR void for_each_set(F&& f) const
+      {
+        for_each_set_bit(blocks, nblocks, f);
       }
 
       //! @par Returns:
@@ -517,17 +864,22 @@ inline namespace fundamental_v3
       //!   value of the corresponding bit in \c rhs.
       constexpr bool operator==(const bit_mask& rhs) const noexcept
       {
-        return bits == rhs.bits;
+        return (nblocks == 1) ? blocks[0] == rhs.blocks[0] : bit_mask_detail::equal(blocks, rhs.blocks, nblocks);
       }
 
       //! @par Returns:
       //!   A nonzero value if <tt>!(*this == rhs)</tt>.
       constexpr bool operator!=(const bit_mask& rhs) const noexcept
       {
-        return bits != rhs.bits;
+        return !(*this == rhs);
       }
     private:
-
+      JASEL_CXX14_CONSTEXPR size_t find_from(size_t pos) const noexcept
+      {
+        // the bits beyond N are zero, so the position found is either less than N or past the last block
+        size_t const r = bit_mask_detail::find_from(blocks, nblocks, pos);
+        return (r < N) ? r : N;
+      }
     };
 
     // bit_mask operators:
@@ -595,7 +947,8 @@ inline namespace fundamental_v3
     //!
     //! @param os the output stream
     //! @param x the \c bit_mask
-    //! @par Returns:<br>   the result of the following expression
+    //! @par Returns:<br>   <tt>os << x.to_integer()</tt> when \c x is stored in a single block, otherwise
+    //! the result of the following expression
     //! @code
     //! os << x.template to_string<charT,traits,allocator<charT> >(
     //!         use_facet<ctype<charT> >(os.getloc()).widen('0'),
@@ -606,7 +959,12 @@ inline namespace fundamental_v3
     std::basic_ostream<charT, traits>&
     operator<<(std::basic_ostream<charT, traits>& os, const bit_mask<N,T>& x)
     {
-      return os << x.to_integer();
+      if (bit_mask<N,T>::block_count == 1)
+        return os << x.to_integer();
+      std::basic_string<charT, traits> str(N, os.widen('0'));
+      for (size_t pos = x.find_first(); pos < N; pos = x.find_next(pos))
+        str[N - 1 - pos] = os.widen('1');
+      return os << str;
     }
 
     template<size_t N, typename T>
@@ -623,15 +981,15 @@ inline namespace fundamental_v3
   //! bit_mask hash template specialization
   template <size_t N, typename T >
   struct hash<experimental::bit_mask<N,T> >
-  : public std::unary_function<experimental::bit_mask<N,T>, std::size_t>
   {
     //! \details The template specialization meets the requirements of class template \c hash.
     //!
     //! @param es the @c bit_mask
-    //! @par Returns:<br>   the hash associated to the underlying bitset.
-    constexpr std::size_t operator()(const experimental::bit_mask<N,T>& es) const
+    //! @par Returns:<br>   the hash of the underlying block when there is a single one, a combination of the hash of
+    //! each block otherwise.
+    std::size_t operator()(const experimental::bit_mask<N,T>& es) const noexcept
     {
-      return hash<T>(es.to_integer());
+      return experimental::bit_mask_detail::hash(es.data(), es.block_count);
     }
   };
 
@@ -14,6 +14,9 @@
  \brief
  The header \c <experimental/.../bits/algorithms.hpp> defines some common bits algorithms.
  Most of them are based on http://www.open-std.org/jtc1/sc22/wg21/docs/papers/2018/p0553r3.html
+
+ The bulk popcount, popcount_and and popcount_xor of spans of 64-bit words dispatch at run time between SIMD kernels.
+ Defining JASEL_BIT_OPS_NO_DISPATCH restricts them to the portable one.
  */
 
 #ifndef JASEL_FUNDAMENTAL_V3_BITS_BITOPS_HPP
@@ -28,9 +31,21 @@
 #include <limits>
 #include <type_traits>
 
+#include <cstdint>
+
 #include <experimental/fundamental/v2/config.hpp>
+#include <experimental/contract.hpp>
+#include <experimental/span.hpp>
 #include <experimental/type_traits.hpp>
 
+// The bulk popcounts choose their kernel at run time; the kernels for the extensions the target doesn't enable by
+// default are compiled with the target attribute.
+#if !defined JASEL_BIT_OPS_NO_DISPATCH && (defined __GNUC__ || defined __clang__) && (defined __x86_64__ || defined __i386__)
+#define JASEL_BIT_OPS_DISPATCH
+#define JASEL_BIT_OPS_TARGET(isa) __attribute__((target(isa)))
+#include <immintrin.h>
+#endif
+
 namespace std
 {
 namespace experimental
@@ -91,6 +106,40 @@ inline namespace fundamental_v3
            ;
     }
 
+    namespace bit_ops_detail
+    {
+      // The builtins work on unsigned, unsigned long or unsigned long long: T is widened to the smallest one that
+      // holds it, and for countl_zero the bits added on the left are subtracted.
+      template <class T, class U>
+      constexpr int extra_digits() noexcept
+      {
+        return numeric_limits<U>::digits - numeric_limits<T>::digits;
+      }
+      template <class T>
+      constexpr int clz(T x) noexcept
+      {
+        return (sizeof(T) <= sizeof(unsigned))
+             ? __builtin_clz(static_cast<unsigned>(x)) - extra_digits<T, unsigned>()
+             : (sizeof(T) <= sizeof(unsigned long))
+             ? __builtin_clzl(static_cast<unsigned long>(x)) - extra_digits<T, unsigned long>()
+             : __builtin_clzll(static_cast<unsigned long long>(x)) - extra_digits<T, unsigned long long>();
+      }
+      template <class T>
+      constexpr int ctz(T x) noexcept
+      {
+        return (sizeof(T) <= sizeof(unsigned)) ? __builtin_ctz(static_cast<unsigned>(x))
+             : (sizeof(T) <= sizeof(unsigned long)) ? __builtin_ctzl(static_cast<unsigned long>(x))
+             : __builtin_ctzll(static_cast<unsigned long long>(x));
+      }
+      template <class T>
+      constexpr int popcount(T x) noexcept
+      {
+        return (sizeof(T) <= sizeof(unsigned)) ? __builtin_popcount(static_cast<unsigned>(x))
+             : (sizeof(T) <= sizeof(unsigned long)) ? __builtin_popcountl(static_cast<unsigned long>(x))
+             : __builtin_popcountll(static_cast<unsigned long long>(x));
+      }
+    }
+
     //! @par Returns
     //!   The number of consecutive 0 bits, starting from the most significant bit.
     //!   [ Note: Returns std::numeric_limits<T>::digits if x == 0. ]
@@ -102,18 +151,7 @@ inline namespace fundamental_v3
     >
     JASEL_NODISCARD constexpr int countl_zero(T x) noexcept
     {
-      return __builtin_clz(x);
-
-    }
-    JASEL_NODISCARD constexpr int countl_zero(unsigned long x) noexcept
-    {
-      return __builtin_clzl(x);
-
-    }
-    JASEL_NODISCARD constexpr int countl_zero(unsigned long long x) noexcept
-    {
-      return __builtin_clzll(x);
-
+      return (x == 0) ? numeric_limits<T>::digits : bit_ops_detail::clz(x);
     }
     //! @par Returns
     //!   The number of consecutive 0 bits, starting from the least significant bit.
@@ -126,16 +164,8 @@ inline namespace fundamental_v3
     >
     JASEL_NODISCARD constexpr int countr_zero(T x) noexcept
     {
-      return __builtin_ctz(x);
+      return (x == 0) ? numeric_limits<T>::digits : bit_ops_detail::ctz(x);
     }
-    JASEL_NODISCARD constexpr int countr_zero(unsigned long x) noexcept
-        {
-          return __builtin_ctzl(x);
-        }
-    JASEL_NODISCARD constexpr int countr_zero(unsigned long long x) noexcept
-        {
-          return __builtin_ctzll(x);
-        }
 
     //! @par Returns
     //!   The number of consecutive 1 bits, starting from the most significant bit.
@@ -148,7 +178,7 @@ inline namespace fundamental_v3
     >
     JASEL_NODISCARD constexpr int countl_one(T x) noexcept
     {
-      return countl_zero(~x);
+      return countl_zero(T(~x));
     }
 
     //! @par Returns
@@ -162,28 +192,300 @@ inline namespace fundamental_v3
     >
     JASEL_NODISCARD constexpr int countr_one(T x) noexcept
     {
-      return countr_zero(~x);
+      return countr_zero(T(~x));
     }
 
     //! @par Returns
     //!   The number of bits set to 1 in x
-    template <class T>
+    //! @par Remarks:
+    //!   Participates in overload resolution only if T is an integer type
+    template <class T, typename= enable_if_t<
+            is_integral<T>::value
+        >
+    >
     JASEL_NODISCARD constexpr int popcount(T x) noexcept
     {
-      return __builtin_popcount(x);
+      return bit_ops_detail::popcount(x);
+    }
+
+    namespace popcount_detail
+    {
+      // The bulk counts are done by one of these kernels, selected at run time from the CPU features the first time
+      // each operation is used. All of them give the same result; the choice only changes the speed.
+      enum class kernel
+      {
+        scalar,   // SWAR counts, for any target
+        popcnt,   // one POPCNT per word
+        avx2,     // Harley-Seal carry-save adders over 16 vectors of 256 bits, counted with a nibble lookup
+        avx512    // VPOPCNTQ over 512 bits
+      };
+
+      // How the two words or vectors are combined before they are counted; the single-span count reads only the first.
+      enum class op
+      {
+        first,
+        and_,
+        xor_
+      };
+
+      using kernel_fn = size_t (*)(uint64_t const*, uint64_t const*, size_t);
+
+      template <op Op>
+      inline uint64_t combine(uint64_t a, uint64_t b) noexcept
+      {
+        return (Op == op::first) ? a : (Op == op::and_) ? (a & b) : (a ^ b);
+      }
+
+      inline size_t swar(uint64_t x) noexcept
+      {
+        x = x - ((x >> 1) & 0x5555555555555555ull);
+        x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+        x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+        return size_t((x * 0x0101010101010101ull) >> 56);
+      }
+
+      template <op Op>
+      size_t count_scalar(uint64_t const* p, uint64_t const* q, size_t n) noexcept
+      {
+        size_t r = 0;
+        for (size_t i = 0; i < n; ++i)
+          r += swar(combine<Op>(p[i], q[i]));
+        return r;
+      }
+
+#if defined JASEL_BIT_OPS_DISPATCH
+      template <op Op>
+      JASEL_BIT_OPS_TARGET("popcnt")
+      size_t count_popcnt(uint64_t const* p, uint64_t const* q, size_t n) noexcept
+      {
+        // four independent sums, so that the POPCNT of consecutive words can run in parallel
+        uint64_t r0 = 0, r1 = 0, r2 = 0, r3 = 0;
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+          r0 += uint64_t(__builtin_popcountll(combine<Op>(p[i], q[i])));
+          r1 += uint64_t(__builtin_popcountll(combine<Op>(p[i + 1], q[i + 1])));
+          r2 += uint64_t(__builtin_popcountll(combine<Op>(p[i + 2], q[i + 2])));
+          r3 += uint64_t(__builtin_popcountll(combine<Op>(p[i + 3], q[i + 3])));
+        }
+        for (; i < n; ++i)
+          r0 += uint64_t(__builtin_popcountll(combine<Op>(p[i], q[i])));
+        return size_t(r0 + r1 + r2 + r3);
+      }
+
+      template <op Op>
+      JASEL_BIT_OPS_TARGET("avx2")
+      inline __m256i load256(uint64_t const* p, uint64_t const* q) noexcept
+      {
+        __m256i const a = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p));
+        return (Op == op::first) ? a
+             : (Op == op::and_) ? _mm256_and_si256(a, _mm256_loadu_si256(reinterpret_cast<__m256i const*>(q)))
+             : _mm256_xor_si256(a, _mm256_loadu_si256(reinterpret_cast<__m256i const*>(q)));
+      }
+
+      //! @par Returns:
+      //!   The counts of the four 64-bit lanes of v: each nibble is counted with a table lookup, and the bytes of a lane
+      //!   are summed by SAD against 0.
+      JASEL_BIT_OPS_TARGET("avx2")
+      inline __m256i count256(__m256i v) noexcept
+      {
+        __m256i const table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                               0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        __m256i const low = _mm256_set1_epi8(0x0F);
+        __m256i const lo = _mm256_and_si256(v, low);
+        __m256i const hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low);
+        __m256i const bytes = _mm256_add_epi8(_mm256_shuffle_epi8(table, lo), _mm256_shuffle_epi8(table, hi));
+        return _mm256_sad_epu8(bytes, _mm256_setzero_si256());
+      }
+
+      // carry-save adder: h:l = a + b + c, bit by bit
+      JASEL_BIT_OPS_TARGET("avx2")
+      inline void csa(__m256i& h, __m256i& l, __m256i a, __m256i b, __m256i c) noexcept
+      {
+        __m256i const u = _mm256_xor_si256(a, b);
+        h = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(u, c));
+        l = _mm256_xor_si256(u, c);
+      }
+
+      template <op Op>
+      JASEL_BIT_OPS_TARGET("avx2")
+      size_t count_avx2(uint64_t const* p, uint64_t const* q, size_t n) noexcept
+      {
+        // The bits of weight 1, 2, 4 and 8 are kept in ones, twos, fours and eights; only the carries of weight 16
+        // are counted in the loop, once per 16 vectors.
+        __m256i total = _mm256_setzero_si256();
+        __m256i ones = _mm256_setzero_si256();
+        __m256i twos = _mm256_setzero_si256();
+        __m256i fours = _mm256_setzero_si256();
+        __m256i eights = _mm256_setzero_si256();
+        __m256i sixteens, twos_a, twos_b, fours_a, fours_b, eights_a, eights_b;
+        size_t i = 0;
+        for (; i + 64 <= n; i += 64)
+        {
+          csa(twos_a, ones, ones, load256<Op>(p + i, q + i), load256<Op>(p + i + 4, q + i + 4));
+          csa(twos_b, ones, ones, load256<Op>(p + i + 8, q + i + 8), load256<Op>(p + i + 12, q + i + 12));
+          csa(fours_a, twos, twos, twos_a, twos_b);
+          csa(twos_a, ones, ones, load256<Op>(p + i + 16, q + i + 16), load256<Op>(p + i + 20, q + i + 20));
+          csa(twos_b, ones, ones, load256<Op>(p + i + 24, q + i + 24), load256<Op>(p + i + 28, q + i + 28));
+          csa(fours_b, twos, twos, twos_a, twos_b);
+          csa(eights_a, fours, fours, fours_a, fours_b);
+          csa(twos_a, ones, ones, load256<Op>(p + i + 32, q + i + 32), load256<Op>(p + i + 36, q + i + 36));
+          csa(twos_b, ones, ones, load256<Op>(p + i + 40, q + i + 40), load256<Op>(p + i + 44, q + i + 44));
+          csa(fours_a, twos, twos, twos_a, twos_b);
+          csa(twos_a, ones, ones, load256<Op>(p + i + 48, q + i + 48), load256<Op>(p + i + 52, q + i + 52));
+          csa(twos_b, ones, ones, load256<Op>(p + i + 56, q + i + 56), load256<Op>(p + i + 60, q + i + 60));
+          csa(fours_b, twos, twos, twos_a, twos_b);
+          csa(eights_b, fours, fours, fours_a, fours_b);
+          csa(sixteens, eights, eights, eights_a, eights_b);
+          total = _mm256_add_epi64(total, count256(sixteens));
+        }
+        total = _mm256_slli_epi64(total, 4);
+        total = _mm256_add_epi64(total, _mm256_slli_epi64(count256(eights), 3));
+        total = _mm256_add_epi64(total, _mm256_slli_epi64(count256(fours), 2));
+        total = _mm256_add_epi64(total, _mm256_slli_epi64(count256(twos), 1));
+        total = _mm256_add_epi64(total, count256(ones));
+        for (; i + 4 <= n; i += 4)
+          total = _mm256_add_epi64(total, count256(load256<Op>(p + i, q + i)));
+        uint64_t lanes[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), total);
+        uint64_t r = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+        for (; i < n; ++i)
+          r += swar(combine<Op>(p[i], q[i]));
+        return size_t(r);
+      }
+
+      template <op Op>
+      JASEL_BIT_OPS_TARGET("avx512f,avx512vpopcntdq")
+      inline __m512i load512(__mmask8 m, uint64_t const* p, uint64_t const* q) noexcept
+      {
+        __m512i const a = _mm512_maskz_loadu_epi64(m, p);
+        return (Op == op::first) ? a
+             : (Op == op::and_) ? _mm512_and_si512(a, _mm512_maskz_loadu_epi64(m, q))
+             : _mm512_xor_si512(a, _mm512_maskz_loadu_epi64(m, q));
+      }
+
+      template <op Op>
+      JASEL_BIT_OPS_TARGET("avx512f,avx512vpopcntdq")
+      size_t count_avx512(uint64_t const* p, uint64_t const* q, size_t n) noexcept
+      {
+        __m512i r0 = _mm512_setzero_si512();
+        __m512i r1 = _mm512_setzero_si512();
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16)
+        {
+          r0 = _mm512_add_epi64(r0, _mm512_popcnt_epi64(load512<Op>(0xFF, p + i, q + i)));
+          r1 = _mm512_add_epi64(r1, _mm512_popcnt_epi64(load512<Op>(0xFF, p + i + 8, q + i + 8)));
+        }
+        // the masked loads don't touch the words past the end
+        for (; i < n; i += 8)
+        {
+          __mmask8 const m = (n - i >= 8) ? __mmask8(0xFF) : __mmask8((1u << (n - i)) - 1);
+          r0 = _mm512_add_epi64(r0, _mm512_popcnt_epi64(load512<Op>(m, p + i, q + i)));
+        }
+        uint64_t lanes[8];
+        _mm512_storeu_si512(lanes, _mm512_add_epi64(r0, r1));
+        return size_t(lanes[0] + lanes[1] + lanes[2] + lanes[3] + lanes[4] + lanes[5] + lanes[6] + lanes[7]);
+      }
+#endif
+
+      //! @par Returns:
+      //!   Whether the CPU can run the kernel k.
+      inline bool supported(kernel k) noexcept
+      {
+#if defined JASEL_BIT_OPS_DISPATCH
+        __builtin_cpu_init();
+        switch (k)
+        {
+        case kernel::scalar: return true;
+        case kernel::popcnt: return __builtin_cpu_supports("popcnt");
+        case kernel::avx2: return __builtin_cpu_supports("avx2");
+        case kernel::avx512: return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq");
+        }
+        return false;
+#else
+        return k == kernel::scalar;
+#endif
+      }
+
+      //! @par Returns:
+      //!   The fastest kernel the CPU can run.
+      inline kernel best() noexcept
+      {
+        return supported(kernel::avx512) ? kernel::avx512
+             : supported(kernel::avx2) ? kernel::avx2
+             : supported(kernel::popcnt) ? kernel::popcnt
+             : kernel::scalar;
+      }
+
+      //! @par Requires:
+      //!   supported(k)
+      //! @par Returns:
+      //!   The function counting the bits of the words combined by Op with the kernel k.
+      template <op Op>
+      kernel_fn select(kernel k) noexcept
+      {
+#if defined JASEL_BIT_OPS_DISPATCH
+        switch (k)
+        {
+        case kernel::scalar: return &count_scalar<Op>;
+        case kernel::popcnt: return &count_popcnt<Op>;
+        case kernel::avx2: return &count_avx2<Op>;
+        case kernel::avx512: return &count_avx512<Op>;
+        }
+#endif
+        static_cast<void>(k);
+        return &count_scalar<Op>;
+      }
+
+      template <op Op>
+      size_t count(uint64_t const* p, uint64_t const* q, size_t n) noexcept
+      {
+        static kernel_fn const fn = select<Op>(best());
+        return fn(p, q, n);
+      }
+    }
+
+    //! @par Returns
+    //!   The number of bits set to 1 in the words of s.
+    //! @par Remarks:
+    //!   The words are counted by the widest kernel the CPU supports (AVX-512 VPOPCNTDQ, AVX2, POPCNT or portable
+    //!   code), chosen at the first call.
+    JASEL_NODISCARD inline size_t popcount(span<uint64_t const> s) noexcept
+    {
+      return popcount_detail::count<popcount_detail::op::first>(s.data(), s.data(), s.size());
+    }
+
+    //! @par Requires:
+    //!   a.size() == b.size()
+    //! @par Returns
+    //!   The number of bits set to 1 in both a and b, i.e. the size of the intersection of the sets.
+    JASEL_NODISCARD inline size_t popcount_and(span<uint64_t const> a, span<uint64_t const> b) noexcept
+    {
+      JASEL_EXPECTS(a.size() == b.size());
+      return popcount_detail::count<popcount_detail::op::and_>(a.data(), b.data(), a.size());
+    }
+
+    //! @par Requires:
+    //!   a.size() == b.size()
+    //! @par Returns
+    //!   The number of bits that differ between a and b, i.e. their Hamming distance.
+    JASEL_NODISCARD inline size_t popcount_xor(span<uint64_t const> a, span<uint64_t const> b) noexcept
+    {
+      JASEL_EXPECTS(a.size() == b.size());
+      return popcount_detail::count<popcount_detail::op::xor_>(a.data(), b.data(), a.size());
     }
 
     //! @par Requires:
     //!   N <= bitsof<T>()
     //! @par Returns
     //!   A mask with all the bits set to 1 up to the bit N
-    //!   [ Note: Returns T(-1} if x > std::numeric_limits<T>::digits. ]
+    //!   [ Note: Returns T(-1} if N == std::numeric_limits<T>::digits. ]
     template <size_t N, class T=unsigned>
     JASEL_NODISCARD constexpr T up_to() noexcept
     {
-      static_assert(N < bitsof<T>(), "Error");
-      return (N >= bitsof<T>()) ?
-          T(-1) : T(1u << N) - 1;
+      static_assert(N <= size_t(bitsof<T>()), "Error");
+      return (N == 0) ?
+          T(0) : T(T(-1) >> (size_t(bitsof<T>()) - N));
     }
 
     //! @par Pre-condition:
@@ -193,9 +495,8 @@ inline namespace fundamental_v3
     template <class T=unsigned>
     JASEL_NODISCARD constexpr T up_to(size_t n) noexcept
     {
-      return (n == bitsof<T>()) ?
-          T(-1) : T(1u << n) - 1;
-           //T(-1) >> (digits-n)
+      return (n == size_t(bitsof<T>())) ?
+          T(-1) : T(T(T(1) << n) - 1);
     }
 
     //! @par Requires:
@@ -338,7 +338,7 @@ inline namespace fundamental_v3
       }
       constexpr bit_reference(word_type& ref, index_type pos)
       : _ptr((JASEL_ASSERT(pos < binary_digits<word_type>::value), &ref))
-      , _mask(static_cast<word_type>(1u << pos))
+      , _mask(static_cast<word_type>(word_type(1) << pos))
       {
       }
 
@@ -0,0 +1,313 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Vicente J. Botet Escriba 2019.
+// Distributed under the Boost
+// Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or
+// copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//////////////////////////////////////////////////////////////////////////////
+
+/*
+ \file
+ \brief
+ The header \c <experimental/rank_select_bitvector.hpp> defines a class \c rank_select_bitvector, a succinct index
+ answering rank and select queries on a sequence of bits stored in an existing buffer of 64-bit words.
+
+ The directory has two levels: the number of 1s before each superblock of 2^16 bits, in 64 bits, and the number of 1s
+ before each block of 512 bits relative to its superblock, in 16 bits. A rank adds the two counts and the popcount of at
+ most 8 words. The block containing every 4096th 1 (and every 4096th 0) is sampled, so that a select searches only the
+ blocks between two samples before scanning the words of a block. The directory and the samples take about 4% of the
+ size of the bits.
+
+ When BMI2 is enabled the bit of a word having a given rank is found with \c pdep. Defining JASEL_NO_BMI2 disables
+ this path, as it disables the BMI2 paths of \c packed_vector.
+ */
+
+#ifndef JASEL_FUNDAMENTAL_V3_BITS_RANK_SELECT_BITVECTOR_HPP
+#define JASEL_FUNDAMENTAL_V3_BITS_RANK_SELECT_BITVECTOR_HPP
+
+#include <experimental/fundamental/v2/config.hpp>
+#include <experimental/fundamental/v3/bits/bit_ops.hpp>
+#include <experimental/bit.hpp>
+#include <experimental/contract.hpp>
+#include <experimental/span.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined __BMI2__ && !defined JASEL_NO_BMI2
+#define JASEL_BITS_BMI2
+#include <immintrin.h>
+#endif
+
+namespace std
+{
+namespace experimental
+{
+inline namespace fundamental_v3
+{
+  namespace rank_select_detail
+  {
+    //! @par Requires:
+    //!   k < popcount(w)
+    //! @par Returns:
+    //!   The position of the 1 of w preceded by k 1s.
+    inline int select_in_word(uint64_t w, unsigned k) noexcept
+    {
+#if defined JASEL_BITS_BMI2
+      return bit_ops::countr_zero(_pdep_u64(uint64_t(1) << k, w));
+#else
+      // the byte i of prefix is the number of 1s in the bytes [0, i]
+      uint64_t s = w - ((w >> 1) & 0x5555555555555555ULL);
+      s = (s & 0x3333333333333333ULL) + ((s >> 2) & 0x3333333333333333ULL);
+      s = (s + (s >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+      uint64_t const prefix = s * 0x0101010101010101ULL;
+      int byte = 0;
+      while (unsigned((prefix >> (8 * byte)) & 0xFF) <= k)
+        ++byte;
+      if (byte > 0)
+        k -= unsigned((prefix >> (8 * (byte - 1))) & 0xFF);
+      unsigned b = unsigned((w >> (8 * byte)) & 0xFF);
+      for (; k != 0; --k)
+        b &= b - 1;
+      return 8 * byte + bit_ops::countr_zero(b);
+#endif
+    }
+  }
+
+  /**
+  A `rank_select_bitvector` indexes the `size()` first bits of a buffer of `uint64_t`, the bit `i` being the bit
+  `i%64` of the word `i/64`. The buffer is not copied and must outlive the index and not be modified while it is used.
+
+  - `rank1(i)` is the number of 1s in the bits [0, i), in constant time.
+  - `select1(k)` is the position of the 1 preceded by k 1s, in near constant time.
+
+  and the same for the 0s.
+  */
+  class rank_select_bitvector
+  {
+  public:
+    using word_type = uint64_t;
+    using size_type = size_t;
+
+    static constexpr size_type word_bits = 64;
+    static constexpr size_type block_bits = 512;
+    static constexpr size_type superblock_bits = size_type(1) << 16;
+    static constexpr size_type select_sample = 4096;
+
+    //! @par Effects:
+    //!   Constructs an index of no bits.
+    rank_select_bitvector()
+    {
+      build();
+    }
+
+    //! @par Requires:
+    //!   size <= 64 * words.size()
+    //! @par Effects:
+    //!   Constructs the index of the size first bits of words.
+    rank_select_bitvector(span<word_type const> words, size_type size)
+      : _words(words.data()), _size(size)
+    {
+      JASEL_EXPECTS(size <= word_bits * size_type(words.size()));
+      build();
+    }
+
+    //! @par Effects:
+    //!   Constructs the index of all the bits of words.
+    explicit rank_select_bitvector(span<word_type const> words)
+      : rank_select_bitvector(words, word_bits * size_type(words.size()))
+    {}
+
+    //! @par Requires:
+    //!   first.position() == 0 and [first, last) is a valid range.
+    //! @par Effects:
+    //!   Constructs the index of the bits [first, last).
+    rank_select_bitvector(bit_iterator<word_type const*> first, bit_iterator<word_type const*> last)
+      : _words(first.base()), _size(size_type(last - first))
+    {
+      JASEL_EXPECTS(first.position() == 0);
+      build();
+    }
+
+    //! @par Returns:
+    //!   The number of bits indexed.
+    size_type size() const noexcept { return _size; }
+    bool empty() const noexcept { return _size == 0; }
+    //! @par Returns:
+    //!   The number of bits set to 1.
+    size_type count() const noexcept { return _ones; }
+    //! @par Returns:
+    //!   The words storing the bits.
+    span<word_type const> words() const noexcept
+    {
+      return span<word_type const>(_words, ptrdiff_t((_size + word_bits - 1) / word_bits));
+    }
+    //! @par Returns:
+    //!   The number of bytes taken by the directory and the select samples.
+    size_type directory_bytes() const noexcept
+    {
+      return _superblocks.size() * sizeof(uint64_t) + _blocks.size() * sizeof(uint16_t)
+           + (_samples1.size() + _samples0.size()) * sizeof(uint32_t);
+    }
+
+    //! @par Pre-condition:
+    //!   i < size()
+    //! @par Returns:
+    //!   The value of the bit i.
+    bool operator[](size_type i) const noexcept
+    {
+      return JASEL_EXPECTS(i < _size), ((_words[i / word_bits] >> (i % word_bits)) & 1) != 0;
+    }
+
+    //! @par Pre-condition:
+    //!   i <= size()
+    //! @par Returns:
+    //!   The number of bits set to 1 in [0, i).
+    size_type rank1(size_type i) const noexcept
+    {
+      JASEL_EXPECTS(i <= _size);
+      size_type const block = i / block_bits;
+      size_type r = block_rank(block);
+      word_type const* w = _words + block * words_per_block;
+      size_type const n = (i % block_bits) / word_bits;
+      for (size_type j = 0; j < n; ++j)
+        r += size_type(bit_ops::popcount(w[j]));
+      if (i % word_bits != 0)
+        r += size_type(bit_ops::popcount(word_type(w[n] & bit_ops::up_to<word_type>(i % word_bits))));
+      return r;
+    }
+    //! @par Pre-condition:
+    //!   i <= size()
+    //! @par Returns:
+    //!   The number of bits set to 0 in [0, i).
+    size_type rank0(size_type i) const noexcept
+    {
+      return i - rank1(i);
+    }
+
+    //! @par Pre-condition:
+    //!   k < count()
+    //! @par Returns:
+    //!   The position of the bit set to 1 preceded by k bits set to 1.
+    size_type select1(size_type k) const noexcept
+    {
+      JASEL_EXPECTS(k < _ones);
+      size_type const block = find_block(k, _samples1, [this](size_type b) { return block_rank(b); });
+      k -= block_rank(block);
+      word_type const* w = _words + block * words_per_block;
+      for (;; ++w)
+      {
+        size_type const c = size_type(bit_ops::popcount(*w));
+        if (k < c)
+          break;
+        k -= c;
+      }
+      return size_type(w - _words) * word_bits + size_type(rank_select_detail::select_in_word(*w, unsigned(k)));
+    }
+    //! @par Pre-condition:
+    //!   k < size() - count()
+    //! @par Returns:
+    //!   The position of the bit set to 0 preceded by k bits set to 0.
+    size_type select0(size_type k) const noexcept
+    {
+      JASEL_EXPECTS(k < _size - _ones);
+      size_type const block = find_block(k, _samples0, [this](size_type b) { return b * block_bits - block_rank(b); });
+      k -= block * block_bits - block_rank(block);
+      word_type const* w = _words + block * words_per_block;
+      for (;; ++w)
+      {
+        size_type const c = size_type(bit_ops::popcount(word_type(~*w)));
+        if (k < c)
+          break;
+        k -= c;
+      }
+      return size_type(w - _words) * word_bits + size_type(rank_select_detail::select_in_word(~*w, unsigned(k)));
+    }
+
+  private:
+    static constexpr size_type words_per_block = block_bits / word_bits;
+    static constexpr size_type blocks_per_superblock = superblock_bits / block_bits;
+
+    //! @par Returns:
+    //!   The number of bits set to 1 before the block b.
+    size_type block_rank(size_type b) const noexcept
+    {
+      return size_type(_superblocks[b / blocks_per_superblock]) + _blocks[b];
+    }
+
+    //! @par Returns:
+    //!   The last block b such that rank(b) <= k, where rank is block_rank for the 1s or its complement for the 0s.
+    template <class Rank>
+    size_type find_block(size_type k, vector<uint32_t> const& samples, Rank rank) const noexcept
+    {
+      size_type lo = samples[k / select_sample];
+      size_type hi = samples[k / select_sample + 1];
+      while (hi - lo > 8)
+      {
+        size_type const mid = lo + (hi - lo + 1) / 2;
+        if (rank(mid) <= k)
+          lo = mid;
+        else
+          hi = mid - 1;
+      }
+      while (lo < hi && rank(lo + 1) <= k)
+        ++lo;
+      return lo;
+    }
+
+    void build()
+    {
+      size_type const nblocks = (_size + block_bits - 1) / block_bits;
+      size_type const nwords = (_size + word_bits - 1) / word_bits;
+      JASEL_EXPECTS(nblocks <= size_type(UINT32_MAX));
+      // one more entry, so that rank1(size()) needs no special case
+      _superblocks.assign(nblocks / blocks_per_superblock + 1, 0);
+      _blocks.assign(nblocks + 1, 0);
+      size_type ones = 0;
+      size_type next1 = 0;
+      size_type next0 = 0;
+      for (size_type b = 0; b <= nblocks; ++b)
+      {
+        if (b % blocks_per_superblock == 0)
+          _superblocks[b / blocks_per_superblock] = ones;
+        _blocks[b] = uint16_t(ones - _superblocks[b / blocks_per_superblock]);
+        if (b == nblocks)
+          break;
+        size_type const last = std::min((b + 1) * words_per_block, nwords);
+        size_type count = 0;
+        for (size_type w = b * words_per_block; w != last; ++w)
+          count += size_type(bit_ops::popcount(_words[w]));
+        // the bits of the last word past the size are not counted
+        if (last == nwords && _size % word_bits != 0)
+          count -= size_type(bit_ops::popcount(word_type(_words[nwords - 1] >> (_size % word_bits))));
+        size_type const bits = std::min(size_type(block_bits), _size - b * block_bits);
+        for (; next1 < ones + count; next1 += select_sample)
+          _samples1.push_back(uint32_t(b));
+        for (; next0 < b * block_bits - ones + bits - count; next0 += select_sample)
+          _samples0.push_back(uint32_t(b));
+        ones += count;
+      }
+      _ones = ones;
+      // the search of the block of the last samples ends at the last block
+      _samples1.push_back(uint32_t(nblocks == 0 ? 0 : nblocks - 1));
+      _samples0.push_back(uint32_t(nblocks == 0 ? 0 : nblocks - 1));
+    }
+
+    word_type const* _words = nullptr;
+    size_type _size = 0;
+    size_type _ones = 0;
+    vector<uint64_t> _superblocks;
+    vector<uint16_t> _blocks;
+    vector<uint32_t> _samples1;
+    vector<uint32_t> _samples0;
+  };
+
+}
+}
+} // std
+
+#endif // header
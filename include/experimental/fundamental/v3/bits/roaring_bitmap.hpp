@@ -0,0 +1,1027 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Vicente J. Botet Escriba 2019.
+// Distributed under the Boost
+// Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or
+// copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Based on the Roaring bitmaps of D. Lemire et al.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+/*
+ \file
+ \brief
+ The header \c <experimental/roaring_bitmap.hpp> defines a class \c roaring_bitmap, a compressed set of 32-bit
+ unsigned integers, and a class \c roaring_view, a read-only view of a serialized \c roaring_bitmap.
+
+ The values are partitioned by their 16 high bits into chunks of 2^16 values. Each chunk stores its 16 low bits as
+ - an array: the sorted values, when there are at most 4096 of them;
+ - a bitmap: 1024 words of 64 bits, when there are more;
+ - runs: the pairs (start, length - 1) of the sequences of consecutive values, when \c run_optimize() finds them
+   smaller than the two other representations.
+
+ The operations on the bitmaps are done a word at a time with the \c bit_ops popcounts and the \c bit_iterator
+ algorithms; the runs are converted to one of the two other representations before combining them.
+
+ The serialized layout, in the native byte order, is
+ - a header: the \c uint32_t magic number 0x314D4252 ("RBM1" on little endian machines) and the \c uint32_t number of
+   chunks;
+ - a descriptor of 16 bytes by chunk, in increasing key: the \c uint16_t key, the \c uint8_t kind (0 array, 1 bitmap,
+   2 runs), a \c uint8_t 0, the \c uint32_t number of values, the \c uint32_t number of elements of the payload
+   (\c uint16_t values or run bounds, or \c uint64_t words) and the \c uint32_t offset of the payload from the start;
+ - the payloads, each one aligned to 8 bytes.
+
+ So that a \c roaring_view can query a buffer mapped in memory without copying it.
+ */
+
+#ifndef JASEL_FUNDAMENTAL_V3_BITS_ROARING_BITMAP_HPP
+#define JASEL_FUNDAMENTAL_V3_BITS_ROARING_BITMAP_HPP
+
+#include <experimental/fundamental/v2/config.hpp>
+#include <experimental/fundamental/v3/bits/bit_ops.hpp>
+#include <experimental/fundamental/v3/bits/set_bit_iterator.hpp>
+#include <experimental/bit.hpp>
+#include <experimental/contract.hpp>
+#include <experimental/span.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+namespace std
+{
+namespace experimental
+{
+inline namespace fundamental_v3
+{
+  namespace roaring_detail
+  {
+    enum class kind : uint8_t { array, bitmap, run };
+
+    constexpr size_t bitmap_words = 1024;
+    constexpr size_t array_max = 4096;
+    constexpr uint32_t magic = 0x314D4252;
+
+    //! The values of a chunk with a given key.
+    struct chunk
+    {
+      uint16_t key = 0;
+      kind k = kind::array;
+      uint32_t card = 0;
+      //! array: the sorted values; run: the pairs (start, length - 1)
+      vector<uint16_t> values;
+      //! bitmap: the 1024 words
+      vector<uint64_t> words;
+    };
+
+    inline bool array_contains(uint16_t const* v, size_t n, uint16_t x) noexcept
+    {
+      return std::binary_search(v, v + n, x);
+    }
+    inline bool bitmap_contains(uint64_t const* w, uint16_t x) noexcept
+    {
+      return ((w[x / 64] >> (x % 64)) & 1) != 0;
+    }
+    //! @par Returns:
+    //!   Whether x is in one of the nruns runs r.
+    inline bool run_contains(uint16_t const* r, size_t nruns, uint16_t x) noexcept
+    {
+      // the last run starting at or before x
+      size_t lo = 0, hi = nruns;
+      while (lo < hi)
+      {
+        size_t const mid = lo + (hi - lo) / 2;
+        if (r[2 * mid] <= x)
+          lo = mid + 1;
+        else
+          hi = mid;
+      }
+      return lo != 0 && uint32_t(x) - r[2 * (lo - 1)] <= r[2 * (lo - 1) + 1];
+    }
+    inline bool contains(kind k, uint16_t const* v, uint64_t const* w, size_t n, uint16_t x) noexcept
+    {
+      switch (k)
+      {
+      case kind::array: return array_contains(v, n, x);
+      case kind::bitmap: return bitmap_contains(w, x);
+      default: return run_contains(v, n / 2, x);
+      }
+    }
+
+    //! @par Effects:
+    //!   Calls f(base + x) for each value x of the chunk, in increasing order.
+    template <class F>
+    void for_each(kind k, uint16_t const* v, uint64_t const* w, size_t n, uint32_t base, F& f)
+    {
+      switch (k)
+      {
+      case kind::array:
+        for (size_t i = 0; i < n; ++i)
+          f(base + v[i]);
+        break;
+      case kind::bitmap:
+        for_each_set_bit(w, bitmap_words, [&](size_t pos) { f(base + uint32_t(pos)); });
+        break;
+      default:
+        for (size_t i = 0; i < n; i += 2)
+          for (uint32_t x = v[i], last = uint32_t(v[i]) + v[i + 1]; ; ++x)
+          {
+            f(base + x);
+            if (x == last) break;
+          }
+        break;
+      }
+    }
+
+    //! @par Returns:
+    //!   The bitmap of the values of c.
+    inline vector<uint64_t> to_words(chunk const& c)
+    {
+      if (c.k == kind::bitmap)
+        return c.words;
+      vector<uint64_t> w(bitmap_words, 0);
+      if (c.k == kind::array)
+        for (uint16_t x : c.values)
+          w[x / 64] |= uint64_t(1) << (x % 64);
+      else
+      {
+        using iterator = bit_iterator<uint64_t*>;
+        for (size_t i = 0; i < c.values.size(); i += 2)
+          fill(iterator(w.data()) + c.values[i], iterator(w.data()) + (c.values[i] + c.values[i + 1] + 1), bit_on);
+      }
+      return w;
+    }
+    //! @par Returns:
+    //!   The sorted values of c.
+    inline vector<uint16_t> to_values(chunk const& c)
+    {
+      if (c.k == kind::array)
+        return c.values;
+      vector<uint16_t> v;
+      v.reserve(c.card);
+      auto push = [&](uint32_t x) { v.push_back(uint16_t(x)); };
+      for_each(c.k, c.values.data(), c.words.data(), c.values.size(), 0, push);
+      return v;
+    }
+
+    //! @par Effects:
+    //!   Uses the array representation when there are at most array_max values and the bitmap one otherwise.
+    inline void normalize(chunk& c)
+    {
+      if (c.k == kind::bitmap && c.card <= array_max)
+      {
+        c.values = to_values(c);
+        c.words = vector<uint64_t>();
+        c.k = kind::array;
+      }
+      else if (c.k == kind::array && c.card > array_max)
+      {
+        c.words = to_words(c);
+        c.values = vector<uint16_t>();
+        c.k = kind::bitmap;
+      }
+      else if (c.k == kind::run)
+      {
+        if (c.card <= array_max)
+        {
+          c.values = to_values(c);
+          c.k = kind::array;
+        }
+        else
+        {
+          c.words = to_words(c);
+          c.values = vector<uint16_t>();
+          c.k = kind::bitmap;
+        }
+      }
+    }
+
+    //! @par Returns:
+    //!   The number of runs of consecutive values of c.
+    inline size_t count_runs(chunk const& c) noexcept
+    {
+      switch (c.k)
+      {
+      case kind::array:
+      {
+        size_t r = c.values.empty() ? 0 : 1;
+        for (size_t i = 1; i < c.values.size(); ++i)
+          r += c.values[i] != c.values[i - 1] + 1;
+        return r;
+      }
+      case kind::bitmap:
+      {
+        // a run starts at each bit set whose previous bit is not set
+        size_t r = 0;
+        uint64_t carry = 0;
+        for (uint64_t w : c.words)
+        {
+          r += size_t(bit_ops::popcount(uint64_t(w & ~((w << 1) | carry))));
+          carry = w >> 63;
+        }
+        return r;
+      }
+      default:
+        return c.values.size() / 2;
+      }
+    }
+
+    //! @par Returns:
+    //!   A chunk with the key and the card values v, sorted and distinct, normalized.
+    inline chunk make_chunk(uint16_t key, vector<uint16_t>&& v)
+    {
+      chunk c;
+      c.key = key;
+      c.card = uint32_t(v.size());
+      c.values = std::move(v);
+      normalize(c);
+      return c;
+    }
+    //! @par Returns:
+    //!   A chunk with the key and the bitmap w, normalized.
+    inline chunk make_chunk(uint16_t key, vector<uint64_t>&& w)
+    {
+      chunk c;
+      c.key = key;
+      c.k = kind::bitmap;
+      c.card = uint32_t(bit_ops::popcount(span<uint64_t const>(w.data(), ptrdiff_t(w.size()))));
+      c.words = std::move(w);
+      normalize(c);
+      return c;
+    }
+
+    enum class op { and_, or_, xor_, andnot };
+
+    //! @par Returns:
+    //!   The chunk combining a and b with the operation Op, normalized. Its card is 0 if it is empty.
+    template <op Op>
+    chunk combine(chunk const& a, chunk const& b)
+    {
+      bool const a_bitmap = a.k == kind::bitmap || (a.k == kind::run && a.card > array_max);
+      bool const b_bitmap = b.k == kind::bitmap || (b.k == kind::run && b.card > array_max);
+      if (!a_bitmap && !b_bitmap)
+      {
+        // merge the sorted values
+        vector<uint16_t> const av = (a.k == kind::array) ? vector<uint16_t>() : to_values(a);
+        vector<uint16_t> const bv = (b.k == kind::array) ? vector<uint16_t>() : to_values(b);
+        vector<uint16_t> const& x = (a.k == kind::array) ? a.values : av;
+        vector<uint16_t> const& y = (b.k == kind::array) ? b.values : bv;
+        vector<uint16_t> r;
+        r.reserve(Op == op::and_ ? std::min(x.size(), y.size()) : Op == op::andnot ? x.size() : x.size() + y.size());
+        switch (Op)
+        {
+        case op::and_: std::set_intersection(x.begin(), x.end(), y.begin(), y.end(), back_inserter(r)); break;
+        case op::or_: std::set_union(x.begin(), x.end(), y.begin(), y.end(), back_inserter(r)); break;
+        case op::xor_: std::set_symmetric_difference(x.begin(), x.end(), y.begin(), y.end(), back_inserter(r)); break;
+        case op::andnot: std::set_difference(x.begin(), x.end(), y.begin(), y.end(), back_inserter(r)); break;
+        }
+        return make_chunk(a.key, std::move(r));
+      }
+      if (Op == op::and_ && (!a_bitmap || !b_bitmap))
+      {
+        // keep the values of the array present in the bitmap
+        chunk const& small = a_bitmap ? b : a;
+        chunk const& big = a_bitmap ? a : b;
+        vector<uint64_t> const bw = (big.k == kind::bitmap) ? vector<uint64_t>() : to_words(big);
+        uint64_t const* w = (big.k == kind::bitmap) ? big.words.data() : bw.data();
+        vector<uint16_t> r;
+        auto keep = [&](uint32_t x) { if (bitmap_contains(w, uint16_t(x))) r.push_back(uint16_t(x)); };
+        for_each(small.k, small.values.data(), small.words.data(), small.values.size(), 0, keep);
+        return make_chunk(a.key, std::move(r));
+      }
+      if (Op == op::andnot && !a_bitmap)
+      {
+        // keep the values of the array absent from the bitmap
+        vector<uint64_t> const bw = (b.k == kind::bitmap) ? vector<uint64_t>() : to_words(b);
+        uint64_t const* w = (b.k == kind::bitmap) ? b.words.data() : bw.data();
+        vector<uint16_t> r;
+        auto keep = [&](uint32_t x) { if (!bitmap_contains(w, uint16_t(x))) r.push_back(uint16_t(x)); };
+        for_each(a.k, a.values.data(), a.words.data(), a.values.size(), 0, keep);
+        return make_chunk(a.key, std::move(r));
+      }
+      // combine the words
+      vector<uint64_t> r = to_words(a);
+      vector<uint64_t> const bw = (b.k == kind::bitmap) ? vector<uint64_t>() : to_words(b);
+      uint64_t const* w = (b.k == kind::bitmap) ? b.words.data() : bw.data();
+      for (size_t i = 0; i < bitmap_words; ++i)
+        switch (Op)
+        {
+        case op::and_: r[i] &= w[i]; break;
+        case op::or_: r[i] |= w[i]; break;
+        case op::xor_: r[i] ^= w[i]; break;
+        case op::andnot: r[i] &= ~w[i]; break;
+        }
+      return make_chunk(a.key, std::move(r));
+    }
+
+    //! The descriptor of a serialized chunk.
+    struct descriptor
+    {
+      uint16_t key;
+      uint8_t k;
+      uint8_t reserved;
+      uint32_t card;
+      uint32_t length;
+      uint32_t offset;
+    };
+    static_assert(sizeof(descriptor) == 16, "The descriptors must take 16 bytes");
+
+    constexpr size_t header_bytes = 8;
+
+    inline size_t align8(size_t n) noexcept
+    {
+      return (n + 7) & ~size_t(7);
+    }
+
+    //! @par Returns:
+    //!   Whether the payload p of the chunk d holds d.card values: an array strictly increasing, a bitmap with d.card
+    //!   bits set or runs within the chunk, in increasing order, not overlapping and counting d.card values.
+    inline bool valid_payload(descriptor const& d, char const* p) noexcept
+    {
+      // the payload may be unaligned when deserialized
+      switch (kind(d.k))
+      {
+      case kind::array:
+      {
+        uint16_t prev = 0;
+        for (uint32_t i = 0; i < d.length; ++i)
+        {
+          uint16_t v;
+          memcpy(&v, p + i * sizeof(v), sizeof(v));
+          if (i != 0 && v <= prev)
+            return false;
+          prev = v;
+        }
+        return true;
+      }
+      case kind::bitmap:
+      {
+        uint32_t card = 0;
+        for (uint32_t i = 0; i < d.length; ++i)
+        {
+          uint64_t w;
+          memcpy(&w, p + i * sizeof(w), sizeof(w));
+          card += uint32_t(bit_ops::popcount(w));
+        }
+        return card == d.card;
+      }
+      default:
+      {
+        // next: the first value a run may start at
+        uint32_t card = 0, next = 0;
+        for (uint32_t i = 0; i < d.length; i += 2)
+        {
+          uint16_t r[2];
+          memcpy(r, p + i * sizeof(uint16_t), sizeof(r));
+          uint32_t const last = uint32_t(r[0]) + r[1];
+          if (r[0] < next || last > 0xFFFF)
+            return false;
+          next = last + 1;
+          card += uint32_t(r[1]) + 1;
+        }
+        return card == d.card;
+      }
+      }
+    }
+
+    //! @par Returns:
+    //!   The number of chunks of the serialized bitmap in.
+    //! @par Throws:
+    //!   std::invalid_argument if the header, one of the descriptors or one of the payloads is not valid.
+    inline uint32_t check(span<char const> in)
+    {
+      size_t const size = size_t(in.size());
+      uint32_t header[2];
+      if (size < header_bytes)
+        throw std::invalid_argument("roaring_bitmap: truncated data");
+      memcpy(header, in.data(), sizeof(header));
+      if (header[0] != magic)
+        throw std::invalid_argument("roaring_bitmap: bad magic number");
+      if ((size - header_bytes) / sizeof(descriptor) < header[1])
+        throw std::invalid_argument("roaring_bitmap: truncated data");
+      for (uint32_t i = 0; i < header[1]; ++i)
+      {
+        descriptor d;
+        memcpy(&d, in.data() + header_bytes + i * sizeof(descriptor), sizeof(d));
+        size_t const element = (d.k == uint8_t(kind::bitmap)) ? sizeof(uint64_t) : sizeof(uint16_t);
+        bool const valid =
+            d.k <= uint8_t(kind::run) && d.offset % 8 == 0 && d.card != 0 && d.card <= 65536
+            && d.offset <= size && (size - d.offset) / element >= d.length
+            && (d.k != uint8_t(kind::array) || d.length == d.card)
+            && (d.k != uint8_t(kind::bitmap) || d.length == bitmap_words)
+            && (d.k != uint8_t(kind::run) || (d.length % 2 == 0 && d.length != 0));
+        if (!valid)
+          throw std::invalid_argument("roaring_bitmap: bad chunk descriptor");
+        if (i != 0)
+        {
+          descriptor p;
+          memcpy(&p, in.data() + header_bytes + (i - 1) * sizeof(descriptor), sizeof(p));
+          if (p.key >= d.key)
+            throw std::invalid_argument("roaring_bitmap: unordered chunks");
+        }
+        if (!valid_payload(d, in.data() + d.offset))
+          throw std::invalid_argument("roaring_bitmap: bad chunk payload");
+      }
+      return header[1];
+    }
+  }
+
+  class roaring_view;
+
+  /**
+  A `roaring_bitmap` is a set of `uint32_t` compressed by chunks of 2^16 values, each one stored as a sorted array, a
+  bitmap or a list of runs depending on its density.
+  It is iterated in increasing order.
+  */
+  class roaring_bitmap
+  {
+    using chunk = roaring_detail::chunk;
+    using kind = roaring_detail::kind;
+    using op = roaring_detail::op;
+
+  public:
+    using value_type = uint32_t;
+    using size_type = size_t;
+
+    //! A forward iterator over the values of the set, in increasing order.
+    class const_iterator
+    {
+    public:
+      using iterator_category = forward_iterator_tag;
+      using value_type = uint32_t;
+      using difference_type = ptrdiff_t;
+      using pointer = void;
+      using reference = uint32_t;
+
+      const_iterator() noexcept = default;
+
+      //! @par Returns:
+      //!   The value.
+      uint32_t operator*() const noexcept
+      {
+        chunk const& c = (*_chunks)[_chunk];
+        uint32_t const base = uint32_t(c.key) << 16;
+        switch (c.k)
+        {
+        case kind::array: return base + c.values[_index];
+        case kind::bitmap: return base + uint32_t(_index * 64) + uint32_t(bit_ops::countr_zero(_word));
+        default: return base + c.values[2 * _index] + uint32_t(_word);
+        }
+      }
+      const_iterator& operator++() noexcept
+      {
+        chunk const& c = (*_chunks)[_chunk];
+        switch (c.k)
+        {
+        case kind::array:
+          if (++_index == c.values.size())
+            next_chunk();
+          break;
+        case kind::bitmap:
+          _word &= _word - 1;
+          while (_word == 0 && ++_index < roaring_detail::bitmap_words)
+            _word = c.words[_index];
+          if (_word == 0)
+            next_chunk();
+          break;
+        default:
+          // _word is the offset in the run _index
+          if (_word < c.values[2 * _index + 1])
+            ++_word;
+          else
+          {
+            _word = 0;
+            if (++_index == c.values.size() / 2)
+              next_chunk();
+          }
+          break;
+        }
+        return *this;
+      }
+      const_iterator operator++(int) noexcept
+      {
+        const_iterator tmp(*this);
+        ++*this;
+        return tmp;
+      }
+      friend bool operator==(const_iterator const& x, const_iterator const& y) noexcept
+      {
+        return x._chunk == y._chunk && x._index == y._index && x._word == y._word;
+      }
+      friend bool operator!=(const_iterator const& x, const_iterator const& y) noexcept
+      {
+        return !(x == y);
+      }
+
+    private:
+      friend class roaring_bitmap;
+      const_iterator(vector<chunk> const& chunks, size_t c) noexcept
+        : _chunks(&chunks), _chunk(c)
+      {
+        if (_chunk != chunks.size())
+          start();
+      }
+      //! Moves to the first value of the chunk _chunk.
+      void start() noexcept
+      {
+        chunk const& c = (*_chunks)[_chunk];
+        _index = 0;
+        _word = 0;
+        if (c.k == kind::bitmap)
+          while ((_word = c.words[_index]) == 0)
+            ++_index;
+      }
+      void next_chunk() noexcept
+      {
+        _index = 0;
+        _word = 0;
+        if (++_chunk != _chunks->size())
+          start();
+      }
+
+      vector<chunk> const* _chunks = nullptr;
+      size_t _chunk = 0;
+      //! array: the index of the value; bitmap: the index of the word; run: the index of the run
+      size_t _index = 0;
+      //! bitmap: the bits of the word not visited yet; run: the offset in the run
+      uint64_t _word = 0;
+    };
+    using iterator = const_iterator;
+
+    // construct/copy/destroy
+    roaring_bitmap() = default;
+
+    //! @par Effects:
+    //!   Constructs a set with the values of il.
+    roaring_bitmap(std::initializer_list<uint32_t> il)
+      : roaring_bitmap(il.begin(), il.end())
+    {}
+
+    //! @par Effects:
+    //!   Constructs a set with the values of [first, last).
+    template <class InputIterator, class = typename iterator_traits<InputIterator>::iterator_category>
+    roaring_bitmap(InputIterator first, InputIterator last)
+    {
+      for (; first != last; ++first)
+        add(uint32_t(*first));
+    }
+
+    //! @par Effects:
+    //!   Constructs a set with the values of the serialized bitmap v.
+    explicit roaring_bitmap(roaring_view const& v);
+
+    // iterators
+    const_iterator begin() const noexcept { return const_iterator(_chunks, 0); }
+    const_iterator end() const noexcept { return const_iterator(_chunks, _chunks.size()); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    //! @par Effects:
+    //!   Calls f(x) for each value x of the set, in increasing order.
+    template <class F>
+    void for_each(F&& f) const
+    {
+      for (chunk const& c : _chunks)
+        roaring_detail::for_each(c.k, c.values.data(), c.words.data(), c.values.size(), uint32_t(c.key) << 16, f);
+    }
+
+    // capacity
+    bool empty() const noexcept { return _chunks.empty(); }
+    //! @par Returns:
+    //!   The number of values, i.e. the cardinality of the set.
+    size_type count() const noexcept
+    {
+      size_type r = 0;
+      for (chunk const& c : _chunks)
+        r += c.card;
+      return r;
+    }
+
+    // lookup
+    bool contains(uint32_t x) const noexcept
+    {
+      chunk const* c = find_chunk(uint16_t(x >> 16));
+      return c != nullptr && roaring_detail::contains(c->k, c->values.data(), c->words.data(), c->values.size(), uint16_t(x));
+    }
+
+    // modifiers
+    //! @par Effects:
+    //!   Adds x to the set.
+    //! @par Returns:
+    //!   Whether x was added, i.e. it was not in the set.
+    bool add(uint32_t x)
+    {
+      uint16_t const key = uint16_t(x >> 16);
+      uint16_t const low = uint16_t(x);
+      auto const it = lower_bound(key);
+      if (it == _chunks.end() || it->key != key)
+      {
+        // the chunk is inserted once complete, so that no empty chunk is left on exception
+        chunk c;
+        c.key = key;
+        c.card = 1;
+        c.values.push_back(low);
+        _chunks.insert(it, std::move(c));
+        return true;
+      }
+      chunk& c = *it;
+      if (c.k == kind::run)
+      {
+        if (roaring_detail::run_contains(c.values.data(), c.values.size() / 2, low))
+          return false;
+        roaring_detail::normalize(c);
+      }
+      if (c.k == kind::array)
+      {
+        auto const pos = std::lower_bound(c.values.begin(), c.values.end(), low);
+        if (pos != c.values.end() && *pos == low)
+          return false;
+        c.values.insert(pos, low);
+      }
+      else
+      {
+        uint64_t& w = c.words[low / 64];
+        uint64_t const bit = uint64_t(1) << (low % 64);
+        if (w & bit)
+          return false;
+        w |= bit;
+      }
+      ++c.card;
+      roaring_detail::normalize(c);
+      return true;
+    }
+
+    //! @par Effects:
+    //!   Removes x from the set.
+    //! @par Returns:
+    //!   Whether x was removed, i.e. it was in the set.
+    bool remove(uint32_t x)
+    {
+      uint16_t const key = uint16_t(x >> 16);
+      uint16_t const low = uint16_t(x);
+      auto const it = lower_bound(key);
+      if (it == _chunks.end() || it->key != key)
+        return false;
+      chunk& c = *it;
+      if (!roaring_detail::contains(c.k, c.values.data(), c.words.data(), c.values.size(), low))
+        return false;
+      if (c.k == kind::run)
+        roaring_detail::normalize(c);
+      if (c.k == kind::array)
+        c.values.erase(std::lower_bound(c.values.begin(), c.values.end(), low));
+      else
+        c.words[low / 64] &= ~(uint64_t(1) << (low % 64));
+      if (--c.card == 0)
+        _chunks.erase(it);
+      else
+        roaring_detail::normalize(c);
+      return true;
+    }
+
+    void clear() noexcept
+    {
+      _chunks.clear();
+    }
+    void swap(roaring_bitmap& other) noexcept
+    {
+      _chunks.swap(other._chunks);
+    }
+
+    //! @par Effects:
+    //!   Stores the chunks as runs when it takes less space than as an array or as a bitmap.
+    //! @par Returns:
+    //!   Whether some chunk is stored as runs.
+    bool run_optimize()
+    {
+      bool r = false;
+      for (chunk& c : _chunks)
+      {
+        size_t const runs = roaring_detail::count_runs(c);
+        size_t const current = (c.k == kind::bitmap) ? roaring_detail::bitmap_words * sizeof(uint64_t)
+                                                     : c.values.size() * sizeof(uint16_t);
+        if (c.k != kind::run && 2 * runs * sizeof(uint16_t) < current)
+        {
+          vector<uint16_t> v;
+          v.reserve(2 * runs);
+          auto push = [&](uint32_t x) {
+            if (!v.empty() && uint32_t(v[v.size() - 2]) + v.back() + 1 == x)
+              ++v.back();
+            else
+            {
+              v.push_back(uint16_t(x));
+              v.push_back(0);
+            }
+          };
+          roaring_detail::for_each(c.k, c.values.data(), c.words.data(), c.values.size(), 0, push);
+          c.values = std::move(v);
+          c.words = vector<uint64_t>();
+          c.k = kind::run;
+        }
+        r = r || c.k == kind::run;
+      }
+      return r;
+    }
+
+    // set operations
+    roaring_bitmap& operator&=(roaring_bitmap const& other)
+    {
+      return *this = combine<op::and_>(*this, other);
+    }
+    roaring_bitmap& operator|=(roaring_bitmap const& other)
+    {
+      return *this = combine<op::or_>(*this, other);
+    }
+    roaring_bitmap& operator^=(roaring_bitmap const& other)
+    {
+      return *this = combine<op::xor_>(*this, other);
+    }
+    //! @par Effects:
+    //!   Removes the values of other, i.e. and not.
+    roaring_bitmap& operator-=(roaring_bitmap const& other)
+    {
+      return *this = combine<op::andnot>(*this, other);
+    }
+
+    friend roaring_bitmap operator&(roaring_bitmap const& x, roaring_bitmap const& y)
+    {
+      return combine<op::and_>(x, y);
+    }
+    friend roaring_bitmap operator|(roaring_bitmap const& x, roaring_bitmap const& y)
+    {
+      return combine<op::or_>(x, y);
+    }
+    friend roaring_bitmap operator^(roaring_bitmap const& x, roaring_bitmap const& y)
+    {
+      return combine<op::xor_>(x, y);
+    }
+    //! @par Returns:
+    //!   The values of x that are not in y.
+    friend roaring_bitmap operator-(roaring_bitmap const& x, roaring_bitmap const& y)
+    {
+      return combine<op::andnot>(x, y);
+    }
+
+    //! @par Returns:
+    //!   Whether both sets have the same values, whatever their representation.
+    friend bool operator==(roaring_bitmap const& x, roaring_bitmap const& y) noexcept
+    {
+      if (x._chunks.size() != y._chunks.size())
+        return false;
+      for (size_t i = 0; i < x._chunks.size(); ++i)
+        if (x._chunks[i].key != y._chunks[i].key || x._chunks[i].card != y._chunks[i].card)
+          return false;
+      return std::equal(x.begin(), x.end(), y.begin());
+    }
+    friend bool operator!=(roaring_bitmap const& x, roaring_bitmap const& y) noexcept
+    {
+      return !(x == y);
+    }
+
+    // serialization
+    //! @par Returns:
+    //!   The number of bytes taken by the serialized set.
+    size_type serialized_size() const noexcept
+    {
+      size_type r = roaring_detail::header_bytes + _chunks.size() * sizeof(roaring_detail::descriptor);
+      for (chunk const& c : _chunks)
+        r = roaring_detail::align8(r) + payload_bytes(c);
+      return r;
+    }
+
+    //! @par Requires:
+    //!   out.size() >= serialized_size()
+    //! @par Effects:
+    //!   Writes the layout described in the header to out.
+    //! @par Returns:
+    //!   The number of bytes written, serialized_size().
+    size_type serialize(span<char> out) const noexcept
+    {
+      JASEL_EXPECTS(size_type(out.size()) >= serialized_size());
+      char* const p = out.data();
+      uint32_t const header[2] = { roaring_detail::magic, uint32_t(_chunks.size()) };
+      memcpy(p, header, sizeof(header));
+      size_type offset = roaring_detail::header_bytes + _chunks.size() * sizeof(roaring_detail::descriptor);
+      for (size_t i = 0; i < _chunks.size(); ++i)
+      {
+        chunk const& c = _chunks[i];
+        size_type const start = roaring_detail::align8(offset);
+        memset(p + offset, 0, start - offset);
+        roaring_detail::descriptor const d = {
+          c.key, uint8_t(c.k), 0, c.card,
+          uint32_t(c.k == kind::bitmap ? c.words.size() : c.values.size()), uint32_t(start) };
+        memcpy(p + roaring_detail::header_bytes + i * sizeof(d), &d, sizeof(d));
+        if (c.k == kind::bitmap)
+          memcpy(p + start, c.words.data(), payload_bytes(c));
+        else
+          memcpy(p + start, c.values.data(), payload_bytes(c));
+        offset = start + payload_bytes(c);
+      }
+      return offset;
+    }
+
+    //! @par Returns:
+    //!   The set serialized in in.
+    //! @par Throws:
+    //!   std::invalid_argument if in is not a serialized set.
+    static roaring_bitmap deserialize(span<char const> in)
+    {
+      uint32_t const n = roaring_detail::check(in);
+      roaring_bitmap r;
+      r._chunks.resize(n);
+      for (uint32_t i = 0; i < n; ++i)
+      {
+        roaring_detail::descriptor d;
+        memcpy(&d, in.data() + roaring_detail::header_bytes + i * sizeof(d), sizeof(d));
+        chunk& c = r._chunks[i];
+        c.key = d.key;
+        c.k = kind(d.k);
+        c.card = d.card;
+        if (c.k == kind::bitmap)
+        {
+          c.words.resize(d.length);
+          memcpy(c.words.data(), in.data() + d.offset, d.length * sizeof(uint64_t));
+        }
+        else
+        {
+          c.values.resize(d.length);
+          memcpy(c.values.data(), in.data() + d.offset, d.length * sizeof(uint16_t));
+        }
+      }
+      return r;
+    }
+
+  private:
+    vector<chunk>::iterator lower_bound(uint16_t key)
+    {
+      return std::lower_bound(_chunks.begin(), _chunks.end(), key,
+                              [](chunk const& c, uint16_t k) { return c.key < k; });
+    }
+    chunk const* find_chunk(uint16_t key) const noexcept
+    {
+      auto const it = std::lower_bound(_chunks.begin(), _chunks.end(), key,
+                                       [](chunk const& c, uint16_t k) { return c.key < k; });
+      return (it != _chunks.end() && it->key == key) ? &*it : nullptr;
+    }
+    static size_type payload_bytes(chunk const& c) noexcept
+    {
+      return (c.k == kind::bitmap) ? c.words.size() * sizeof(uint64_t) : c.values.size() * sizeof(uint16_t);
+    }
+
+    //! @par Returns:
+    //!   The set combining x and y with the operation Op, merging their keys.
+    template <op Op>
+    static roaring_bitmap combine(roaring_bitmap const& x, roaring_bitmap const& y)
+    {
+      roaring_bitmap r;
+      r._chunks.reserve(Op == op::and_ ? std::min(x._chunks.size(), y._chunks.size())
+                                       : Op == op::andnot ? x._chunks.size() : x._chunks.size() + y._chunks.size());
+      auto i = x._chunks.begin();
+      auto j = y._chunks.begin();
+      while (i != x._chunks.end() || j != y._chunks.end())
+      {
+        if (j == y._chunks.end() || (i != x._chunks.end() && i->key < j->key))
+        {
+          if (Op != op::and_)
+            r._chunks.push_back(*i);
+          ++i;
+        }
+        else if (i == x._chunks.end() || j->key < i->key)
+        {
+          if (Op == op::or_ || Op == op::xor_)
+            r._chunks.push_back(*j);
+          ++j;
+        }
+        else
+        {
+          chunk c = roaring_detail::combine<Op>(*i, *j);
+          if (c.card != 0)
+            r._chunks.push_back(std::move(c));
+          ++i;
+          ++j;
+        }
+      }
+      return r;
+    }
+
+    //! The chunks in increasing key, none empty.
+    vector<chunk> _chunks;
+  };
+
+  inline void swap(roaring_bitmap& x, roaring_bitmap& y) noexcept
+  {
+    x.swap(y);
+  }
+
+  /**
+  A `roaring_view` is a read-only view of a `roaring_bitmap` serialized in a buffer, e.g. mapped in memory.
+  The buffer must be aligned to 8 bytes and outlive the view. It is checked at the construction, in a time linear in
+  its size, as by `roaring_bitmap::deserialize`.
+  */
+  class roaring_view
+  {
+  public:
+    using value_type = uint32_t;
+    using size_type = size_t;
+
+    //! @par Requires:
+    //!   in.data() is aligned to 8 bytes.
+    //! @par Throws:
+    //!   std::invalid_argument if in is not a serialized set.
+    explicit roaring_view(span<char const> in)
+      : _data(in.data()), _chunks(roaring_detail::check(in))
+    {
+      JASEL_EXPECTS(reinterpret_cast<uintptr_t>(in.data()) % 8 == 0);
+    }
+
+    bool empty() const noexcept { return _chunks == 0; }
+    //! @par Returns:
+    //!   The number of values, i.e. the cardinality of the set.
+    size_type count() const noexcept
+    {
+      size_type r = 0;
+      for (uint32_t i = 0; i < _chunks; ++i)
+        r += descriptor(i).card;
+      return r;
+    }
+
+    bool contains(uint32_t x) const noexcept
+    {
+      uint16_t const key = uint16_t(x >> 16);
+      uint32_t lo = 0, hi = _chunks;
+      while (lo < hi)
+      {
+        uint32_t const mid = lo + (hi - lo) / 2;
+        if (descriptor(mid).key < key)
+          lo = mid + 1;
+        else
+          hi = mid;
+      }
+      if (lo == _chunks)
+        return false;
+      roaring_detail::descriptor const d = descriptor(lo);
+      return d.key == key && roaring_detail::contains(roaring_detail::kind(d.k), values(d), words(d), d.length, uint16_t(x));
+    }
+
+    //! @par Effects:
+    //!   Calls f(x) for each value x of the set, in increasing order.
+    template <class F>
+    void for_each(F&& f) const
+    {
+      for (uint32_t i = 0; i < _chunks; ++i)
+      {
+        roaring_detail::descriptor const d = descriptor(i);
+        roaring_detail::for_each(roaring_detail::kind(d.k), values(d), words(d), d.length, uint32_t(d.key) << 16, f);
+      }
+    }
+
+  private:
+    roaring_detail::descriptor descriptor(uint32_t i) const noexcept
+    {
+      roaring_detail::descriptor d;
+      memcpy(&d, _data + roaring_detail::header_bytes + i * sizeof(d), sizeof(d));
+      return d;
+    }
+    uint16_t const* values(roaring_detail::descriptor const& d) const noexcept
+    {
+      return reinterpret_cast<uint16_t const*>(_data + d.offset);
+    }
+    uint64_t const* words(roaring_detail::descriptor const& d) const noexcept
+    {
+      return reinterpret_cast<uint64_t const*>(_data + d.offset);
+    }
+
+    char const* _data;
+    uint32_t _chunks;
+  };
+
+  inline roaring_bitmap::roaring_bitmap(roaring_view const& v)
+  {
+    v.for_each([this](uint32_t x) {
+      // the values come in increasing order: append to the last chunk
+      uint16_t const key = uint16_t(x >> 16);
+      if (_chunks.empty() || _chunks.back().key != key)
+      {
+        if (!_chunks.empty())
+          roaring_detail::normalize(_chunks.back());
+        _chunks.emplace_back();
+        _chunks.back().key = key;
+      }
+      _chunks.back().values.push_back(uint16_t(x));
+      ++_chunks.back().card;
+    });
+    if (!_chunks.empty())
+      roaring_detail::normalize(_chunks.back());
+  }
+
+}
+}
+} // std
+
+#endif // header
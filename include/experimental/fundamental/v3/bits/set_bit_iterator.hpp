@@ -0,0 +1,163 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Vicente J. Botet Escriba 2019.
+// Distributed under the Boost
+// Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or
+// copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//////////////////////////////////////////////////////////////////////////////
+
+/*
+ \file
+ \brief
+ The header \c <experimental/.../bits/set_bit_iterator.hpp> defines the iteration over the positions of the bits set in
+ an array of words, the bit \c pos being the bit \c pos%digits of the word \c pos/digits.
+
+ The iterator keeps a copy of the current word from which the bits already visited have been cleared: the next
+ position is found with \c countr_zero and the bit is cleared with <tt>x & (x - 1)</tt>, so that the cost is
+ proportional to the number of bits set plus the number of words.
+ */
+
+#ifndef JASEL_FUNDAMENTAL_V3_BITS_SET_BIT_ITERATOR_HPP
+#define JASEL_FUNDAMENTAL_V3_BITS_SET_BIT_ITERATOR_HPP
+
+#include <experimental/fundamental/v2/config.hpp>
+#include <experimental/fundamental/v3/bits/bit_ops.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <limits>
+
+namespace std
+{
+namespace experimental
+{
+inline namespace fundamental_v3
+{
+  /**
+  A forward iterator over the positions of the bits set in the n words starting at p, in increasing order.
+  The value is a @c size_t.
+  */
+  template <class Word>
+  class set_bit_iterator
+  {
+    static_assert(is_unsigned<Word>::value, "A Word must be unsigned");
+    static constexpr size_t digits = size_t(numeric_limits<Word>::digits);
+
+  public:
+    using iterator_category = forward_iterator_tag;
+    using value_type = size_t;
+    using difference_type = ptrdiff_t;
+    using pointer = void;
+    using reference = size_t;
+
+    //! @par Effects:
+    //!   Constructs a singular iterator.
+    constexpr set_bit_iterator() noexcept
+      : _words(nullptr), _index(0), _count(0), _current(0)
+    {}
+
+    //! @par Effects:
+    //!   Constructs an iterator to the first bit set in the n words starting at p.
+    JASEL_CXX14_CONSTEXPR set_bit_iterator(Word const* p, size_t n) noexcept
+      : _words(p), _index(size_t(-1)), _count(n), _current(0)
+    {
+      skip();
+    }
+
+    //! @par Returns:
+    //!   The iterator past the last bit set in the n words starting at p.
+    static constexpr set_bit_iterator end(Word const* p, size_t n) noexcept
+    {
+      return set_bit_iterator(p, n, n);
+    }
+
+    //! @par Returns:
+    //!   The position of the bit.
+    constexpr size_t operator*() const noexcept
+    {
+      return _index * digits + size_t(bit_ops::countr_zero(_current));
+    }
+
+    JASEL_CXX14_CONSTEXPR set_bit_iterator& operator++() noexcept
+    {
+      _current = Word(_current & (_current - 1));
+      skip();
+      return *this;
+    }
+    JASEL_CXX14_CONSTEXPR set_bit_iterator operator++(int) noexcept
+    {
+      set_bit_iterator tmp(*this);
+      ++*this;
+      return tmp;
+    }
+
+    //! @par Returns:
+    //!   Whether both iterators refer to the same bit.
+    //! @par Requires:
+    //!   x and y iterate over the same words.
+    friend constexpr bool operator==(set_bit_iterator const& x, set_bit_iterator const& y) noexcept
+    {
+      return x._index == y._index && x._current == y._current;
+    }
+    friend constexpr bool operator!=(set_bit_iterator const& x, set_bit_iterator const& y) noexcept
+    {
+      return !(x == y);
+    }
+
+  private:
+    constexpr set_bit_iterator(Word const* p, size_t n, size_t index) noexcept
+      : _words(p), _index(index), _count(n), _current(0)
+    {}
+
+    //! Moves to the next word having a bit set, or to the end.
+    JASEL_CXX14_CONSTEXPR void skip() noexcept
+    {
+      while (_current == 0 && ++_index < _count)
+        _current = _words[_index];
+    }
+
+    Word const* _words;
+    size_t _index;
+    size_t _count;
+    Word _current;
+  };
+
+  /**
+  The range of the positions of the bits set in the n words starting at p, as returned by @c set_bits().
+  */
+  template <class Word>
+  class set_bit_range
+  {
+  public:
+    using iterator = set_bit_iterator<Word>;
+    using const_iterator = iterator;
+
+    constexpr set_bit_range(Word const* p, size_t n) noexcept
+      : _words(p), _count(n)
+    {}
+
+    JASEL_CXX14_CONSTEXPR iterator begin() const noexcept { return iterator(_words, _count); }
+    constexpr iterator end() const noexcept { return iterator::end(_words, _count); }
+
+  private:
+    Word const* _words;
+    size_t _count;
+  };
+
+  //! @par Effects:
+  //!   Calls f(pos) for the position pos of each bit set in the n words starting at p, in increasing order.
+  template <class Word, class F>
+  JASEL_CXX14_CONSTEXPR void for_each_set_bit(Word const* p, size_t n, F&& f)
+  {
+    for (size_t i = 0; i < n; ++i)
+      for (Word x = p[i]; x != 0; x = Word(x & (x - 1)))
+        f(i * size_t(numeric_limits<Word>::digits) + size_t(bit_ops::countr_zero(x)));
+  }
+
+}
+}
+} // std
+
+#endif // header
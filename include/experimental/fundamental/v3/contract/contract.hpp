@@ -14,6 +14,7 @@
 #include <cassert>
 #include <cstdint>
 #include <cstdio>
+#include <cstdlib>
 #include <stdexcept>
 
 namespace std
@@ -28,7 +29,7 @@ class source_location {
 	const char *   function_name_;
 
 public:
-	source_location(uint_least32_t line, const char *file, const char *function)
+	constexpr source_location(uint_least32_t line, const char *file, const char *function)
 	        : line_number_(line), file_name_(file), function_name_(function) {}
 	constexpr uint_least32_t line_number() const noexcept { return line_number_; }
 	constexpr const char *   file_name() const noexcept { return file_name_; }
@@ -46,8 +47,8 @@ class contract_violation {
 	const char *   assertion_level_;
 
 public:
-	contract_violation(const char *kind, uint_least32_t line, const char *file, const char *function, const char *comment)
-	        : line_number_(line), file_name_(file), function_name_(function) {}
+	constexpr contract_violation(const char *kind, uint_least32_t line, const char *file, const char *function, const char *comment)
+	        : line_number_(line), file_name_(file), function_name_(function), comment_(comment), assertion_level_(kind) {}
 
 	constexpr uint_least32_t line_number() const noexcept { return line_number_; }
 	constexpr const char *   file_name() const noexcept { return file_name_; }
@@ -68,6 +69,7 @@ inline void throw_violation_handler(contract_violation const &cv)
 
 inline void violation_handler(contract_violation const &cv)
 {
+	(void)cv;
 #if JASEL_CONFIG_CONTRACT_VIOLATION_LOGS_V
 	log_violation_handler(cv);
 #endif
@@ -90,10 +92,10 @@ namespace contract
 #define JASEL_CONTRACT_IGNORE(KIND, cond) ((void)sizeof(decltype((cond) ? true : false)))
 #define JASEL_CONTRACT_ASSUME(KIND, cond, MSG) JASEL_ASSUME(cond &&MSG)
 #define JASEL_CONTRACT_CHECK_MAYBE_CONTINUE(KIND, cond, MSG) \
-	((void)((cond) ? 0 : (std::experimental::violation_handler(std::experimental::contract_violation(KIND, __LINE__, __FILE_, __PRETTY_FUNCTION__, JASEL_STRINGIFY(cond) MSG)), 0)))
+	((void)((cond) ? 0 : (std::experimental::violation_handler(std::experimental::contract_violation(KIND, __LINE__, __FILE__, __PRETTY_FUNCTION__, JASEL_STRINGIFY(cond) MSG)), 0)))
 
 #define JASEL_CONTRACT_CHECK_NEVER_CONTINUE(KIND, cond, MSG) \
-	((void)((cond) ? 0 : (std::experimental::violation_handler(std::experimental::contract_violation(KIND, __LINE__, __FILE_, __PRETTY_FUNCTION__, JASEL_STRINGIFY(cond) MSG)), std::abort(), 0)))
+	((void)((cond) ? 0 : (std::experimental::violation_handler(std::experimental::contract_violation(KIND, __LINE__, __FILE__, __PRETTY_FUNCTION__, JASEL_STRINGIFY(cond) MSG)), std::abort(), 0)))
 
 #define JASEL_CONFIG_CONTRACT_AS_IGNORE 1
 #define JASEL_CONFIG_CONTRACT_AS_ASSUME 2
@@ -0,0 +1,134 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Vicente J. Botet Escriba 2019.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file // LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//////////////////////////////////////////////////////////////////////////////
+
+/*
+ \file
+ \brief
+ The header \c <experimental/.../flat_map/batch_search.hpp> defines the algorithms used by the flat_map batched lookups.
+
+ Sorted queries are resolved by a single walk of the keys, galloping from the position of the previous query.
+ Unsorted queries are resolved by groups of independent branchless binary searches advanced in lockstep, so that
+ the memory accesses of the searches of a group overlap.
+ */
+
+#ifndef JASEL_FUNDAMENTAL_V3_FLAT_MAP_BATCH_SEARCH_HPP
+#define JASEL_FUNDAMENTAL_V3_FLAT_MAP_BATCH_SEARCH_HPP
+
+#include <experimental/fundamental/v3/flat_map/search_policy.hpp>
+
+namespace std
+{
+namespace experimental
+{
+inline namespace fundamental_v3
+{
+
+namespace flat_map_detail
+{
+
+// The number of searches advanced together
+constexpr size_t batch_group_size = 16;
+
+// Calls sink(*q, lower_bound(first, last, *q)) for each q in [qfirst, qlast), the queries being sorted.
+// Each search gallops from the result of the previous one, so that the total work is O(m log(n / m)).
+template <class RandomIt, class ForwardIt, class Compare, class Sink>
+void galloping_lower_bounds(RandomIt first, RandomIt last, ForwardIt qfirst, ForwardIt qlast, Compare comp,
+                            Sink sink)
+{
+	using difference_type = typename iterator_traits<RandomIt>::difference_type;
+	RandomIt pos          = first;
+	for (; qfirst != qlast; ++qfirst)
+	{
+		auto const &          x     = *qfirst;
+		difference_type const rest  = last - pos;
+		difference_type       bound = 1;
+		while (bound <= rest && comp(pos[bound - 1], x))
+			bound *= 2;
+		// the keys before pos + bound / 2 are less than x and pos[bound - 1], if any, is not
+		RandomIt const lo = pos + bound / 2;
+		RandomIt const hi = bound <= rest ? pos + (bound - 1) : last;
+		pos               = branchless_search_policy::lower_bound(lo, hi, x, comp);
+		sink(x, pos);
+	}
+}
+
+// Calls sink(*q, lower_bound(first, last, *q)) for each q in [qfirst, qlast).
+// The searches of a group of queries are interleaved: at each level all of them prefetch their next probes and then
+// all of them compare.
+template <class RandomIt, class ForwardIt, class Compare, class Sink>
+void interleaved_lower_bounds(RandomIt first, RandomIt last, ForwardIt qfirst, ForwardIt qlast, Compare comp,
+                              Sink sink)
+{
+	using difference_type = typename iterator_traits<RandomIt>::difference_type;
+	size_t const n        = static_cast<size_t>(last - first);
+	ForwardIt    query[batch_group_size];
+	RandomIt     base[batch_group_size];
+	while (qfirst != qlast)
+	{
+		size_t g = 0;
+		for (; g < batch_group_size && qfirst != qlast; ++g, ++qfirst)
+		{
+			query[g] = qfirst;
+			base[g]  = first;
+		}
+		if (n != 0)
+		{
+			size_t len = n;
+			while (len > 1)
+			{
+				size_t const half = len / 2;
+				for (size_t i = 0; i < g; ++i)
+				{
+					prefetch(base[i] + difference_type(half / 2));
+					prefetch(base[i] + difference_type(half + half / 2));
+				}
+				for (size_t i = 0; i < g; ++i)
+					base[i] = comp(base[i][difference_type(half)], *query[i]) ? base[i] + difference_type(half)
+					                                                           : base[i];
+				len -= half;
+			}
+			for (size_t i = 0; i < g; ++i)
+				base[i] += difference_type(bool(comp(*base[i], *query[i])));
+		}
+		for (size_t i = 0; i < g; ++i)
+			sink(*query[i], base[i]);
+	}
+}
+
+template <class RandomIt, class ForwardIt, class Compare, class Sink>
+void batch_lower_bounds(RandomIt first, RandomIt last, ForwardIt qfirst, ForwardIt qlast, Compare comp, Sink sink,
+                        true_type)
+{
+	if (std::is_sorted(qfirst, qlast, comp))
+		galloping_lower_bounds(first, last, qfirst, qlast, comp, sink);
+	else
+		interleaved_lower_bounds(first, last, qfirst, qlast, comp, sink);
+}
+template <class RandomIt, class ForwardIt, class Compare, class Sink>
+void batch_lower_bounds(RandomIt first, RandomIt last, ForwardIt qfirst, ForwardIt qlast, Compare comp, Sink sink,
+                        false_type)
+{
+	interleaved_lower_bounds(first, last, qfirst, qlast, comp, sink);
+}
+// Dispatches to the galloping walk when the queries are sorted with respect to comp.
+// Heterogeneous queries are not checked, as comp could be unable to compare them with each other.
+template <class RandomIt, class ForwardIt, class Compare, class Sink>
+void batch_lower_bounds(RandomIt first, RandomIt last, ForwardIt qfirst, ForwardIt qlast, Compare comp, Sink sink)
+{
+	batch_lower_bounds(first, last, qfirst, qlast, comp, sink,
+	                   is_same<typename iterator_traits<RandomIt>::value_type,
+	                           typename decay<typename iterator_traits<ForwardIt>::value_type>::type>{});
+}
+
+} // namespace flat_map_detail
+
+} // namespace fundamental_v3
+} // namespace experimental
+} // namespace std
+
+#endif
@@ -0,0 +1,576 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Vicente J. Botet Escriba 2019.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file // LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//////////////////////////////////////////////////////////////////////////////
+
+/*
+ \file
+ \brief
+ The header \c <experimental/.../flat_map/eytzinger_flat_map.hpp> defines a read-only associative container built from
+ a flat_map that stores its keys in Eytzinger (BFS) order.
+
+ The node k of the implicit binary search tree (1 <= k <= size()) is stored at index k - 1, its children being the
+ nodes 2k and 2k + 1. A lookup reads a single key per level, and the keys of the next levels are contiguous, so that
+ the key needed four levels below can be prefetched while the current one is compared.
+ The mapped values are stored in the same order than the keys.
+ Iteration visits the elements in key order.
+
+ The layout pays off while the walk down the tree doesn't miss the TLB at each level: beyond a few million keys the
+ containers should be backed by huge pages.
+ */
+
+#ifndef JASEL_FUNDAMENTAL_V3_FLAT_MAP_EYTZINGER_FLAT_MAP_HPP
+#define JASEL_FUNDAMENTAL_V3_FLAT_MAP_EYTZINGER_FLAT_MAP_HPP
+
+#include <experimental/fundamental/v3/flat_map/flat_map.hpp>
+
+namespace std
+{
+namespace experimental
+{
+inline namespace fundamental_v3
+{
+
+namespace flat_map_detail
+{
+// The ancestor of node k of which k is in the left subtree, or 0 if k is in the rightmost path.
+inline size_t eytzinger_climb_left(size_t k) noexcept
+{
+#if defined __GNUC__ || defined __clang__
+	return k >> (__builtin_ctzll(~static_cast<unsigned long long>(k)) + 1);
+#else
+	while (k & 1)
+		k >>= 1;
+	return k >> 1;
+#endif
+}
+// The ancestor of node k of which k is in the right subtree, or 0 if k is in the leftmost path.
+inline size_t eytzinger_climb_right(size_t k) noexcept
+{
+	while (k != 0 && !(k & 1))
+		k >>= 1;
+	return k >> 1;
+}
+
+// The node following k in key order, or 0 when k is the last one.
+inline size_t eytzinger_next(size_t k, size_t n) noexcept
+{
+	if (2 * k + 1 <= n)
+	{
+		k = 2 * k + 1;
+		while (2 * k <= n)
+			k = 2 * k;
+		return k;
+	}
+	return eytzinger_climb_left(k);
+}
+// The node preceding k in key order. The node preceding 0 (the end) is the last node.
+inline size_t eytzinger_prev(size_t k, size_t n) noexcept
+{
+	if (k == 0 || 2 * k <= n)
+	{
+		k = (k == 0) ? 1 : 2 * k;
+		while (2 * k + 1 <= n)
+			k = 2 * k + 1;
+		return k;
+	}
+	return eytzinger_climb_right(k);
+}
+// The number of complete levels of a tree of n nodes, floor(log2(n + 1)).
+inline size_t eytzinger_complete_levels(size_t n) noexcept
+{
+#if defined __GNUC__ || defined __clang__
+	return size_t(numeric_limits<unsigned long long>::digits - 1 -
+	              __builtin_clzll(static_cast<unsigned long long>(n) + 1));
+#else
+	size_t l = 0;
+	while ((n + 1) >> (l + 1))
+		++l;
+	return l;
+#endif
+}
+inline size_t eytzinger_first(size_t n) noexcept
+{
+	if (n == 0)
+		return 0;
+	size_t k = 1;
+	while (2 * k <= n)
+		k = 2 * k;
+	return k;
+}
+
+// An empty container using the allocator of c, if any, so that it can be swapped with c.
+template <class Container>
+auto empty_like(Container const &c, int) -> decltype(Container(c.get_allocator()))
+{
+	return Container(c.get_allocator());
+}
+template <class Container>
+Container empty_like(Container const &, long)
+{
+	return Container();
+}
+
+// Moves the elements of the sorted containers to new containers in Eytzinger order.
+template <class KeyContainer, class MappedContainer>
+void to_eytzinger(KeyContainer &keys, MappedContainer &values)
+{
+	size_t const        n = keys.size();
+	std::vector<size_t> rank(n);
+	size_t              i = 0;
+	for (size_t k = eytzinger_first(n); k != 0; k = eytzinger_next(k, n))
+		rank[k - 1] = i++;
+	KeyContainer    ekeys   = empty_like(keys, 0);
+	MappedContainer evalues = empty_like(values, 0);
+	for (size_t k = 0; k < n; ++k)
+	{
+		ekeys.insert(ekeys.end(), std::move(keys[rank[k]]));
+		evalues.insert(evalues.end(), std::move(values[rank[k]]));
+	}
+	keys.swap(ekeys);
+	values.swap(evalues);
+}
+
+// Moves the elements of the containers in Eytzinger order to new containers in key order.
+template <class KeyContainer, class MappedContainer>
+void from_eytzinger(KeyContainer &keys, MappedContainer &values)
+{
+	size_t const    n = keys.size();
+	KeyContainer    skeys   = empty_like(keys, 0);
+	MappedContainer svalues = empty_like(values, 0);
+	for (size_t k = eytzinger_first(n); k != 0; k = eytzinger_next(k, n))
+	{
+		skeys.insert(skeys.end(), std::move(keys[k - 1]));
+		svalues.insert(svalues.end(), std::move(values[k - 1]));
+	}
+	keys.swap(skeys);
+	values.swap(svalues);
+}
+} // namespace flat_map_detail
+
+// Bidirectional iterator visiting the nodes in key order.
+template <class KeyContainer, class MappedContainer>
+class eytzinger_flat_map_iterator {
+public:
+	using key_type                 = typename KeyContainer::value_type;
+	using mapped_type              = typename MappedContainer::value_type;
+	using key_const_reference_type = typename KeyContainer::const_reference;
+	using mapped_reference_type    = typename conditional<is_const<MappedContainer>::value,
+	                                                   typename MappedContainer::const_reference,
+	                                                   typename MappedContainer::reference>::type;
+
+	using iterator_category = bidirectional_iterator_tag;
+	using value_type        = pair<const key_type, mapped_type>;
+	using difference_type   = ptrdiff_t;
+	using reference         = pair<key_const_reference_type, mapped_reference_type>;
+	using pointer           = arrow_proxy<reference>;
+
+	eytzinger_flat_map_iterator()
+	        : keys(nullptr), values(nullptr), k(0)
+	{
+	}
+	eytzinger_flat_map_iterator(KeyContainer const *keys, MappedContainer *values, size_t k)
+	        : keys(keys), values(values), k(k)
+	{
+	}
+	// iterator to const_iterator conversion
+	template <class OtherMappedContainer,
+	          JASEL_REQUIRES(is_same<MappedContainer, OtherMappedContainer const>::value)>
+	eytzinger_flat_map_iterator(eytzinger_flat_map_iterator<KeyContainer, OtherMappedContainer> const &other)
+	        : keys(other.keys), values(other.values), k(other.k)
+	{
+	}
+
+	eytzinger_flat_map_iterator &operator++()
+	{
+		k = flat_map_detail::eytzinger_next(k, keys->size());
+		return *this;
+	}
+	eytzinger_flat_map_iterator operator++(int)
+	{
+		eytzinger_flat_map_iterator retval = *this;
+		++(*this);
+		return retval;
+	}
+	eytzinger_flat_map_iterator &operator--()
+	{
+		k = flat_map_detail::eytzinger_prev(k, keys->size());
+		return *this;
+	}
+	eytzinger_flat_map_iterator operator--(int)
+	{
+		eytzinger_flat_map_iterator retval = *this;
+		--(*this);
+		return retval;
+	}
+	reference operator*() const
+	{
+		return {(*keys)[k - 1], (*values)[k - 1]};
+	}
+	pointer operator->() const
+	{
+		return {**this};
+	}
+	// The position of the element in keys() and values().
+	size_t index() const
+	{
+		return k - 1;
+	}
+	friend bool operator==(eytzinger_flat_map_iterator const &x, eytzinger_flat_map_iterator const &y)
+	{
+		return x.k == y.k;
+	}
+	friend bool operator!=(eytzinger_flat_map_iterator const &x, eytzinger_flat_map_iterator const &y)
+	{
+		return !(x == y);
+	}
+
+private:
+	template <class OtherKeyContainer, class OtherMappedContainer>
+	friend class eytzinger_flat_map_iterator;
+	KeyContainer const *keys;
+	MappedContainer *   values;
+	// the node, 0 for the end
+	size_t k;
+};
+
+template <class Key, class T, class Compare = less<Key>, class KeyContainer = vector<Key>,
+          class MappedContainer = vector<T>>
+class eytzinger_flat_map {
+public:
+	// types:
+	using key_container_type          = KeyContainer;
+	using mapped_container_type       = MappedContainer;
+	using key_type                    = typename key_container_type::value_type;
+	using mapped_type                 = typename mapped_container_type::value_type;
+	using key_const_reference_type    = typename key_container_type::const_reference;
+	using mapped_reference_type       = typename mapped_container_type::reference;
+	using mapped_const_reference_type = typename mapped_container_type::const_reference;
+
+	using key_compare   = Compare;
+	using flat_map_type = flat_map<Key, T, Compare, KeyContainer, MappedContainer>;
+	using containers    = typename flat_map_type::containers;
+
+	using value_type      = pair<const key_type, mapped_type>;
+	using reference       = pair<key_const_reference_type, mapped_reference_type>;
+	using const_reference = pair<key_const_reference_type, mapped_const_reference_type>;
+	using size_type       = size_t;
+	using difference_type = ptrdiff_t;
+
+	using iterator               = eytzinger_flat_map_iterator<key_container_type, mapped_container_type>;
+	using const_iterator         = eytzinger_flat_map_iterator<key_container_type, mapped_container_type const>;
+	using reverse_iterator       = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	// construct/copy/destroy
+	eytzinger_flat_map() {}
+	explicit eytzinger_flat_map(flat_map_type &&m)
+	        : c(std::move(m).extract()), compare{m.key_comp()}
+	{
+		flat_map_detail::to_eytzinger(c.keys, c.values);
+	}
+	explicit eytzinger_flat_map(flat_map_type const &m)
+	        : c{m.keys(), m.values()}, compare{m.key_comp()}
+	{
+		flat_map_detail::to_eytzinger(c.keys, c.values);
+	}
+	// key_cont must be sorted with respect to comp and have no equivalent keys.
+	eytzinger_flat_map(sorted_unique_t, key_container_type &&key_cont, mapped_container_type &&mapped_cont,
+	                   const key_compare &comp = key_compare())
+	        : c{move(key_cont), move(mapped_cont)}, compare{comp}
+	{
+		assert(c.keys.size() == c.values.size());
+		flat_map_detail::to_eytzinger(c.keys, c.values);
+	}
+
+	// iterators
+	iterator               begin() noexcept { return make_iterator(flat_map_detail::eytzinger_first(size())); }
+	const_iterator         begin() const noexcept { return make_iterator(flat_map_detail::eytzinger_first(size())); }
+	iterator               end() noexcept { return make_iterator(0); }
+	const_iterator         end() const noexcept { return make_iterator(0); }
+	reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
+	const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+	reverse_iterator       rend() noexcept { return reverse_iterator(begin()); }
+	const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+	const_iterator         cbegin() const noexcept { return begin(); }
+	const_iterator         cend() const noexcept { return end(); }
+	const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+	const_reverse_iterator crend() const noexcept { return rend(); }
+
+	// capacity
+	bool      empty() const noexcept { return c.keys.empty(); }
+	size_type size() const noexcept { return c.keys.size(); }
+	size_type max_size() const noexcept { return c.keys.max_size(); }
+
+	// element access
+	mapped_type &at(const key_type &x)
+	{
+		auto const k = find_node(x);
+		if (k == 0)
+			throw out_of_range("eytzinger_flat_map::at");
+		return c.values[k - 1];
+	}
+	const mapped_type &at(const key_type &x) const
+	{
+		auto const k = find_node(x);
+		if (k == 0)
+			throw out_of_range("eytzinger_flat_map::at");
+		return c.values[k - 1];
+	}
+
+	// modifiers
+	// Returns the containers sorted in key order, as they were before the construction.
+	containers extract() &&
+	{
+		flat_map_detail::from_eytzinger(c.keys, c.values);
+		containers temp{std::move(c.keys), std::move(c.values)};
+		c.keys.clear();
+		c.values.clear();
+		return temp;
+	}
+	flat_map_type to_flat_map() &&
+	{
+		auto comp = compare;
+		auto cont = std::move(*this).extract();
+		flat_map_type m(comp);
+		m.replace(std::move(cont.keys), std::move(cont.values));
+		return m;
+	}
+
+	void swap(eytzinger_flat_map &fm) noexcept
+	{
+		using std::swap;
+		swap(c.keys, fm.c.keys);
+		swap(c.values, fm.c.values);
+		swap(compare, fm.compare);
+	}
+
+	void clear() noexcept
+	{
+		c.keys.clear();
+		c.values.clear();
+	}
+
+	// observers
+	key_compare key_comp() const { return compare; }
+
+	// The keys and values in Eytzinger order.
+	const key_container_type &keys() const
+	{
+		return c.keys;
+	}
+	const mapped_container_type &values() const
+	{
+		return c.values;
+	}
+
+	// map operations
+	iterator find(const key_type &x)
+	{
+		return make_iterator(find_node(x));
+	}
+	const_iterator find(const key_type &x) const
+	{
+		return make_iterator(find_node(x));
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	iterator find(const K &x)
+	{
+		return make_iterator(find_node(x));
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	const_iterator find(const K &x) const
+	{
+		return make_iterator(find_node(x));
+	}
+
+	size_type count(const key_type &x) const
+	{
+		return find_node(x) != 0 ? 1 : 0;
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	size_type count(const K &x) const
+	{
+		// there could be several keys equivalent to x
+		auto const rng = equal_range_nodes(x);
+		size_type  r   = 0;
+		for (size_t k = rng.first; k != rng.second; k = flat_map_detail::eytzinger_next(k, size()))
+			++r;
+		return r;
+	}
+
+	bool contains(const key_type &x) const
+	{
+		return find_node(x) != 0;
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	bool contains(const K &x) const
+	{
+		return find_node(x) != 0;
+	}
+
+	iterator lower_bound(const key_type &x)
+	{
+		return make_iterator(lower_bound_node(x));
+	}
+	const_iterator lower_bound(const key_type &x) const
+	{
+		return make_iterator(lower_bound_node(x));
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	iterator lower_bound(const K &x)
+	{
+		return make_iterator(lower_bound_node(x));
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	const_iterator lower_bound(const K &x) const
+	{
+		return make_iterator(lower_bound_node(x));
+	}
+
+	iterator upper_bound(const key_type &x)
+	{
+		return make_iterator(upper_bound_node(x));
+	}
+	const_iterator upper_bound(const key_type &x) const
+	{
+		return make_iterator(upper_bound_node(x));
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	iterator upper_bound(const K &x)
+	{
+		return make_iterator(upper_bound_node(x));
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	const_iterator upper_bound(const K &x) const
+	{
+		return make_iterator(upper_bound_node(x));
+	}
+
+	pair<iterator, iterator> equal_range(const key_type &x)
+	{
+		auto const r = equal_range_nodes(x);
+		return {make_iterator(r.first), make_iterator(r.second)};
+	}
+	pair<const_iterator, const_iterator> equal_range(const key_type &x) const
+	{
+		auto const r = equal_range_nodes(x);
+		return {make_iterator(r.first), make_iterator(r.second)};
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	pair<iterator, iterator> equal_range(const K &x)
+	{
+		auto const r = equal_range_nodes(x);
+		return {make_iterator(r.first), make_iterator(r.second)};
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	pair<const_iterator, const_iterator> equal_range(const K &x) const
+	{
+		auto const r = equal_range_nodes(x);
+		return {make_iterator(r.first), make_iterator(r.second)};
+	}
+
+private:
+	static constexpr size_t floor_pow2(size_t n, size_t p = 1)
+	{
+		return 2 * p > n ? p : floor_pow2(n, 2 * p);
+	}
+	// The descendants of node k log2(prefetch_factor()) levels below are the nodes starting at
+	// k * prefetch_factor(), whose keys fill a cache line.
+	static constexpr size_t prefetch_factor()
+	{
+		return sizeof(key_type) >= 64 ? 1 : floor_pow2(64 / sizeof(key_type));
+	}
+	void prefetch_descendants(size_t k) const
+	{
+		size_t const d = k * prefetch_factor();
+		if (d <= size())
+			flat_map_detail::prefetch(c.keys.begin() + difference_type(d - 1));
+	}
+
+	// Walks down from the root, going right when pred(key) is true, and returns the first node in key order for
+	// which pred is false, or 0.
+	// All the lookups walk the complete levels in the same number of steps and the last partial level is handled
+	// with a conditional move, so that the exit of the loop is always predicted.
+	template <class Predicate>
+	size_t descend(Predicate pred) const
+	{
+		size_t const n = size();
+		if (n == 0)
+			return 0;
+		size_t k = 1;
+		for (size_t l = flat_map_detail::eytzinger_complete_levels(n); l != 0; --l)
+		{
+			prefetch_descendants(k);
+			k = 2 * k + size_t(bool(pred(c.keys[k - 1])));
+		}
+		bool const   partial = k <= n;
+		size_t const j       = partial ? k : 1;
+		size_t const right   = size_t(bool(pred(c.keys[j - 1])));
+		k                    = partial ? 2 * k + right : k;
+		return flat_map_detail::eytzinger_climb_left(k);
+	}
+	// The node of the first key not less than x, or 0.
+	template <class K>
+	size_t lower_bound_node(const K &x) const
+	{
+		return descend([&](key_const_reference_type e) { return compare(e, x); });
+	}
+	// The node of the first key greater than x, or 0.
+	template <class K>
+	size_t upper_bound_node(const K &x) const
+	{
+		return descend([&](key_const_reference_type e) { return !compare(x, e); });
+	}
+	template <class K>
+	size_t find_node(const K &x) const
+	{
+		auto const k = lower_bound_node(x);
+		return (k != 0 && !compare(x, c.keys[k - 1])) ? k : 0;
+	}
+	// The keys are unique, so the range of a key_type has at most one node.
+	pair<size_t, size_t> equal_range_nodes(const key_type &x) const
+	{
+		auto const k = lower_bound_node(x);
+		auto const l = (k != 0 && !compare(x, c.keys[k - 1])) ? flat_map_detail::eytzinger_next(k, size()) : k;
+		return {k, l};
+	}
+	// A heterogeneous x can be equivalent to several keys, visited in order from the lower bound.
+	template <class K>
+	pair<size_t, size_t> equal_range_nodes(const K &x) const
+	{
+		auto const k = lower_bound_node(x);
+		auto       l = k;
+		while (l != 0 && !compare(x, c.keys[l - 1]))
+			l = flat_map_detail::eytzinger_next(l, size());
+		return {k, l};
+	}
+
+	iterator make_iterator(size_t k)
+	{
+		return iterator{&c.keys, &c.values, k};
+	}
+	const_iterator make_iterator(size_t k) const
+	{
+		return const_iterator{&c.keys, &c.values, k};
+	}
+
+	containers  c;
+	key_compare compare;
+};
+
+template <class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+void swap(eytzinger_flat_map<Key, T, Compare, KeyContainer, MappedContainer> &x,
+          eytzinger_flat_map<Key, T, Compare, KeyContainer, MappedContainer> &y) noexcept(noexcept(x.swap(y)))
+{
+	x.swap(y);
+}
+
+} // namespace fundamental_v3
+} // namespace experimental
+} // namespace std
+
+#endif
@@ -10,10 +10,13 @@
 #define JASEL_FUNDAMENTAL_V3_FLAT_MAP_FLAT_MAP_HPP
 
 #include <experimental/fundamental/v2/config.hpp>
+#include <experimental/fundamental/v3/config/requires.hpp>
+#include <experimental/fundamental/v3/flat_map/batch_search.hpp>
 #include <algorithm>
 #include <cassert>
 #include <initializer_list>
 #include <iterator>
+#include <memory>
 #include <stdexcept>
 #include <vector>
 
@@ -859,20 +862,284 @@ template <class Key, class T, class Compare = less<Key>, class KeyContainer = ve
           class MappedContainer = vector<T>>
 class flat_map;
 
+template <class Key, class T, class Compare = less<Key>, class KeyContainer = vector<Key>,
+          class MappedContainer = vector<T>>
+class flat_multimap;
+
+namespace flat_map_detail
+{
+template <class T>
+struct void_type
+{
+	using type = void;
+};
+template <class Compare, class = void>
+struct is_transparent : false_type
+{
+};
+template <class Compare>
+struct is_transparent<Compare, typename void_type<typename Compare::is_transparent>::type> : true_type
+{
+};
+
+// Whether the key and the mapped containers can both be constructed with an allocator of type Alloc.
+template <class KeyContainer, class MappedContainer, class Alloc>
+struct uses_allocator
+        : integral_constant<bool, std::uses_allocator<KeyContainer, Alloc>::value &&
+                                          std::uses_allocator<MappedContainer, Alloc>::value>
+{
+};
+
+inline std::vector<size_t> identity_permutation(size_t n)
+{
+	std::vector<size_t> perm(n);
+	for (size_t i = 0; i < n; ++i)
+		perm[i] = i;
+	return perm;
+}
+
+template <class KeyContainer, class Compare>
+struct index_compare
+{
+	KeyContainer const *keys;
+	Compare const *     comp;
+	size_t              base;
+	bool                operator()(size_t i, size_t j) const
+	{
+		return (*comp)((*keys)[base + i], (*keys)[base + j]);
+	}
+};
+
+// Moves the element at base + perm[i] to base + i in both containers, following the cycles of the permutation.
+template <class KeyContainer, class MappedContainer>
+void permute(KeyContainer &keys, MappedContainer &values, size_t base, std::vector<size_t> &perm)
+{
+	for (size_t i = 0; i < perm.size(); ++i)
+	{
+		if (perm[i] == i)
+			continue;
+		typename KeyContainer::value_type    k = std::move(keys[base + i]);
+		typename MappedContainer::value_type v = std::move(values[base + i]);
+		size_t                               j = i;
+		while (perm[j] != i)
+		{
+			size_t const from  = perm[j];
+			keys[base + j]   = std::move(keys[base + from]);
+			values[base + j] = std::move(values[base + from]);
+			perm[j]          = j;
+			j                = from;
+		}
+		keys[base + j]   = std::move(k);
+		values[base + j] = std::move(v);
+		perm[j]          = j;
+	}
+}
+
+// Sorts the elements appended at [pos, size()), unless they are already sorted, and merges them with the sorted
+// range [0, pos), moving keys and values together. Both the sort and the merge are stable.
+// Returns the index of the first element that could be equivalent to one of its neighbours.
+template <class KeyContainer, class MappedContainer, class Compare>
+size_t sort_from(KeyContainer &keys, MappedContainer &values, Compare const &comp, size_t pos, bool sorted)
+{
+	using difference_type = typename KeyContainer::difference_type;
+	size_t const n        = keys.size();
+	if (pos == n)
+		return n;
+	if (!sorted)
+	{
+		auto perm = identity_permutation(n - pos);
+		std::stable_sort(perm.begin(), perm.end(), index_compare<KeyContainer, Compare>{&keys, &comp, pos});
+		permute(keys, values, pos, perm);
+	}
+	if (pos == 0 || !comp(keys[pos], keys[pos - 1]))
+		return pos == 0 ? 0 : pos - 1;
+
+	// only the elements not less than the smallest new key take part in the merge
+	size_t const first = static_cast<size_t>(
+	        std::lower_bound(keys.begin(), keys.begin() + difference_type(pos), keys[pos], comp) - keys.begin());
+	auto perm = identity_permutation(n - first);
+	std::inplace_merge(perm.begin(), perm.begin() + difference_type(pos - first), perm.end(),
+	                   index_compare<KeyContainer, Compare>{&keys, &comp, first});
+	permute(keys, values, first, perm);
+	return first;
+}
+
+struct discard
+{
+	template <class K, class V>
+	void operator()(K &&, V &&) const
+	{
+	}
+};
+
+// Removes the consecutive equivalent keys of the sorted range [first, size()), keeping the first one.
+// The removed elements are given to sink.
+template <class KeyContainer, class MappedContainer, class Compare, class Sink>
+void unique_from(KeyContainer &keys, MappedContainer &values, Compare const &comp, size_t first, Sink sink)
+{
+	using difference_type = typename KeyContainer::difference_type;
+	size_t const n        = keys.size();
+	if (n - first < 2)
+		return;
+	size_t last = first;
+	for (size_t i = first + 1; i < n; ++i)
+	{
+		if (comp(keys[last], keys[i]))
+		{
+			++last;
+			if (last != i)
+			{
+				keys[last]   = std::move(keys[i]);
+				values[last] = std::move(values[i]);
+			}
+		}
+		else
+			sink(std::move(keys[i]), std::move(values[i]));
+	}
+	++last;
+	keys.erase(keys.begin() + difference_type(last), keys.end());
+	values.erase(values.begin() + difference_type(last), values.end());
+}
+
+// Appends the elements it is given to two containers.
+template <class KeyContainer, class MappedContainer>
+struct push_back_to
+{
+	KeyContainer *   keys;
+	MappedContainer *values;
+	template <class K, class V>
+	void operator()(K &&k, V &&v) const
+	{
+		keys->insert(keys->end(), std::forward<K>(k));
+		values->insert(values->end(), std::forward<V>(v));
+	}
+};
+
+// Removes the elements at the positions i for which remove(i) is true, moving the kept ones once in a single stable
+// pass over both containers.
+// On exception from remove the elements not visited yet are kept, after the ones already kept, so that the
+// containers stay sorted and hold no moved-from element.
+// Returns the number of removed elements.
+template <class KeyContainer, class MappedContainer, class Predicate>
+size_t compact(KeyContainer &keys, MappedContainer &values, Predicate remove)
+{
+	using difference_type = typename KeyContainer::difference_type;
+	size_t const n        = keys.size();
+	size_t       i        = 0;
+	while (i != n && !remove(i))
+		++i;
+	size_t last = i;
+	try
+	{
+		for (; i != n; ++i)
+		{
+			if (!remove(i))
+			{
+				keys[last]   = std::move(keys[i]);
+				values[last] = std::move(values[i]);
+				++last;
+			}
+		}
+	}
+	catch (...)
+	{
+		auto const key_end =
+		        std::move(keys.begin() + difference_type(i), keys.end(), keys.begin() + difference_type(last));
+		keys.erase(key_end, keys.end());
+		auto const value_end =
+		        std::move(values.begin() + difference_type(i), values.end(), values.begin() + difference_type(last));
+		values.erase(value_end, values.end());
+		throw;
+	}
+	keys.erase(keys.begin() + difference_type(last), keys.end());
+	values.erase(values.begin() + difference_type(last), values.end());
+	return n - last;
+}
+
+// Removes the elements whose key is equivalent to one of the sorted range [first, last), merging it with the keys:
+// remove(i) is asked for increasing positions, so that the cursor in [first, last) only moves forward.
+// Returns the number of removed elements.
+template <class KeyContainer, class MappedContainer, class Compare, class ForwardIt>
+size_t erase_sorted_keys(KeyContainer &keys, MappedContainer &values, Compare const &comp, ForwardIt first,
+                         ForwardIt last)
+{
+	return compact(keys, values, [&](size_t i) {
+		while (first != last && comp(*first, keys[i]))
+			++first;
+		return first != last && !comp(keys[i], *first);
+	});
+}
+
+// Throws length_error when n more elements do not fit in a container of max_size elements, as happens when
+// inserting into a full fixed-capacity container such as static_vector.
+inline void check_room(size_t size, size_t max_size, size_t n, char const *what)
+{
+	if (n > max_size - size)
+		throw length_error(what);
+}
+
+// Appends the pairs of [first, last) to both containers.
+// On exception, in particular when the containers become full, the appended elements are removed.
+template <class KeyContainer, class MappedContainer, class InputIterator>
+void append(KeyContainer &keys, MappedContainer &values, InputIterator first, InputIterator last, size_t max_size,
+            char const *what)
+{
+	using difference_type = typename KeyContainer::difference_type;
+	size_t const pos      = keys.size();
+	try
+	{
+		for (; first != last; ++first)
+		{
+			check_room(keys.size(), max_size, 1, what);
+			keys.insert(keys.end(), first->first);
+			values.insert(values.end(), first->second);
+		}
+	}
+	catch (...)
+	{
+		keys.erase(keys.begin() + difference_type(pos), keys.end());
+		values.erase(values.begin() + difference_type(pos), values.end());
+		throw;
+	}
+}
+// The lookups shared by flat_map and flat_multimap. Search finds the keys in c.keys and the iterator of type Iterator
+// pairs them with the values at the same positions; when c is const, Iterator is the const_iterator.
+template <class Iterator, class Containers, class KeyIterator>
+Iterator iterator_at(Containers &c, KeyIterator key_it)
+{
+	return Iterator{key_it, c.values.begin() + distance(KeyIterator(c.keys.begin()), key_it)};
+}
+template <class Iterator, class Containers, class KeyIterator>
+pair<Iterator, Iterator> range_at(Containers &c, pair<KeyIterator, KeyIterator> const &keys)
+{
+	return make_pair(iterator_at<Iterator>(c, keys.first), iterator_at<Iterator>(c, keys.second));
+}
+template <class Iterator, class Search, class Containers, class Compare, class K>
+Iterator lower_bound(Containers &c, Compare const &comp, const K &x)
+{
+	return iterator_at<Iterator>(c, Search::lower_bound(c.keys.begin(), c.keys.end(), x, comp));
+}
+template <class Iterator, class Search, class Containers, class Compare, class K>
+Iterator upper_bound(Containers &c, Compare const &comp, const K &x)
+{
+	return iterator_at<Iterator>(c, Search::upper_bound(c.keys.begin(), c.keys.end(), x, comp));
+}
+} // namespace flat_map_detail
+
 template <class KeyConstIterator, class MappedIterator>
 class flat_map_iterator {
 public:
 	using key_const_iterator_type = KeyConstIterator;
 	using mapped_iterator_type    = MappedIterator;
 
-	using key_type                 = typename key_const_iterator_type::value_type;
-	using mapped_type              = typename mapped_iterator_type::value_type;
-	using key_const_reference_type = typename key_const_iterator_type::reference;
-	using mapped_reference_type    = typename mapped_iterator_type::reference;
+	using key_type                 = typename iterator_traits<key_const_iterator_type>::value_type;
+	using mapped_type              = typename iterator_traits<mapped_iterator_type>::value_type;
+	using key_const_reference_type = typename iterator_traits<key_const_iterator_type>::reference;
+	using mapped_reference_type    = typename iterator_traits<mapped_iterator_type>::reference;
 
 	using iterator_category = random_access_iterator_tag;
 	using value_type        = pair<const key_type, mapped_type>;
-	using difference_type   = typename key_const_iterator_type::difference_type;
+	using difference_type   = typename iterator_traits<key_const_iterator_type>::difference_type;
 	using reference         = pair<key_const_reference_type, mapped_reference_type>;
 	using pointer           = arrow_proxy<reference>;
 
@@ -881,6 +1148,13 @@ public:
 	          value_it(value_it)
 	{
 	}
+	// iterator to const_iterator conversion
+	template <class OtherMappedIterator, JASEL_REQUIRES(is_convertible<OtherMappedIterator, MappedIterator>::value)>
+	flat_map_iterator(flat_map_iterator<KeyConstIterator, OtherMappedIterator> const &other)
+	        : key_it(other.key_it),
+	          value_it(other.value_it)
+	{
+	}
 
 	flat_map_iterator &operator++()
 	{
@@ -903,7 +1177,7 @@ public:
 	flat_map_iterator operator--(int)
 	{
 		flat_map_iterator retval = *this;
-		++(*this);
+		--(*this);
 		return retval;
 	}
 	flat_map_iterator &operator+=(difference_type n)
@@ -960,8 +1234,12 @@ public:
 	}
 
 private:
+	template <class OtherKeyConstIterator, class OtherMappedIterator>
+	friend class flat_map_iterator;
 	template <class Key, class T, class Compare, class KeyContainer, class MappedContainer>
 	friend class flat_map;
+	template <class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+	friend class flat_multimap;
 	key_const_iterator_type key_it;
 	mapped_iterator_type    value_it;
 };
@@ -984,6 +1262,8 @@ public:
 	using mapped_const_reference_type = typename mapped_container_type::const_reference;
 
 	using key_compare = Compare;
+	// the policy used to search the key column, see search_policy.hpp
+	using search_policy = typename flat_search_policy<key_type, key_compare>::type;
 
 	using value_type      = pair<const key_type, mapped_type>;
 	using reference       = pair<key_const_reference_type, mapped_reference_type>;
@@ -1029,29 +1309,17 @@ public:
 	}
 
 	flat_map(key_container_type &&key_cont, mapped_container_type &&mapped_cont)
-	        // : c{move(key_cont), move(mapped_cont)}, compare{}
-	        : c{},
-	          compare{}
+	        : c{move(key_cont), move(mapped_cont)}, compare{}
 	{
-		assert(key_cont.size() == mapped_cont.size());
-		//sort(begin(), end(), value_compare{compare});
-		auto mapped_it = mapped_cont.begin();
-		for (auto const &k : key_cont)
-		{
-			(void)emplace(k, *mapped_it);
-			++mapped_it;
-		}
+		assert(c.keys.size() == c.values.size());
+		sort_and_unique_from(0, false);
 	}
 	template <class InputIterator>
 	flat_map(InputIterator first, InputIterator last, const key_compare &comp = key_compare())
+	        : c{}, compare{comp}
 	{
-		for (; first != last; ++first)
-		{
-			(void)emplace(first->first, first->second);
-			// c.keys.insert(c.keys.end(), first->first);
-			// c.values.insert(c.values.end(), first->second);
-		}
-		//sort(begin(), end(), compare);
+		append(first, last);
+		sort_and_unique_from(0, false);
 	}
 
 	template <class Container>
@@ -1076,91 +1344,105 @@ public:
 	flat_map(sorted_unique_t, InputIterator first, InputIterator last, const key_compare &comp = key_compare())
 	        : c{}, compare{comp}
 	{
-		for (; first != last; ++first)
-		{
-			c.keys.insert(c.keys.end(), first->first);
-			c.values.insert(c.values.end(), first->second);
-		}
+		append(first, last);
 	}
 
-	// todo:
-	/// constructor with allocators
-	//    template <class InputIterator, class Alloc>
-	//    flat_map(InputIterator first, InputIterator last, const key_compare& comp, const Alloc& a)
-	//    {
-	//        assert(0);
-	//    }
-	//
-	//    template <class InputIterator, class Alloc>
-	//    flat_map(sorted_unique_t, InputIterator first, InputIterator last, const key_compare& comp, const Alloc& a)
-	//    {
-	//        assert(0);
-	//    }
-
-	//    template <class Alloc>
-	//    flat_map(key_container_type&& key_cont, mapped_container_type&& mapped_cont, const Alloc& a)
-	//                    : flat_map(key_container_type(std::move(key_cont), a),
-	//                               mapped_container_type(std::move(mapped_cont), a))
-	//    {
-	//    }
-	//    template <class Container, class Alloc>
-	//    flat_map(const Container& cont, const Alloc& a)
-	//                    : flat_map(cont.begin(), cont.end(), key_compare(), a)
-	//    {
-	//    }
-	//
-	//
-	//    template <class Alloc>
-	//    flat_map(sorted_unique_t s, key_container_type&& key_cont, mapped_container_type&& mapped_cont, const Alloc& a)
-	//                    : flat_map(s, key_container_type(std::move(key_cont), a),
-	//                               mapped_container_type(std::move(mapped_cont), a))
-	//    {
-	//    }
-	//
-	//    template <class Container, class Alloc>
-	//    flat_map(sorted_unique_t s, const Container& cont, const Alloc& a)
-	//                    : flat_map(s, cont.begin(), cont.end(), key_compare(), a)
-	//    {
-	//    }
-	//    template <class InputIterator, class Alloc>
-	//    flat_map(sorted_unique_t s, InputIterator first, InputIterator last, const Alloc& a)
-	//                    : flat_map(s, first, last, key_compare(), a)
-	//    {
-	//    }
-
-	//    flat_map(initializer_list<pair<key_type, mapped_type>> && il, const key_compare& comp = key_compare())
-	//                    : flat_map(il, comp)
-	//    {
-	//    }
-	//    template <class Alloc>
-	//    flat_map(initializer_list<pair<key_type, mapped_type>> && il, const key_compare& comp, const Alloc& a)
-	//                    : flat_map(il, comp, a)
-	//    {
-	//    }
-	//    template <class Alloc>
-	//    flat_map(initializer_list<pair<key_type, mapped_type>> && il, const Alloc& a)
-	//                    : flat_map(il, key_compare(), a)
-	//    {
-	//    }
-	flat_map(sorted_unique_t s, initializer_list<pair<key_type, mapped_type>> &&il, const key_compare &comp = key_compare())
+	flat_map(initializer_list<pair<key_type, mapped_type>> il, const key_compare &comp = key_compare())
+	        : flat_map(il.begin(), il.end(), comp)
+	{
+	}
+	flat_map(sorted_unique_t s, initializer_list<pair<key_type, mapped_type>> il,
+	         const key_compare &comp = key_compare())
 	        : flat_map(s, il.begin(), il.end(), comp)
 	{
 	}
-	// todo:
-#if 0
-    template <class Alloc>
-    flat_map(sorted_unique_t s, initializer_list<pair<key_type, mapped_type>> && il, const key_compare& comp,
-             const Alloc& a)
-                    : flat_map(s, il, comp, a)
-    {
-    }
-    template <class Alloc>
-    flat_map(sorted_unique_t s, initializer_list<pair<key_type, mapped_type>> && il, const Alloc& a)
-                    : flat_map(s, il, key_compare(), a)
-    {
-    }
-#endif
-	flat_map &operator=(initializer_list<pair<key_type, mapped_type>> il);
+
+	/// allocator-extended constructors
+	// Each constructor above has a counterpart taking allocator_arg and an allocator first, the allocator being used
+	// to construct the containers. They participate in overload resolution only if both containers use the allocator.
+	template <class Alloc, JASEL_REQUIRES(flat_map_detail::uses_allocator<KeyContainer, MappedContainer, Alloc>::value)>
+	flat_map(allocator_arg_t, const Alloc &a)
+	        : c{key_container_type(a), mapped_container_type(a)}, compare{}
+	{
+	}
+	template <class Alloc, JASEL_REQUIRES(flat_map_detail::uses_allocator<KeyContainer, MappedContainer, Alloc>::value)>
+	flat_map(allocator_arg_t, const Alloc &a, const key_compare &comp)
+	        : c{key_container_type(a), mapped_container_type(a)}, compare{comp}
+	{
+	}
+	template <class Alloc, JASEL_REQUIRES(flat_map_detail::uses_allocator<KeyContainer, MappedContainer, Alloc>::value)>
+	flat_map(allocator_arg_t, const Alloc &a, key_container_type &&key_cont, mapped_container_type &&mapped_cont)
+	        : c{key_container_type(std::move(key_cont), a), mapped_container_type(std::move(mapped_cont), a)}, compare{}
+	{
+		assert(c.keys.size() == c.values.size());
+		sort_and_unique_from(0, false);
+	}
+	template <class Container, class Alloc,
+	          JASEL_REQUIRES(flat_map_detail::uses_allocator<KeyContainer, MappedContainer, Alloc>::value)>
+	flat_map(allocator_arg_t, const Alloc &a, const Container &cont)
+	        : flat_map(allocator_arg, a, cont.begin(), cont.end(), key_compare())
+	{
+	}
+	template <class InputIterator, class Alloc,
+	          JASEL_REQUIRES(flat_map_detail::uses_allocator<KeyContainer, MappedContainer, Alloc>::value)>
+	flat_map(allocator_arg_t, const Alloc &a, InputIterator first, InputIterator last,
+	         const key_compare &comp = key_compare())
+	        : c{key_container_type(a), mapped_container_type(a)}, compare{comp}
+	{
+		append(first, last);
+		sort_and_unique_from(0, false);
+	}
+	template <class Alloc, JASEL_REQUIRES(flat_map_detail::uses_allocator<KeyContainer, MappedContainer, Alloc>::value)>
+	flat_map(allocator_arg_t, const Alloc &a, initializer_list<pair<key_type, mapped_type>> il,
+	         const key_compare &comp = key_compare())
+	        : flat_map(allocator_arg, a, il.begin(), il.end(), comp)
+	{
+	}
+	template <class Alloc, JASEL_REQUIRES(flat_map_detail::uses_allocator<KeyContainer, MappedContainer, Alloc>::value)>
+	flat_map(allocator_arg_t, const Alloc &a, sorted_unique_t, key_container_type &&key_cont,
+	         mapped_container_type &&mapped_cont)
+	        : c{key_container_type(std::move(key_cont), a), mapped_container_type(std::move(mapped_cont), a)}, compare{}
+	{
+		assert(c.keys.size() == c.values.size());
+	}
+	template <class Container, class Alloc,
+	          JASEL_REQUIRES(flat_map_detail::uses_allocator<KeyContainer, MappedContainer, Alloc>::value)>
+	flat_map(allocator_arg_t, const Alloc &a, sorted_unique_t s, const Container &cont)
+	        : flat_map(allocator_arg, a, s, cont.begin(), cont.end(), key_compare())
+	{
+	}
+	template <class InputIterator, class Alloc,
+	          JASEL_REQUIRES(flat_map_detail::uses_allocator<KeyContainer, MappedContainer, Alloc>::value)>
+	flat_map(allocator_arg_t, const Alloc &a, sorted_unique_t, InputIterator first, InputIterator last,
+	         const key_compare &comp = key_compare())
+	        : c{key_container_type(a), mapped_container_type(a)}, compare{comp}
+	{
+		append(first, last);
+	}
+	template <class Alloc, JASEL_REQUIRES(flat_map_detail::uses_allocator<KeyContainer, MappedContainer, Alloc>::value)>
+	flat_map(allocator_arg_t, const Alloc &a, sorted_unique_t s, initializer_list<pair<key_type, mapped_type>> il,
+	         const key_compare &comp = key_compare())
+	        : flat_map(allocator_arg, a, s, il.begin(), il.end(), comp)
+	{
+	}
+	template <class Alloc, JASEL_REQUIRES(flat_map_detail::uses_allocator<KeyContainer, MappedContainer, Alloc>::value)>
+	flat_map(allocator_arg_t, const Alloc &a, const flat_map &m)
+	        : c{key_container_type(m.c.keys, a), mapped_container_type(m.c.values, a)}, compare{m.compare}
+	{
+	}
+	template <class Alloc, JASEL_REQUIRES(flat_map_detail::uses_allocator<KeyContainer, MappedContainer, Alloc>::value)>
+	flat_map(allocator_arg_t, const Alloc &a, flat_map &&m)
+	        : c{key_container_type(std::move(m.c.keys), a), mapped_container_type(std::move(m.c.values), a)},
+	          compare{std::move(m.compare)}
+	{
+	}
+
+	flat_map &operator=(initializer_list<pair<key_type, mapped_type>> il)
+	{
+		clear();
+		insert(il);
+		return *this;
+	}
 
 	//// iterators
 	iterator begin() noexcept
@@ -1233,6 +1515,11 @@ public:
 	{
 		return (*try_emplace(move(x)).first).second;
 	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	mapped_type &operator[](K &&x)
+	{
+		return (*try_emplace(std::forward<K>(x)).first).second;
+	}
 	mapped_type &at(const key_type &k)
 	{
 		auto it = lower_bound(k);
@@ -1258,6 +1545,7 @@ public:
 		if (points_to(it, k))
 			return make_pair(it, false);
 
+		check_room(1);
 		auto nkey_it   = c.keys.emplace(it.key_it, std::move(t.first));
 		auto nvalue_it = c.values.emplace(it.value_it, std::move(t.second));
 		return std::make_pair(iterator{nkey_it, nvalue_it}, true);
@@ -1273,6 +1561,7 @@ public:
 		if (points_to(it, k))
 			return it;
 
+		check_room(1);
 		auto nkey_it   = c.keys.emplace(it.key_it, std::move(t.first));
 		auto nvalue_it = c.values.emplace(it.value_it, std::move(t.second));
 		return iterator{nkey_it, nvalue_it};
@@ -1309,18 +1598,24 @@ public:
 		return emplace_hint(position, std::forward<P>(x));
 	}
 
+	// The elements are appended to both containers, the new tail is sorted and then merged with the
+	// existing elements, so that inserting m elements costs O(m log m + size()) instead of O(m * size()).
+	// As for a sequence of insert(x), the first element with a given key wins.
 	template <class InputIterator>
 	void insert(InputIterator first, InputIterator last)
 	{
-		for (; first < last; ++first)
-			insert(*first);
+		auto const pos = size();
+		append(first, last);
+		sort_and_unique_from(pos, false);
 	}
 
+	// Same as above but [first, last) must be sorted and unique with respect to key_comp(), so the sort is skipped.
 	template <class InputIterator>
 	void insert(sorted_unique_t, InputIterator first, InputIterator last)
 	{
-		// todo : optimize
-		insert(first, last);
+		auto const pos = size();
+		append(first, last);
+		sort_and_unique_from(pos, true);
 	}
 
 	void insert(initializer_list<pair<key_type, mapped_type>> il)
@@ -1328,10 +1623,9 @@ public:
 		insert(il.begin(), il.end());
 	}
 
-	void insert(sorted_unique_t, initializer_list<pair<key_type, mapped_type>> il)
+	void insert(sorted_unique_t s, initializer_list<pair<key_type, mapped_type>> il)
 	{
-		// todo : optimize
-		insert(il.begin(), il.end());
+		insert(s, il.begin(), il.end());
 	}
 
 	void replace(key_container_type &&key_cont, mapped_container_type &&mapped_cont)
@@ -1344,24 +1638,22 @@ public:
 	template <class... Args>
 	pair<iterator, bool> try_emplace(const key_type &k, Args &&... args)
 	{
-		auto it = lower_bound(k);
-		if (points_to(it, k))
-			return std::make_pair(it, false);
-
-		auto nkey_it   = c.keys.insert(it.key_it, k);
-		auto nvalue_it = c.values.emplace(it.value_it, std::forward<Args>(args)...);
-		return std::make_pair(iterator{nkey_it, nvalue_it}, true);
+		return try_emplace_impl(k, std::forward<Args>(args)...);
 	}
 
 	template <class... Args>
 	pair<iterator, bool> try_emplace(key_type &&k, Args &&... args)
 	{
-		auto it = lower_bound(move(k));
-		if (points_to(it, k))
-			return std::make_pair(it, false);
-		auto nkey_it   = c.keys.insert(it.key_it, k);
-		auto nvalue_it = c.values.emplace(it.value_it, std::forward<Args>(args)...);
-		return std::make_pair(iterator{nkey_it, nvalue_it}, true);
+		return try_emplace_impl(move(k), std::forward<Args>(args)...);
+	}
+
+	// The key_type is constructed from k only if the element is inserted.
+	template <class K, class... Args, class C = Compare,
+	          JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value && is_constructible<key_type, K>::value &&
+	                         !is_convertible<K &&, const_iterator>::value && !is_convertible<K &&, iterator>::value)>
+	pair<iterator, bool> try_emplace(K &&k, Args &&... args)
+	{
+		return try_emplace_impl(std::forward<K>(k), std::forward<Args>(args)...);
 	}
 
 	template <class... Args>
@@ -1369,13 +1661,7 @@ public:
 	{
 		// todo: don't ignore the hint
 		(void)hint;
-		auto it = lower_bound(k);
-		if (points_to(it, k))
-			return std::make_pair(it, false);
-
-		auto nkey_it   = c.keys.insert(it.key_it, k);
-		auto nvalue_it = c.values.emplace(it.value_it, std::forward<Args>(args)...);
-		return std::make_pair(iterator{nkey_it, nvalue_it}, true);
+		return try_emplace_impl(k, std::forward<Args>(args)...).first;
 	}
 
 	template <class... Args>
@@ -1383,13 +1669,18 @@ public:
 	{
 		// todo: don't ignore the hint
 		(void)hint;
-		auto it = lower_bound(move(k));
-		if (points_to(it, k))
-			return std::make_pair(it, false);
-		auto nkey_it   = c.keys.insert(it.key_it, k);
-		auto nvalue_it = c.values.emplace(it.value_it, std::forward<Args>(args)...);
-		return std::make_pair(iterator{nkey_it, nvalue_it}, true);
+		return try_emplace_impl(move(k), std::forward<Args>(args)...).first;
 	}
+
+	template <class K, class... Args, class C = Compare,
+	          JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value && is_constructible<key_type, K>::value)>
+	iterator try_emplace(const_iterator hint, K &&k, Args &&... args)
+	{
+		// todo: don't ignore the hint
+		(void)hint;
+		return try_emplace_impl(std::forward<K>(k), std::forward<Args>(args)...).first;
+	}
+
 	template <class M>
 	pair<iterator, bool> insert_or_assign(const key_type &k, M &&obj)
 	{
@@ -1400,6 +1691,7 @@ public:
 			return std::make_pair(it, false);
 		}
 
+		check_room(1);
 		auto nkey_it   = c.keys.insert(it.key_it, k);
 		auto nvalue_it = c.values.emplace(it.value_it, std::forward<M>(obj));
 		return std::make_pair(iterator{nkey_it, nvalue_it}, true);
@@ -1415,6 +1707,7 @@ public:
 			return std::make_pair(it, false);
 		}
 
+		check_room(1);
 		auto nkey_it   = c.keys.insert(it.key_it, move(k));
 		auto nvalue_it = c.values.emplace(it.value_it, std::forward<M>(obj));
 		return std::make_pair(iterator{nkey_it, nvalue_it}, true);
@@ -1422,18 +1715,13 @@ public:
 
 	iterator erase(iterator position)
 	{
-		iterator res;
-		res.key_it   = c.keys.erase(position.key_it);
-		res.value_it = c.values.erase(position.value_it);
-		return res;
+		return erase(const_iterator(position));
 	}
-
 	iterator erase(const_iterator position)
 	{
-		iterator res;
-		res.key_it   = c.keys.erase(position.key_it);
-		res.value_it = c.values.erase(position.value_it);
-		return res;
+		auto key_it   = c.keys.erase(position.key_it);
+		auto value_it = c.values.erase(position.value_it);
+		return iterator{key_it, value_it};
 	}
 
 	size_type erase(const key_type &k)
@@ -1447,14 +1735,33 @@ public:
 		return 0;
 	}
 
-	// todo:
-	//    iterator erase(const_iterator first, const_iterator last);
+	iterator erase(const_iterator first, const_iterator last)
+	{
+		auto key_it   = c.keys.erase(first.key_it, last.key_it);
+		auto value_it = c.values.erase(first.value_it, last.value_it);
+		return iterator{key_it, value_it};
+	}
+
+	// Erases the elements whose key is in the range xs, a container or a span of keys, moving each remaining element
+	// at most once.
+	// When xs is sorted with respect to key_comp() nothing is allocated; otherwise the keys are sorted in a copy.
+	// Returns the number of erased elements.
+	template <class KeyRange>
+	size_type erase_keys(const KeyRange &xs)
+	{
+		if (std::is_sorted(xs.begin(), xs.end(), compare))
+			return flat_map_detail::erase_sorted_keys(c.keys, c.values, compare, xs.begin(), xs.end());
+		std::vector<typename iterator_traits<decltype(xs.begin())>::value_type> sorted(xs.begin(), xs.end());
+		std::sort(sorted.begin(), sorted.end(), compare);
+		return flat_map_detail::erase_sorted_keys(c.keys, c.values, compare, sorted.cbegin(), sorted.cend());
+	}
 
+	// The containers are moved out, not swapped, so that they keep their allocators.
 	containers extract() &&
 	{
-		containers temp;
-		temp.keys.swap(c.keys);
-		temp.values.swap(c.values);
+		containers temp{std::move(c.keys), std::move(c.values)};
+		c.keys.clear();
+		c.values.clear();
 		return temp;
 	}
 
@@ -1463,7 +1770,7 @@ public:
 		using std::swap;
 		swap(c.keys, fm.c.keys);
 		swap(c.values, fm.c.values);
-		swap(c.compare, fm.compare);
+		swap(compare, fm.compare);
 	}
 
 	void clear() noexcept
@@ -1472,17 +1779,35 @@ public:
 		c.values.clear();
 	}
 
-	// todo:
-	//    template <class C2>
-	//    void merge(flat_map<key_type, mapped_type, C2, key_container_type, mapped_container_type>& source)
-	//    {
-	//        flat_map res;
-	//        std::merge(c.keys.begin(), c.keys.end(), source.c.keys.begin(), source.c.keys.end()
-	//                   back_inserter(res));
-	//        *this = res;
-	//    }
-	//    template <class C2>
-	//    void merge(flat_map<key_type, mapped_type, C2, key_container_type, mapped_container_type> && source);
+	// Moves the elements of source whose key is not in *this, in a single merge pass when both use the same
+	// comparator. The other elements stay in source.
+	template <class C2>
+	void merge(flat_map<key_type, mapped_type, C2, key_container_type, mapped_container_type> &source)
+	{
+		if (static_cast<void *>(&source) == this)
+			return;
+		// All the elements of source are appended before the duplicates are moved back.
+		check_room(source.size());
+		auto const pos = size();
+		auto       src = std::move(source).extract();
+		c.keys.insert(c.keys.end(), make_move_iterator(src.keys.begin()), make_move_iterator(src.keys.end()));
+		c.values.insert(c.values.end(), make_move_iterator(src.values.begin()), make_move_iterator(src.values.end()));
+		src.keys.clear();
+		src.values.clear();
+		auto const first =
+		        flat_map_detail::sort_from(c.keys, c.values, compare, pos, is_same<C2, key_compare>::value);
+		flat_map_detail::unique_from(c.keys, c.values, compare, first,
+		                             flat_map_detail::push_back_to<key_container_type, mapped_container_type>{
+		                                     &src.keys, &src.values});
+		if (!is_same<C2, key_compare>::value)
+			(void)flat_map_detail::sort_from(src.keys, src.values, source.key_comp(), 0, false);
+		source.replace(std::move(src.keys), std::move(src.values));
+	}
+	template <class C2>
+	void merge(flat_map<key_type, mapped_type, C2, key_container_type, mapped_container_type> &&source)
+	{
+		merge(source);
+	}
 
 	//// observers
 	key_compare   key_comp() const { return compare; }
@@ -1513,111 +1838,252 @@ public:
 		return end();
 	}
 
-// todo:
-// Compare::is_transparent
-#if 0
-    template <class K>
-    // requires Compare::is_transparent
-    iterator find(const K& x)
-    {
-        auto it = lower_bound(x);
-        if (points_to(it, x)) return it;
-        return end();
-    }
-
-    template <class K>
-    // requires Compare::is_transparent
-    const_iterator find(const K& x) const
-    {
-        auto it = lower_bound(x);
-        if (points_to(it, x)) return it;
-        return end();
-    }
-#endif
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	iterator find(const K &x)
+	{
+		auto it = lower_bound(x);
+		if (points_to(it, x))
+			return it;
+		return end();
+	}
+
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	const_iterator find(const K &x) const
+	{
+		auto it = lower_bound(x);
+		if (points_to(it, x))
+			return it;
+		return end();
+	}
 
 	size_type count(const key_type &x) const
 	{
 		return contains(x) ? 1 : 0;
 	}
-	//    template <class K> size_type count(const K& x) const;
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	size_type count(const K &x) const
+	{
+		// there could be several keys equivalent to x
+		auto rng = equal_range(x);
+		return static_cast<size_type>(rng.second - rng.first);
+	}
 
 	bool contains(const key_type &x) const
 	{
-		//todo: optimize
-#if 0
-        return find(x) != end();
-#else
 		auto it = lower_bound(x);
 		return points_to(it, x);
-#endif
 	}
-
-	// todo:
-	//    template <class K> bool contains(const K& x) const;
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	bool contains(const K &x) const
+	{
+		auto it = lower_bound(x);
+		return points_to(it, x);
+	}
 
 	iterator lower_bound(const key_type &x)
 	{
-		auto key_it   = std::lower_bound(c.keys.begin(), c.keys.end(), x, compare);
-		auto value_it = c.values.begin() + distance(c.keys.begin(), key_it);
-		return iterator{key_it, value_it};
+		return lower_bound_impl(x);
 	}
-
 	const_iterator lower_bound(const key_type &x) const
 	{
-		auto key_it   = std::lower_bound(c.keys.begin(), c.keys.end(), x, compare);
-		auto value_it = c.values.begin() + distance(c.keys.begin(), key_it);
-		return const_iterator{key_it, value_it};
+		return lower_bound_impl(x);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	iterator lower_bound(const K &x)
+	{
+		return lower_bound_impl(x);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	const_iterator lower_bound(const K &x) const
+	{
+		return lower_bound_impl(x);
 	}
-
-	// todo:
-	//    template <class K> iterator lower_bound(const K& x);
-	//    template <class K> const_iterator lower_bound(const K& x) const;
 
 	iterator upper_bound(const key_type &x)
 	{
-		auto key_it   = std::upper_bound(c.keys.begin(), c.keys.end(), x, compare);
-		auto value_it = c.values.begin() + distance(c.keys.begin(), key_it);
-		return iterator{key_it, value_it};
+		return upper_bound_impl(x);
 	}
 	const_iterator upper_bound(const key_type &x) const
 	{
-		auto const key_it   = std::upper_bound(c.keys.begin(), c.keys.end(), x, compare);
-		auto const value_it = c.values.begin() + distance(c.keys.begin(), key_it);
-		return const_iterator{key_it, value_it};
+		return upper_bound_impl(x);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	iterator upper_bound(const K &x)
+	{
+		return upper_bound_impl(x);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	const_iterator upper_bound(const K &x) const
+	{
+		return upper_bound_impl(x);
 	}
-
-	// todo:
-	//    template <class K> iterator upper_bound(const K& x);
-	//    template <class K> const_iterator upper_bound(const K& x) const;
 
 	pair<iterator, iterator> equal_range(const key_type &x)
 	{
-		auto       key_pit   = std::equal_range(c.keys.begin(), c.keys.end(), x, compare);
-		auto const value_fit = c.values.begin() + distance(c.keys.begin(), key_pit.first);
-		auto const value_sit = c.values.begin() + distance(c.keys.begin(), key_pit.second);
-		return make_pair(iterator{key_pit.first, value_fit}, iterator{key_pit.second, value_sit});
+		return equal_range_impl(x);
 	}
-
 	pair<const_iterator, const_iterator> equal_range(const key_type &x) const
 	{
-		auto       key_pit   = std::equal_range(c.keys.begin(), c.keys.end(), x, compare);
-		auto const value_fit = c.values.begin() + distance(c.keys.begin(), key_pit.first);
-		auto const value_sit = c.values.begin() + distance(c.keys.begin(), key_pit.second);
-		return make_pair(const_iterator{key_pit.first, value_fit}, const_iterator{key_pit.second, value_sit});
+		return equal_range_impl(x);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	pair<iterator, iterator> equal_range(const K &x)
+	{
+		return equal_range_impl(x);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	pair<const_iterator, const_iterator> equal_range(const K &x) const
+	{
+		return equal_range_impl(x);
+	}
+
+	// batched lookups
+	// xs is a container or a span of keys.
+	// Write for each key x of the range xs, in order, the result of lower_bound(x) or find(x) to out, as an iterator
+	// or as an index in keys(), size() meaning end().
+	// Keys sorted with respect to key_comp() are resolved in a single walk of the key column; otherwise the binary
+	// searches of consecutive keys are interleaved.
+	template <class KeyRange, class OutputIterator>
+	OutputIterator lower_bound_batch(const KeyRange &xs, OutputIterator out) const
+	{
+		return batch<false, false>(xs, out);
+	}
+	template <class KeyRange, class OutputIterator>
+	OutputIterator lower_bound_index_batch(const KeyRange &xs, OutputIterator out) const
+	{
+		return batch<false, true>(xs, out);
+	}
+	template <class KeyRange, class OutputIterator>
+	OutputIterator find_batch(const KeyRange &xs, OutputIterator out) const
+	{
+		return batch<true, false>(xs, out);
+	}
+	template <class KeyRange, class OutputIterator>
+	OutputIterator find_index_batch(const KeyRange &xs, OutputIterator out) const
+	{
+		return batch<true, true>(xs, out);
 	}
-	// todo:
-	//    template <class K>
-	//    pair<iterator, iterator> equal_range(const K& x);
-	//    template <class K>
-	//    pair<const_iterator, const_iterator> equal_range(const K& x) const;
 
 private:
-	bool points_to(iterator const &it, const key_type &x)
+	template <class InputIterator>
+	void append(InputIterator first, InputIterator last)
+	{
+		flat_map_detail::append(c.keys, c.values, first, last, max_size(), "flat_map capacity exceeded");
+	}
+	void check_room(size_type n) const
+	{
+		flat_map_detail::check_room(size(), max_size(), n, "flat_map capacity exceeded");
+	}
+
+	// Restores the class invariant when [0, pos) is sorted and unique and [pos, size()) has been appended.
+	// When sorted is true, [pos, size()) is already sorted.
+	void sort_and_unique_from(size_type pos, bool sorted)
+	{
+		auto const first = flat_map_detail::sort_from(c.keys, c.values, compare, pos, sorted);
+		flat_map_detail::unique_from(c.keys, c.values, compare, first, flat_map_detail::discard{});
+	}
+
+	template <class OutputIterator, bool Find, bool Index>
+	struct batch_sink
+	{
+		flat_map const *self;
+		OutputIterator *out;
+		template <class K>
+		void operator()(const K &x, key_const_iterator_type it) const
+		{
+			if (Find && !(it != self->c.keys.end() && !self->compare(x, *it)))
+				it = self->c.keys.end();
+			put(static_cast<size_type>(it - self->c.keys.begin()), integral_constant<bool, Index>{});
+		}
+		void put(size_type i, true_type) const
+		{
+			*(*out)++ = i;
+		}
+		void put(size_type i, false_type) const
+		{
+			*(*out)++ = self->cbegin() + difference_type(i);
+		}
+	};
+	template <bool Find, bool Index, class KeyRange, class OutputIterator>
+	OutputIterator batch(const KeyRange &xs, OutputIterator out) const
+	{
+		// the members, as the free begin(span) takes the span by value and its iterators would refer to the copy
+		flat_map_detail::batch_lower_bounds(c.keys.begin(), c.keys.end(), xs.begin(), xs.end(), compare,
+		                                    batch_sink<OutputIterator, Find, Index>{this, &out});
+		return out;
+	}
+
+	template <class K, class... Args>
+	pair<iterator, bool> try_emplace_impl(K &&k, Args &&... args)
+	{
+		auto it = lower_bound(k);
+		if (points_to(it, k))
+			return std::make_pair(it, false);
+
+		check_room(1);
+		auto nkey_it   = c.keys.emplace(it.key_it, std::forward<K>(k));
+		auto nvalue_it = c.values.emplace(it.value_it, std::forward<Args>(args)...);
+		return std::make_pair(iterator{nkey_it, nvalue_it}, true);
+	}
+
+	template <class K>
+	iterator lower_bound_impl(const K &x)
+	{
+		return flat_map_detail::lower_bound<iterator, search_policy>(c, compare, x);
+	}
+	template <class K>
+	const_iterator lower_bound_impl(const K &x) const
+	{
+		return flat_map_detail::lower_bound<const_iterator, search_policy>(c, compare, x);
+	}
+
+	template <class K>
+	iterator upper_bound_impl(const K &x)
+	{
+		return flat_map_detail::upper_bound<iterator, search_policy>(c, compare, x);
+	}
+	template <class K>
+	const_iterator upper_bound_impl(const K &x) const
+	{
+		return flat_map_detail::upper_bound<const_iterator, search_policy>(c, compare, x);
+	}
+
+	template <class K>
+	pair<iterator, iterator> equal_range_impl(const K &x)
+	{
+		return flat_map_detail::range_at<iterator>(c, equal_range_keys(x));
+	}
+	template <class K>
+	pair<const_iterator, const_iterator> equal_range_impl(const K &x) const
+	{
+		return flat_map_detail::range_at<const_iterator>(c, equal_range_keys(x));
+	}
+
+	// The keys are unique, so the range of a key_type has at most one element.
+	pair<typename key_container_type::const_iterator, typename key_container_type::const_iterator>
+	equal_range_keys(const key_type &x) const
+	{
+		auto const first = search_policy::lower_bound(c.keys.begin(), c.keys.end(), x, compare);
+		auto const last  = (first != c.keys.end() && !compare(x, *first)) ? first + 1 : first;
+		return make_pair(first, last);
+	}
+	// A heterogeneous x can be equivalent to several keys.
+	template <class K>
+	pair<typename key_container_type::const_iterator, typename key_container_type::const_iterator>
+	equal_range_keys(const K &x) const
+	{
+		auto const first = search_policy::lower_bound(c.keys.begin(), c.keys.end(), x, compare);
+		return make_pair(first, search_policy::upper_bound(first, c.keys.end(), x, compare));
+	}
+
+	template <class K>
+	bool points_to(iterator const &it, const K &x)
 	{
 		auto const key_it = it.key_it;
 		return (key_it != c.keys.end() && compare(x, *key_it) == 0);
 	}
-	bool points_to(const_iterator const &it, const key_type &x) const
+	template <class K>
+	bool points_to(const_iterator const &it, const K &x) const
 	{
 		auto const key_it = it.key_it;
 		return (key_it != c.keys.end() && compare(x, *key_it) == 0);
@@ -1633,6 +2099,31 @@ void swap(flat_map<Key, T, Compare, KeyContainer, MappedContainer> &x,
 	x.swap(y);
 }
 
+// Erases the elements e for which pred(e) is true, in a single stable pass over both containers.
+// On exception from pred, m keeps the elements not erased yet.
+// Returns the number of erased elements.
+template <class Key, class T, class Compare, class KeyContainer, class MappedContainer, class Predicate>
+typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::size_type
+erase_if(flat_map<Key, T, Compare, KeyContainer, MappedContainer> &m, Predicate pred)
+{
+	using const_reference = typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::const_reference;
+	auto   cont = std::move(m).extract();
+	size_t n    = 0;
+	try
+	{
+		n = flat_map_detail::compact(cont.keys, cont.values, [&](size_t i) {
+			return bool(pred(const_reference{cont.keys[i], cont.values[i]}));
+		});
+	}
+	catch (...)
+	{
+		m.replace(std::move(cont.keys), std::move(cont.values));
+		throw;
+	}
+	m.replace(std::move(cont.keys), std::move(cont.values));
+	return n;
+}
+
 } // namespace fundamental_v3
 } // namespace experimental
 } // namespace std
@@ -0,0 +1,652 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Vicente J. Botet Escriba 2019.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file // LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef JASEL_FUNDAMENTAL_V3_FLAT_MAP_FLAT_MULTIMAP_HPP
+#define JASEL_FUNDAMENTAL_V3_FLAT_MAP_FLAT_MULTIMAP_HPP
+
+#include <experimental/fundamental/v3/flat_map/flat_map.hpp>
+
+namespace std
+{
+namespace experimental
+{
+inline namespace fundamental_v3
+{
+
+template <class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+class flat_multimap {
+public:
+	// types:
+	using key_container_type          = KeyContainer;
+	using mapped_container_type       = MappedContainer;
+	using key_iterator_type           = typename key_container_type::iterator;
+	using key_const_iterator_type     = typename key_container_type::const_iterator;
+	using mapped_iterator_type        = typename mapped_container_type::iterator;
+	using mapped_const_iterator_type  = typename mapped_container_type::const_iterator;
+	using key_type                    = typename key_container_type::value_type;
+	using mapped_type                 = typename mapped_container_type::value_type;
+	using key_reference_type          = typename key_container_type::reference;
+	using key_const_reference_type    = typename key_container_type::const_reference;
+	using mapped_reference_type       = typename mapped_container_type::reference;
+	using mapped_const_reference_type = typename mapped_container_type::const_reference;
+
+	using key_compare = Compare;
+
+	using value_type      = pair<const key_type, mapped_type>;
+	using reference       = pair<key_const_reference_type, mapped_reference_type>;
+	using const_reference = pair<key_const_reference_type, mapped_const_reference_type>;
+	using pointer         = arrow_proxy<reference>;
+	using const_pointer   = arrow_proxy<const_reference>;
+	using size_type       = size_t;
+	using difference_type = ptrdiff_t;
+
+	class value_compare {
+		friend class flat_multimap;
+
+	protected:
+		key_compare comp;
+		value_compare(key_compare c)
+		        : comp(c)
+		{
+		}
+
+	public:
+		bool operator()(const_reference x, const_reference y) const
+		{
+			return comp(x.first, y.first);
+		}
+	};
+
+	using iterator               = flat_map_iterator<key_const_iterator_type, mapped_iterator_type>;
+	using const_iterator         = flat_map_iterator<key_const_iterator_type, mapped_const_iterator_type>;
+	using reverse_iterator       = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	struct containers
+	{
+		key_container_type    keys;
+		mapped_container_type values;
+	};
+
+	// 26.6.9.2, construct/copy/destroy
+	flat_multimap() {}
+	explicit flat_multimap(const key_compare &comp)
+	        : c{}, compare{comp}
+	{
+	}
+
+	flat_multimap(key_container_type &&key_cont, mapped_container_type &&mapped_cont)
+	        : c{move(key_cont), move(mapped_cont)}, compare{}
+	{
+		assert(c.keys.size() == c.values.size());
+		sort_from(0, false);
+	}
+	template <class InputIterator>
+	flat_multimap(InputIterator first, InputIterator last, const key_compare &comp = key_compare())
+	        : c{}, compare{comp}
+	{
+		append(first, last);
+		sort_from(0, false);
+	}
+
+	template <class Container>
+	explicit flat_multimap(const Container &cont)
+	        : flat_multimap(cont.begin(), cont.end(), key_compare())
+	{
+	}
+
+	flat_multimap(initializer_list<pair<key_type, mapped_type>> &&il, const key_compare &comp = key_compare())
+	        : flat_multimap(il.begin(), il.end(), comp)
+	{
+	}
+
+	/// sorted_equivalent_t constructors
+	////////////////////
+	flat_multimap(sorted_equivalent_t, key_container_type &&key_cont, mapped_container_type &&mapped_cont)
+	        : c{move(key_cont), move(mapped_cont)}, compare{}
+	{
+		assert(c.keys.size() == c.values.size());
+	}
+	template <class Container>
+	flat_multimap(sorted_equivalent_t s, const Container &cont)
+	        : flat_multimap(s, cont.begin(), cont.end(), key_compare())
+	{
+	}
+
+	template <class InputIterator>
+	flat_multimap(sorted_equivalent_t, InputIterator first, InputIterator last, const key_compare &comp = key_compare())
+	        : c{}, compare{comp}
+	{
+		append(first, last);
+	}
+
+	flat_multimap(sorted_equivalent_t s, initializer_list<pair<key_type, mapped_type>> &&il,
+	              const key_compare &comp = key_compare())
+	        : flat_multimap(s, il.begin(), il.end(), comp)
+	{
+	}
+
+	/// allocator-extended constructors
+	// Each constructor above has a counterpart taking allocator_arg and an allocator first, the allocator being used
+	// to construct the containers. They participate in overload resolution only if both containers use the allocator.
+	template <class Alloc, JASEL_REQUIRES(flat_map_detail::uses_allocator<KeyContainer, MappedContainer, Alloc>::value)>
+	flat_multimap(allocator_arg_t, const Alloc &a)
+	        : c{key_container_type(a), mapped_container_type(a)}, compare{}
+	{
+	}
+	template <class Alloc, JASEL_REQUIRES(flat_map_detail::uses_allocator<KeyContainer, MappedContainer, Alloc>::value)>
+	flat_multimap(allocator_arg_t, const Alloc &a, const key_compare &comp)
+	        : c{key_container_type(a), mapped_container_type(a)}, compare{comp}
+	{
+	}
+	template <class Alloc, JASEL_REQUIRES(flat_map_detail::uses_allocator<KeyContainer, MappedContainer, Alloc>::value)>
+	flat_multimap(allocator_arg_t, const Alloc &a, key_container_type &&key_cont, mapped_container_type &&mapped_cont)
+	        : c{key_container_type(std::move(key_cont), a), mapped_container_type(std::move(mapped_cont), a)}, compare{}
+	{
+		assert(c.keys.size() == c.values.size());
+		sort_from(0, false);
+	}
+	template <class Container, class Alloc,
+	          JASEL_REQUIRES(flat_map_detail::uses_allocator<KeyContainer, MappedContainer, Alloc>::value)>
+	flat_multimap(allocator_arg_t, const Alloc &a, const Container &cont)
+	        : flat_multimap(allocator_arg, a, cont.begin(), cont.end(), key_compare())
+	{
+	}
+	template <class InputIterator, class Alloc,
+	          JASEL_REQUIRES(flat_map_detail::uses_allocator<KeyContainer, MappedContainer, Alloc>::value)>
+	flat_multimap(allocator_arg_t, const Alloc &a, InputIterator first, InputIterator last,
+	              const key_compare &comp = key_compare())
+	        : c{key_container_type(a), mapped_container_type(a)}, compare{comp}
+	{
+		append(first, last);
+		sort_from(0, false);
+	}
+	template <class Alloc, JASEL_REQUIRES(flat_map_detail::uses_allocator<KeyContainer, MappedContainer, Alloc>::value)>
+	flat_multimap(allocator_arg_t, const Alloc &a, initializer_list<pair<key_type, mapped_type>> il,
+	              const key_compare &comp = key_compare())
+	        : flat_multimap(allocator_arg, a, il.begin(), il.end(), comp)
+	{
+	}
+	template <class Alloc, JASEL_REQUIRES(flat_map_detail::uses_allocator<KeyContainer, MappedContainer, Alloc>::value)>
+	flat_multimap(allocator_arg_t, const Alloc &a, sorted_equivalent_t, key_container_type &&key_cont,
+	              mapped_container_type &&mapped_cont)
+	        : c{key_container_type(std::move(key_cont), a), mapped_container_type(std::move(mapped_cont), a)}, compare{}
+	{
+		assert(c.keys.size() == c.values.size());
+	}
+	template <class Container, class Alloc,
+	          JASEL_REQUIRES(flat_map_detail::uses_allocator<KeyContainer, MappedContainer, Alloc>::value)>
+	flat_multimap(allocator_arg_t, const Alloc &a, sorted_equivalent_t s, const Container &cont)
+	        : flat_multimap(allocator_arg, a, s, cont.begin(), cont.end(), key_compare())
+	{
+	}
+	template <class InputIterator, class Alloc,
+	          JASEL_REQUIRES(flat_map_detail::uses_allocator<KeyContainer, MappedContainer, Alloc>::value)>
+	flat_multimap(allocator_arg_t, const Alloc &a, sorted_equivalent_t, InputIterator first, InputIterator last,
+	              const key_compare &comp = key_compare())
+	        : c{key_container_type(a), mapped_container_type(a)}, compare{comp}
+	{
+		append(first, last);
+	}
+	template <class Alloc, JASEL_REQUIRES(flat_map_detail::uses_allocator<KeyContainer, MappedContainer, Alloc>::value)>
+	flat_multimap(allocator_arg_t, const Alloc &a, sorted_equivalent_t s,
+	              initializer_list<pair<key_type, mapped_type>> il, const key_compare &comp = key_compare())
+	        : flat_multimap(allocator_arg, a, s, il.begin(), il.end(), comp)
+	{
+	}
+	template <class Alloc, JASEL_REQUIRES(flat_map_detail::uses_allocator<KeyContainer, MappedContainer, Alloc>::value)>
+	flat_multimap(allocator_arg_t, const Alloc &a, const flat_multimap &m)
+	        : c{key_container_type(m.c.keys, a), mapped_container_type(m.c.values, a)}, compare{m.compare}
+	{
+	}
+	template <class Alloc, JASEL_REQUIRES(flat_map_detail::uses_allocator<KeyContainer, MappedContainer, Alloc>::value)>
+	flat_multimap(allocator_arg_t, const Alloc &a, flat_multimap &&m)
+	        : c{key_container_type(std::move(m.c.keys), a), mapped_container_type(std::move(m.c.values), a)},
+	          compare{std::move(m.compare)}
+	{
+	}
+
+	flat_multimap &operator=(initializer_list<pair<key_type, mapped_type>> il)
+	{
+		clear();
+		insert(il);
+		return *this;
+	}
+
+	//// iterators
+	iterator begin() noexcept
+	{
+		return iterator{c.keys.begin(), c.values.begin()};
+	}
+	const_iterator begin() const noexcept
+	{
+		return const_iterator{c.keys.begin(), c.values.begin()};
+	}
+	iterator end() noexcept
+	{
+		return iterator{c.keys.end(), c.values.end()};
+	}
+	const_iterator end() const noexcept
+	{
+		return const_iterator{c.keys.end(), c.values.end()};
+	}
+	reverse_iterator rbegin() noexcept
+	{
+		return reverse_iterator{end()};
+	}
+	const_reverse_iterator rbegin() const noexcept
+	{
+		return const_reverse_iterator{end()};
+	}
+	reverse_iterator rend() noexcept
+	{
+		return reverse_iterator{begin()};
+	}
+	const_reverse_iterator rend() const noexcept
+	{
+		return const_reverse_iterator{begin()};
+	}
+	const_iterator cbegin() const noexcept
+	{
+		return const_iterator{c.keys.cbegin(), c.values.cbegin()};
+	}
+	const_iterator cend() const noexcept
+	{
+		return const_iterator{c.keys.cend(), c.values.cend()};
+	}
+	const_reverse_iterator crbegin() const noexcept
+	{
+		return const_reverse_iterator{cend()};
+	}
+	const_reverse_iterator crend() const noexcept
+	{
+		return const_reverse_iterator{cbegin()};
+	}
+
+	// capacity
+	//[[nodiscard]]
+	bool      empty() const noexcept { return c.keys.empty(); }
+	size_type size() const noexcept { return c.keys.size(); }
+	size_type max_size() const noexcept { return std::min<size_type>(c.keys.max_size(), c.values.max_size()); }
+
+	// 26.6.9.4, modifiers
+	// The new element is inserted after the elements with an equivalent key.
+	template <class... Args>
+	iterator emplace(Args &&... args)
+	{
+		pair<key_type, mapped_type> t(std::forward<Args>(args)...);
+		return insert_at(upper_bound(t.first), std::move(t));
+	}
+	// The new element is inserted as close as possible to the position just prior to position.
+	template <class... Args>
+	iterator emplace_hint(const_iterator position, Args &&... args)
+	{
+		pair<key_type, mapped_type> t(std::forward<Args>(args)...);
+		if (position != cend() && compare(*position.key_it, t.first))
+			return insert_at(lower_bound(t.first), std::move(t));
+		if (position != cbegin() && compare(t.first, *(position.key_it - 1)))
+			return insert_at(upper_bound(t.first), std::move(t));
+		return insert_at(position, std::move(t));
+	}
+
+	iterator insert(const value_type &x)
+	{
+		return emplace(x);
+	}
+	iterator insert(value_type &&x)
+	{
+		return emplace(move(x));
+	}
+	template <class P>
+	iterator insert(P &&x)
+	{
+		return emplace(std::forward<P>(x));
+	}
+	iterator insert(const_iterator position, const value_type &x)
+	{
+		return emplace_hint(position, x);
+	}
+	iterator insert(const_iterator position, value_type &&x)
+	{
+		return emplace_hint(position, move(x));
+	}
+	template <class P>
+	iterator insert(const_iterator position, P &&x)
+	{
+		return emplace_hint(position, std::forward<P>(x));
+	}
+
+	// See flat_map::insert(InputIterator, InputIterator). The elements with equivalent keys keep their relative order.
+	template <class InputIterator>
+	void insert(InputIterator first, InputIterator last)
+	{
+		auto const pos = size();
+		append(first, last);
+		sort_from(pos, false);
+	}
+	template <class InputIterator>
+	void insert(sorted_equivalent_t, InputIterator first, InputIterator last)
+	{
+		auto const pos = size();
+		append(first, last);
+		sort_from(pos, true);
+	}
+	void insert(initializer_list<pair<key_type, mapped_type>> il)
+	{
+		insert(il.begin(), il.end());
+	}
+	void insert(sorted_equivalent_t s, initializer_list<pair<key_type, mapped_type>> il)
+	{
+		insert(s, il.begin(), il.end());
+	}
+
+	containers extract() &&
+	{
+		containers temp{std::move(c.keys), std::move(c.values)};
+		c.keys.clear();
+		c.values.clear();
+		return temp;
+	}
+	// key_cont must be sorted with respect to key_comp().
+	void replace(key_container_type &&key_cont, mapped_container_type &&mapped_cont)
+	{
+		assert(key_cont.size() == mapped_cont.size());
+		c.keys   = std::move(key_cont);
+		c.values = std::move(mapped_cont);
+	}
+
+	iterator erase(iterator position)
+	{
+		return erase(const_iterator(position));
+	}
+	iterator erase(const_iterator position)
+	{
+		auto key_it   = c.keys.erase(position.key_it);
+		auto value_it = c.values.erase(position.value_it);
+		return iterator{key_it, value_it};
+	}
+	size_type erase(const key_type &x)
+	{
+		auto rng = equal_range(x);
+		auto n   = static_cast<size_type>(rng.second - rng.first);
+		erase(rng.first, rng.second);
+		return n;
+	}
+	iterator erase(const_iterator first, const_iterator last)
+	{
+		auto key_it   = c.keys.erase(first.key_it, last.key_it);
+		auto value_it = c.values.erase(first.value_it, last.value_it);
+		return iterator{key_it, value_it};
+	}
+
+	void swap(flat_multimap &fm) noexcept
+	{
+		using std::swap;
+		swap(c.keys, fm.c.keys);
+		swap(c.values, fm.c.values);
+		swap(compare, fm.compare);
+	}
+
+	void clear() noexcept
+	{
+		c.keys.clear();
+		c.values.clear();
+	}
+
+	// Moves all the elements of source into *this with a single sort and merge pass.
+	// When both use the same comparator no sort is needed.
+	template <class C2>
+	void merge(flat_multimap<key_type, mapped_type, C2, key_container_type, mapped_container_type> &source)
+	{
+		if (static_cast<void *>(&source) == this)
+			return;
+		check_room(source.size());
+		auto const pos = size();
+		auto       src = std::move(source).extract();
+		c.keys.insert(c.keys.end(), make_move_iterator(src.keys.begin()), make_move_iterator(src.keys.end()));
+		c.values.insert(c.values.end(), make_move_iterator(src.values.begin()), make_move_iterator(src.values.end()));
+		sort_from(pos, is_same<C2, key_compare>::value);
+	}
+	template <class C2>
+	void merge(flat_multimap<key_type, mapped_type, C2, key_container_type, mapped_container_type> &&source)
+	{
+		merge(source);
+	}
+
+	//// observers
+	key_compare   key_comp() const { return compare; }
+	value_compare value_comp() const { return value_compare(compare); }
+
+	const key_container_type &keys() const
+	{
+		return c.keys;
+	}
+	const mapped_container_type &values() const
+	{
+		return c.values;
+	}
+
+	// map operations
+	iterator find(const key_type &x)
+	{
+		auto it = lower_bound(x);
+		if (points_to(it, x))
+			return it;
+		return end();
+	}
+	const_iterator find(const key_type &x) const
+	{
+		auto it = lower_bound(x);
+		if (points_to(it, x))
+			return it;
+		return end();
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	iterator find(const K &x)
+	{
+		auto it = lower_bound(x);
+		if (points_to(it, x))
+			return it;
+		return end();
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	const_iterator find(const K &x) const
+	{
+		auto it = lower_bound(x);
+		if (points_to(it, x))
+			return it;
+		return end();
+	}
+
+	size_type count(const key_type &x) const
+	{
+		auto rng = equal_range(x);
+		return static_cast<size_type>(rng.second - rng.first);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	size_type count(const K &x) const
+	{
+		auto rng = equal_range(x);
+		return static_cast<size_type>(rng.second - rng.first);
+	}
+
+	bool contains(const key_type &x) const
+	{
+		auto it = lower_bound(x);
+		return points_to(it, x);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	bool contains(const K &x) const
+	{
+		auto it = lower_bound(x);
+		return points_to(it, x);
+	}
+
+	iterator lower_bound(const key_type &x)
+	{
+		return lower_bound_impl(x);
+	}
+	const_iterator lower_bound(const key_type &x) const
+	{
+		return lower_bound_impl(x);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	iterator lower_bound(const K &x)
+	{
+		return lower_bound_impl(x);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	const_iterator lower_bound(const K &x) const
+	{
+		return lower_bound_impl(x);
+	}
+
+	iterator upper_bound(const key_type &x)
+	{
+		return upper_bound_impl(x);
+	}
+	const_iterator upper_bound(const key_type &x) const
+	{
+		return upper_bound_impl(x);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	iterator upper_bound(const K &x)
+	{
+		return upper_bound_impl(x);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	const_iterator upper_bound(const K &x) const
+	{
+		return upper_bound_impl(x);
+	}
+
+	pair<iterator, iterator> equal_range(const key_type &x)
+	{
+		return equal_range_impl(x);
+	}
+	pair<const_iterator, const_iterator> equal_range(const key_type &x) const
+	{
+		return equal_range_impl(x);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	pair<iterator, iterator> equal_range(const K &x)
+	{
+		return equal_range_impl(x);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	pair<const_iterator, const_iterator> equal_range(const K &x) const
+	{
+		return equal_range_impl(x);
+	}
+
+private:
+	template <class InputIterator>
+	void append(InputIterator first, InputIterator last)
+	{
+		flat_map_detail::append(c.keys, c.values, first, last, max_size(), "flat_multimap capacity exceeded");
+	}
+	void check_room(size_type n) const
+	{
+		flat_map_detail::check_room(size(), max_size(), n, "flat_multimap capacity exceeded");
+	}
+
+	// Restores the class invariant when [0, pos) is sorted and [pos, size()) has been appended.
+	// When sorted is true, [pos, size()) is already sorted.
+	void sort_from(size_type pos, bool sorted)
+	{
+		(void)flat_map_detail::sort_from(c.keys, c.values, compare, pos, sorted);
+	}
+
+	template <class Iterator>
+	iterator insert_at(Iterator it, pair<key_type, mapped_type> &&t)
+	{
+		check_room(1);
+		auto nkey_it   = c.keys.emplace(it.key_it, std::move(t.first));
+		auto nvalue_it = c.values.emplace(it.value_it, std::move(t.second));
+		return iterator{nkey_it, nvalue_it};
+	}
+
+	template <class K>
+	iterator lower_bound_impl(const K &x)
+	{
+		return flat_map_detail::lower_bound<iterator, std_search_policy>(c, compare, x);
+	}
+	template <class K>
+	const_iterator lower_bound_impl(const K &x) const
+	{
+		return flat_map_detail::lower_bound<const_iterator, std_search_policy>(c, compare, x);
+	}
+
+	template <class K>
+	iterator upper_bound_impl(const K &x)
+	{
+		return flat_map_detail::upper_bound<iterator, std_search_policy>(c, compare, x);
+	}
+	template <class K>
+	const_iterator upper_bound_impl(const K &x) const
+	{
+		return flat_map_detail::upper_bound<const_iterator, std_search_policy>(c, compare, x);
+	}
+
+	template <class K>
+	pair<iterator, iterator> equal_range_impl(const K &x)
+	{
+		return flat_map_detail::range_at<iterator>(c, std::equal_range(c.keys.begin(), c.keys.end(), x, compare));
+	}
+	template <class K>
+	pair<const_iterator, const_iterator> equal_range_impl(const K &x) const
+	{
+		return flat_map_detail::range_at<const_iterator>(c, std::equal_range(c.keys.begin(), c.keys.end(), x, compare));
+	}
+
+	template <class It, class K>
+	bool points_to(It const &it, const K &x) const
+	{
+		auto const key_it = it.key_it;
+		return (key_it != c.keys.end() && !compare(x, *key_it));
+	}
+
+	containers  c;
+	key_compare compare;
+};
+
+template <class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+void swap(flat_multimap<Key, T, Compare, KeyContainer, MappedContainer> &x,
+          flat_multimap<Key, T, Compare, KeyContainer, MappedContainer> &y) noexcept(noexcept(x.swap(y)))
+{
+	x.swap(y);
+}
+
+// See erase_if(flat_map&, Predicate).
+template <class Key, class T, class Compare, class KeyContainer, class MappedContainer, class Predicate>
+typename flat_multimap<Key, T, Compare, KeyContainer, MappedContainer>::size_type
+erase_if(flat_multimap<Key, T, Compare, KeyContainer, MappedContainer> &m, Predicate pred)
+{
+	using const_reference = typename flat_multimap<Key, T, Compare, KeyContainer, MappedContainer>::const_reference;
+	auto   cont = std::move(m).extract();
+	size_t n    = 0;
+	try
+	{
+		n = flat_map_detail::compact(cont.keys, cont.values, [&](size_t i) {
+			return bool(pred(const_reference{cont.keys[i], cont.values[i]}));
+		});
+	}
+	catch (...)
+	{
+		m.replace(std::move(cont.keys), std::move(cont.values));
+		throw;
+	}
+	m.replace(std::move(cont.keys), std::move(cont.values));
+	return n;
+}
+
+} // namespace fundamental_v3
+} // namespace experimental
+} // namespace std
+
+#endif
@@ -0,0 +1,429 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Vicente J. Botet Escriba 2019.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file // LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//////////////////////////////////////////////////////////////////////////////
+
+/*
+ \file
+ \brief
+ The header \c <experimental/.../flat_map/search_policy.hpp> defines the policies used by flat_map to search
+ its key column.
+
+ A search policy is a class with two static member functions
+
+   RandomIt lower_bound(RandomIt first, RandomIt last, const K& x, Compare comp);
+   RandomIt upper_bound(RandomIt first, RandomIt last, const K& x, Compare comp);
+
+ having the semantics of the corresponding std algorithms.
+ The policy used by flat_map<Key, T, Compare, ...> is flat_search_policy<Key, Compare>::type, which can be
+ specialized for user types.
+
+ Defining JASEL_FLAT_MAP_NO_SIMD disables the x86 vectorized paths.
+ */
+
+#ifndef JASEL_FUNDAMENTAL_V3_FLAT_MAP_SEARCH_POLICY_HPP
+#define JASEL_FUNDAMENTAL_V3_FLAT_MAP_SEARCH_POLICY_HPP
+
+#include <experimental/fundamental/v2/config.hpp>
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#if !defined JASEL_FLAT_MAP_NO_SIMD && (defined __GNUC__ || defined __clang__)
+#if defined __AVX2__
+#define JASEL_FLAT_MAP_AVX2
+#endif
+#if defined __SSE4_2__
+#define JASEL_FLAT_MAP_SSE4_2
+#endif
+#if defined __SSE2__
+#define JASEL_FLAT_MAP_SSE2
+#endif
+#endif
+
+#if defined JASEL_FLAT_MAP_SSE2
+#include <immintrin.h>
+#endif
+
+namespace std
+{
+namespace experimental
+{
+inline namespace fundamental_v3
+{
+
+namespace flat_map_detail
+{
+
+template <class RandomIt>
+void prefetch(RandomIt it, true_type)
+{
+#if defined __GNUC__ || defined __clang__
+	__builtin_prefetch(std::addressof(*it));
+#else
+	(void)it;
+#endif
+}
+template <class RandomIt>
+void prefetch(RandomIt, false_type)
+{
+}
+// Prefetching needs the address of the element, which proxy iterators don't have.
+template <class RandomIt>
+void prefetch(RandomIt it)
+{
+	prefetch(it, is_lvalue_reference<typename iterator_traits<RandomIt>::reference>{});
+}
+
+// Binary search without data dependent branches: the position is updated with a conditional move and the
+// two possible positions of the next probe are prefetched.
+// pred must be true for a prefix of [first, first + n). Narrows the range containing its partition point until n is not
+// greater than linear, and returns the new first.
+template <class RandomIt, class Predicate>
+RandomIt branchless_partition_point(RandomIt first, size_t &n, size_t linear, Predicate pred)
+{
+	using difference_type = typename iterator_traits<RandomIt>::difference_type;
+	while (n > linear)
+	{
+		size_t const half = n / 2;
+		prefetch(first + difference_type(half / 2));
+		prefetch(first + difference_type(half + half / 2));
+		first = pred(first[difference_type(half)]) ? first + difference_type(half) : first;
+		n -= half;
+	}
+	return first;
+}
+
+namespace simd
+{
+#if defined JASEL_FLAT_MAP_SSE2
+inline size_t mask_count(int mask)
+{
+	return static_cast<size_t>(__builtin_popcount(static_cast<unsigned>(mask)));
+}
+#endif
+
+// The number of elements e in [p, p + n) such that e < x, or x < e when Greater is true.
+template <bool Greater, class T>
+size_t scalar_count(T const *p, size_t n, T const &x)
+{
+	size_t r = 0;
+	for (size_t i = 0; i < n; ++i)
+		r += static_cast<size_t>(Greater ? x < p[i] : p[i] < x);
+	return r;
+}
+
+template <class T>
+using kind = integral_constant<int, is_floating_point<T>::value
+                                            ? (sizeof(T) == 4 ? 3 : sizeof(T) == 8 ? 4 : 0)
+                                            : (sizeof(T) == 4 ? 1 : sizeof(T) == 8 ? 2 : 0)>;
+
+// 32 bits integers. Unsigned values are compared as signed ones once their sign bit is flipped.
+template <bool Greater, class T>
+size_t count(T const *p, size_t n, T const &x, integral_constant<int, 1>)
+{
+	size_t r = 0;
+	size_t i = 0;
+#if defined JASEL_FLAT_MAP_AVX2
+	{
+		__m256i const bias = _mm256_set1_epi32(is_signed<T>::value ? 0 : numeric_limits<int>::min());
+		__m256i const vx   = _mm256_xor_si256(_mm256_set1_epi32(static_cast<int>(x)), bias);
+		for (; i + 8 <= n; i += 8)
+		{
+			__m256i const v = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(p + i)), bias);
+			__m256i const m = Greater ? _mm256_cmpgt_epi32(v, vx) : _mm256_cmpgt_epi32(vx, v);
+			r += mask_count(_mm256_movemask_ps(_mm256_castsi256_ps(m)));
+		}
+	}
+#endif
+#if defined JASEL_FLAT_MAP_SSE2
+	{
+		__m128i const bias = _mm_set1_epi32(is_signed<T>::value ? 0 : numeric_limits<int>::min());
+		__m128i const vx   = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(x)), bias);
+		for (; i + 4 <= n; i += 4)
+		{
+			__m128i const v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<__m128i const *>(p + i)), bias);
+			__m128i const m = Greater ? _mm_cmpgt_epi32(v, vx) : _mm_cmpgt_epi32(vx, v);
+			r += mask_count(_mm_movemask_ps(_mm_castsi128_ps(m)));
+		}
+	}
+#endif
+	return r + scalar_count<Greater>(p + i, n - i, x);
+}
+
+// 64 bits integers. The signed comparison needs SSE4.2.
+template <bool Greater, class T>
+size_t count(T const *p, size_t n, T const &x, integral_constant<int, 2>)
+{
+	size_t r = 0;
+	size_t i = 0;
+#if defined JASEL_FLAT_MAP_AVX2
+	{
+		__m256i const bias = _mm256_set1_epi64x(is_signed<T>::value ? 0 : numeric_limits<long long>::min());
+		__m256i const vx   = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<long long>(x)), bias);
+		for (; i + 4 <= n; i += 4)
+		{
+			__m256i const v = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(p + i)), bias);
+			__m256i const m = Greater ? _mm256_cmpgt_epi64(v, vx) : _mm256_cmpgt_epi64(vx, v);
+			r += mask_count(_mm256_movemask_pd(_mm256_castsi256_pd(m)));
+		}
+	}
+#endif
+#if defined JASEL_FLAT_MAP_SSE4_2
+	{
+		__m128i const bias = _mm_set1_epi64x(is_signed<T>::value ? 0 : numeric_limits<long long>::min());
+		__m128i const vx   = _mm_xor_si128(_mm_set1_epi64x(static_cast<long long>(x)), bias);
+		for (; i + 2 <= n; i += 2)
+		{
+			__m128i const v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<__m128i const *>(p + i)), bias);
+			__m128i const m = Greater ? _mm_cmpgt_epi64(v, vx) : _mm_cmpgt_epi64(vx, v);
+			r += mask_count(_mm_movemask_pd(_mm_castsi128_pd(m)));
+		}
+	}
+#endif
+	return r + scalar_count<Greater>(p + i, n - i, x);
+}
+
+template <bool Greater>
+size_t count(float const *p, size_t n, float const &x, integral_constant<int, 3>)
+{
+	size_t r = 0;
+	size_t i = 0;
+#if defined JASEL_FLAT_MAP_AVX2
+	{
+		__m256 const vx = _mm256_set1_ps(x);
+		for (; i + 8 <= n; i += 8)
+		{
+			__m256 const v = _mm256_loadu_ps(p + i);
+			__m256 const m = Greater ? _mm256_cmp_ps(vx, v, _CMP_LT_OQ) : _mm256_cmp_ps(v, vx, _CMP_LT_OQ);
+			r += mask_count(_mm256_movemask_ps(m));
+		}
+	}
+#endif
+#if defined JASEL_FLAT_MAP_SSE2
+	{
+		__m128 const vx = _mm_set1_ps(x);
+		for (; i + 4 <= n; i += 4)
+		{
+			__m128 const v = _mm_loadu_ps(p + i);
+			__m128 const m = Greater ? _mm_cmplt_ps(vx, v) : _mm_cmplt_ps(v, vx);
+			r += mask_count(_mm_movemask_ps(m));
+		}
+	}
+#endif
+	return r + scalar_count<Greater>(p + i, n - i, x);
+}
+
+template <bool Greater>
+size_t count(double const *p, size_t n, double const &x, integral_constant<int, 4>)
+{
+	size_t r = 0;
+	size_t i = 0;
+#if defined JASEL_FLAT_MAP_AVX2
+	{
+		__m256d const vx = _mm256_set1_pd(x);
+		for (; i + 4 <= n; i += 4)
+		{
+			__m256d const v = _mm256_loadu_pd(p + i);
+			__m256d const m = Greater ? _mm256_cmp_pd(vx, v, _CMP_LT_OQ) : _mm256_cmp_pd(v, vx, _CMP_LT_OQ);
+			r += mask_count(_mm256_movemask_pd(m));
+		}
+	}
+#endif
+#if defined JASEL_FLAT_MAP_SSE2
+	{
+		__m128d const vx = _mm_set1_pd(x);
+		for (; i + 2 <= n; i += 2)
+		{
+			__m128d const v = _mm_loadu_pd(p + i);
+			__m128d const m = Greater ? _mm_cmplt_pd(vx, v) : _mm_cmplt_pd(v, vx);
+			r += mask_count(_mm_movemask_pd(m));
+		}
+	}
+#endif
+	return r + scalar_count<Greater>(p + i, n - i, x);
+}
+
+// long double and other sizes are counted by the scalar loop
+template <bool Greater, class T, int K>
+size_t count(T const *p, size_t n, T const &x, integral_constant<int, K>)
+{
+	return scalar_count<Greater>(p, n, x);
+}
+
+template <bool Greater, class T>
+size_t count(T const *p, size_t n, T const &x)
+{
+	return count<Greater>(p, n, x, kind<T>{});
+}
+
+// The number of elements at which the binary search switches to the linear scan: four 256 bits registers.
+template <class T>
+constexpr size_t linear_threshold()
+{
+	return 128 / sizeof(T);
+}
+
+template <class T>
+T const *lower_bound(T const *first, size_t n, T const &x)
+{
+	first = branchless_partition_point(first, n, linear_threshold<T>(), [&x](T const &e) { return e < x; });
+	return first + count<false>(first, n, x);
+}
+template <class T>
+T const *upper_bound(T const *first, size_t n, T const &x)
+{
+	first = branchless_partition_point(first, n, linear_threshold<T>(), [&x](T const &e) { return !(x < e); });
+	return first + (n - count<true>(first, n, x));
+}
+
+template <class Compare, class T>
+struct is_std_less : false_type
+{
+};
+template <class T>
+struct is_std_less<std::less<T>, T> : true_type
+{
+};
+#if __cplusplus >= 201402L
+template <class T>
+struct is_std_less<std::less<>, T> : true_type
+{
+};
+#endif
+
+template <class RandomIt, class T>
+struct is_contiguous_iterator
+        : integral_constant<bool, is_pointer<RandomIt>::value ||
+                                          is_same<RandomIt, typename std::vector<T>::iterator>::value ||
+                                          is_same<RandomIt, typename std::vector<T>::const_iterator>::value>
+{
+};
+
+// The vectorized scan applies to contiguous ranges of arithmetic values searched for a value of the same type with
+// the built-in operator<.
+template <class RandomIt, class K, class Compare, class T = typename iterator_traits<RandomIt>::value_type>
+struct applies : integral_constant<bool, is_arithmetic<T>::value && !is_same<T, bool>::value && is_same<K, T>::value &&
+                                                 is_std_less<Compare, T>::value &&
+                                                 is_contiguous_iterator<RandomIt, T>::value>
+{
+};
+
+} // namespace simd
+
+} // namespace flat_map_detail
+
+//! Searches with std::lower_bound and std::upper_bound.
+struct std_search_policy
+{
+	template <class RandomIt, class K, class Compare>
+	static RandomIt lower_bound(RandomIt first, RandomIt last, const K &x, Compare comp)
+	{
+		return std::lower_bound(first, last, x, comp);
+	}
+	template <class RandomIt, class K, class Compare>
+	static RandomIt upper_bound(RandomIt first, RandomIt last, const K &x, Compare comp)
+	{
+		return std::upper_bound(first, last, x, comp);
+	}
+};
+
+//! Binary search where the comparison selects the next position with a conditional move instead of a branch,
+//! prefetching both candidates of the next probe. Works for any key and comparator.
+struct branchless_search_policy
+{
+	template <class RandomIt, class K, class Compare>
+	static RandomIt lower_bound(RandomIt first, RandomIt last, const K &x, Compare comp)
+	{
+		using difference_type = typename iterator_traits<RandomIt>::difference_type;
+		size_t                n               = static_cast<size_t>(last - first);
+		if (n == 0)
+			return first;
+		first = flat_map_detail::branchless_partition_point(first, n, 1,
+		                                                     [&](decltype(*first) e) { return bool(comp(e, x)); });
+		return first + difference_type(bool(comp(*first, x)));
+	}
+	template <class RandomIt, class K, class Compare>
+	static RandomIt upper_bound(RandomIt first, RandomIt last, const K &x, Compare comp)
+	{
+		using difference_type = typename iterator_traits<RandomIt>::difference_type;
+		size_t                n               = static_cast<size_t>(last - first);
+		if (n == 0)
+			return first;
+		first = flat_map_detail::branchless_partition_point(first, n, 1,
+		                                                     [&](decltype(*first) e) { return !bool(comp(x, e)); });
+		return first + difference_type(!bool(comp(x, *first)));
+	}
+};
+
+//! Branchless binary search down to a few cache lines, which are then scanned with AVX2/SSE comparisons counting the
+//! keys less than the searched one. Used for arithmetic keys ordered by std::less in contiguous containers;
+//! otherwise, and on targets without SSE2, it behaves as branchless_search_policy (the scan being a scalar loop in the
+//! last case).
+struct simd_search_policy
+{
+	template <class RandomIt, class K, class Compare>
+	static RandomIt lower_bound(RandomIt first, RandomIt last, const K &x, Compare comp)
+	{
+		return lower_bound(first, last, x, comp, flat_map_detail::simd::applies<RandomIt, K, Compare>{});
+	}
+	template <class RandomIt, class K, class Compare>
+	static RandomIt upper_bound(RandomIt first, RandomIt last, const K &x, Compare comp)
+	{
+		return upper_bound(first, last, x, comp, flat_map_detail::simd::applies<RandomIt, K, Compare>{});
+	}
+
+private:
+	template <class RandomIt, class K, class Compare>
+	static RandomIt lower_bound(RandomIt first, RandomIt last, const K &x, Compare comp, false_type)
+	{
+		return branchless_search_policy::lower_bound(first, last, x, comp);
+	}
+	template <class RandomIt, class K, class Compare>
+	static RandomIt lower_bound(RandomIt first, RandomIt last, const K &x, Compare, true_type)
+	{
+		if (first == last)
+			return first;
+		auto const p = std::addressof(*first);
+		return first + (flat_map_detail::simd::lower_bound(p, static_cast<size_t>(last - first), x) - p);
+	}
+	template <class RandomIt, class K, class Compare>
+	static RandomIt upper_bound(RandomIt first, RandomIt last, const K &x, Compare comp, false_type)
+	{
+		return branchless_search_policy::upper_bound(first, last, x, comp);
+	}
+	template <class RandomIt, class K, class Compare>
+	static RandomIt upper_bound(RandomIt first, RandomIt last, const K &x, Compare, true_type)
+	{
+		if (first == last)
+			return first;
+		auto const p = std::addressof(*first);
+		return first + (flat_map_detail::simd::upper_bound(p, static_cast<size_t>(last - first), x) - p);
+	}
+};
+
+//! The search policy used by the flat containers with keys Key ordered by Compare.
+//! Specialize it to select another policy for a given key type and comparator.
+template <class Key, class Compare>
+struct flat_search_policy
+{
+	using type = typename conditional<is_arithmetic<Key>::value && !is_same<Key, bool>::value &&
+	                                          flat_map_detail::simd::is_std_less<Compare, Key>::value,
+	                                  simd_search_policy, branchless_search_policy>::type;
+};
+
+} // namespace fundamental_v3
+} // namespace experimental
+} // namespace std
+
+#endif
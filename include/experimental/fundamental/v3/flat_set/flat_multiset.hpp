@@ -0,0 +1,473 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Vicente J. Botet Escriba 2019.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file // LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef JASEL_FUNDAMENTAL_V3_FLAT_SET_FLAT_MULTISET_HPP
+#define JASEL_FUNDAMENTAL_V3_FLAT_SET_FLAT_MULTISET_HPP
+
+#include <experimental/fundamental/v3/flat_set/flat_set.hpp>
+
+namespace std
+{
+namespace experimental
+{
+inline namespace fundamental_v3
+{
+
+template <class Key, class Compare, class KeyContainer>
+class flat_multiset {
+public:
+	// types:
+	using container_type         = KeyContainer;
+	using key_type               = typename container_type::value_type;
+	using value_type             = key_type;
+	using key_compare            = Compare;
+	using value_compare          = Compare;
+	using reference              = value_type &;
+	using const_reference        = const value_type &;
+	using size_type              = size_t;
+	using difference_type        = ptrdiff_t;
+	using iterator               = typename container_type::const_iterator;
+	using const_iterator         = typename container_type::const_iterator;
+	using reverse_iterator       = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	// construct/copy/destroy
+	flat_multiset() {}
+	explicit flat_multiset(const key_compare &comp)
+	        : c{}, compare{comp}
+	{
+	}
+
+	explicit flat_multiset(container_type &&cont)
+	        : c(move(cont)), compare{}
+	{
+		sort_from(0, false);
+	}
+	template <class InputIterator>
+	flat_multiset(InputIterator first, InputIterator last, const key_compare &comp = key_compare())
+	        : c{}, compare{comp}
+	{
+		append(first, last);
+		sort_from(0, false);
+	}
+	flat_multiset(initializer_list<key_type> il, const key_compare &comp = key_compare())
+	        : flat_multiset(il.begin(), il.end(), comp)
+	{
+	}
+
+	/// sorted_equivalent_t constructors
+	////////////////////
+	flat_multiset(sorted_equivalent_t, container_type &&cont)
+	        : c(move(cont)), compare{}
+	{
+	}
+	template <class InputIterator>
+	flat_multiset(sorted_equivalent_t, InputIterator first, InputIterator last, const key_compare &comp = key_compare())
+	        : c{}, compare{comp}
+	{
+		append(first, last);
+	}
+	flat_multiset(sorted_equivalent_t s, initializer_list<key_type> il, const key_compare &comp = key_compare())
+	        : flat_multiset(s, il.begin(), il.end(), comp)
+	{
+	}
+
+	/// allocator-extended constructors
+	// Each constructor above has a counterpart taking allocator_arg and an allocator first, the allocator being used
+	// to construct the container. They participate in overload resolution only if the container uses the allocator.
+	template <class Alloc, JASEL_REQUIRES(std::uses_allocator<KeyContainer, Alloc>::value)>
+	flat_multiset(allocator_arg_t, const Alloc &a)
+	        : c(a), compare{}
+	{
+	}
+	template <class Alloc, JASEL_REQUIRES(std::uses_allocator<KeyContainer, Alloc>::value)>
+	flat_multiset(allocator_arg_t, const Alloc &a, const key_compare &comp)
+	        : c(a), compare{comp}
+	{
+	}
+	template <class Alloc, JASEL_REQUIRES(std::uses_allocator<KeyContainer, Alloc>::value)>
+	flat_multiset(allocator_arg_t, const Alloc &a, container_type &&cont)
+	        : c(container_type(std::move(cont), a)), compare{}
+	{
+		sort_from(0, false);
+	}
+	template <class InputIterator, class Alloc,
+	          JASEL_REQUIRES(std::uses_allocator<KeyContainer, Alloc>::value)>
+	flat_multiset(allocator_arg_t, const Alloc &a, InputIterator first, InputIterator last,
+	              const key_compare &comp = key_compare())
+	        : c(a), compare{comp}
+	{
+		append(first, last);
+		sort_from(0, false);
+	}
+	template <class Alloc, JASEL_REQUIRES(std::uses_allocator<KeyContainer, Alloc>::value)>
+	flat_multiset(allocator_arg_t, const Alloc &a, initializer_list<key_type> il,
+	              const key_compare &comp = key_compare())
+	        : flat_multiset(allocator_arg, a, il.begin(), il.end(), comp)
+	{
+	}
+	template <class Alloc, JASEL_REQUIRES(std::uses_allocator<KeyContainer, Alloc>::value)>
+	flat_multiset(allocator_arg_t, const Alloc &a, sorted_equivalent_t, container_type &&cont)
+	        : c(container_type(std::move(cont), a)), compare{}
+	{
+	}
+	template <class InputIterator, class Alloc,
+	          JASEL_REQUIRES(std::uses_allocator<KeyContainer, Alloc>::value)>
+	flat_multiset(allocator_arg_t, const Alloc &a, sorted_equivalent_t, InputIterator first, InputIterator last,
+	              const key_compare &comp = key_compare())
+	        : c(a), compare{comp}
+	{
+		append(first, last);
+	}
+	template <class Alloc, JASEL_REQUIRES(std::uses_allocator<KeyContainer, Alloc>::value)>
+	flat_multiset(allocator_arg_t, const Alloc &a, sorted_equivalent_t s, initializer_list<key_type> il,
+	              const key_compare &comp = key_compare())
+	        : flat_multiset(allocator_arg, a, s, il.begin(), il.end(), comp)
+	{
+	}
+	template <class Alloc, JASEL_REQUIRES(std::uses_allocator<KeyContainer, Alloc>::value)>
+	flat_multiset(allocator_arg_t, const Alloc &a, const flat_multiset &m)
+	        : c(m.c, a), compare{m.compare}
+	{
+	}
+	template <class Alloc, JASEL_REQUIRES(std::uses_allocator<KeyContainer, Alloc>::value)>
+	flat_multiset(allocator_arg_t, const Alloc &a, flat_multiset &&m)
+	        : c(std::move(m.c), a), compare{std::move(m.compare)}
+	{
+	}
+
+	flat_multiset &operator=(initializer_list<key_type> il)
+	{
+		clear();
+		insert(il);
+		return *this;
+	}
+
+	//// iterators
+	iterator               begin() noexcept { return c.begin(); }
+	const_iterator         begin() const noexcept { return c.begin(); }
+	iterator               end() noexcept { return c.end(); }
+	const_iterator         end() const noexcept { return c.end(); }
+	reverse_iterator       rbegin() noexcept { return reverse_iterator{end()}; }
+	const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator{end()}; }
+	reverse_iterator       rend() noexcept { return reverse_iterator{begin()}; }
+	const_reverse_iterator rend() const noexcept { return const_reverse_iterator{begin()}; }
+	const_iterator         cbegin() const noexcept { return c.cbegin(); }
+	const_iterator         cend() const noexcept { return c.cend(); }
+	const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator{cend()}; }
+	const_reverse_iterator crend() const noexcept { return const_reverse_iterator{cbegin()}; }
+
+	// capacity
+	//[[nodiscard]]
+	bool      empty() const noexcept { return c.empty(); }
+	size_type size() const noexcept { return c.size(); }
+	size_type max_size() const noexcept { return c.max_size(); }
+
+	// modifiers
+	template <class... Args>
+	iterator emplace(Args &&... args)
+	{
+		return insert(key_type(std::forward<Args>(args)...));
+	}
+	template <class... Args>
+	iterator emplace_hint(const_iterator position, Args &&... args)
+	{
+		return insert(position, key_type(std::forward<Args>(args)...));
+	}
+
+	// The new element is inserted after the elements with an equivalent key.
+	iterator insert(const value_type &x)
+	{
+		check_room(1);
+		return c.insert(upper_bound(x), x);
+	}
+	iterator insert(value_type &&x)
+	{
+		check_room(1);
+		auto it = upper_bound(x);
+		return c.insert(it, move(x));
+	}
+	// x is inserted as close as possible to the position just prior to position.
+	iterator insert(const_iterator position, const value_type &x)
+	{
+		check_room(1);
+		return c.insert(hint(position, x), x);
+	}
+	iterator insert(const_iterator position, value_type &&x)
+	{
+		check_room(1);
+		auto it = hint(position, x);
+		return c.insert(it, move(x));
+	}
+
+	// See flat_map::insert(InputIterator, InputIterator). The elements with equivalent keys keep their relative order.
+	template <class InputIterator>
+	void insert(InputIterator first, InputIterator last)
+	{
+		auto const pos = size();
+		append(first, last);
+		sort_from(pos, false);
+	}
+	template <class InputIterator>
+	void insert(sorted_equivalent_t, InputIterator first, InputIterator last)
+	{
+		auto const pos = size();
+		append(first, last);
+		sort_from(pos, true);
+	}
+	void insert(initializer_list<key_type> il)
+	{
+		insert(il.begin(), il.end());
+	}
+	void insert(sorted_equivalent_t s, initializer_list<key_type> il)
+	{
+		insert(s, il.begin(), il.end());
+	}
+
+	container_type extract() &&
+	{
+		container_type temp(std::move(c));
+		c.clear();
+		return temp;
+	}
+	// cont must be sorted with respect to key_comp().
+	void replace(container_type &&cont)
+	{
+		c = std::move(cont);
+	}
+
+	iterator erase(const_iterator position)
+	{
+		return c.erase(position);
+	}
+	size_type erase(const key_type &x)
+	{
+		auto rng = equal_range(x);
+		auto n   = static_cast<size_type>(rng.second - rng.first);
+		erase(rng.first, rng.second);
+		return n;
+	}
+	iterator erase(const_iterator first, const_iterator last)
+	{
+		return c.erase(first, last);
+	}
+
+	void swap(flat_multiset &fs) noexcept
+	{
+		using std::swap;
+		swap(c, fs.c);
+		swap(compare, fs.compare);
+	}
+
+	void clear() noexcept
+	{
+		c.clear();
+	}
+
+	// Moves all the elements of source into *this with a single sort and merge pass.
+	// When both use the same comparator no sort is needed.
+	template <class C2>
+	void merge(flat_multiset<Key, C2, KeyContainer> &source)
+	{
+		if (static_cast<void *>(&source) == this)
+			return;
+		check_room(source.size());
+		auto const     pos = size();
+		container_type src = std::move(source).extract();
+		c.insert(c.end(), make_move_iterator(src.begin()), make_move_iterator(src.end()));
+		sort_from(pos, is_same<C2, key_compare>::value);
+	}
+	template <class C2>
+	void merge(flat_multiset<Key, C2, KeyContainer> &&source)
+	{
+		merge(source);
+	}
+
+	//// observers
+	key_compare   key_comp() const { return compare; }
+	value_compare value_comp() const { return compare; }
+
+	// set operations
+	iterator find(const key_type &x)
+	{
+		return find_impl(x);
+	}
+	const_iterator find(const key_type &x) const
+	{
+		return find_impl(x);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	iterator find(const K &x)
+	{
+		return find_impl(x);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	const_iterator find(const K &x) const
+	{
+		return find_impl(x);
+	}
+
+	size_type count(const key_type &x) const
+	{
+		auto rng = equal_range(x);
+		return static_cast<size_type>(rng.second - rng.first);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	size_type count(const K &x) const
+	{
+		auto rng = equal_range(x);
+		return static_cast<size_type>(rng.second - rng.first);
+	}
+
+	bool contains(const key_type &x) const
+	{
+		return points_to(lower_bound(x), x);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	bool contains(const K &x) const
+	{
+		return points_to(lower_bound(x), x);
+	}
+
+	iterator lower_bound(const key_type &x)
+	{
+		return std::lower_bound(c.begin(), c.end(), x, compare);
+	}
+	const_iterator lower_bound(const key_type &x) const
+	{
+		return std::lower_bound(c.begin(), c.end(), x, compare);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	iterator lower_bound(const K &x)
+	{
+		return std::lower_bound(c.begin(), c.end(), x, compare);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	const_iterator lower_bound(const K &x) const
+	{
+		return std::lower_bound(c.begin(), c.end(), x, compare);
+	}
+
+	iterator upper_bound(const key_type &x)
+	{
+		return std::upper_bound(c.begin(), c.end(), x, compare);
+	}
+	const_iterator upper_bound(const key_type &x) const
+	{
+		return std::upper_bound(c.begin(), c.end(), x, compare);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	iterator upper_bound(const K &x)
+	{
+		return std::upper_bound(c.begin(), c.end(), x, compare);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	const_iterator upper_bound(const K &x) const
+	{
+		return std::upper_bound(c.begin(), c.end(), x, compare);
+	}
+
+	pair<iterator, iterator> equal_range(const key_type &x)
+	{
+		return std::equal_range(c.begin(), c.end(), x, compare);
+	}
+	pair<const_iterator, const_iterator> equal_range(const key_type &x) const
+	{
+		return std::equal_range(c.begin(), c.end(), x, compare);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	pair<iterator, iterator> equal_range(const K &x)
+	{
+		return std::equal_range(c.begin(), c.end(), x, compare);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	pair<const_iterator, const_iterator> equal_range(const K &x) const
+	{
+		return std::equal_range(c.begin(), c.end(), x, compare);
+	}
+
+private:
+	template <class InputIterator>
+	void append(InputIterator first, InputIterator last)
+	{
+		flat_set_detail::append(c, first, last, "flat_multiset capacity exceeded");
+	}
+	void check_room(size_type n) const
+	{
+		flat_map_detail::check_room(size(), max_size(), n, "flat_multiset capacity exceeded");
+	}
+
+	// Restores the class invariant when [0, pos) is sorted and [pos, size()) has been appended.
+	// When sorted is true, [pos, size()) is already sorted.
+	void sort_from(size_type pos, bool sorted)
+	{
+		(void)flat_set_detail::sort_from(c, compare, pos, sorted);
+	}
+
+	// the valid insertion position for x closest to position
+	const_iterator hint(const_iterator position, const key_type &x) const
+	{
+		if (position != cend() && compare(*position, x))
+			return lower_bound(x);
+		if (position != cbegin() && compare(x, *(position - 1)))
+			return upper_bound(x);
+		return position;
+	}
+
+	template <class K>
+	const_iterator find_impl(const K &x) const
+	{
+		auto it = lower_bound(x);
+		if (points_to(it, x))
+			return it;
+		return end();
+	}
+
+	template <class K>
+	bool points_to(const_iterator it, const K &x) const
+	{
+		return it != c.end() && !compare(x, *it);
+	}
+
+	container_type c;
+	key_compare    compare;
+};
+
+template <class Key, class Compare, class KeyContainer>
+void swap(flat_multiset<Key, Compare, KeyContainer> &x,
+          flat_multiset<Key, Compare, KeyContainer> &y) noexcept(noexcept(x.swap(y)))
+{
+	x.swap(y);
+}
+
+// Erases the elements e for which pred(e) is true, in a single stable pass.
+// On exception from pred, s keeps the elements not erased yet.
+// Returns the number of erased elements.
+template <class Key, class Compare, class KeyContainer, class Predicate>
+typename flat_multiset<Key, Compare, KeyContainer>::size_type erase_if(flat_multiset<Key, Compare, KeyContainer> &s, Predicate pred)
+{
+	auto   cont   = std::move(s).extract();
+	size_t erased = 0;
+	try
+	{
+		erased = flat_set_detail::compact(cont, pred);
+	}
+	catch (...)
+	{
+		s.replace(std::move(cont));
+		throw;
+	}
+	s.replace(std::move(cont));
+	return erased;
+}
+
+} // namespace fundamental_v3
+} // namespace experimental
+} // namespace std
+
+#endif
@@ -0,0 +1,621 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Vicente J. Botet Escriba 2019.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file // LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef JASEL_FUNDAMENTAL_V3_FLAT_SET_FLAT_SET_HPP
+#define JASEL_FUNDAMENTAL_V3_FLAT_SET_FLAT_SET_HPP
+
+#include <experimental/fundamental/v3/flat_map/flat_map.hpp>
+
+namespace std
+{
+namespace experimental
+{
+inline namespace fundamental_v3
+{
+
+template <class Key, class Compare = less<Key>, class KeyContainer = vector<Key>>
+class flat_set;
+
+template <class Key, class Compare = less<Key>, class KeyContainer = vector<Key>>
+class flat_multiset;
+
+namespace flat_set_detail
+{
+// Sorts the elements appended at [pos, size()), unless they are already sorted, and merges them with the sorted
+// range [0, pos). Both the sort and the merge are stable.
+// Returns the index of the first element that could be equivalent to one of its neighbours.
+template <class Container, class Compare>
+size_t sort_from(Container &cont, Compare const &comp, size_t pos, bool sorted)
+{
+	using difference_type = typename Container::difference_type;
+	if (pos == cont.size())
+		return pos;
+	auto const middle = cont.begin() + difference_type(pos);
+	if (!sorted)
+		std::stable_sort(middle, cont.end(), comp);
+	if (pos == 0 || !comp(*middle, *(middle - 1)))
+		return pos == 0 ? 0 : pos - 1;
+
+	// only the elements not less than the smallest new key take part in the merge
+	auto const first = std::lower_bound(cont.begin(), middle, *middle, comp);
+	std::inplace_merge(first, middle, cont.end(), comp);
+	return static_cast<size_t>(first - cont.begin());
+}
+
+struct discard
+{
+	template <class K>
+	void operator()(K &&) const
+	{
+	}
+};
+
+// Removes the consecutive equivalent keys of the sorted range [first, size()), keeping the first one.
+// The removed elements are given to sink.
+template <class Container, class Compare, class Sink>
+void unique_from(Container &cont, Compare const &comp, size_t first, Sink sink)
+{
+	using difference_type = typename Container::difference_type;
+	size_t const n        = cont.size();
+	if (n - first < 2)
+		return;
+	size_t last = first;
+	for (size_t i = first + 1; i < n; ++i)
+	{
+		if (comp(cont[last], cont[i]))
+		{
+			++last;
+			if (last != i)
+				cont[last] = std::move(cont[i]);
+		}
+		else
+			sink(std::move(cont[i]));
+	}
+	cont.erase(cont.begin() + difference_type(last + 1), cont.end());
+}
+
+template <class Container>
+struct push_back_to
+{
+	Container *cont;
+	template <class K>
+	void operator()(K &&k) const
+	{
+		cont->insert(cont->end(), std::forward<K>(k));
+	}
+};
+
+// Appends [first, last) to cont. The room is checked before inserting anything when the number of elements is
+// known, otherwise before each element, the appended elements being removed on exception.
+template <class Container, class InputIterator>
+void append(Container &cont, InputIterator first, InputIterator last, char const *what, forward_iterator_tag)
+{
+	flat_map_detail::check_room(cont.size(), cont.max_size(), static_cast<size_t>(std::distance(first, last)), what);
+	cont.insert(cont.end(), first, last);
+}
+template <class Container, class InputIterator>
+void append(Container &cont, InputIterator first, InputIterator last, char const *what, input_iterator_tag)
+{
+	using difference_type = typename Container::difference_type;
+	size_t const pos      = cont.size();
+	try
+	{
+		for (; first != last; ++first)
+		{
+			flat_map_detail::check_room(cont.size(), cont.max_size(), 1, what);
+			cont.insert(cont.end(), *first);
+		}
+	}
+	catch (...)
+	{
+		cont.erase(cont.begin() + difference_type(pos), cont.end());
+		throw;
+	}
+}
+template <class Container, class InputIterator>
+void append(Container &cont, InputIterator first, InputIterator last, char const *what)
+{
+	append(cont, first, last, what, typename iterator_traits<InputIterator>::iterator_category{});
+}
+
+// Removes the elements e of cont for which pred(e) is true, moving the kept ones once in a single stable pass.
+// On exception from pred the elements not visited yet are kept, after the ones already kept.
+// Returns the number of removed elements.
+template <class Container, class Predicate>
+size_t compact(Container &cont, Predicate &pred)
+{
+	auto const n     = cont.size();
+	auto       first = cont.begin();
+	while (first != cont.end() && !pred(*first))
+		++first;
+	auto last = first;
+	try
+	{
+		for (; first != cont.end(); ++first)
+		{
+			if (!pred(*first))
+			{
+				*last = std::move(*first);
+				++last;
+			}
+		}
+	}
+	catch (...)
+	{
+		cont.erase(std::move(first, cont.end(), last), cont.end());
+		throw;
+	}
+	cont.erase(last, cont.end());
+	return n - cont.size();
+}
+} // namespace flat_set_detail
+
+template <class Key, class Compare, class KeyContainer>
+class flat_set {
+public:
+	// types:
+	using container_type         = KeyContainer;
+	using key_type               = typename container_type::value_type;
+	using value_type             = key_type;
+	using key_compare            = Compare;
+	using value_compare          = Compare;
+	using reference              = value_type &;
+	using const_reference        = const value_type &;
+	using size_type              = size_t;
+	using difference_type        = ptrdiff_t;
+	using iterator               = typename container_type::const_iterator;
+	using const_iterator         = typename container_type::const_iterator;
+	using reverse_iterator       = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	// construct/copy/destroy
+	flat_set() {}
+	explicit flat_set(const key_compare &comp)
+	        : c{}, compare{comp}
+	{
+	}
+
+	explicit flat_set(container_type &&cont)
+	        : c(move(cont)), compare{}
+	{
+		sort_and_unique_from(0, false);
+	}
+	template <class InputIterator>
+	flat_set(InputIterator first, InputIterator last, const key_compare &comp = key_compare())
+	        : c{}, compare{comp}
+	{
+		append(first, last);
+		sort_and_unique_from(0, false);
+	}
+	flat_set(initializer_list<key_type> il, const key_compare &comp = key_compare())
+	        : flat_set(il.begin(), il.end(), comp)
+	{
+	}
+
+	/// sorted_unique_t constructors
+	////////////////////
+	flat_set(sorted_unique_t, container_type &&cont)
+	        : c(move(cont)), compare{}
+	{
+	}
+	template <class InputIterator>
+	flat_set(sorted_unique_t, InputIterator first, InputIterator last, const key_compare &comp = key_compare())
+	        : c{}, compare{comp}
+	{
+		append(first, last);
+	}
+	flat_set(sorted_unique_t s, initializer_list<key_type> il, const key_compare &comp = key_compare())
+	        : flat_set(s, il.begin(), il.end(), comp)
+	{
+	}
+
+	/// allocator-extended constructors
+	// Each constructor above has a counterpart taking allocator_arg and an allocator first, the allocator being used
+	// to construct the container. They participate in overload resolution only if the container uses the allocator.
+	template <class Alloc, JASEL_REQUIRES(std::uses_allocator<KeyContainer, Alloc>::value)>
+	flat_set(allocator_arg_t, const Alloc &a)
+	        : c(a), compare{}
+	{
+	}
+	template <class Alloc, JASEL_REQUIRES(std::uses_allocator<KeyContainer, Alloc>::value)>
+	flat_set(allocator_arg_t, const Alloc &a, const key_compare &comp)
+	        : c(a), compare{comp}
+	{
+	}
+	template <class Alloc, JASEL_REQUIRES(std::uses_allocator<KeyContainer, Alloc>::value)>
+	flat_set(allocator_arg_t, const Alloc &a, container_type &&cont)
+	        : c(container_type(std::move(cont), a)), compare{}
+	{
+		sort_and_unique_from(0, false);
+	}
+	template <class InputIterator, class Alloc,
+	          JASEL_REQUIRES(std::uses_allocator<KeyContainer, Alloc>::value)>
+	flat_set(allocator_arg_t, const Alloc &a, InputIterator first, InputIterator last,
+	         const key_compare &comp = key_compare())
+	        : c(a), compare{comp}
+	{
+		append(first, last);
+		sort_and_unique_from(0, false);
+	}
+	template <class Alloc, JASEL_REQUIRES(std::uses_allocator<KeyContainer, Alloc>::value)>
+	flat_set(allocator_arg_t, const Alloc &a, initializer_list<key_type> il, const key_compare &comp = key_compare())
+	        : flat_set(allocator_arg, a, il.begin(), il.end(), comp)
+	{
+	}
+	template <class Alloc, JASEL_REQUIRES(std::uses_allocator<KeyContainer, Alloc>::value)>
+	flat_set(allocator_arg_t, const Alloc &a, sorted_unique_t, container_type &&cont)
+	        : c(container_type(std::move(cont), a)), compare{}
+	{
+	}
+	template <class InputIterator, class Alloc,
+	          JASEL_REQUIRES(std::uses_allocator<KeyContainer, Alloc>::value)>
+	flat_set(allocator_arg_t, const Alloc &a, sorted_unique_t, InputIterator first, InputIterator last,
+	         const key_compare &comp = key_compare())
+	        : c(a), compare{comp}
+	{
+		append(first, last);
+	}
+	template <class Alloc, JASEL_REQUIRES(std::uses_allocator<KeyContainer, Alloc>::value)>
+	flat_set(allocator_arg_t, const Alloc &a, sorted_unique_t s, initializer_list<key_type> il,
+	         const key_compare &comp = key_compare())
+	        : flat_set(allocator_arg, a, s, il.begin(), il.end(), comp)
+	{
+	}
+	template <class Alloc, JASEL_REQUIRES(std::uses_allocator<KeyContainer, Alloc>::value)>
+	flat_set(allocator_arg_t, const Alloc &a, const flat_set &m)
+	        : c(m.c, a), compare{m.compare}
+	{
+	}
+	template <class Alloc, JASEL_REQUIRES(std::uses_allocator<KeyContainer, Alloc>::value)>
+	flat_set(allocator_arg_t, const Alloc &a, flat_set &&m)
+	        : c(std::move(m.c), a), compare{std::move(m.compare)}
+	{
+	}
+
+	flat_set &operator=(initializer_list<key_type> il)
+	{
+		clear();
+		insert(il);
+		return *this;
+	}
+
+	//// iterators
+	iterator               begin() noexcept { return c.begin(); }
+	const_iterator         begin() const noexcept { return c.begin(); }
+	iterator               end() noexcept { return c.end(); }
+	const_iterator         end() const noexcept { return c.end(); }
+	reverse_iterator       rbegin() noexcept { return reverse_iterator{end()}; }
+	const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator{end()}; }
+	reverse_iterator       rend() noexcept { return reverse_iterator{begin()}; }
+	const_reverse_iterator rend() const noexcept { return const_reverse_iterator{begin()}; }
+	const_iterator         cbegin() const noexcept { return c.cbegin(); }
+	const_iterator         cend() const noexcept { return c.cend(); }
+	const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator{cend()}; }
+	const_reverse_iterator crend() const noexcept { return const_reverse_iterator{cbegin()}; }
+
+	// capacity
+	//[[nodiscard]]
+	bool      empty() const noexcept { return c.empty(); }
+	size_type size() const noexcept { return c.size(); }
+	size_type max_size() const noexcept { return c.max_size(); }
+
+	// modifiers
+	template <class... Args>
+	pair<iterator, bool> emplace(Args &&... args)
+	{
+		return insert(key_type(std::forward<Args>(args)...));
+	}
+	template <class... Args>
+	iterator emplace_hint(const_iterator position, Args &&... args)
+	{
+		return insert(position, key_type(std::forward<Args>(args)...));
+	}
+
+	pair<iterator, bool> insert(const value_type &x)
+	{
+		return insert_impl(x);
+	}
+	pair<iterator, bool> insert(value_type &&x)
+	{
+		return insert_impl(move(x));
+	}
+	iterator insert(const_iterator position, const value_type &x)
+	{
+		return insert_hint_impl(position, x);
+	}
+	iterator insert(const_iterator position, value_type &&x)
+	{
+		return insert_hint_impl(position, move(x));
+	}
+
+	// See flat_map::insert(InputIterator, InputIterator).
+	template <class InputIterator>
+	void insert(InputIterator first, InputIterator last)
+	{
+		auto const pos = size();
+		append(first, last);
+		sort_and_unique_from(pos, false);
+	}
+	template <class InputIterator>
+	void insert(sorted_unique_t, InputIterator first, InputIterator last)
+	{
+		auto const pos = size();
+		append(first, last);
+		sort_and_unique_from(pos, true);
+	}
+	void insert(initializer_list<key_type> il)
+	{
+		insert(il.begin(), il.end());
+	}
+	void insert(sorted_unique_t s, initializer_list<key_type> il)
+	{
+		insert(s, il.begin(), il.end());
+	}
+
+	container_type extract() &&
+	{
+		container_type temp(std::move(c));
+		c.clear();
+		return temp;
+	}
+	// cont must be sorted and unique with respect to key_comp().
+	void replace(container_type &&cont)
+	{
+		c = std::move(cont);
+	}
+
+	iterator erase(const_iterator position)
+	{
+		return c.erase(position);
+	}
+	size_type erase(const key_type &x)
+	{
+		auto it = lower_bound(x);
+		if (points_to(it, x))
+		{
+			erase(it);
+			return 1;
+		}
+		return 0;
+	}
+	iterator erase(const_iterator first, const_iterator last)
+	{
+		return c.erase(first, last);
+	}
+
+	void swap(flat_set &fs) noexcept
+	{
+		using std::swap;
+		swap(c, fs.c);
+		swap(compare, fs.compare);
+	}
+
+	void clear() noexcept
+	{
+		c.clear();
+	}
+
+	// Moves the elements of source into *this with a single sort and merge pass.
+	// As for std::set::merge, the elements whose key is already in *this are left in source.
+	template <class C2>
+	void merge(flat_set<Key, C2, KeyContainer> &source)
+	{
+		if (static_cast<void *>(&source) == this)
+			return;
+		// All the elements of source are appended before the duplicates are moved back.
+		check_room(source.size());
+		auto const     pos = size();
+		container_type src = std::move(source).extract();
+		c.insert(c.end(), make_move_iterator(src.begin()), make_move_iterator(src.end()));
+		src.clear();
+		auto const first = flat_set_detail::sort_from(c, compare, pos, is_same<C2, key_compare>::value);
+		flat_set_detail::unique_from(c, compare, first, flat_set_detail::push_back_to<container_type>{&src});
+		if (!is_same<C2, key_compare>::value)
+			std::sort(src.begin(), src.end(), source.key_comp());
+		source.replace(move(src));
+	}
+	template <class C2>
+	void merge(flat_set<Key, C2, KeyContainer> &&source)
+	{
+		merge(source);
+	}
+
+	//// observers
+	key_compare   key_comp() const { return compare; }
+	value_compare value_comp() const { return compare; }
+
+	// set operations
+	iterator find(const key_type &x)
+	{
+		return find_impl(x);
+	}
+	const_iterator find(const key_type &x) const
+	{
+		return find_impl(x);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	iterator find(const K &x)
+	{
+		return find_impl(x);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	const_iterator find(const K &x) const
+	{
+		return find_impl(x);
+	}
+
+	size_type count(const key_type &x) const
+	{
+		return contains(x) ? 1 : 0;
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	size_type count(const K &x) const
+	{
+		auto rng = equal_range(x);
+		return static_cast<size_type>(rng.second - rng.first);
+	}
+
+	bool contains(const key_type &x) const
+	{
+		return points_to(lower_bound(x), x);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	bool contains(const K &x) const
+	{
+		return points_to(lower_bound(x), x);
+	}
+
+	iterator lower_bound(const key_type &x)
+	{
+		return std::lower_bound(c.begin(), c.end(), x, compare);
+	}
+	const_iterator lower_bound(const key_type &x) const
+	{
+		return std::lower_bound(c.begin(), c.end(), x, compare);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	iterator lower_bound(const K &x)
+	{
+		return std::lower_bound(c.begin(), c.end(), x, compare);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	const_iterator lower_bound(const K &x) const
+	{
+		return std::lower_bound(c.begin(), c.end(), x, compare);
+	}
+
+	iterator upper_bound(const key_type &x)
+	{
+		return std::upper_bound(c.begin(), c.end(), x, compare);
+	}
+	const_iterator upper_bound(const key_type &x) const
+	{
+		return std::upper_bound(c.begin(), c.end(), x, compare);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	iterator upper_bound(const K &x)
+	{
+		return std::upper_bound(c.begin(), c.end(), x, compare);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	const_iterator upper_bound(const K &x) const
+	{
+		return std::upper_bound(c.begin(), c.end(), x, compare);
+	}
+
+	pair<iterator, iterator> equal_range(const key_type &x)
+	{
+		return std::equal_range(c.begin(), c.end(), x, compare);
+	}
+	pair<const_iterator, const_iterator> equal_range(const key_type &x) const
+	{
+		return std::equal_range(c.begin(), c.end(), x, compare);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	pair<iterator, iterator> equal_range(const K &x)
+	{
+		return std::equal_range(c.begin(), c.end(), x, compare);
+	}
+	template <class K, class C = Compare, JASEL_REQUIRES(flat_map_detail::is_transparent<C>::value)>
+	pair<const_iterator, const_iterator> equal_range(const K &x) const
+	{
+		return std::equal_range(c.begin(), c.end(), x, compare);
+	}
+
+private:
+	template <class InputIterator>
+	void append(InputIterator first, InputIterator last)
+	{
+		flat_set_detail::append(c, first, last, "flat_set capacity exceeded");
+	}
+	void check_room(size_type n) const
+	{
+		flat_map_detail::check_room(size(), max_size(), n, "flat_set capacity exceeded");
+	}
+
+	// Restores the class invariant when [0, pos) is sorted and unique and [pos, size()) has been appended.
+	// When sorted is true, [pos, size()) is already sorted.
+	void sort_and_unique_from(size_type pos, bool sorted)
+	{
+		auto const first = flat_set_detail::sort_from(c, compare, pos, sorted);
+		flat_set_detail::unique_from(c, compare, first, flat_set_detail::discard{});
+	}
+
+	template <class K>
+	pair<iterator, bool> insert_impl(K &&x)
+	{
+		auto it = lower_bound(x);
+		if (points_to(it, x))
+			return std::make_pair(it, false);
+		check_room(1);
+		return std::make_pair(iterator(c.insert(it, std::forward<K>(x))), true);
+	}
+
+	// x is inserted just before position if this preserves the order.
+	template <class K>
+	iterator insert_hint_impl(const_iterator position, K &&x)
+	{
+		if ((position == cend() || compare(x, *position)) && (position == cbegin() || compare(*(position - 1), x)))
+		{
+			check_room(1);
+			return c.insert(position, std::forward<K>(x));
+		}
+		return insert_impl(std::forward<K>(x)).first;
+	}
+
+	template <class K>
+	const_iterator find_impl(const K &x) const
+	{
+		auto it = lower_bound(x);
+		if (points_to(it, x))
+			return it;
+		return end();
+	}
+
+	template <class K>
+	bool points_to(const_iterator it, const K &x) const
+	{
+		return it != c.end() && !compare(x, *it);
+	}
+
+	container_type c;
+	key_compare    compare;
+};
+
+template <class Key, class Compare, class KeyContainer>
+void swap(flat_set<Key, Compare, KeyContainer> &x, flat_set<Key, Compare, KeyContainer> &y) noexcept(noexcept(x.swap(y)))
+{
+	x.swap(y);
+}
+
+// Erases the elements e for which pred(e) is true, in a single stable pass.
+// On exception from pred, s keeps the elements not erased yet.
+// Returns the number of erased elements.
+template <class Key, class Compare, class KeyContainer, class Predicate>
+typename flat_set<Key, Compare, KeyContainer>::size_type erase_if(flat_set<Key, Compare, KeyContainer> &s, Predicate pred)
+{
+	auto   cont   = std::move(s).extract();
+	size_t erased = 0;
+	try
+	{
+		erased = flat_set_detail::compact(cont, pred);
+	}
+	catch (...)
+	{
+		s.replace(std::move(cont));
+		throw;
+	}
+	s.replace(std::move(cont));
+	return erased;
+}
+
+} // namespace fundamental_v3
+} // namespace experimental
+} // namespace std
+
+#endif
@@ -0,0 +1,187 @@
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// (C) Copyright 2019 Vicente J. Botet Escriba
+
+#ifndef JASEL_EXPERIMENTAL_OBJECT_POOL_OBJECT_POOL_HPP
+#define JASEL_EXPERIMENTAL_OBJECT_POOL_OBJECT_POOL_HPP
+
+#if __cplusplus >= 201103L
+
+#include <experimental/contract.hpp>
+#include <experimental/fundamental/v2/config.hpp>
+#include <experimental/fundamental/v3/object_pool/pool_delete.hpp>
+#include <functional>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace std
+{
+namespace experimental
+{
+inline namespace fundamental_v3
+{
+
+// A pool of slots for objects of type T, growing by chunks.
+// As static_pool, the slots never allocated yet are taken in order from the last chunk and the ones given back are
+// linked in a free list, so that allocate and deallocate are O(1). A chunk is allocated when no slot is left; the
+// chunks double in size, from the initial one up to max_chunk_size() slots, and are released by the destructor only.
+// The pool is not synchronized and doesn't destroy the objects still alive when it is destroyed.
+
+template <typename T>
+class object_pool {
+	using slot = pool_detail::slot<T>;
+
+public:
+	// types:
+	using value_type      = T;
+	using pointer         = T *;
+	using size_type       = size_t;
+	using deleter_type    = pool_delete<object_pool>;
+	using unique_ptr_type = unique_ptr<T, deleter_type>;
+
+	static constexpr size_type max_chunk_size() noexcept
+	{
+		return size_type(1) << 16;
+	}
+
+	//! Effects: Constructs a pool without slots, whose first chunk will have initial_chunk_size slots.
+	explicit object_pool(size_type initial_chunk_size = 32) noexcept
+	        : free_(nullptr), next_(nullptr), last_(nullptr), size_(0), capacity_(0),
+	          chunk_size_(initial_chunk_size == 0 ? 1 : initial_chunk_size)
+	{
+	}
+	object_pool(object_pool const &) = delete;
+	object_pool &operator=(object_pool const &) = delete;
+
+	//! Returns: The storage for a T.
+	//! Throws: bad_alloc if a chunk cannot be allocated.
+	pointer allocate()
+	{
+		slot *s = free_;
+		if (s != nullptr)
+			free_ = s->next_;
+		else
+		{
+			if (next_ == last_)
+				add_chunk(chunk_size_);
+			s = next_++;
+		}
+		++size_;
+		return reinterpret_cast<pointer>(s);
+	}
+
+	//! Expects: p was returned by allocate() and its object, if any, is destroyed.
+	//! Effects: Gives back the slot of p.
+	void deallocate(pointer p) noexcept
+	{
+		slot *s  = reinterpret_cast<slot *>(p);
+		s->next_ = free_;
+		free_    = s;
+		--size_;
+	}
+
+	//! Effects: Constructs a T from args in a slot.
+	//! Returns: A pointer to the object.
+	//! Throws: bad_alloc, or what the constructor throws, the slot being given back.
+	template <class... Args>
+	pointer create(Args &&... args)
+	{
+		pointer p = allocate();
+		try
+		{
+			::new (static_cast<void *>(p)) T(std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			deallocate(p);
+			throw;
+		}
+		return p;
+	}
+
+	//! Expects: p was returned by create().
+	//! Effects: Destroys the object and gives back its slot.
+	void destroy(pointer p) noexcept
+	{
+		p->~T();
+		deallocate(p);
+	}
+
+	//! Returns: A unique_ptr to an object created from args, destroyed by this pool.
+	template <class... Args>
+	unique_ptr_type make_unique(Args &&... args)
+	{
+		return unique_ptr_type(create(std::forward<Args>(args)...), deleter_type(*this));
+	}
+
+	//! Effects: Allocates a chunk so that n slots can be allocated without allocating again.
+	void reserve(size_type n)
+	{
+		size_type const available = capacity_ - size_;
+		if (n > available)
+			add_chunk(n - available);
+	}
+
+	//! Returns: Whether p points to a slot of this pool.
+	//! Complexity: Linear in the number of chunks.
+	bool owns(T const *p) const noexcept
+	{
+		void const *q = p;
+		for (auto const &c : chunks_)
+			if (!less<void const *>()(q, c.first.get()) && less<void const *>()(q, c.first.get() + c.second))
+				return true;
+		return false;
+	}
+
+	//! Returns: The number of slots allocated.
+	size_type size() const noexcept
+	{
+		return size_;
+	}
+	//! Returns: The number of slots of the chunks.
+	size_type capacity() const noexcept
+	{
+		return capacity_;
+	}
+	bool empty() const noexcept
+	{
+		return size_ == 0;
+	}
+
+private:
+	// The free slots remaining in the current chunk are linked into the free list, so that they are not lost.
+	void add_chunk(size_type n)
+	{
+		chunks_.reserve(chunks_.size() + 1);
+		unique_ptr<slot[]> c(new slot[n]);
+		for (; next_ != last_; ++next_)
+		{
+			next_->next_ = free_;
+			free_        = next_;
+		}
+		next_ = c.get();
+		last_ = c.get() + n;
+		chunks_.emplace_back(std::move(c), n);
+		capacity_ += n;
+		if (chunk_size_ < max_chunk_size())
+			chunk_size_ *= 2;
+	}
+
+	vector<pair<unique_ptr<slot[]>, size_type>> chunks_;
+	slot *                                      free_;
+	slot *                                      next_;
+	slot *                                      last_;
+	size_type                                   size_;
+	size_type                                   capacity_;
+	size_type                                   chunk_size_;
+};
+
+} // namespace fundamental_v3
+} // namespace experimental
+} // namespace std
+#endif
+#endif // header
@@ -0,0 +1,62 @@
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// (C) Copyright 2019 Vicente J. Botet Escriba
+
+#ifndef JASEL_EXPERIMENTAL_OBJECT_POOL_POOL_DELETE_HPP
+#define JASEL_EXPERIMENTAL_OBJECT_POOL_POOL_DELETE_HPP
+
+#if __cplusplus >= 201103L
+
+#include <experimental/fundamental/v2/config.hpp>
+#include <experimental/type_traits.hpp>
+
+namespace std
+{
+namespace experimental
+{
+inline namespace fundamental_v3
+{
+
+namespace pool_detail
+{
+// A slot of a pool: the storage of an element when allocated, the link to the next free slot otherwise.
+template <typename T>
+union slot {
+	slot *                   next_;
+	aligned_storage_for_t<T> storage_;
+};
+} // namespace pool_detail
+
+//! The deleter of the unique_ptr to an element created by a pool: destroys the element and gives back its slot.
+template <typename Pool>
+class pool_delete {
+	Pool *pool_;
+
+public:
+	constexpr pool_delete() noexcept
+	        : pool_(nullptr)
+	{
+	}
+	constexpr explicit pool_delete(Pool &pool) noexcept
+	        : pool_(&pool)
+	{
+	}
+
+	void operator()(typename Pool::value_type *p) const noexcept
+	{
+		pool_->destroy(p);
+	}
+
+	constexpr Pool *pool() const noexcept
+	{
+		return pool_;
+	}
+};
+
+} // namespace fundamental_v3
+} // namespace experimental
+} // namespace std
+#endif
+#endif // header
@@ -0,0 +1,86 @@
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// (C) Copyright 2019 Vicente J. Botet Escriba
+
+#ifndef JASEL_EXPERIMENTAL_OBJECT_POOL_POOL_RESOURCE_HPP
+#define JASEL_EXPERIMENTAL_OBJECT_POOL_POOL_RESOURCE_HPP
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<memory_resource>)
+
+#include <experimental/fundamental/v2/config.hpp>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+
+namespace std
+{
+namespace experimental
+{
+inline namespace fundamental_v3
+{
+
+// A memory_resource allocating the blocks that fit in a T from a static_pool<T, N> or an object_pool<T>, and the
+// other ones from an upstream resource, so that the objects allocated by a pmr::polymorphic_allocator<T>, or the
+// nodes of a pmr container when they fit in a T, take the slots of the pool.
+
+template <typename Pool>
+class pool_resource : public pmr::memory_resource {
+	using value_type = typename Pool::value_type;
+
+public:
+	//! Effects: Constructs a resource allocating from pool, and from upstream the blocks that don't fit in a slot.
+	explicit pool_resource(Pool &pool, pmr::memory_resource *upstream = pmr::get_default_resource()) noexcept
+	        : pool_(&pool), upstream_(upstream)
+	{
+	}
+	pool_resource(pool_resource const &) = delete;
+	pool_resource &operator=(pool_resource const &) = delete;
+
+	Pool &pool() const noexcept
+	{
+		return *pool_;
+	}
+	pmr::memory_resource *upstream_resource() const noexcept
+	{
+		return upstream_;
+	}
+
+private:
+	static constexpr bool fits(size_t bytes, size_t alignment) noexcept
+	{
+		return bytes <= sizeof(value_type) && alignment <= alignof(value_type);
+	}
+	void *do_allocate(size_t bytes, size_t alignment) override
+	{
+		if (!fits(bytes, alignment))
+			return upstream_->allocate(bytes, alignment);
+		void *p = pool_->allocate();
+		if (p == nullptr)
+			throw bad_alloc();
+		return p;
+	}
+	void do_deallocate(void *p, size_t bytes, size_t alignment) override
+	{
+		if (fits(bytes, alignment))
+			pool_->deallocate(static_cast<value_type *>(p));
+		else
+			upstream_->deallocate(p, bytes, alignment);
+	}
+	bool do_is_equal(pmr::memory_resource const &other) const noexcept override
+	{
+		return this == &other;
+	}
+
+	Pool *                pool_;
+	pmr::memory_resource *upstream_;
+};
+
+} // namespace fundamental_v3
+} // namespace experimental
+} // namespace std
+#endif
+#endif
+#endif // header
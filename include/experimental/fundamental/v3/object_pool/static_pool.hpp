@@ -0,0 +1,152 @@
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// (C) Copyright 2019 Vicente J. Botet Escriba
+
+#ifndef JASEL_EXPERIMENTAL_OBJECT_POOL_STATIC_POOL_HPP
+#define JASEL_EXPERIMENTAL_OBJECT_POOL_STATIC_POOL_HPP
+
+#if __cplusplus >= 201103L
+
+#include <experimental/contract.hpp>
+#include <experimental/fundamental/v2/config.hpp>
+#include <experimental/fundamental/v3/object_pool/pool_delete.hpp>
+#include <functional>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace std
+{
+namespace experimental
+{
+inline namespace fundamental_v3
+{
+
+// A pool of N slots for objects of type T, embedded in the object as an array of pool_detail::slot.
+// The slots never allocated yet are taken in order from the array by bumping an index, the ones given back are
+// linked through the slot itself in an intrusive free list, that is used first, so that the construction, allocate
+// and deallocate are O(1) and never call the system.
+// The pool is not synchronized and doesn't destroy the objects still alive when it is destroyed.
+
+template <typename T, size_t N>
+class static_pool {
+	static_assert(N > 0, "A static_pool must have at least one slot");
+	using slot = pool_detail::slot<T>;
+
+public:
+	// types:
+	using value_type      = T;
+	using pointer         = T *;
+	using size_type       = size_t;
+	using deleter_type    = pool_delete<static_pool>;
+	using unique_ptr_type = unique_ptr<T, deleter_type>;
+
+	//! Effects: Constructs a pool with all its slots free.
+	//! Complexity: Constant, the slots are not initialized.
+	static_pool() noexcept
+	        : free_(nullptr), unused_(0), size_(0)
+	{
+	}
+	static_pool(static_pool const &) = delete;
+	static_pool &operator=(static_pool const &) = delete;
+
+	//! Returns: The storage for a T, or nullptr if full().
+	pointer allocate() noexcept
+	{
+		slot *s = free_;
+		if (s != nullptr)
+			free_ = s->next_;
+		else if (unused_ < N)
+			s = &slots_[unused_++];
+		else
+			return nullptr;
+		++size_;
+		return reinterpret_cast<pointer>(s);
+	}
+
+	//! Expects: p was returned by allocate() and its object, if any, is destroyed.
+	//! Effects: Gives back the slot of p.
+	void deallocate(pointer p) noexcept
+	{
+		JASEL_EXPECTS(owns(p) && "try to deallocate a pointer not allocated by this pool");
+		slot *s  = reinterpret_cast<slot *>(p);
+		s->next_ = free_;
+		free_    = s;
+		--size_;
+	}
+
+	//! Effects: Constructs a T from args in a slot.
+	//! Returns: A pointer to the object.
+	//! Throws: bad_alloc if full(), or what the constructor throws, the slot being given back.
+	template <class... Args>
+	pointer create(Args &&... args)
+	{
+		pointer p = allocate();
+		if (p == nullptr)
+			throw bad_alloc();
+		try
+		{
+			::new (static_cast<void *>(p)) T(std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			deallocate(p);
+			throw;
+		}
+		return p;
+	}
+
+	//! Expects: p was returned by create().
+	//! Effects: Destroys the object and gives back its slot.
+	void destroy(pointer p) noexcept
+	{
+		p->~T();
+		deallocate(p);
+	}
+
+	//! Returns: A unique_ptr to an object created from args, destroyed by this pool.
+	template <class... Args>
+	unique_ptr_type make_unique(Args &&... args)
+	{
+		return unique_ptr_type(create(std::forward<Args>(args)...), deleter_type(*this));
+	}
+
+	//! Returns: Whether p points to a slot of this pool.
+	bool owns(T const *p) const noexcept
+	{
+		void const *q = p;
+		return !less<void const *>()(q, slots_) && less<void const *>()(q, slots_ + N);
+	}
+
+	//! Returns: The number of slots allocated.
+	size_type size() const noexcept
+	{
+		return size_;
+	}
+	static constexpr size_type capacity() noexcept
+	{
+		return N;
+	}
+	bool empty() const noexcept
+	{
+		return size_ == 0;
+	}
+	bool full() const noexcept
+	{
+		return size_ == N;
+	}
+
+private:
+	slot      slots_[N];
+	slot *    free_;
+	size_type unused_;
+	size_type size_;
+};
+
+} // namespace fundamental_v3
+} // namespace experimental
+} // namespace std
+#endif
+#endif // header
@@ -28,6 +28,8 @@ We can say that
 #include <cassert>
 #include <iterator>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 namespace std
 {
@@ -283,6 +285,15 @@ public:
 		std::fill_n(begin(), size(), value);
 	}
 
+	//! \n<b>Pre-condition:</b> <tt>pos(first) <= pos(last)</tt>
+	//! \n<b>Effects:</b> Assigns `value` to the elements whose key is in the closed range [first, last], as does
+	//! `std::fill` over `make_range(first, last)`.
+	void fill(key_type first, key_type last, const T &value)
+	{
+		assert(ordinal::pos(first) <= ordinal::pos(last) && "invalid range");
+		std::fill(data() + ordinal::pos(first), data() + ordinal::pos(last) + 1, value);
+	}
+
 	//! check range (may be private because it is static)
 	static size_type rangecheck(key_type k)
 	{
@@ -351,6 +362,64 @@ inline void swap(ordinal_array<T, O> &x, ordinal_array<T, O> &y)
 	x.swap(y);
 }
 
+// bulk operations
+//
+// The loops are over the positions and access the elements directly, so that
+// they vectorize when the functions are inlined.
+
+//! \n<b>Returns:</b> The array whose element with key `k` is `f(k)`.
+//! \n<b>Complexity:</b> \c meta::size<O>::value calls to `f`, in increasing position.
+template <class T, typename O, class F>
+JASEL_CXX14_CONSTEXPR ordinal_array<T, O> tabulate(F f)
+{
+	ordinal_array<T, O> r{};
+	for (ordinal::index_t i = 0; i < r.static_size; ++i)
+		r.elems[i] = f(ordinal::val<O>(i));
+	return r;
+}
+
+//! \n<b>Returns:</b> The array whose element with key `k` is `f(a[k])`.
+template <class T, typename O, class F>
+JASEL_CXX14_CONSTEXPR ordinal_array<decay_t<decltype(declval<F &>()(declval<T const &>()))>, O>
+transform(ordinal_array<T, O> const &a, F f)
+{
+	ordinal_array<decay_t<decltype(declval<F &>()(declval<T const &>()))>, O> r{};
+	for (ordinal::index_t i = 0; i < r.static_size; ++i)
+		r.elems[i] = f(a.elems[i]);
+	return r;
+}
+
+//! \n<b>Returns:</b> The array whose element with key `k` is `f(a[k], b[k])`.
+template <class T, class U, typename O, class F>
+JASEL_CXX14_CONSTEXPR ordinal_array<decay_t<decltype(declval<F &>()(declval<T const &>(), declval<U const &>()))>, O>
+transform(ordinal_array<T, O> const &a, ordinal_array<U, O> const &b, F f)
+{
+	ordinal_array<decay_t<decltype(declval<F &>()(declval<T const &>(), declval<U const &>()))>, O> r{};
+	for (ordinal::index_t i = 0; i < r.static_size; ++i)
+		r.elems[i] = f(a.elems[i], b.elems[i]);
+	return r;
+}
+
+//! \n<b>Returns:</b> The left fold of the elements by `op`, starting from `init`, in increasing position.
+//! \n<b>Note:</b> As for `std::accumulate`, the compiler vectorizes the fold only when it may reassociate `op`, e.g.
+//! an integral addition.
+template <class T, typename O, class U, class BinaryOperation>
+JASEL_CXX14_CONSTEXPR U reduce(ordinal_array<T, O> const &a, U init, BinaryOperation op)
+{
+	for (ordinal::index_t i = 0; i < a.static_size; ++i)
+		init = op(std::move(init), a.elems[i]);
+	return init;
+}
+
+//! \n<b>Returns:</b> The sum of `init` and the elements.
+template <class T, typename O, class U>
+JASEL_CXX14_CONSTEXPR U reduce(ordinal_array<T, O> const &a, U init)
+{
+	for (ordinal::index_t i = 0; i < a.static_size; ++i)
+		init = std::move(init) + a.elems[i];
+	return init;
+}
+
 #if 0
 
     template <typename T, typename O>
@@ -0,0 +1,274 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Vicente J. Botet Escriba 2019.
+// Distributed under the Boost
+// Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or
+// copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Based on the <set> interface
+//
+//////////////////////////////////////////////////////////////////////////////
+
+/*!
+\file
+\brief
+The header \c <experimental/ordinal_dense_set.hpp> defines a class template \c ordinal_dense_set<OKey> for storing
+sets of Ordinal types with the interface of \c std::set.
+We can say that
+\c ordinal_dense_set is the counterpart of \c ordinal_ordered_set when the key space is dense: the set is an
+\c ordinal_set<OKey>, having a bit for each ordinal of \c OKey, instead of the nodes of a tree.
+*/
+
+#ifndef JASEL_FUNDAMENTAL_V3_ORDINAL_ORDINAL_DENSE_SET_HPP
+#define JASEL_FUNDAMENTAL_V3_ORDINAL_ORDINAL_DENSE_SET_HPP
+
+#include <experimental/ordinal.hpp>
+#include <experimental/ordinal_set.hpp>
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+namespace std
+{
+namespace experimental
+{
+inline namespace fundamental_v3
+{
+
+    /**
+      @tparam OKey set's element ordinal
+
+      <b>Requires:</b> `OKey` must be a model of <em>Ordinal</em>.
+
+     An `ordinal_dense_set<OKey>` is an associative container with unique keys providing the interface of `std::set`,
+     except that there is neither comparator nor allocator: the keys present are the bits set of an
+     `ordinal_set<OKey>`.
+
+     - `insert`, `erase` and `find` are O(1) and never allocate.
+     - The iteration visits the keys in increasing position, walking the bits set.
+     - As for `std::set`, inserting or erasing a key doesn't invalidate the iterators to the other keys.
+     */
+    template <typename OKey>
+    class ordinal_dense_set
+    {
+      static constexpr size_t N = size_t(ordinal::meta::size<OKey>::value);
+    public:
+      // type definitions
+      using key_type = OKey;
+      using value_type = OKey;
+      using size_type = std::size_t;
+      using difference_type = std::ptrdiff_t;
+      using reference = value_type const&;
+      using const_reference = value_type const&;
+
+      //! @brief A forward iterator over the keys, in increasing position.
+      class const_iterator {
+        friend class ordinal_dense_set;
+        ordinal_set<OKey> const* keys_;
+        size_t pos_;
+        constexpr const_iterator(ordinal_set<OKey> const* keys, size_t pos) noexcept
+        : keys_(keys), pos_(pos)
+        { }
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = OKey;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = OKey;
+
+        constexpr const_iterator() noexcept
+        : keys_(nullptr), pos_(0)
+        { }
+        //! \n<b>Returns:</b> The ordinal.
+        constexpr OKey operator*() const noexcept
+        {
+          return ordinal::val<OKey>(ordinal::index_t(pos_));
+        }
+        JASEL_CXX14_CONSTEXPR const_iterator& operator++() noexcept
+        {
+          pos_ = keys_->detail_bits().find_next(pos_);
+          return *this;
+        }
+        JASEL_CXX14_CONSTEXPR const_iterator operator++(int) noexcept
+        {
+          const_iterator tmp(*this);
+          ++*this;
+          return tmp;
+        }
+        friend constexpr bool operator==(const_iterator const& x, const_iterator const& y) noexcept
+        {
+          return x.pos_ == y.pos_;
+        }
+        friend constexpr bool operator!=(const_iterator const& x, const_iterator const& y) noexcept
+        {
+          return x.pos_ != y.pos_;
+        }
+      };
+      using iterator = const_iterator;
+
+      // construct/copy/destroy
+
+      //! \n<b>Effects:</b> Constructs an empty set.
+      constexpr ordinal_dense_set() noexcept
+        : keys_()
+      {
+      }
+
+      //! \n<b>Effects:</b> Constructs a set having the keys set in `keys`.
+      constexpr explicit ordinal_dense_set(ordinal_set<OKey> const& keys) noexcept
+        : keys_(keys)
+      {
+      }
+
+      ordinal_dense_set(std::initializer_list<value_type> il)
+        : keys_()
+      {
+        insert(il);
+      }
+
+      template <class InputIterator, class = typename iterator_traits<InputIterator>::iterator_category>
+      ordinal_dense_set(InputIterator first, InputIterator last)
+        : keys_()
+      {
+        insert(first, last);
+      }
+
+      ordinal_dense_set& operator=(std::initializer_list<value_type> il)
+      {
+        clear();
+        insert(il);
+        return *this;
+      }
+
+      // iterators
+      JASEL_CXX14_CONSTEXPR const_iterator begin() const noexcept
+      {
+        return const_iterator(&keys_, keys_.detail_bits().find_first());
+      }
+      constexpr const_iterator cbegin() const noexcept { return begin(); }
+      constexpr const_iterator end() const noexcept { return const_iterator(&keys_, N); }
+      constexpr const_iterator cend() const noexcept { return end(); }
+
+      // capacity
+      constexpr bool empty() const noexcept { return keys_.none(); }
+      //! \n<b>Returns:</b> The number of keys, the count of the bits set of `keys()`.
+      constexpr size_type size() const noexcept { return size_type(keys_.count()); }
+      //! \n<b>Returns:</b> The number of ordinals of `OKey`.
+      constexpr size_type max_size() const noexcept { return N; }
+
+      // modifiers
+
+      //! \n<b>Effects:</b> Inserts `k` if it is not in `*this`.
+      //! \n<b>Returns:</b> The iterator to `k` and whether it was inserted.
+      pair<iterator, bool> insert(value_type const& k)
+      {
+        bool const inserted = ! contains(k);
+        keys_.set(k);
+        return pair<iterator, bool>(iterator(&keys_, to_pos(k)), inserted);
+      }
+      template <class InputIterator>
+      void insert(InputIterator first, InputIterator last)
+      {
+        for (; first != last; ++first)
+          keys_.set(*first);
+      }
+      void insert(std::initializer_list<value_type> il)
+      {
+        insert(il.begin(), il.end());
+      }
+      template <class... Args>
+      pair<iterator, bool> emplace(Args&&... args)
+      {
+        return insert(value_type(std::forward<Args>(args)...));
+      }
+
+      //! \n<b>Effects:</b> Erases `k` if it is in `*this`.
+      //! \n<b>Returns:</b> The number of keys erased.
+      size_type erase(key_type const& k) noexcept
+      {
+        if (! contains(k))
+          return 0;
+        keys_.reset(k);
+        return 1;
+      }
+      //! \n<b>Pre-condition:</b> `it` is a dereferenceable iterator of `*this`.
+      //! \n<b>Effects:</b> Erases the key referred by `it`.
+      //! \n<b>Returns:</b> The iterator following `it` before the key is erased.
+      iterator erase(const_iterator it) noexcept
+      {
+        iterator next(&keys_, keys_.detail_bits().find_next(it.pos_));
+        keys_.detail_bits().reset(it.pos_);
+        return next;
+      }
+      iterator erase(const_iterator first, const_iterator last) noexcept
+      {
+        while (first != last)
+          first = erase(first);
+        return last;
+      }
+
+      void clear() noexcept
+      {
+        keys_.reset();
+      }
+
+      void swap(ordinal_dense_set& x) noexcept
+      {
+        std::swap(keys_, x.keys_);
+      }
+
+      // lookup
+      //! \n<b>Returns:</b> The iterator to `k`, or `end()` if `k` is not in `*this`.
+      constexpr const_iterator find(key_type const& k) const noexcept
+      {
+        return const_iterator(&keys_, contains(k) ? to_pos(k) : N);
+      }
+      constexpr size_type count(key_type const& k) const noexcept
+      {
+        return contains(k) ? 1 : 0;
+      }
+      constexpr bool contains(key_type const& k) const noexcept
+      {
+        return keys_[k];
+      }
+
+      //! \n<b>Returns:</b> The set of the keys.
+      constexpr ordinal_set<OKey> const& keys() const noexcept
+      {
+        return keys_;
+      }
+
+    private:
+      static constexpr size_t to_pos(key_type const& k) noexcept
+      {
+        return size_t(ordinal::pos(k));
+      }
+
+      ordinal_set<OKey> keys_;
+    };
+
+    // comparisons
+    template <typename OKey>
+    constexpr bool operator==(const ordinal_dense_set<OKey>& x, const ordinal_dense_set<OKey>& y) noexcept
+    {
+      return x.keys() == y.keys();
+    }
+    template <typename OKey>
+    constexpr bool operator!=(const ordinal_dense_set<OKey>& x, const ordinal_dense_set<OKey>& y) noexcept
+    {
+      return !(x == y);
+    }
+
+    template <typename OKey>
+    void swap(ordinal_dense_set<OKey>& x, ordinal_dense_set<OKey>& y) noexcept
+    {
+      x.swap(y);
+    }
+
+}} // experimental::fundamental_v3
+} // std
+
+#endif // header
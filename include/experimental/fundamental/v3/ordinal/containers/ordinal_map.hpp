@@ -0,0 +1,445 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Vicente J. Botet Escriba 2019.
+// Distributed under the Boost
+// Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or
+// copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Based on the <map> interface
+//
+//////////////////////////////////////////////////////////////////////////////
+
+/*!
+\file
+\brief
+The header \c <experimental/ordinal_map.hpp> defines a class template \c ordinal_map<OKey, T> for storing
+associative containers having an Ordinal key.
+We can say that
+\c ordinal_map is the counterpart of \c ordinal_ordered_map when the key space is dense: instead of the nodes of a
+tree, there is a slot for each ordinal of \c OKey and an \c ordinal_set<OKey> telling which slots are occupied.
+*/
+
+#ifndef JASEL_FUNDAMENTAL_V3_ORDINAL_ORDINAL_MAP_HPP
+#define JASEL_FUNDAMENTAL_V3_ORDINAL_ORDINAL_MAP_HPP
+
+#include <experimental/ordinal.hpp>
+#include <experimental/ordinal_array.hpp>
+#include <experimental/ordinal_set.hpp>
+#include <experimental/type_traits.hpp>
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+namespace std
+{
+namespace experimental
+{
+inline namespace fundamental_v3
+{
+
+    /**
+      @tparam OKey map's key ordinal
+      @tparam T map's mapped type
+
+      <b>Requires:</b> `OKey` must be a model of <em>Ordinal</em>.
+
+     An `ordinal_map<OKey, T>` is an associative container with unique keys providing the interface of `std::map`,
+     except that there is neither comparator nor allocator: the elements are stored in an
+     `ordinal_array<storage, OKey>` having a slot for each ordinal of `OKey`, and the keys present are the bits set of
+     an `ordinal_set<OKey>`.
+
+     - `insert`, `erase` and `find` are O(1) and never allocate.
+     - The iteration visits the elements in the order of the position of their key, walking the bits set.
+     - As for `std::map`, inserting or erasing an element doesn't invalidate the iterators to the other elements.
+
+     The slot of an element stores its `value_type`, so that `*it` is a `std::pair<const OKey, T>&` as for `std::map`.
+     */
+    template <typename OKey, class T>
+    class ordinal_map
+    {
+      static constexpr size_t N = size_t(ordinal::meta::size<OKey>::value);
+    public:
+      // type definitions
+      using key_type = OKey;
+      using mapped_type = T;
+      using value_type = pair<const OKey, T>;
+      using size_type = std::size_t;
+      using difference_type = std::ptrdiff_t;
+      using reference = value_type&;
+      using const_reference = value_type const&;
+      using pointer = value_type*;
+      using const_pointer = value_type const*;
+
+    private:
+      //! @brief A forward iterator over the elements, in increasing position of their key.
+      template <bool Const>
+      class iterator_t {
+        friend class ordinal_map;
+        template <bool> friend class iterator_t;
+        using map_type = conditional_t<Const, ordinal_map const, ordinal_map>;
+        map_type* map_;
+        size_t pos_;
+        iterator_t(map_type* m, size_t pos) noexcept
+        : map_(m), pos_(pos)
+        { }
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename ordinal_map::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = conditional_t<Const, value_type const*, value_type*>;
+        using reference = conditional_t<Const, value_type const&, value_type&>;
+
+        iterator_t() noexcept
+        : map_(nullptr), pos_(0)
+        { }
+        //! conversion from iterator to const_iterator
+        template <bool C = Const, class = enable_if_t<C>>
+        iterator_t(iterator_t<false> const& x) noexcept
+        : map_(x.map_), pos_(x.pos_)
+        { }
+
+        reference operator*() const noexcept
+        {
+          return *map_->slot(pos_);
+        }
+        pointer operator->() const noexcept
+        {
+          return map_->slot(pos_);
+        }
+        iterator_t& operator++() noexcept
+        {
+          pos_ = map_->keys_.detail_bits().find_next(pos_);
+          return *this;
+        }
+        iterator_t operator++(int) noexcept
+        {
+          iterator_t tmp(*this);
+          ++*this;
+          return tmp;
+        }
+        friend bool operator==(iterator_t const& x, iterator_t const& y) noexcept
+        {
+          return x.pos_ == y.pos_;
+        }
+        friend bool operator!=(iterator_t const& x, iterator_t const& y) noexcept
+        {
+          return x.pos_ != y.pos_;
+        }
+      };
+
+    public:
+      using iterator = iterator_t<false>;
+      using const_iterator = iterator_t<true>;
+
+      // construct/copy/destroy
+
+      //! \n<b>Effects:</b> Constructs an empty map.
+      ordinal_map() noexcept
+        : keys_()
+      {
+      }
+
+      //! \n<b>Effects:</b> Constructs a map with the elements of `il`. When several have the same key only the first
+      //! one is inserted.
+      ordinal_map(std::initializer_list<value_type> il)
+        : ordinal_map()
+      {
+        insert(il);
+      }
+
+      template <class InputIterator, class = typename iterator_traits<InputIterator>::iterator_category>
+      ordinal_map(InputIterator first, InputIterator last)
+        : ordinal_map()
+      {
+        insert(first, last);
+      }
+
+      ordinal_map(ordinal_map const& x)
+        : ordinal_map()
+      {
+        copy_from(x);
+      }
+
+      ordinal_map(ordinal_map&& x) noexcept(is_nothrow_move_constructible<T>::value)
+        : ordinal_map()
+      {
+        move_from(x);
+      }
+
+      ~ordinal_map()
+      {
+        clear();
+      }
+
+      ordinal_map& operator=(ordinal_map const& x)
+      {
+        if (this != &x)
+        {
+          clear();
+          copy_from(x);
+        }
+        return *this;
+      }
+
+      ordinal_map& operator=(ordinal_map&& x) noexcept(is_nothrow_move_constructible<T>::value)
+      {
+        if (this != &x)
+        {
+          clear();
+          move_from(x);
+        }
+        return *this;
+      }
+
+      ordinal_map& operator=(std::initializer_list<value_type> il)
+      {
+        clear();
+        insert(il);
+        return *this;
+      }
+
+      // iterators
+      iterator begin() noexcept { return iterator(this, keys_.detail_bits().find_first()); }
+      const_iterator begin() const noexcept { return const_iterator(this, keys_.detail_bits().find_first()); }
+      const_iterator cbegin() const noexcept { return begin(); }
+      iterator end() noexcept { return iterator(this, N); }
+      const_iterator end() const noexcept { return const_iterator(this, N); }
+      const_iterator cend() const noexcept { return end(); }
+
+      // capacity
+      bool empty() const noexcept { return keys_.none(); }
+      //! \n<b>Returns:</b> The number of elements, the count of the bits set of `keys()`.
+      size_type size() const noexcept { return size_type(keys_.count()); }
+      //! \n<b>Returns:</b> The number of ordinals of `OKey`.
+      constexpr size_type max_size() const noexcept { return N; }
+
+      // element access
+
+      //! \n<b>Effects:</b> Inserts a value-initialized element with key `k` if there is none.
+      //! \n<b>Returns:</b> The mapped value of the element with key `k`.
+      mapped_type& operator[](key_type const& k)
+      {
+        return try_emplace(k).first->second;
+      }
+
+      //! \n<b>Returns:</b> The mapped value of the element with key `k`.
+      //! \n<b>Throws:</b> `std::out_of_range` if there is no element with key `k`.
+      mapped_type& at(key_type const& k)
+      {
+        return slot(rangecheck(k))->second;
+      }
+      mapped_type const& at(key_type const& k) const
+      {
+        return slot(rangecheck(k))->second;
+      }
+
+      // modifiers
+
+      //! \n<b>Effects:</b> Inserts `v` if there is no element with the key `v.first`.
+      //! \n<b>Returns:</b> The iterator to the element with the key `v.first` and whether `v` was inserted.
+      pair<iterator, bool> insert(value_type const& v)
+      {
+        return emplace_key(v.first, v);
+      }
+      pair<iterator, bool> insert(value_type&& v)
+      {
+        return emplace_key(v.first, std::move(v));
+      }
+      template <class InputIterator>
+      void insert(InputIterator first, InputIterator last)
+      {
+        for (; first != last; ++first)
+          insert(*first);
+      }
+      void insert(std::initializer_list<value_type> il)
+      {
+        insert(il.begin(), il.end());
+      }
+
+      //! \n<b>Effects:</b> Constructs a `value_type` from `args` and inserts it if there is no element with its key.
+      template <class... Args>
+      pair<iterator, bool> emplace(Args&&... args)
+      {
+        return insert(value_type(std::forward<Args>(args)...));
+      }
+
+      //! \n<b>Effects:</b> If there is no element with key `k`, inserts one whose mapped value is constructed from
+      //! `args`, otherwise does nothing.
+      //! \n<b>Returns:</b> The iterator to the element with the key `k` and whether it was inserted.
+      template <class... Args>
+      pair<iterator, bool> try_emplace(key_type const& k, Args&&... args)
+      {
+        return emplace_key(k, piecewise_construct, std::forward_as_tuple(k),
+                           std::forward_as_tuple(std::forward<Args>(args)...));
+      }
+
+      //! \n<b>Effects:</b> Inserts an element with key `k` and mapped value `obj` if there is none, otherwise assigns
+      //! `obj` to the mapped value.
+      template <class M>
+      pair<iterator, bool> insert_or_assign(key_type const& k, M&& obj)
+      {
+        size_t const pos = to_pos(k);
+        if (contains(k))
+        {
+          slot(pos)->second = std::forward<M>(obj);
+          return pair<iterator, bool>(iterator(this, pos), false);
+        }
+        return emplace_key(k, k, std::forward<M>(obj));
+      }
+
+      //! \n<b>Effects:</b> Erases the element with key `k` if any.
+      //! \n<b>Returns:</b> The number of elements erased.
+      size_type erase(key_type const& k) noexcept
+      {
+        if (! contains(k))
+          return 0;
+        destroy(to_pos(k));
+        keys_.reset(k);
+        return 1;
+      }
+      //! \n<b>Pre-condition:</b> `it` is a dereferenceable iterator of `*this`.
+      //! \n<b>Effects:</b> Erases the element referred by `it`.
+      //! \n<b>Returns:</b> The iterator following `it` before the element is erased.
+      iterator erase(const_iterator it) noexcept
+      {
+        size_t const pos = it.pos_;
+        iterator next(this, keys_.detail_bits().find_next(pos));
+        destroy(pos);
+        keys_.detail_bits().reset(pos);
+        return next;
+      }
+      iterator erase(const_iterator first, const_iterator last) noexcept
+      {
+        while (first != last)
+          first = erase(first);
+        return iterator(this, last.pos_);
+      }
+
+      void clear() noexcept
+      {
+        keys_.detail_bits().for_each_set([this](size_t pos) { destroy(pos); });
+        keys_.reset();
+      }
+
+      void swap(ordinal_map& x)
+      {
+        ordinal_map tmp(std::move(x));
+        x = std::move(*this);
+        *this = std::move(tmp);
+      }
+
+      // lookup
+      //! \n<b>Returns:</b> The iterator to the element with key `k`, or `end()` if there is none.
+      iterator find(key_type const& k) noexcept
+      {
+        return iterator(this, contains(k) ? to_pos(k) : N);
+      }
+      const_iterator find(key_type const& k) const noexcept
+      {
+        return const_iterator(this, keys_[k] ? to_pos(k) : N);
+      }
+      size_type count(key_type const& k) const noexcept
+      {
+        return keys_[k] ? 1 : 0;
+      }
+      bool contains(key_type const& k) const noexcept
+      {
+        return keys_[k];
+      }
+
+      //! \n<b>Returns:</b> The set of the keys of the elements.
+      ordinal_set<OKey> const& keys() const noexcept
+      {
+        return keys_;
+      }
+
+    private:
+      using storage_type = aligned_storage_for_t<value_type>;
+
+      static size_t to_pos(key_type const& k) noexcept
+      {
+        return size_t(ordinal::pos(k));
+      }
+      value_type* slot(size_t pos) noexcept
+      {
+        return reinterpret_cast<value_type*>(&slots_.data()[pos]);
+      }
+      value_type const* slot(size_t pos) const noexcept
+      {
+        return reinterpret_cast<value_type const*>(&slots_.data()[pos]);
+      }
+      size_t rangecheck(key_type const& k) const
+      {
+        if (! keys_[k])
+          throw std::out_of_range("ordinal_map<>: key not found");
+        return to_pos(k);
+      }
+
+      template <class... Args>
+      pair<iterator, bool> emplace_key(key_type const& k, Args&&... args)
+      {
+        size_t const pos = to_pos(k);
+        if (contains(k))
+          return pair<iterator, bool>(iterator(this, pos), false);
+        ::new (static_cast<void*>(slot(pos))) value_type(std::forward<Args>(args)...);
+        keys_.set(k);
+        return pair<iterator, bool>(iterator(this, pos), true);
+      }
+      void destroy(size_t pos) noexcept
+      {
+        slot(pos)->~value_type();
+      }
+      // On exception the elements already copied are destroyed by the destructor.
+      void copy_from(ordinal_map const& x)
+      {
+        x.keys_.detail_bits().for_each_set([this, &x](size_t pos) {
+          ::new (static_cast<void*>(slot(pos))) value_type(*x.slot(pos));
+          keys_.detail_bits().set(pos);
+        });
+      }
+      void move_from(ordinal_map& x)
+      {
+        x.keys_.detail_bits().for_each_set([this, &x](size_t pos) {
+          ::new (static_cast<void*>(slot(pos))) value_type(std::move(*x.slot(pos)));
+          keys_.detail_bits().set(pos);
+        });
+      }
+
+      ordinal_set<OKey> keys_;
+      ordinal_array<storage_type, OKey> slots_;
+    };
+
+    // comparisons
+    //! \n<b>Returns:</b> Whether `x` and `y` have the same keys and the same mapped values.
+    template <typename OKey, class T>
+    bool operator==(const ordinal_map<OKey, T>& x, const ordinal_map<OKey, T>& y)
+    {
+      if (x.keys() != y.keys())
+        return false;
+      for (auto const& v : x)
+        if (! (v.second == y.find(v.first)->second))
+          return false;
+      return true;
+    }
+    template <typename OKey, class T>
+    bool operator!=(const ordinal_map<OKey, T>& x, const ordinal_map<OKey, T>& y)
+    {
+      return !(x == y);
+    }
+
+    template <typename OKey, class T>
+    void swap(ordinal_map<OKey, T>& x, ordinal_map<OKey, T>& y)
+    {
+      x.swap(y);
+    }
+
+}} // experimental::fundamental_v3
+} // std
+
+#endif // header
@@ -15,6 +15,7 @@ The header \c <experimantal/ordinal_ordered_map.hpp> defines a alias template fo
 ordered maps having an Ordinal key.
 We can say that
 \c ordinal_ordered_map is the counterpart of \c std::map when the key is an Ordinal type and it compares by default using the ordinal::less comparator.
+When the key space is small and dense, \c ordinal_map provides the same interface without allocating.
 */
 
 #ifndef JASEL_FUNDAMENTAL_V3_ORDINAL_ORDINAL_AORDERED_MAP_HPP
@@ -15,6 +15,7 @@ The header \c <experimantal/ordinal_ordered_set.hpp> defines a alias template fo
 Ordinal types ordered by his position.
 We can say that
 \c ordinal_ordered_set is the counterpart of \c std::set when the key is an `Ordinal` type and it compares by default using the ordinal::less comparator.
+When the key space is small and dense, \c ordinal_dense_set provides the same interface without allocating.
 */
 
 #ifndef JASEL_FUNDAMENTAL_V3_ORDINAL_ORDINAL_ORDERED_SET_HPP
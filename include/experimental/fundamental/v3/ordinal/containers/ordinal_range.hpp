@@ -19,10 +19,11 @@
 
 #include <experimental/ordinal.hpp>
 
-#include <boost/iterator/iterator_facade.hpp>
 #include <boost/range/iterator_range.hpp>
+#include <cstddef>
 #include <iosfwd>
 #include <iostream>
+#include <iterator>
 
 namespace std
 {
@@ -39,69 +40,126 @@ inline namespace fundamental_v3
         // This is useful for implementing the ordinal_range<E>()
         // function.
         //
-        // @par Note:
-        // The use of this iterator and ordinal_range<E>() is appreciably less
-        // performant than the corresponding hand-written integer
-        // loop on many compilers.
+        // The iterator stores the position only, so that advancing it and
+        // computing a distance are integer operations, and it satisfies the
+        // requirements of a random access iterator: the standard algorithms,
+        // including the parallel ones, can split an ordinal_range in chunks.
+        // The value is obtained by ordinal::val on dereference, so that a loop
+        // over an ordinal_range vectorizes as the corresponding hand-written
+        // integer loop as soon as ordinal::val is an inline function of the
+        // position.
 
         //! ordinal_iterator is a model of RandomAccessIterator
         template<typename T /* , typename Traits=ordinal_range_traits<T> */ >
         class ordinal_iterator
-            : public boost::iterator_facade<
-                        ordinal_iterator<T>,
-                        T,
-                        boost::random_access_traversal_tag,
-                        T,
-                        std::ptrdiff_t
-                    >
         {
-            typedef boost::iterator_facade<
-                        ordinal_iterator<T>,
-                        T,
-                        boost::random_access_traversal_tag,
-                        T,
-                        std::ptrdiff_t
-                    > base_t;
         public:
-            typedef typename base_t::value_type value_type;
-            typedef typename base_t::difference_type difference_type;
-            typedef typename base_t::reference reference;
+            typedef std::random_access_iterator_tag iterator_category;
+            typedef T value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef T reference;
 
-            ordinal_iterator() : index_(0u) {}
-            explicit ordinal_iterator(ordinal::index_t x) : index_(x) {}
+            //! As the reference is a value, the pointer holds a copy of it.
+            class pointer
+            {
+                T value_;
+            public:
+                constexpr explicit pointer(T v) : value_(v) {}
+                constexpr T const* operator->() const { return &value_; }
+            };
 
-        private:
-            void increment()
+            constexpr ordinal_iterator() noexcept : index_(0u) {}
+            constexpr explicit ordinal_iterator(ordinal::index_t x) noexcept : index_(x) {}
+
+            constexpr reference operator*() const
             {
-                ++index_;
+                return ordinal::val<T>(index_);
+            }
+            constexpr pointer operator->() const
+            {
+                return pointer(**this);
+            }
+            constexpr reference operator[](difference_type n) const
+            {
+                return ordinal::val<T>(ordinal::index_t(difference_type(index_) + n));
             }
 
-            void decrement()
+            JASEL_CXX14_CONSTEXPR ordinal_iterator& operator++() noexcept
+            {
+                ++index_;
+                return *this;
+            }
+            JASEL_CXX14_CONSTEXPR ordinal_iterator operator++(int) noexcept
+            {
+                ordinal_iterator tmp(*this);
+                ++index_;
+                return tmp;
+            }
+            JASEL_CXX14_CONSTEXPR ordinal_iterator& operator--() noexcept
             {
                 --index_;
+                return *this;
             }
-
-            void advance(difference_type offset)
+            JASEL_CXX14_CONSTEXPR ordinal_iterator operator--(int) noexcept
             {
-                index_ += offset;
+                ordinal_iterator tmp(*this);
+                --index_;
+                return tmp;
             }
-
-            difference_type distance_to(const ordinal_iterator& other) const
+            JASEL_CXX14_CONSTEXPR ordinal_iterator& operator+=(difference_type n) noexcept
+            {
+                index_ = ordinal::index_t(difference_type(index_) + n);
+                return *this;
+            }
+            JASEL_CXX14_CONSTEXPR ordinal_iterator& operator-=(difference_type n) noexcept
             {
-                return other.index_ - index_;
+                index_ = ordinal::index_t(difference_type(index_) - n);
+                return *this;
             }
 
-            bool equal(const ordinal_iterator& other) const
+            friend constexpr ordinal_iterator operator+(ordinal_iterator it, difference_type n) noexcept
+            {
+                return ordinal_iterator(ordinal::index_t(difference_type(it.index_) + n));
+            }
+            friend constexpr ordinal_iterator operator+(difference_type n, ordinal_iterator it) noexcept
+            {
+                return it + n;
+            }
+            friend constexpr ordinal_iterator operator-(ordinal_iterator it, difference_type n) noexcept
             {
-                return index_ == other.index_;
+                return ordinal_iterator(ordinal::index_t(difference_type(it.index_) - n));
+            }
+            friend constexpr difference_type operator-(ordinal_iterator x, ordinal_iterator y) noexcept
+            {
+                return difference_type(x.index_) - difference_type(y.index_);
             }
 
-            reference dereference() const
+            friend constexpr bool operator==(ordinal_iterator x, ordinal_iterator y) noexcept
             {
-                return ordinal::val<T>(index_);
+                return x.index_ == y.index_;
+            }
+            friend constexpr bool operator!=(ordinal_iterator x, ordinal_iterator y) noexcept
+            {
+                return x.index_ != y.index_;
+            }
+            friend constexpr bool operator<(ordinal_iterator x, ordinal_iterator y) noexcept
+            {
+                return x.index_ < y.index_;
+            }
+            friend constexpr bool operator>(ordinal_iterator x, ordinal_iterator y) noexcept
+            {
+                return y.index_ < x.index_;
+            }
+            friend constexpr bool operator<=(ordinal_iterator x, ordinal_iterator y) noexcept
+            {
+                return !(y.index_ < x.index_);
+            }
+            friend constexpr bool operator>=(ordinal_iterator x, ordinal_iterator y) noexcept
+            {
+                return !(x.index_ < y.index_);
             }
 
-            friend class ::boost::iterator_core_access;
+        private:
             ordinal::index_t index_;
         };
     } // namespace ordinal_detail
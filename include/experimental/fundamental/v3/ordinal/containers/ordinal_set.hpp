@@ -16,20 +16,29 @@
  The header `<experimental/ordinal_set.hpp>` defines a class template `ordinal_set<T>` for managing sets of ordinals and several
  //! related functions for representing and manipulating sets of ordinals. We can say that
  `ordinal_set` is the counterpart of `std::bitset` when the index are ordinals.
+
+ The bits are stored in a `bit_mask` of the smallest unsigned type having `ordinal::meta::size<T>::value` digits, or in
+ an array of `uint64_t` when there are more than 64 ordinals, so that a set of up to 8 ordinals takes a single byte.
+ All the operations are `constexpr` (the modifiers since C++14).
  */
 
 #ifndef JASEL_FUNDAMENTAL_V3_ORDINAL_ORDINAL_SET_HPP
 #define JASEL_FUNDAMENTAL_V3_ORDINAL_ORDINAL_SET_HPP
 
 #include <experimental/ordinal.hpp>
+#include <experimental/bit_mask.hpp>
+#include <experimental/fundamental/v3/bits/set_bit_iterator.hpp>
+#include <experimental/fundamental/v3/type_traits/integer_sequence.hpp>
 
-// todo replace with bit_mask is the size is <= 64
+#include <array>
 #include <bitset>
 #include <stdexcept>
 #include <iosfwd>
 #include <string>
 #include <cstddef>
 #include <climits>
+#include <cstdint>
+#include <iterator>
 #include <string>
 
 
@@ -65,10 +74,30 @@ inline namespace fundamental_v3
     template <typename T>
     class ordinal_set;
 
+    namespace ordinal_set_detail
+    {
+      //! The smallest unsigned type having N digits, or uint64_t if there is none.
+      template <size_t N>
+      using word_t = conditional_t<(N <= 8), uint8_t,
+                     conditional_t<(N <= 16), uint16_t,
+                     conditional_t<(N <= 32), uint32_t, uint64_t>>>;
+    }
+
     template <typename T>
     class ordinal_set
     {
+      static constexpr size_t N = size_t(ordinal::meta::size<T>::value);
     public:
+      //! The unsigned type of the words storing the bits.
+      using word_type = ordinal_set_detail::word_t<N>;
+      //! The number of words storing the bits.
+      static constexpr size_t word_count = bit_mask<N, word_type>::block_count;
+      //! The type returned by `to_words()`.
+      using words_type = std::array<word_type, word_count>;
+    private:
+      using bits_type = bit_mask<N, word_type>;
+    public:
+
       //! @brief A proxy class that acts as a reference to a single bit.
 
       //! It contains an assignment operator, a conversion to `bool`,
@@ -78,7 +107,7 @@ inline namespace fundamental_v3
         friend class ordinal_set<T>;
         ordinal_set<T>* ref_;
         T pos_;
-        reference(ordinal_set<T>& ref, T pos)
+        constexpr reference(ordinal_set<T>& ref, T pos)
         : ref_(&ref), pos_(pos)
         { }
       public:
@@ -88,26 +117,26 @@ inline namespace fundamental_v3
         reference& operator=(const reference& x) noexcept = default;
 
         //! assignement from bool
-        reference& operator=(bool x) noexcept
+        JASEL_MUTABLE_CONSTEXPR reference& operator=(bool x) noexcept
         {
           ref_->set(pos_,x);
           return *this;
         }
 
         //! flip the bit
-        bool operator~() const noexcept
+        constexpr bool operator~() const noexcept
         {
-          return ! ref_->test(pos_);
+          return ! static_cast<ordinal_set<T> const&>(*ref_)[pos_];
         }
 
         //! implicit conversion to bool
-        operator bool() const noexcept
+        constexpr operator bool() const noexcept
         {
-          return ref_->test(pos_);
+          return static_cast<ordinal_set<T> const&>(*ref_)[pos_];
         }
 
         //! flip the bit
-        reference flip() noexcept
+        JASEL_MUTABLE_CONSTEXPR reference flip() noexcept
         {
           ref_->flip(pos_);
           return *this;
@@ -116,14 +145,14 @@ inline namespace fundamental_v3
       //! \n<b>Effects:</b> Constructs an object of class `ordinal_set<>`, initializing all
       //! ordinals to zero.
       constexpr ordinal_set() noexcept
+        : bits()
       {
       }
-      // fixme: constexpr
-      // Need to be refactored to be a constexpr
-      // error: constexpr constructor does not have empty body
-      explicit ordinal_set(T setting)
+      //! \n<b>Effects:</b> Constructs an object of class `ordinal_set<>`, initializing the bit
+      //! associated to `setting` to one and the others to zero.
+      constexpr explicit ordinal_set(T setting) noexcept
+        : bits(pos_tag_t{}, to_bit(setting))
       {
-        set(setting);
       }
 
       //! \n<b>Effects:</b> Constructs an object of class `ordinal_set<>`, initializing the
@@ -133,7 +162,7 @@ inline namespace fundamental_v3
       //! positions are initialized to zero.
 
       constexpr explicit ordinal_set(unsigned long long val) noexcept
-        : bits(val)
+        : bits(mask_tag_t{}, word_type(val))
       {
       }
       //#if defined(__GNUC__) &&  (__GNUC__ < 4 || ( __GNUC__ == 4 && __GNUC_MINOR__ < 4 ))
@@ -179,7 +208,7 @@ inline namespace fundamental_v3
       //! \n<b>Effects:</b> Clears each bit in `*this` for which the corresponding bit in
       //! `rhs` is clear, and leaves all other bits unchanged.
       //! \n<b>Returns:</b> `*this`.
-      ordinal_set &operator&=(const ordinal_set &rhs) noexcept
+      JASEL_MUTABLE_CONSTEXPR ordinal_set &operator&=(const ordinal_set &rhs) noexcept
       {
         bits &= rhs.bits;
         return *this;
@@ -188,7 +217,7 @@ inline namespace fundamental_v3
       //! \n<b>Effects:</b> Sets each bit in `*this` for which the corresponding bit in
       //! `rhs` is set, and leaves all other bits unchanged.
       //! \n<b>Returns:</b> `*this`.
-      ordinal_set &operator|=(const ordinal_set &rhs) noexcept
+      JASEL_MUTABLE_CONSTEXPR ordinal_set &operator|=(const ordinal_set &rhs) noexcept
       {
         bits |= rhs.bits;
         return *this;
@@ -197,7 +226,7 @@ inline namespace fundamental_v3
       //! \n<b>Effects:</b> Toggles each bit in `*this` for which the corresponding bit in
       //! `rhs` is set, and leaves all other bits unchanged.
       //! \n<b>Returns:</b> `*this`.
-      ordinal_set &operator^=(const ordinal_set &rhs) noexcept
+      JASEL_MUTABLE_CONSTEXPR ordinal_set &operator^=(const ordinal_set &rhs) noexcept
       {
         bits ^= rhs.bits;
         return *this;
@@ -208,9 +237,9 @@ inline namespace fundamental_v3
       //! - If `I >= pos`, the new value is the previous value of the bit at position `I - pos`.
       //!
       //! <b>Returns:</b> `*this`.
-      ordinal_set &operator<<=(ordinal::index_t pos) noexcept
+      JASEL_MUTABLE_CONSTEXPR ordinal_set &operator<<=(ordinal::index_t pos) noexcept
       {
-        bits <<= pos;
+        bits <<= size_t(pos);
         return *this;
       }
 
@@ -220,14 +249,14 @@ inline namespace fundamental_v3
       //!
       //! <b>Returns:</b> `*this`.
 
-      ordinal_set &operator>>=(ordinal::index_t pos) noexcept
+      JASEL_MUTABLE_CONSTEXPR ordinal_set &operator>>=(ordinal::index_t pos) noexcept
       {
-        bits >>= pos;
+        bits >>= size_t(pos);
         return *this;
       }
 
       //! \n<b>Returns:</b> A count of the number of bits set in `*this`.
-      ordinal::index_t count() const noexcept
+      constexpr ordinal::index_t count() const noexcept
       {
         return static_cast<ordinal::index_t>(bits.count());
       }
@@ -244,7 +273,7 @@ inline namespace fundamental_v3
       //! otherwise `false`.
       constexpr bool operator[](T e) const noexcept
       {
-        return bits.test(to_bit(e));
+        return (bits.data()[to_bit(e) / word_digits] >> (to_bit(e) % word_digits)) & 1;
       }
 
       //! \n<b>Requires:</b> `pos` shall be valid.
@@ -256,14 +285,14 @@ inline namespace fundamental_v3
       //! any access or update through the resulting reference potentially
       //! accesses or modifies, respectively, the entire underlying  bitset.
 
-      reference operator[](T pos) noexcept
+      JASEL_CXX14_CONSTEXPR reference operator[](T pos) noexcept
       {
         return reference(*this,pos);
       }
       //! \n<b>Effects:</b> Sets all bits in `*this`.
       //! \n<b>Returns:</b> `*this`.
 
-      ordinal_set &set() noexcept
+      JASEL_MUTABLE_CONSTEXPR ordinal_set &set() noexcept
       {
         bits.set();
         return *this;
@@ -274,7 +303,7 @@ inline namespace fundamental_v3
       //! \n<b>Effects:</b> Stores a new value in the bit at the position associated to `setting` in `*this`.
       //! If `value` is non-zero, the stored value is one, otherwise it is zero.
       //! \n<b>Returns:</b> `*this`.
-      ordinal_set &set(T setting, bool value = true)
+      JASEL_MUTABLE_CONSTEXPR ordinal_set &set(T setting, bool value = true)
       {
         bits.set(to_bit(setting), value);
         return *this;
@@ -282,7 +311,7 @@ inline namespace fundamental_v3
 
       //! \n<b>Effects:</b> Resets all bits in `*this`.
       //! \n<b>Returns:</b> `*this`.
-      ordinal_set &reset() noexcept
+      JASEL_MUTABLE_CONSTEXPR ordinal_set &reset() noexcept
       {
         bits.reset();
         return *this;
@@ -293,7 +322,7 @@ inline namespace fundamental_v3
       //! \n<b>Effects:</b> Resets the bit at the position associated to `resetting` in `*this`.
       //! \n<b>Returns:</b> `*this`.
 
-      ordinal_set &reset(T resetting)
+      JASEL_MUTABLE_CONSTEXPR ordinal_set &reset(T resetting)
       {
         bits.reset(to_bit(resetting));
         return *this;
@@ -301,7 +330,7 @@ inline namespace fundamental_v3
 
       //! \n<b>Effects:</b> Toggles all bits in `*this`.
       //! \n<b>Returns:</b> `*this`.
-      ordinal_set &flip() noexcept
+      JASEL_MUTABLE_CONSTEXPR ordinal_set &flip() noexcept
       {
         bits.flip();
         return *this;
@@ -311,7 +340,7 @@ inline namespace fundamental_v3
       //! \n<b>Throws:</b> `std::invalid_argument` if `flipping` does not correspond to a valid ordinal.
       //! \n<b>Effects:</b> Toggles the bit at position associated to `pos` in `*this`.
       //! \n<b>Returns:</b> `*this`.
-      ordinal_set &flip(T flipping)
+      JASEL_MUTABLE_CONSTEXPR ordinal_set &flip(T flipping)
       {
         bits.flip(to_bit(flipping));
         return *this;
@@ -322,7 +351,7 @@ inline namespace fundamental_v3
       //! bits in `*this` cannot be represented as type `unsigned long`.
       //! \n<b>Returns:</b> `x`.
 
-      unsigned long to_ulong() const
+      constexpr unsigned long to_ulong() const
       {
         return bits.to_ulong();
       }
@@ -331,9 +360,9 @@ inline namespace fundamental_v3
       //! \n<b>Throws:</b> `std::overflow_error` if the integral value `x` corresponding to the
       //!  bits in `*this` cannot be represented as type `unsigned long long`.
       //! \n<b>Returns:</b> `x`.
-      unsigned long long to_ullong() const
+      constexpr unsigned long long to_ullong() const
       {
-        return bits.to_ulong();
+        return bits.to_ullong();
       }
 #if 0 && ! defined JASEL_DOXYGEN_INVOKED
 
@@ -354,39 +383,131 @@ inline namespace fundamental_v3
 
       //! \n<b>Effects:</b> Constructs an object `x` of class `ordinal_set<T>` and initializes it with `*this`.
       //! \n<b>Returns:</b> `x.flip()`.
-      ordinal_set operator~() const noexcept
+      JASEL_CXX14_CONSTEXPR ordinal_set operator~() const noexcept
       {
-        return ordinal_set(*this).flip();
+        return ordinal_set(~bits);
       }
 
       //! \n<b>Requires:</b> `testing` is valid
       //! \n<b>Throws:</b> `std::out_of_range` if the associated position of `testing` does not correspond to a valid bit position.
       //! \n<b>Returns:</b> `true` if the bit at position `testing` in `*this` has the value one.
-      bool test(T testing) const
+      JASEL_MUTABLE_CONSTEXPR bool test(T testing) const
       {
         return bits.test(to_bit(testing));
       }
 
       //! \n<b>Returns:</b> `count() == size()`
-      bool all() const noexcept
+      constexpr bool all() const noexcept
       {
         return bits.all();
       }
 
       //! \n<b>Returns:</b> `count() != 0`
-      bool any() const noexcept
+      constexpr bool any() const noexcept
       {
         return bits.any();
       }
 
       //! \n<b>Returns:</b> `count() == 0`
-      bool none() const noexcept
+      constexpr bool none() const noexcept
       {
         return bits.none();
       }
 
+      //! \n<b>Returns:</b> The words storing the bits, the bit associated to the position `pos` being the
+      //! bit `pos % digits` of the word `pos / digits`, where `digits` are the digits of `word_type`.
+      //! The bits beyond `size()` are zero.
+      constexpr words_type to_words() const noexcept
+      {
+        return to_words(make_index_sequence<word_count>{});
+      }
+
+      //! \n<b>Returns:</b> The set whose bits are stored in `words` as by `to_words()`.
+      //! The bits beyond `size()` are ignored.
+      static constexpr ordinal_set from_words(words_type const& words) noexcept
+      {
+        return ordinal_set(bits_type(blocks_tag_t{}, words));
+      }
+
+      //! @brief A forward iterator over the ordinals whose bit is set, in increasing position.
+
+      //! It visits the words of the set, finding the next bit with `countr_zero` and clearing it.
+      class const_iterator {
+        friend class ordinal_set<T>;
+        set_bit_iterator<word_type> it_;
+        constexpr explicit const_iterator(set_bit_iterator<word_type> it) noexcept
+        : it_(it)
+        { }
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = T;
+
+        constexpr const_iterator() noexcept
+        : it_()
+        { }
+        //! \n<b>Returns:</b> The ordinal.
+        constexpr T operator*() const noexcept
+        {
+          return ordinal::val<T>(ordinal::index_t(*it_));
+        }
+        JASEL_CXX14_CONSTEXPR const_iterator& operator++() noexcept
+        {
+          ++it_;
+          return *this;
+        }
+        JASEL_CXX14_CONSTEXPR const_iterator operator++(int) noexcept
+        {
+          const_iterator tmp(*this);
+          ++it_;
+          return tmp;
+        }
+        friend constexpr bool operator==(const_iterator const& x, const_iterator const& y) noexcept
+        {
+          return x.it_ == y.it_;
+        }
+        friend constexpr bool operator!=(const_iterator const& x, const_iterator const& y) noexcept
+        {
+          return x.it_ != y.it_;
+        }
+      };
+
+      //! @brief The range of the ordinals whose bit is set, as returned by `set_bits()`.
+      class set_bit_range {
+        friend class ordinal_set<T>;
+        std::experimental::set_bit_range<word_type> r_;
+        constexpr explicit set_bit_range(std::experimental::set_bit_range<word_type> r) noexcept
+        : r_(r)
+        { }
+      public:
+        using iterator = const_iterator;
+        JASEL_CXX14_CONSTEXPR const_iterator begin() const noexcept
+        {
+          return const_iterator(r_.begin());
+        }
+        constexpr const_iterator end() const noexcept
+        {
+          return const_iterator(r_.end());
+        }
+      };
+
+      //! \n<b>Returns:</b> The range of the ordinals whose bit is set in `*this`, in increasing position.
+      constexpr set_bit_range set_bits() const noexcept
+      {
+        return set_bit_range(bits.set_bits());
+      }
+
+      //! \n<b>Effects:</b> Calls `f(e)` for each ordinal `e` whose bit is set in `*this`, in increasing position.
+      template <class F>
+      JASEL_CXX14_CONSTEXPR void for_each_set(F&& f) const
+      {
+        bits.for_each_set([&f](size_t pos) { f(ordinal::val<T>(ordinal::index_t(pos))); });
+      }
+
       //! \n<b>Equivalent to:</b> `ordinal_set<T>(*this) <<= pos`.
-      ordinal_set operator<<(ordinal::index_t pos) const noexcept
+      JASEL_CXX14_CONSTEXPR ordinal_set operator<<(ordinal::index_t pos) const noexcept
       {
         ordinal_set r = *this;
         r <<= pos;
@@ -394,7 +515,7 @@ inline namespace fundamental_v3
       }
 
       //! \n<b>Equivalent to:</b> `ordinal_set<T>(*this) >>= pos`.
-      ordinal_set operator>>(ordinal::index_t pos) const noexcept
+      JASEL_CXX14_CONSTEXPR ordinal_set operator>>(ordinal::index_t pos) const noexcept
       {
         ordinal_set r = *this;
         r >>= pos;
@@ -403,29 +524,41 @@ inline namespace fundamental_v3
 
       //! \n<b>Returns:</b> A nonzero value if the value of each bit in `*this` equals the
       //! value of the corresponding bit in `rhs`.
-      bool operator==(const ordinal_set& rhs) const noexcept
+      constexpr bool operator==(const ordinal_set& rhs) const noexcept
       {
         return bits == rhs.bits;
       }
 
       //! \n<b>Returns:</b> A nonzero value if `!(*this == rhs)`.
-      bool operator!=(const ordinal_set& rhs) const noexcept
+      constexpr bool operator!=(const ordinal_set& rhs) const noexcept
       {
         return bits != rhs.bits;
       }
     private:
+      static constexpr size_t word_digits = size_t(numeric_limits<word_type>::digits);
+
+      constexpr explicit ordinal_set(bits_type const& b) noexcept
+        : bits(b)
+      {
+      }
 
-      static size_t to_bit(T value) noexcept
+      static constexpr size_t to_bit(T value) noexcept
       {
         return static_cast<size_t>(ordinal::pos(value));
       }
 
-      std::bitset<ordinal::meta::size<T>::value> bits;
+      template <size_t... I>
+      constexpr words_type to_words(index_sequence<I...>) const noexcept
+      {
+        return {{ bits.data()[I]... }};
+      }
+
+      bits_type bits;
 
     public:
 
-      std::bitset<ordinal::meta::size<T>::value> const& detail_bits() const  noexcept { return bits; }
-      std::bitset<ordinal::meta::size<T>::value>& detail_bits()  noexcept { return bits; }
+      bits_type const& detail_bits() const  noexcept { return bits; }
+      bits_type& detail_bits()  noexcept { return bits; }
     };
 
     // ordinal_set operators:
@@ -434,7 +567,7 @@ inline namespace fundamental_v3
     //! \n<b>Returns:</b> `ordinal_set<T>(lhs) &= rhs`.
     //! \n<b>Throws:</b> Nothing
     template <typename T>
-    ordinal_set<T> operator&(const ordinal_set<T>& x, const ordinal_set<T>& y)
+    JASEL_CXX14_CONSTEXPR ordinal_set<T> operator&(const ordinal_set<T>& x, const ordinal_set<T>& y) noexcept
     {
       ordinal_set<T> r = x;
       r &= y;
@@ -445,7 +578,7 @@ inline namespace fundamental_v3
     //! \n<b>Returns:</b> `ordinal_set<T>>(lhs) |= rhs`.
     //! \n<b>Throws:</b> Nothing
     template <typename T >
-    ordinal_set<T> operator|(const ordinal_set<T>& x, const ordinal_set<T>& y)
+    JASEL_CXX14_CONSTEXPR ordinal_set<T> operator|(const ordinal_set<T>& x, const ordinal_set<T>& y) noexcept
     {
       ordinal_set<T> r = x;
       r |= y;
@@ -456,7 +589,7 @@ inline namespace fundamental_v3
     //! \n<b>Returns:</b> `ordinal_set<T>(lhs) ^= rhs`.
     //! \n<b>Throws:</b> Nothing
     template <typename T >
-    ordinal_set<T> operator^(const ordinal_set<T>& x, const ordinal_set<T>& y)
+    JASEL_CXX14_CONSTEXPR ordinal_set<T> operator^(const ordinal_set<T>& x, const ordinal_set<T>& y) noexcept
     {
       ordinal_set<T> r = x;
       r ^= y;
@@ -482,7 +615,16 @@ inline namespace fundamental_v3
     std::basic_istream<charT, traits>&
     operator>>(std::basic_istream<charT, traits>& is, ordinal_set<T>& x)
     {
-      return is >> x.detail_bits();
+      std::bitset<ordinal::meta::size<T>::value> b;
+      is >> b;
+      if (is)
+      {
+        x.reset();
+        for (ordinal::index_t pos = 0; pos < x.size(); ++pos)
+          if (b[size_t(pos)])
+            x.set(ordinal::val<T>(pos));
+      }
+      return is;
     }
 
     //! A formatted output function.
@@ -500,7 +642,9 @@ inline namespace fundamental_v3
     std::basic_ostream<charT, traits>&
     operator<<(std::basic_ostream<charT, traits>& os, const ordinal_set<T>& x)
     {
-      return os << x.detail_bits();
+      std::basic_string<charT, traits> str(size_t(x.size()), os.widen('0'));
+      x.detail_bits().for_each_set([&](size_t pos) { str[str.size() - 1 - pos] = os.widen('1'); });
+      return os << str;
     }
 
 }} // experimental::fundamental_v3
@@ -509,14 +653,17 @@ inline namespace fundamental_v3
 
   template <typename T >
   struct hash<experimental::ordinal_set<T> >
-  : public std::unary_function<experimental::ordinal_set<T>, std::size_t>
   {
+    using argument_type = experimental::ordinal_set<T>;
+    using result_type = std::size_t;
+
     //! \n<b>Note:</b> The template specialization meets the requirements of class template `hash`.
     //! @param es the `ordinal_set`
-    //! \n<b>Returns:</b> the hash associated to the underlying bitset.
+    //! \n<b>Returns:</b> the hash associated to the underlying bit_mask.
     std::size_t operator()(const experimental::ordinal_set<T>& es) const
     {
-      return hash<std::bitset<experimental::ordinal::meta::size<T>::size> >(es.detail_bits());
+      using word_type = typename experimental::ordinal_set<T>::word_type;
+      return hash<experimental::bit_mask<experimental::ordinal::meta::size<T>::value, word_type> >()(es.detail_bits());
     }
   };
 
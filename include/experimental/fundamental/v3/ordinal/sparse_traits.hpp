@@ -0,0 +1,352 @@
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// Copyright (C) 2019 Vicente J. Botet Escriba
+
+/*!
+\file
+\brief
+The header \c <experimental/ordinal_sparse_traits.hpp> defines a class template \c ordinal::sparse_traits<T, Values...>
+from which the \c ordinal::traits of an enum or integral type having the values \c Values... can inherit, the position
+of a value being its index in \c Values.
+
+\c val(p) reads an array. \c pos(v) reads a table built at compile time:
+
+- when the values span less than 4 times their number (plus 64), a direct table indexed by the offset of \c v from the
+  lowest value;
+- otherwise a perfect hash, built by hash and displace: the values are distributed in buckets of about 2 values, and
+  the displacement of each bucket, stored in a table, is chosen so that the values of all the buckets land in distinct
+  slots of a table twice as large as the number of values.
+
+The tables are computed by constexpr functions, so that this header requires C++14.
+*/
+
+#ifndef JASEL_FUNDAMENTAL_V3_ORDINAL_SPARSE_TRAITS_HPP
+#define JASEL_FUNDAMENTAL_V3_ORDINAL_SPARSE_TRAITS_HPP
+
+#include <experimental/fundamental/v3/ordinal/ordinal.hpp>
+
+#if __cplusplus >= 201402L || defined JASEL_DOXYGEN_INVOKED
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace std
+{
+namespace experimental
+{
+inline namespace fundamental_v3
+{
+
+namespace ordinal
+{
+
+namespace sparse_detail
+{
+template <class T, bool = is_enum<T>::value>
+struct underlying
+{
+	using type = underlying_type_t<T>;
+};
+template <class T>
+struct underlying<T, false>
+{
+	using type = T;
+};
+
+//! The value of v as a 64-bit key. The conversion of the underlying type is a bijection.
+template <class T>
+constexpr uint64_t key(T v) noexcept
+{
+	return static_cast<uint64_t>(static_cast<typename underlying<T>::type>(v));
+}
+
+//! The smallest unsigned type storing the positions [0, N], N meaning no position.
+template <size_t N>
+using position_t = conditional_t<(N < 0xFF), uint8_t, conditional_t<(N < 0xFFFF), uint16_t, uint32_t>>;
+
+constexpr size_t ceil_log2(size_t n) noexcept
+{
+	size_t r = 0;
+	while ((size_t(1) << r) < n)
+		++r;
+	return r;
+}
+
+template <size_t N>
+struct key_array
+{
+	uint64_t keys[N];
+};
+
+//! The position of a value is stored at the offset of the value from the lowest one.
+template <size_t N, size_t Range>
+struct direct_table
+{
+	position_t<N> slots[Range];
+	bool          distinct;
+};
+
+template <size_t N, size_t Range>
+constexpr direct_table<N, Range> make_direct_table(key_array<N> const &k, uint64_t low) noexcept
+{
+	direct_table<N, Range> t{};
+	t.distinct = true;
+	for (size_t s = 0; s < Range; ++s)
+		t.slots[s] = position_t<N>(N);
+	for (size_t p = 0; p < N; ++p)
+	{
+		size_t const s = size_t(k.keys[p] - low);
+		if (t.slots[s] != N)
+			t.distinct = false;
+		t.slots[s] = position_t<N>(p);
+	}
+	return t;
+}
+
+constexpr uint64_t mix(uint64_t k) noexcept
+{
+	return k * 0x9E3779B97F4A7C15ULL;
+}
+//! The bucket of k, among 2^RBits.
+constexpr size_t bucket(uint64_t k, size_t rbits) noexcept
+{
+	return size_t(mix(k) >> (64 - rbits));
+}
+//! The slot of k, among 2^MBits, when its bucket has the displacement d.
+constexpr size_t slot(uint64_t k, uint64_t d, size_t mbits) noexcept
+{
+	return size_t(((mix(k) ^ d) * 0xC2B2AE3D27D4EB4FULL) >> (64 - mbits));
+}
+
+template <size_t N, size_t MBits, size_t RBits>
+struct hashed_table
+{
+	uint16_t      displacements[size_t(1) << RBits];
+	position_t<N> slots[size_t(1) << MBits];
+	bool          distinct;
+	bool          found;
+};
+
+//! Hash and displace: the buckets are placed by decreasing size, each one with the first displacement sending its keys
+//! to free slots.
+template <size_t N, size_t MBits, size_t RBits>
+constexpr hashed_table<N, MBits, RBits> make_hashed_table(key_array<N> const &k) noexcept
+{
+	constexpr size_t R = size_t(1) << RBits;
+	constexpr size_t M = size_t(1) << MBits;
+	hashed_table<N, MBits, RBits> t{};
+	t.distinct = true;
+	t.found    = true;
+	for (size_t s = 0; s < M; ++s)
+		t.slots[s] = position_t<N>(N);
+
+	// the positions sorted by bucket
+	size_t start[R + 1] = {};
+	for (size_t p = 0; p < N; ++p)
+		++start[bucket(k.keys[p], RBits) + 1];
+	size_t largest = 0;
+	for (size_t b = 0; b < R; ++b)
+	{
+		largest = start[b + 1] > largest ? start[b + 1] : largest;
+		start[b + 1] += start[b];
+	}
+	size_t members[N] = {};
+	size_t next[R]    = {};
+	for (size_t p = 0; p < N; ++p)
+	{
+		size_t const b           = bucket(k.keys[p], RBits);
+		members[start[b] + next[b]++] = p;
+	}
+
+	size_t tried[N] = {};
+	for (size_t size = largest; size > 0; --size)
+		for (size_t b = 0; b < R; ++b)
+		{
+			if (start[b + 1] - start[b] != size)
+				continue;
+			for (size_t i = start[b]; i < start[b + 1]; ++i)
+				for (size_t j = start[b]; j < i; ++j)
+					if (k.keys[members[i]] == k.keys[members[j]])
+						t.distinct = false;
+			if (!t.distinct)
+				return t;
+			for (uint64_t d = 0;; ++d)
+			{
+				if (d > 0xFFFF)
+				{
+					t.found = false;
+					return t;
+				}
+				bool free = true;
+				for (size_t i = 0; free && i < size; ++i)
+				{
+					tried[i] = slot(k.keys[members[start[b] + i]], d, MBits);
+					free     = t.slots[tried[i]] == N;
+					for (size_t j = 0; free && j < i; ++j)
+						free = tried[i] != tried[j];
+				}
+				if (free)
+				{
+					for (size_t i = 0; i < size; ++i)
+						t.slots[tried[i]] = position_t<N>(members[start[b] + i]);
+					t.displacements[b] = uint16_t(d);
+					break;
+				}
+			}
+		}
+	return t;
+}
+
+template <class T, T... Values>
+struct value_range
+{
+	using U = typename underlying<T>::type;
+	static constexpr U lowest() noexcept
+	{
+		U const v[] = {static_cast<U>(Values)...};
+		U       r   = v[0];
+		for (U x : v)
+			r = x < r ? x : r;
+		return r;
+	}
+	static constexpr U highest() noexcept
+	{
+		U const v[] = {static_cast<U>(Values)...};
+		U       r   = v[0];
+		for (U x : v)
+			r = r < x ? x : r;
+		return r;
+	}
+	static constexpr uint64_t low  = static_cast<uint64_t>(lowest());
+	static constexpr uint64_t span = static_cast<uint64_t>(highest()) - low;
+};
+
+template <class T, T... Values>
+struct direct_index
+{
+	static constexpr size_t   N     = sizeof...(Values);
+	static constexpr uint64_t low   = value_range<T, Values...>::low;
+	static constexpr size_t   Range = size_t(value_range<T, Values...>::span) + 1;
+
+	static constexpr direct_table<N, Range> table = make_direct_table<N, Range>(key_array<N>{{key(Values)...}}, low);
+	static_assert(table.distinct, "The values of a sparse_traits must be distinct");
+
+	static constexpr index_t pos(T v) noexcept
+	{
+		return index_t(table.slots[size_t(key(v) - low)]);
+	}
+	static constexpr bool contains(T v) noexcept
+	{
+		return key(v) - low < Range && table.slots[size_t(key(v) - low)] != N;
+	}
+};
+template <class T, T... Values>
+constexpr direct_table<direct_index<T, Values...>::N, direct_index<T, Values...>::Range> direct_index<T, Values...>::table;
+
+template <class T, T... Values>
+struct hashed_index
+{
+	static constexpr size_t N     = sizeof...(Values);
+	static constexpr size_t MBits = ceil_log2(2 * N) < 3 ? 3 : ceil_log2(2 * N);
+	static constexpr size_t RBits = MBits - 2;
+
+	static constexpr key_array<N>                      keys  = {{key(Values)...}};
+	static constexpr hashed_table<N, MBits, RBits> table = make_hashed_table<N, MBits, RBits>(keys);
+	static_assert(table.distinct, "The values of a sparse_traits must be distinct");
+	static_assert(table.found, "No perfect hash was found for the values of this sparse_traits");
+
+	static constexpr size_t slot_of(T v) noexcept
+	{
+		return slot(key(v), table.displacements[bucket(key(v), RBits)], MBits);
+	}
+	static constexpr index_t pos(T v) noexcept
+	{
+		return index_t(table.slots[slot_of(v)]);
+	}
+	static constexpr bool contains(T v) noexcept
+	{
+		return table.slots[slot_of(v)] != N && keys.keys[table.slots[slot_of(v)]] == key(v);
+	}
+};
+template <class T, T... Values>
+constexpr key_array<hashed_index<T, Values...>::N> hashed_index<T, Values...>::keys;
+template <class T, T... Values>
+constexpr hashed_table<hashed_index<T, Values...>::N, hashed_index<T, Values...>::MBits,
+                       hashed_index<T, Values...>::RBits>
+        hashed_index<T, Values...>::table;
+
+} // namespace sparse_detail
+
+/**
+  The traits of an ordinal having the values `Values...`, in this order:
+
+  @code
+  enum class color { red = 1, green = 10, blue = 100 };
+  namespace std { namespace experimental { namespace ordinal {
+    template <>
+    struct traits<color> : sparse_traits<color, color::red, color::green, color::blue> {};
+  }}}
+  @endcode
+
+  @tparam T an enum or integral type
+  @tparam Values the distinct values of `T`
+  */
+template <class T, T... Values>
+struct sparse_traits
+{
+	static_assert(is_enum<T>::value || is_integral<T>::value, "T must be an enum or an integral type");
+	static_assert(sizeof...(Values) > 0, "A sparse_traits must have at least one value");
+
+	using value_type = T;
+	using size_type  = index_t;
+	static constexpr size_type size_v = size_type(sizeof...(Values));
+	using size                        = integral_constant<size_type, size_v>;
+
+	//! Whether `pos` reads a direct table rather than a perfect hash table.
+	static constexpr bool direct =
+	        sparse_detail::value_range<T, Values...>::span < 4 * sizeof...(Values) + 64;
+
+	//! The values, in the order of their positions.
+	static constexpr value_type values[sizeof...(Values)] = {Values...};
+
+	//! @par Pre-condition:
+	//!   `0 <= p < size_v`
+	//! @par Returns:
+	//!   The value at the position `p`.
+	static constexpr value_type val(size_type p) noexcept
+	{
+		return values[p];
+	}
+
+	//! @par Pre-condition:
+	//!   `contains(v)`
+	//! @par Returns:
+	//!   The position of `v`.
+	static constexpr size_type pos(value_type v) noexcept
+	{
+		return index::pos(v);
+	}
+
+	//! @par Returns:
+	//!   Whether `v` is one of `Values`.
+	static constexpr bool contains(value_type v) noexcept
+	{
+		return index::contains(v);
+	}
+
+private:
+	using index = conditional_t<direct, sparse_detail::direct_index<T, Values...>, sparse_detail::hashed_index<T, Values...>>;
+};
+template <class T, T... Values>
+constexpr T sparse_traits<T, Values...>::values[sizeof...(Values)];
+
+} // namespace ordinal
+} // namespace fundamental_v3
+} // namespace experimental
+} // namespace std
+
+#endif
+#endif // header
@@ -0,0 +1,742 @@
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// (C) Copyright 2019 Vicente J. Botet Escriba
+
+#ifndef JASEL_EXPERIMENTAL_SMALL_VECTOR_SMALL_VECTOR_HPP
+#define JASEL_EXPERIMENTAL_SMALL_VECTOR_SMALL_VECTOR_HPP
+
+#if __cplusplus >= 201103L
+
+#include <experimental/contract.hpp>
+#include <experimental/fundamental/v2/config.hpp>
+#include <experimental/fundamental/v3/span/span.hpp>
+#include <experimental/fundamental/v3/static_vector/static_vector.hpp>
+#include <experimental/fundamental/v3/utility/length_tag.hpp>
+#include <experimental/type_traits.hpp>
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+
+namespace std
+{
+namespace experimental
+{
+inline namespace fundamental_v3
+{
+
+namespace small_vector_detail
+{
+// Moves the elements of [first, last) to the raw memory at dest and destroys them.
+// When T is trivially relocatable the bytes are copied, the source being left as raw memory.
+template <typename T>
+void relocate(T *first, T *last, T *dest, true_type) noexcept
+{
+	if (first != last)
+		memcpy(static_cast<void *>(dest), static_cast<void const *>(first), size_t(last - first) * sizeof(T));
+}
+// On exception the elements already constructed at dest are destroyed and the source is left moved from.
+template <typename T>
+void relocate(T *first, T *last, T *dest, false_type)
+{
+	uninitialized_copy(make_move_iterator(first), make_move_iterator(last), dest);
+	static_vector_detail::destroy(first, last);
+}
+template <typename T>
+void relocate(T *first, T *last, T *dest) noexcept(is_trivially_relocatable<T>::value)
+{
+	relocate(first, last, dest, is_trivially_relocatable<T>{});
+}
+// Relocates as move_if_noexcept would: the elements are copied, then destroyed, when their move constructor may throw
+// and they are copyable, so that on exception the source is unchanged.
+template <typename T>
+void relocate_if_noexcept(T *first, T *last, T *dest, true_type)
+{
+	uninitialized_copy(first, last, dest);
+	static_vector_detail::destroy(first, last);
+}
+template <typename T>
+void relocate_if_noexcept(T *first, T *last, T *dest, false_type)
+{
+	relocate(first, last, dest);
+}
+template <typename T>
+void relocate_if_noexcept(T *first, T *last, T *dest)
+{
+	using copy = integral_constant<bool, !is_trivially_relocatable<T>::value && !is_nothrow_move_constructible<T>::value &&
+	                                             is_copy_constructible<T>::value>;
+	relocate_if_noexcept(first, last, dest, copy{});
+}
+} // namespace small_vector_detail
+
+/**
+  A vector storing up to N elements inline, in the storage of a static_vector<T, N>, and moving them to memory
+  obtained from Allocator when it overflows.
+
+  - Until the size exceeds N nothing is allocated; once on the heap the capacity grows geometrically, and only
+    shrink_to_fit() brings the elements back inline.
+  - The elements are moved to the new storage by a memcpy when T is trivially relocatable, and copied when their move
+    constructor may throw and they are copyable, as by std::vector.
+  - The moves of a small_vector whose elements are inline move the elements, and so invalidate the iterators.
+  - as_span() views the elements, without the inline capacity or the allocator in the type, so that the functions
+    taking them don't depend on N.
+ */
+template <typename T, size_t N, typename Allocator = allocator<T>>
+class small_vector {
+	static_assert(N > 0, "The inline capacity of a small_vector must be positive");
+
+	using alloc_traits = allocator_traits<Allocator>;
+
+public:
+	// types:
+	using value_type      = T;
+	using allocator_type  = Allocator;
+	using pointer         = T *;
+	using const_pointer   = const T *;
+	using reference       = value_type &;
+	using const_reference = const value_type &;
+	using size_type       = size_t;
+	using difference_type = ptrdiff_t;
+	using iterator        = pointer;
+	using const_iterator  = const_pointer;
+
+	using reverse_iterator       = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+	using relocatable = is_trivially_relocatable<T>;
+
+	// The allocator is a base of the header so that it takes no room when it is empty.
+	struct header : Allocator
+	{
+		T *       data_;
+		size_type size_;
+		size_type capacity_;
+
+		header(Allocator const &a, T *data) noexcept
+		        : Allocator(a), data_(data), size_(0), capacity_(N) {}
+		header(Allocator &&a, T *data) noexcept
+		        : Allocator(move(a)), data_(data), size_(0), capacity_(N) {}
+	};
+	header h_;
+	// The elements while they fit, laid out as the ones of a static_vector<T, N>.
+	using element_storage_type = typename static_vector_detail::storage<T, N>::element_storage_type;
+	alignas(alignof(T)) element_storage_type inline_[N];
+
+	T *inline_data() noexcept
+	{
+		return reinterpret_cast<T *>(inline_);
+	}
+	Allocator &alloc() noexcept
+	{
+		return h_;
+	}
+	Allocator const &alloc() const noexcept
+	{
+		return h_;
+	}
+
+	// The capacity for n elements, at least twice the current one.
+	size_type grown_capacity(size_type n) const
+	{
+		size_type const m = max_size();
+		if (n > m)
+			throw length_error("small_vector: try to grow beyond max_size");
+		size_type const doubled = capacity() < m / 2 ? 2 * capacity() : m;
+		return n < doubled ? doubled : n;
+	}
+	// Gives back the heap storage, if any, and makes the storage the inline one. The elements must be destroyed.
+	void deallocate() noexcept
+	{
+		if (!is_inline())
+			alloc_traits::deallocate(alloc(), h_.data_, h_.capacity_);
+		h_.data_     = inline_data();
+		h_.capacity_ = N;
+	}
+	// Moves the elements to a new heap storage of capacity cap, after construct(p) has constructed n elements at p,
+	// the new end, so that they can refer to the elements moved.
+	// On exception the elements and the storage are unchanged, unless T is not copyable and its move constructor throws:
+	// the elements are then left moved from, as by std::vector.
+	template <class Construct>
+	void reallocate(size_type cap, size_type n, Construct construct)
+	{
+		T *p = alloc_traits::allocate(alloc(), cap);
+		try
+		{
+			construct(p + size());
+		}
+		catch (...)
+		{
+			alloc_traits::deallocate(alloc(), p, cap);
+			throw;
+		}
+		try
+		{
+			small_vector_detail::relocate_if_noexcept(begin(), end(), p);
+		}
+		catch (...)
+		{
+			static_vector_detail::destroy(p + size(), p + size() + n);
+			alloc_traits::deallocate(alloc(), p, cap);
+			throw;
+		}
+		size_type const sz = size();
+		deallocate();
+		h_.data_     = p;
+		h_.capacity_ = cap;
+		h_.size_     = sz + n;
+	}
+	void grow_to(size_type n)
+	{
+		if (n > capacity())
+			reallocate(grown_capacity(n), 0, [](T *) {});
+	}
+
+	// Takes the heap storage of other, leaving it empty and inline. *this must be empty and inline.
+	void take_storage(small_vector &other) noexcept
+	{
+		h_.data_           = other.h_.data_;
+		h_.size_           = other.h_.size_;
+		h_.capacity_       = other.h_.capacity_;
+		other.h_.data_     = other.inline_data();
+		other.h_.size_     = 0;
+		other.h_.capacity_ = N;
+	}
+	// Moves the elements of other at the end, leaving it empty. The capacity must be enough.
+	void take_elements(small_vector &other) noexcept(relocatable::value || is_nothrow_move_constructible<T>::value)
+	{
+		small_vector_detail::relocate(other.begin(), other.end(), end());
+		h_.size_ += other.h_.size_;
+		other.h_.size_ = 0;
+	}
+
+	void propagate(Allocator const &a, true_type)
+	{
+		alloc() = a;
+	}
+	void propagate(Allocator &&a, true_type)
+	{
+		alloc() = move(a);
+	}
+	void propagate(Allocator const &, false_type) {}
+
+	template <class... Args>
+	reference emplace_back_grow(Args &&... args)
+	{
+		reallocate(grown_capacity(size() + 1), 1, [&](T *p) { new (p) T(forward<Args>(args)...); });
+		return back();
+	}
+
+	// Constructs the elements of [first, last) at the end, at once when the iterators are forward ones.
+	// On exception the elements already constructed are destroyed and the size is unchanged, the capacity may
+	// have grown.
+	template <class ForwardIterator>
+	void append(ForwardIterator first, ForwardIterator last, forward_iterator_tag)
+	{
+		size_type const n = size_type(distance(first, last));
+		if (n > capacity() - size())
+			reallocate(grown_capacity(size() + n), n, [&](T *p) { uninitialized_copy(first, last, p); });
+		else
+		{
+			uninitialized_copy(first, last, end());
+			h_.size_ += n;
+		}
+	}
+	template <class InputIterator>
+	void append(InputIterator first, InputIterator last, input_iterator_tag)
+	{
+		size_type const old_size = size();
+		try
+		{
+			for (; first != last; ++first)
+				emplace_back(*first);
+		}
+		catch (...)
+		{
+			static_vector_detail::destroy(begin() + old_size, end());
+			h_.size_ = old_size;
+			throw;
+		}
+	}
+
+	template <typename It>
+	constexpr bool iterator_in_range(It it) const noexcept
+	{
+		return (begin() <= it) && (it <= end());
+	}
+
+public:
+	// construct/copy/destroy:
+
+	//! Effects: Constructs an empty small_vector, its elements being inline.
+	small_vector() noexcept(noexcept(Allocator()))
+	        : small_vector(Allocator()) {}
+	explicit small_vector(const Allocator &a) noexcept
+	        : h_(a, inline_data()) {}
+	small_vector(length_tag_t, size_type n, const Allocator &a = Allocator())
+	        : small_vector(a)
+	{
+		resize(n);
+	}
+	small_vector(length_tag_t tag, size_type n, const value_type &value, const Allocator &a = Allocator())
+	        : small_vector(a)
+	{
+		insert(end(), tag, n, value);
+	}
+	template <class InputIterator, class = typename iterator_traits<InputIterator>::iterator_category>
+	small_vector(InputIterator first, InputIterator last, const Allocator &a = Allocator())
+	        : small_vector(a)
+	{
+		insert(end(), first, last);
+	}
+	small_vector(initializer_list<value_type> il, const Allocator &a = Allocator())
+	        : small_vector(il.begin(), il.end(), a)
+	{
+	}
+
+	small_vector(const small_vector &other)
+	        : small_vector(alloc_traits::select_on_container_copy_construction(other.alloc()))
+	{
+		insert(end(), other.begin(), other.end());
+	}
+	//! Effects: Takes the heap storage of other, or moves its inline elements. other is left empty.
+	small_vector(small_vector &&other) noexcept(relocatable::value || is_nothrow_move_constructible<T>::value)
+	        : h_(move(other.alloc()), inline_data())
+	{
+		if (other.is_inline())
+			take_elements(other);
+		else
+			take_storage(other);
+	}
+	~small_vector()
+	{
+		clear();
+		deallocate();
+	}
+
+	small_vector &operator=(const small_vector &other)
+	{
+		if (this != &other)
+		{
+			using pocca = typename alloc_traits::propagate_on_container_copy_assignment;
+			if (pocca::value && alloc() != other.alloc())
+			{
+				clear();
+				deallocate();
+			}
+			propagate(other.alloc(), pocca{});
+			assign(other.begin(), other.end());
+		}
+		return *this;
+	}
+	//! Effects: Takes the heap storage of other when the allocators allow it, moves its elements otherwise. other is
+	//! left empty.
+	small_vector &operator=(small_vector &&other)
+	{
+		if (this != &other)
+		{
+			using pocma = typename alloc_traits::propagate_on_container_move_assignment;
+			clear();
+			if (!other.is_inline() && (pocma::value || alloc() == other.alloc()))
+			{
+				deallocate();
+				propagate(move(other.alloc()), pocma{});
+				take_storage(other);
+			}
+			else
+			{
+				// the heap storage, if any, must be released by the allocator that obtained it
+				if (pocma::value && alloc() != other.alloc())
+					deallocate();
+				propagate(move(other.alloc()), pocma{});
+				grow_to(other.size());
+				take_elements(other);
+			}
+		}
+		return *this;
+	}
+	small_vector &operator=(initializer_list<value_type> il)
+	{
+		assign(il);
+		return *this;
+	}
+
+	//! Replaces the contents of the container.
+
+	template <class InputIterator, class = typename iterator_traits<InputIterator>::iterator_category>
+	void assign(InputIterator first, InputIterator last)
+	{
+		clear();
+		insert(end(), first, last);
+	}
+	void assign(length_tag_t tag, size_type n, const value_type &u)
+	{
+		clear();
+		insert(end(), tag, n, u);
+	}
+	void assign(initializer_list<value_type> il)
+	{
+		assign(il.begin(), il.end());
+	}
+
+	allocator_type get_allocator() const noexcept
+	{
+		return alloc();
+	}
+
+	// iterators
+	iterator begin() noexcept
+	{
+		return data();
+	}
+	const_iterator begin() const noexcept
+	{
+		return data();
+	}
+	iterator end() noexcept
+	{
+		return data() + size();
+	}
+	const_iterator end() const noexcept
+	{
+		return data() + size();
+	}
+	reverse_iterator rbegin() noexcept
+	{
+		return reverse_iterator(end());
+	}
+	const_reverse_iterator rbegin() const noexcept
+	{
+		return const_reverse_iterator(end());
+	}
+	reverse_iterator rend() noexcept
+	{
+		return reverse_iterator(begin());
+	}
+	const_reverse_iterator rend() const noexcept
+	{
+		return const_reverse_iterator(begin());
+	}
+	const_iterator cbegin() const noexcept
+	{
+		return begin();
+	}
+	const_iterator cend() const noexcept
+	{
+		return end();
+	}
+	const_reverse_iterator crbegin() const noexcept
+	{
+		return const_reverse_iterator(end());
+	}
+	const_reverse_iterator crend() const noexcept
+	{
+		return const_reverse_iterator(begin());
+	}
+
+	// size/capacity:
+	bool empty() const noexcept
+	{
+		return size() == 0;
+	}
+	size_type size() const noexcept
+	{
+		return h_.size_;
+	}
+	size_type max_size() const noexcept
+	{
+		return alloc_traits::max_size(alloc());
+	}
+	size_type capacity() const noexcept
+	{
+		return h_.capacity_;
+	}
+	//! Returns: The number of elements stored without allocating.
+	static constexpr size_type inline_capacity() noexcept
+	{
+		return N;
+	}
+	//! Returns: Whether the elements are stored inline.
+	bool is_inline() const noexcept
+	{
+		return h_.data_ == reinterpret_cast<T const *>(inline_);
+	}
+
+	//! Effects: Moves the elements to a heap storage of capacity n if n > capacity(), nothing otherwise.
+	void reserve(size_type n)
+	{
+		if (n > capacity())
+		{
+			if (n > max_size())
+				throw length_error("small_vector: try to reserve beyond max_size");
+			reallocate(n, 0, [](T *) {});
+		}
+	}
+	//! Effects: Moves the elements back inline if they fit, to a heap storage of capacity size() otherwise.
+	void shrink_to_fit()
+	{
+		if (is_inline() || size() == capacity())
+			return;
+		if (size() > N)
+		{
+			reallocate(size(), 0, [](T *) {});
+			return;
+		}
+		T *             p   = h_.data_;
+		size_type const cap = h_.capacity_;
+		small_vector_detail::relocate_if_noexcept(p, p + size(), inline_data());
+		h_.data_     = inline_data();
+		h_.capacity_ = N;
+		alloc_traits::deallocate(alloc(), p, cap);
+	}
+
+	void resize(size_type sz)
+	{
+		if (sz < size())
+			erase(begin() + sz, end());
+		else
+		{
+			grow_to(sz);
+			for (; h_.size_ < sz; ++h_.size_)
+				new (end()) T();
+		}
+	}
+	void resize(size_type sz, const value_type &c)
+	{
+		if (sz < size())
+			erase(begin() + sz, end());
+		else
+			insert(end(), length_tag_t{}, sz - size(), c);
+	}
+	//! Effects: As resize(sz), except that the elements added are default-initialized, so that their value is
+	//! indeterminate when T is trivially default constructible and nothing is written.
+	void resize_default_init(size_type sz)
+	{
+		if (sz < size())
+			erase(begin() + sz, end());
+		else
+		{
+			grow_to(sz);
+			for (; h_.size_ < sz; ++h_.size_)
+				new (end()) T;
+		}
+	}
+	//! Expects: op(data(), sz) returns r <= sz.
+	//! Effects: resize_default_init(sz), then lets op write the elements of [data(), data() + sz), and keeps the r
+	//! first ones.
+	template <class Operation>
+	void resize_and_overwrite(size_type sz, Operation op)
+	{
+		resize_default_init(sz);
+		size_type const r = size_type(op(data(), sz));
+		JASEL_EXPECTS(r <= sz && "the operation returns a size beyond the one given");
+		erase(begin() + r, end());
+	}
+
+	// element and data access:
+
+	reference operator[](size_type n)
+	{
+		JASEL_EXPECTS(size() > n && "try to access with index out of range");
+		return data()[n];
+	}
+	const_reference operator[](size_type n) const
+	{
+		JASEL_EXPECTS(size() > n && "try to access with index out of range");
+		return data()[n];
+	}
+	reference front()
+	{
+		return (*this)[0];
+	}
+	const_reference front() const
+	{
+		return (*this)[0];
+	}
+	reference back()
+	{
+		return (*this)[size() - 1];
+	}
+	const_reference back() const
+	{
+		return (*this)[size() - 1];
+	}
+	T *data() noexcept
+	{
+		return h_.data_;
+	}
+	const T *data() const noexcept
+	{
+		return h_.data_;
+	}
+	//! Returns: A view of the elements, valid until the next insertion or shrink_to_fit().
+	span<T> as_span() noexcept
+	{
+		return span<T>(data(), size());
+	}
+	span<T const> as_span() const noexcept
+	{
+		return span<T const>(data(), size());
+	}
+
+	// modifiers:
+	iterator insert(const_iterator position, const value_type &value)
+	{
+		return insert(position, length_tag_t{}, size_type(1), value);
+	}
+	iterator insert(const_iterator position, value_type &&value)
+	{
+		return emplace(position, move(value));
+	}
+	//! Effects: Inserts n copies of x before position. x may be an element of *this.
+	iterator insert(const_iterator position, length_tag_t, size_type n, const value_type &x)
+	{
+		JASEL_EXPECTS(iterator_in_range(position) && "try to insert in position out of range");
+		size_type const offset = size_type(position - begin());
+		if (n > capacity() - size())
+			reallocate(grown_capacity(size() + n), n, [&](T *p) { uninitialized_fill_n(p, n, x); });
+		else
+		{
+			uninitialized_fill_n(end(), n, x);
+			h_.size_ += n;
+		}
+		rotate(begin() + offset, end() - n, end());
+		return begin() + offset;
+	}
+	template <class InputIterator, class = typename iterator_traits<InputIterator>::iterator_category>
+	iterator insert(const_iterator position, InputIterator first, InputIterator last)
+	{
+		JASEL_EXPECTS(iterator_in_range(position) && "try to insert in position out of range");
+		size_type const offset   = size_type(position - begin());
+		size_type const old_size = size();
+		append(first, last, typename iterator_traits<InputIterator>::iterator_category{});
+		rotate(begin() + offset, begin() + old_size, end());
+		return begin() + offset;
+	}
+	template <class InputIterator>
+	iterator move_insert(const_iterator position, InputIterator first, InputIterator last)
+	{
+		return insert(position, make_move_iterator(first), make_move_iterator(last));
+	}
+	iterator insert(const_iterator position, initializer_list<value_type> il)
+	{
+		return insert(position, il.begin(), il.end());
+	}
+
+	template <class... Args>
+	iterator emplace(const_iterator position, Args &&... args)
+	{
+		JASEL_EXPECTS(iterator_in_range(position) && "try to emplace in position out of range");
+		size_type const offset = size_type(position - begin());
+		emplace_back(forward<Args>(args)...);
+		rotate(begin() + offset, end() - 1, end());
+		return begin() + offset;
+	}
+
+	//! Effects: Constructs an element at the end, moving the elements to a larger storage if size() == capacity().
+	//! args may refer to the elements.
+	template <class... Args>
+	reference emplace_back(Args &&... args)
+	{
+		if (size() == capacity())
+			return emplace_back_grow(forward<Args>(args)...);
+		T *p = new (end()) T(forward<Args>(args)...);
+		++h_.size_;
+		return *p;
+	}
+	void push_back(const value_type &x)
+	{
+		emplace_back(x);
+	}
+	void push_back(value_type &&x)
+	{
+		emplace_back(move(x));
+	}
+
+	void pop_back()
+	{
+		JASEL_EXPECTS(!empty() && "try to pop_back in an empty collection");
+		--h_.size_;
+		end()->~T();
+	}
+
+	iterator erase(const_iterator position)
+	{
+		return erase(position, position + 1);
+	}
+	iterator erase(const_iterator first, const_iterator last)
+	{
+		JASEL_EXPECTS(iterator_in_range(first));
+		JASEL_EXPECTS(iterator_in_range(last));
+		JASEL_EXPECTS(first <= last);
+
+		iterator p = begin() + (first - begin());
+		if (first != last)
+		{
+			static_vector_detail::destroy(move(p + (last - first), end(), p), end());
+			h_.size_ -= size_type(last - first);
+		}
+		return p;
+	}
+
+	//! Effects: Destroys the elements, keeping the storage.
+	void clear() noexcept
+	{
+		static_vector_detail::destroy(begin(), end());
+		h_.size_ = 0;
+	}
+
+	void swap(small_vector &other)
+	{
+		small_vector tmp = move(other);
+		other            = move(*this);
+		(*this)          = move(tmp);
+	}
+};
+
+template <typename T, size_t N, typename A>
+bool operator==(const small_vector<T, N, A> &a, const small_vector<T, N, A> &b)
+{
+	return a.size() == b.size() && equal(a.begin(), a.end(), b.begin());
+}
+template <typename T, size_t N, typename A>
+bool operator!=(const small_vector<T, N, A> &a, const small_vector<T, N, A> &b)
+{
+	return !(a == b);
+}
+template <typename T, size_t N, typename A>
+bool operator<(const small_vector<T, N, A> &a, const small_vector<T, N, A> &b)
+{
+	return lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+}
+template <typename T, size_t N, typename A>
+bool operator<=(const small_vector<T, N, A> &a, const small_vector<T, N, A> &b)
+{
+	return !(b < a);
+}
+template <typename T, size_t N, typename A>
+bool operator>(const small_vector<T, N, A> &a, const small_vector<T, N, A> &b)
+{
+	return b < a;
+}
+template <typename T, size_t N, typename A>
+bool operator>=(const small_vector<T, N, A> &a, const small_vector<T, N, A> &b)
+{
+	return !(a < b);
+}
+
+template <typename T, size_t N, typename A>
+void swap(small_vector<T, N, A> &x, small_vector<T, N, A> &y)
+{
+	x.swap(y);
+}
+
+} // namespace fundamental_v3
+} // namespace experimental
+} // namespace std
+#endif
+#endif // header
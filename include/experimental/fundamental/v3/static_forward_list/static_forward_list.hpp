@@ -16,6 +16,8 @@
 #include <experimental/type_traits.hpp>
 #include <algorithm>
 #include <cassert>
+#include <iterator>
+#include <limits>
 
 namespace std
 {
@@ -25,7 +27,9 @@ inline namespace fundamental_v3
 {
 
 // The main difference with forward_list is that this class doesn't shares his allocator but contains the allocator statically.
-// This make impossible to implement the splice/merge functions. As the reason to don't implement size from hence, we can use a counter for the size of elements.
+// The nodes of a list are in its own pool, so that sort, reverse and splice_after within a list relink the nodes as
+// forward_list does, while merge and splice_after from another list move the values to free nodes of this list.
+// As the reason to don't implement size from hence, we can use a counter for the size of elements.
 
 template <typename T, size_t N>
 class static_forward_list {
@@ -101,11 +105,23 @@ private:
 		typedef T const *            pointer;
 
 		const_node_iterator() : ptr_(nullptr) {}
-		const_node_iterator(node const *it) : ptr_(it) {}
+		const_node_iterator(node const *it) : ptr_(const_cast<node *>(it)) {}
 		const_node_iterator(node_iterator const it) : ptr_(it.ptr_) {}
 
-		T const *operator->() const { return &ptr_->value; }
-		T const &operator*() const { return ptr_->value; }
+		const_node_iterator &operator++() noexcept
+		{
+			ptr_ = ptr_->next_;
+			return *this;
+		}
+		const_node_iterator operator++(int) noexcept
+		{
+			const_node_iterator tmp = *this;
+			ptr_                    = ptr_->next_;
+			return tmp;
+		}
+
+		T const *operator->() const { return reinterpret_cast<T const *>(&ptr_->storage_); }
+		T const &operator*() const { return reinterpret_cast<T const &>(ptr_->storage_); }
 
 		friend bool operator==(const_node_iterator const &x, const_node_iterator const &y)
 		{
@@ -155,6 +171,70 @@ private:
 	{
 		element_ptr(n)->~T();
 	}
+	static T &value(node *n)
+	{
+		return *reinterpret_cast<T *>(&n->storage_);
+	}
+	// Takes the first free node.
+	node *allocate() noexcept
+	{
+		node *n     = head_free();
+		head_free() = n->next_;
+		return n;
+	}
+	// Gives back a node whose element is destroyed to the free nodes.
+	void deallocate(node *n) noexcept
+	{
+		n->next_    = head_free();
+		head_free() = n;
+	}
+	// Appends the chain b to the chain a, returning the first node.
+	static node *concat_nodes(node *a, node *b) noexcept
+	{
+		if (a == nullptr)
+			return b;
+		node *last = a;
+		while (last->next_ != nullptr)
+			last = last->next_;
+		last->next_ = b;
+		return a;
+	}
+	// Merges the sorted chain b into the sorted chain a, the nodes of a first when their values are equivalent, and
+	// leaves b empty.
+	// On exception from comp a holds all the nodes, in an unspecified order, and b is empty.
+	template <class Compare>
+	static void merge_nodes(node *&a, node *&b, Compare &comp)
+	{
+		node * first = nullptr;
+		node **link  = &first;
+		try
+		{
+			while (a != nullptr && b != nullptr)
+			{
+				if (comp(value(b), value(a)))
+				{
+					*link = b;
+					b     = b->next_;
+				}
+				else
+				{
+					*link = a;
+					a     = a->next_;
+				}
+				link = &(*link)->next_;
+			}
+		}
+		catch (...)
+		{
+			*link = concat_nodes(a, b);
+			a     = first;
+			b     = nullptr;
+			throw;
+		}
+		*link = a != nullptr ? a : b;
+		a     = first;
+		b     = nullptr;
+	}
 	// template <class It>
 	// JASEL_CXX14_CONSTEXPR void destruct(It first, It last)
 	// {
@@ -187,7 +267,7 @@ public:
 	JASEL_CXX14_CONSTEXPR static_forward_list() noexcept
 	        : size_(0)
 	{
-		for (int i = 0; i < N; i++)
+		for (size_t i = 0; i < N; i++)
 		{
 
 			data_[i].next_ = &data_[i + 1];
@@ -198,12 +278,12 @@ public:
 	}
 
 	JASEL_CXX14_CONSTEXPR static_forward_list(const static_forward_list &other)
-	        : size_(0)
+	        : static_forward_list()
 	{
 		insert_after(before_begin(), other.begin(), other.end());
 	}
 	JASEL_CXX14_CONSTEXPR static_forward_list(static_forward_list &&other)
-	        : size_(0)
+	        : static_forward_list()
 	{
 		move_insert_after(before_begin(), other.begin(), other.end());
 	}
@@ -212,7 +292,7 @@ public:
 	{
 	}
 	JASEL_CXX14_CONSTEXPR static_forward_list(length_tag_t tag, size_type n, const value_type &value)
-	        : size_(0)
+	        : static_forward_list()
 	{
 		insert_after(before_begin(), tag, n, value);
 	}
@@ -220,7 +300,7 @@ public:
 	template <class InputIterator>
 	// requires IsInputIterator<InputIterator>
 	JASEL_CXX14_CONSTEXPR static_forward_list(InputIterator first, InputIterator last)
-	        : size_(0)
+	        : static_forward_list()
 	{
 		insert_after(before_begin(), first, last);
 	}
@@ -296,7 +376,7 @@ public:
 		return nullptr;
 	}
 
-	JASEL_CXX14_CONSTEXPR const_iterator cbegin() noexcept
+	JASEL_CXX14_CONSTEXPR const_iterator cbegin() const noexcept
 	{
 		return head_.next_;
 	}
@@ -362,7 +442,7 @@ public:
 		if (sz < size())
 			erase_after(before_pos(sz), end());
 		else
-			insert_after(before_pos(size()), sz - size(), c);
+			insert_after(before_pos(size()), length_tag_t{}, sz - size(), c);
 	}
 
 	// // 5.6, element and data access:
@@ -425,7 +505,7 @@ public:
 	{
 		//JASEL_EXPECTS(iterator_in_range(position) && "try to insert in position out of range");
 		//JASEL_EXPECTS(valid_iterator_range(first, last) && "try to insert invalid iterator");
-		JASEL_EXPECTS(distance(first, last) <= capacity() - size() && "try to insert beyond capacity");
+		JASEL_EXPECTS(size_type(distance(first, last)) <= capacity() - size() && "try to insert beyond capacity");
 
 		node *    last_busy_m_1 = &data_[0];
 		size_type num           = 0;
@@ -445,7 +525,7 @@ public:
 	{
 		//JASEL_EXPECTS(iterator_in_range(position) && "try to insert in position out of range");
 		//JASEL_EXPECTS(valid_iterator_range(first, last) && "try to insert invalid iterator");
-		JASEL_EXPECTS(distance(first, last) <= capacity() - size() && "try to insert beyond capacity");
+		JASEL_EXPECTS(size_type(distance(first, last)) <= capacity() - size() && "try to insert beyond capacity");
 		node *    last_busy_m_1 = &data_[0];
 		size_type num           = 0;
 
@@ -461,7 +541,7 @@ public:
 	}
 	JASEL_CXX14_CONSTEXPR iterator insert_after(const_iterator position, initializer_list<value_type> il)
 	{
-		return insert(position, il.begin(), il.end());
+		return insert_after(position, il.begin(), il.end());
 	}
 
 	template <class... Args>
@@ -494,7 +574,7 @@ public:
 	JASEL_CXX14_CONSTEXPR void _move_to_free(node *n)
 	{
 		auto nextbusy  = n->next_;
-		n->next_       = data_[0].next_->next_;
+		n->next_       = data_[0].next_;
 		data_[0].next_ = n;
 		head_.next_    = nextbusy;
 		--size_;
@@ -521,40 +601,46 @@ public:
 		auto n = head_.next_;
 		destruct(n);
 		auto nextbusy  = n->next_;
-		n->next_       = data_[0].next_->next_;
+		n->next_       = data_[0].next_;
 		data_[0].next_ = n;
 		head_.next_    = nextbusy;
 		--size_;
 	}
 
+	//! Expects: position is dereferenceable or before_begin(), and is not the last element.
+	//! Effects: Erases the element following position.
+	//! Returns: An iterator to the element following the one erased.
 	JASEL_CXX14_CONSTEXPR iterator erase_after(const_iterator position)
 	{
-		return erase(position, position + 1);
+		node *n                = position.ptr_->next_;
+		position.ptr_->next_   = n->next_;
+		destruct(n);
+		deallocate(n);
+		--size_;
+		return position.ptr_->next_;
 	}
 
+	//! Effects: Erases the elements in the range (first, last).
+	//! Returns: last.
 	JASEL_CXX14_CONSTEXPR iterator erase_after(const_iterator first, const_iterator last)
 	{
-		//JASEL_EXPECTS(iterator_in_range(first));
-		//JASEL_EXPECTS(iterator_in_range(last));
-		//JASEL_EXPECTS(valid_iterator_range(first, last));
-
-		iterator p = begin() + (first - begin());
-		if (first != last)
-		{
-			destruct(
-			        move(p + (last - first), end(), p), end());
-			size_ = (size() - static_cast<size_type>(last - first));
-		}
-
-		return p;
+		while (first.ptr_->next_ != last.ptr_)
+			erase_after(first);
+		return last.ptr_;
 	}
 
 	JASEL_CXX14_CONSTEXPR void clear() noexcept
 	{
-		for (iterator it = begin(); it != end(); it++)
+		node *n = head_.next_;
+		while (n != nullptr)
 		{
-			destruct(it.ptr_);
+			node *next = n->next_;
+			destruct(n);
+			deallocate(n);
+			n = next;
 		}
+		head_.next_ = nullptr;
+		size_       = 0;
 	}
 
 	JASEL_CXX14_CONSTEXPR void swap(static_forward_list &other)
@@ -566,46 +652,217 @@ public:
 	}
 
 	// Operations
-#if 0
-	// static_forward_list owns his elements and cannot support neither merge, nor splice operations without copying.
-	// While these operations are less expensive to implement for static_forward_list than for contiguous containers 
-	// it is however much more expensive than for std::forward_list and std::list.
-	// This is why we don't implement them here
-
-	void merge(static_forward_list &other);
-	void merge(static_forward_list &&other);
+
+	// The nodes of other are in its own pool. Splicing or merging the elements of another list moves them to free
+	// nodes of *this, so that the iterators to the elements of other are invalidated, and the capacity of *this must
+	// be enough. Splicing within a list relinks the nodes and doesn't invalidate any iterator.
+
+	//! Expects: sorted by comp, and size() + other.size() <= capacity().
+	//! Effects: Moves the elements of other into *this, keeping the order by comp; the elements of *this precede the
+	//! equivalent elements of other. other is empty.
+	//! Complexity: At most size() + other.size() - 1 comparisons.
 	template <class Compare>
-	void merge(static_forward_list &other, Compare comp);
+	void merge(static_forward_list &other, Compare comp)
+	{
+		if (this == &other)
+			return;
+		JASEL_EXPECTS(other.size() <= capacity() - size() && "try to merge beyond capacity");
+		node *prev = &head_;
+		while (!other.empty())
+		{
+			T &x = other.front();
+			while (prev->next_ != nullptr && !comp(x, value(prev->next_)))
+				prev = prev->next_;
+			emplace_after(prev, move(x));
+			prev = prev->next_;
+			other.pop_front();
+		}
+	}
 	template <class Compare>
-	void merge(static_forward_list &&other, Compare comp);
+	void merge(static_forward_list &&other, Compare comp)
+	{
+		merge(other, comp);
+	}
+	void merge(static_forward_list &other)
+	{
+		merge(other, [](T const &x, T const &y) { return x < y; });
+	}
+	void merge(static_forward_list &&other)
+	{
+		merge(other);
+	}
 
-	void splice_after(const_iterator pos, static_forward_list &other);
-#endif
+	//! Expects: this != &other, and size() + other.size() <= capacity().
+	//! Effects: Moves the elements of other after pos. other is empty.
+	void splice_after(const_iterator pos, static_forward_list &other)
+	{
+		JASEL_EXPECTS(this != &other && "try to splice a list into itself");
+		move_insert_after(pos, other.begin(), other.end());
+		other.clear();
+	}
+	void splice_after(const_iterator pos, static_forward_list &&other)
+	{
+		splice_after(pos, other);
+	}
+
+	//! Effects: Moves the element following it after pos.
+	void splice_after(const_iterator pos, static_forward_list &other, const_iterator it)
+	{
+		if (this == &other)
+		{
+			node *n = it.ptr_->next_;
+			if (pos == it || pos.ptr_ == n)
+				return;
+			it.ptr_->next_  = n->next_;
+			n->next_        = pos.ptr_->next_;
+			pos.ptr_->next_ = n;
+			return;
+		}
+		emplace_after(pos, move(value(it.ptr_->next_)));
+		other.erase_after(it);
+	}
+	void splice_after(const_iterator pos, static_forward_list &&other, const_iterator it)
+	{
+		splice_after(pos, other, it);
+	}
+
+	//! Expects: pos is not in (first, last).
+	//! Effects: Moves the elements in the range (first, last) after pos.
+	void splice_after(const_iterator pos, static_forward_list &other, const_iterator first, const_iterator last)
+	{
+		if (this == &other)
+		{
+			node *n = first.ptr_->next_;
+			if (n == last.ptr_ || pos == first)
+				return;
+			node *tail = n;
+			while (tail->next_ != last.ptr_)
+				tail = tail->next_;
+			first.ptr_->next_ = last.ptr_;
+			tail->next_       = pos.ptr_->next_;
+			pos.ptr_->next_   = n;
+			return;
+		}
+		move_insert_after(pos, iterator(first.ptr_->next_), iterator(last.ptr_));
+		other.erase_after(first, last);
+	}
+	void splice_after(const_iterator pos, static_forward_list &&other, const_iterator first, const_iterator last)
+	{
+		splice_after(pos, other, first, last);
+	}
 
 	size_type remove(const T &value)
 	{
-		remove_if([&value](T const &v) { return v == value; });
+		return remove_if([&value](T const &v) { return v == value; });
 	}
+	//! Effects: Erases the elements satisfying p.
+	//! Returns: The number of elements erased.
 	template <class UnaryPredicate>
-	size_type remove_if(UnaryPredicate p);
+	size_type remove_if(UnaryPredicate p)
+	{
+		size_type const old_size = size();
+		node *          prev     = &head_;
+		while (prev->next_ != nullptr)
+		{
+			if (p(value(prev->next_)))
+				erase_after(prev);
+			else
+				prev = prev->next_;
+		}
+		return old_size - size();
+	}
 
-	void reverse() noexcept;
+	//! Effects: Reverses the order of the elements, relinking the nodes.
+	void reverse() noexcept
+	{
+		node *r = nullptr;
+		node *n = head_.next_;
+		while (n != nullptr)
+		{
+			node *next = n->next_;
+			n->next_   = r;
+			r          = n;
+			n          = next;
+		}
+		head_.next_ = r;
+	}
 
 	size_type unique()
 	{
 		return unique([](T const &x, T const &y) { return x == y; });
 	}
 
+	//! Effects: Erases the elements x following an element y when p(y, x), keeping the first one of each group.
+	//! Returns: The number of elements erased.
 	template <class BinaryPredicate>
-	size_type unique(BinaryPredicate p);
+	size_type unique(BinaryPredicate p)
+	{
+		size_type const old_size = size();
+		node *          n        = head_.next_;
+		while (n != nullptr)
+		{
+			while (n->next_ != nullptr && p(value(n), value(n->next_)))
+				erase_after(n);
+			n = n->next_;
+		}
+		return old_size - size();
+	}
 
 	void sort()
 	{
 		return sort([](T const &x, T const &y) { return x < y; });
 	}
 
+	//! Effects: Sorts the elements by comp, relinking the nodes without moving the values. The sort is stable.
+	//! Complexity: O(n log n) comparisons, O(1) space.
+	//! Throws: When comp throws the list keeps all its elements, in an unspecified order.
 	template <class Compare>
-	void sort(Compare comp);
+	void sort(Compare comp)
+	{
+		// A bottom-up merge sort: runs[i] is either empty or a sorted chain of 2^i nodes, preceding the nodes of the
+		// runs of lower index. Each node is in one of n, carry, runs and sorted, so that they can be given back to the
+		// list on exception.
+		node *runs[numeric_limits<size_t>::digits] = {};
+		node *n                                     = head_.next_;
+		node *carry                                 = nullptr;
+		node *sorted                                = nullptr;
+		try
+		{
+			while (n != nullptr)
+			{
+				carry        = n;
+				n            = n->next_;
+				carry->next_ = nullptr;
+				size_t i     = 0;
+				for (; runs[i] != nullptr; ++i)
+				{
+					merge_nodes(runs[i], carry, comp);
+					carry   = runs[i];
+					runs[i] = nullptr;
+				}
+				runs[i] = carry;
+				carry   = nullptr;
+			}
+			for (node *&run : runs)
+			{
+				if (run != nullptr)
+				{
+					merge_nodes(run, sorted, comp);
+					sorted = run;
+					run    = nullptr;
+				}
+			}
+		}
+		catch (...)
+		{
+			node *all = concat_nodes(carry, n);
+			for (node *run : runs)
+				all = concat_nodes(run, all);
+			head_.next_ = concat_nodes(sorted, all);
+			throw;
+		}
+		head_.next_ = sorted;
+	}
 };
 
 template <typename T, size_t N>
@@ -16,6 +16,9 @@
 #include <experimental/type_traits.hpp>
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <memory>
 
 namespace std
 {
@@ -24,8 +27,117 @@ namespace experimental
 inline namespace fundamental_v3
 {
 
+namespace static_vector_detail
+{
+// The smallest unsigned type storing the sizes [0, N].
+template <size_t N>
+using size_storage_t = conditional_t<(N <= 0xFF), uint8_t,
+                                     conditional_t<(N <= 0xFFFF), uint16_t,
+                                                   conditional_t<(N <= 0xFFFFFFFF), uint32_t, size_t>>>;
+
+// Destroys the elements of [first, last), nothing to do when T is trivially destructible.
+template <typename T>
+void destroy(T *, T *, true_type) noexcept
+{
+}
+template <typename T>
+void destroy(T *first, T *last, false_type) noexcept
+{
+	for (; first != last; ++first)
+		first->~T();
+}
+template <typename T>
+void destroy(T *first, T *last) noexcept
+{
+	destroy(first, last, is_trivially_destructible<T>{});
+}
+
+// The elements and the size of a static_vector.
+// When T is trivially copyable the copy, the move and the destruction are the implicit ones, so that the storage,
+// and a static_vector of T, are trivially copyable too.
+template <typename T, size_t N, bool = is_trivially_copyable<T>::value>
+struct storage
+{
+	using aligned_storage_t    = aligned_storage_for_t<remove_const_t<T>>;
+	using element_storage_type = conditional_t<is_const<T>::value, aligned_storage_t const, aligned_storage_t>;
+	alignas(alignof(T)) element_storage_type data_[N];
+	size_storage_t<N> size_;
+
+	constexpr storage() noexcept
+	        : size_(0) {}
+};
+
 template <typename T, size_t N>
-class static_vector {
+struct storage<T, N, false>
+{
+	using aligned_storage_t    = aligned_storage_for_t<remove_const_t<T>>;
+	using element_storage_type = conditional_t<is_const<T>::value, aligned_storage_t const, aligned_storage_t>;
+	alignas(alignof(T)) element_storage_type data_[N];
+	size_storage_t<N> size_;
+
+	constexpr storage() noexcept
+	        : size_(0) {}
+	storage(const storage &other)
+	        : size_(0)
+	{
+		copy_from(other);
+	}
+	storage(storage &&other)
+	        : size_(0)
+	{
+		move_from(other);
+	}
+	storage &operator=(const storage &other)
+	{
+		if (this != &other)
+		{
+			clear();
+			copy_from(other);
+		}
+		return *this;
+	}
+	storage &operator=(storage &&other)
+	{
+		if (this != &other)
+		{
+			clear();
+			move_from(other);
+		}
+		return *this;
+	}
+	~storage()
+	{
+		clear();
+	}
+
+private:
+	T *elements()
+	{
+		return reinterpret_cast<T *>(data_);
+	}
+	void clear() noexcept
+	{
+		destroy(elements(), elements() + size_);
+		size_ = 0;
+	}
+	// On exception the elements already constructed are destroyed by uninitialized_copy and *this stays empty.
+	void copy_from(const storage &other)
+	{
+		T const *first = reinterpret_cast<T const *>(other.data_);
+		uninitialized_copy(first, first + other.size_, elements());
+		size_ = other.size_;
+	}
+	void move_from(storage &other)
+	{
+		uninitialized_copy(make_move_iterator(other.elements()), make_move_iterator(other.elements() + other.size_),
+		                   elements());
+		size_ = other.size_;
+	}
+};
+} // namespace static_vector_detail
+
+template <typename T, size_t N>
+class static_vector : private static_vector_detail::storage<T, N> {
 public:
 	// types:
 	using value_type      = T;
@@ -44,10 +156,9 @@ public:
 	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
 private:
-	using aligned_storage_t    = aligned_storage_for_t<remove_const_t<T>>;
-	using element_storage_type = conditional_t<is_const<T>::value, aligned_storage_t const, aligned_storage_t>;
-	alignas(alignof(T)) element_storage_type data_[N];
-	size_t      size_;
+	using base_type = static_vector_detail::storage<T, N>;
+	using base_type::data_;
+	using base_type::size_;
 	void const *data_ptr(size_t i) const
 	{
 		return &data_[i];
@@ -76,11 +187,37 @@ private:
 	{
 		element_ptr(index)->~T();
 	}
-	template <class It>
-	JASEL_CXX14_CONSTEXPR void destruct(It first, It last)
+	JASEL_CXX14_CONSTEXPR void destruct(pointer first, pointer last)
 	{
-		for (; first < last; ++first)
-			first->~T();
+		static_vector_detail::destroy(first, last);
+	}
+
+	// Constructs the elements of [first, last) at the end, at once when the iterators are forward ones, so that
+	// the copy is a memmove when T is trivially copyable.
+	// On exception the elements already constructed are destroyed and the size is unchanged.
+	template <class ForwardIterator>
+	void append(ForwardIterator first, ForwardIterator last, forward_iterator_tag)
+	{
+		size_type const n = size_type(distance(first, last));
+		JASEL_EXPECTS(n <= capacity() - size() && "try to insert beyond capacity");
+		uninitialized_copy(first, last, end());
+		size_ += n;
+	}
+	template <class InputIterator>
+	void append(InputIterator first, InputIterator last, input_iterator_tag)
+	{
+		size_type const old_size = size_;
+		try
+		{
+			for (; first != last; ++first)
+				emplace_back(*first);
+		}
+		catch (...)
+		{
+			destruct(begin() + old_size, end());
+			size_ = old_size;
+			throw;
+		}
 	}
 
 	template <typename It>
@@ -107,31 +244,13 @@ public:
         Complexity: Constant.
      */
 	constexpr static_vector() noexcept
-	        : size_(0) {}
-	JASEL_CXX14_CONSTEXPR static_vector(const static_vector &other)
-	        : size_(0)
-	{
-		insert(begin(), other.begin(), other.end());
-		// for (size_ = 0; size_ < other.size(); ++size_)
-		// {
-		// 	construct(size_, other[size_]);
-		// }
-	}
-	JASEL_CXX14_CONSTEXPR static_vector(static_vector &&other)
-	        : size_(0)
-	{
-		move_insert(begin(), other.begin(), other.end());
-		// for (size_ = 0; size_ < other.size(); ++size_)
-		// {
-		// 	construct(size_, move(other[size_]));
-		// }
-	}
+	        : base_type() {}
+	// The copy, the move and the destruction are the ones of the storage.
 	constexpr explicit static_vector(length_tag_t tag, size_type n)
 	        : static_vector(tag, n, T())
 	{
 	}
 	JASEL_CXX14_CONSTEXPR static_vector(length_tag_t tag, size_type n, const value_type &value)
-	        : size_(0)
 	{
 		insert(begin(), tag, n, value);
 		// JASEL_EXPECTS(n <= capacity() && "try to insert beyond capacity");
@@ -144,7 +263,6 @@ public:
 	template <class InputIterator>
 	// requires IsInputIterator<InputIterator>
 	JASEL_CXX14_CONSTEXPR static_vector(InputIterator first, InputIterator last)
-	        : size_(0)
 	{
 		insert(begin(), first, last);
 		// for (size_ = 0; first < last; ++first, ++size_)
@@ -163,26 +281,6 @@ public:
 
 	//! Replaces the contents of the container.
 
-	JASEL_CXX14_CONSTEXPR static_vector &operator=(const static_vector &other)
-	{
-		if (this == &other)
-			return *this;
-		// fixme: Could we optimize it by limiting the destructions and constructions, and using assignments when possible?
-		assign(other.begin(), other.end());
-
-		return *this;
-	}
-	JASEL_CXX14_CONSTEXPR static_vector &operator=(static_vector &&other)
-	{
-		if (this == &other)
-			return *this;
-
-		clear();
-		move_insert(this->begin(), other.begin(), other.end());
-
-		return *this;
-	}
-
 	template <class InputIterator>
 	JASEL_CXX14_CONSTEXPR void assign(InputIterator first, InputIterator last)
 	{
@@ -201,12 +299,6 @@ public:
 		insert(this->begin(), il);
 	}
 
-	// 5.4, destruction
-	~static_vector()
-	{
-		clear();
-	}
-
 	// iterators
 	JASEL_CXX14_CONSTEXPR iterator begin() noexcept
 	{
@@ -240,7 +332,7 @@ public:
 	{
 		return const_reverse_iterator(begin());
 	}
-	JASEL_CXX14_CONSTEXPR const_iterator cbegin() noexcept
+	JASEL_CXX14_CONSTEXPR const_iterator cbegin() const noexcept
 	{
 		return begin();
 	}
@@ -248,7 +340,7 @@ public:
 	{
 		return end();
 	}
-	JASEL_CXX14_CONSTEXPR const_reverse_iterator crbegin() noexcept
+	JASEL_CXX14_CONSTEXPR const_reverse_iterator crbegin() const noexcept
 	{
 		return const_reverse_iterator(end());
 	}
@@ -290,7 +382,36 @@ public:
 		if (sz < size())
 			erase(element_ptr(sz), end());
 		else
-			insert(end(), sz - size(), c);
+			insert(end(), length_tag_t{}, sz - size(), c);
+	}
+
+	// See http://www.open-std.org/jtc1/sc22/wg21/docs/papers/2019/p1072r3.html for resize_default_init motivation
+
+	//! Expects: sz <= capacity().
+	//! Effects: As resize(sz), except that the elements added are default-initialized, so that their value is
+	//! indeterminate when T is trivially default constructible and nothing is written.
+	JASEL_CXX14_CONSTEXPR void resize_default_init(size_type sz)
+	{
+		JASEL_EXPECTS(sz <= capacity() && "try to resize beyond capacity");
+		if (sz < size())
+			erase(element_ptr(sz), end());
+		else
+			for (; size_ < sz; ++size_)
+				new (data_ptr(size_)) T;
+	}
+
+	//! Expects: sz <= capacity() and op(data(), sz) returns r <= sz.
+	//! Effects: resize_default_init(sz), then lets op write the elements of [data(), data() + sz), and keeps the r
+	//! first ones.
+	//!
+	//!   frame.resize_and_overwrite(frame.capacity(), [fd](char *p, size_t n) { return read(fd, p, n); });
+	template <class Operation>
+	JASEL_CXX14_CONSTEXPR void resize_and_overwrite(size_type sz, Operation op)
+	{
+		resize_default_init(sz);
+		size_type const r = size_type(op(data(), sz));
+		JASEL_EXPECTS(r <= sz && "the operation returns a size beyond the one given");
+		erase(begin() + r, end());
 	}
 
 	// 5.6, element and data access:
@@ -330,46 +451,43 @@ public:
 	}
 
 	// 5.7, modifiers:
-	constexpr iterator insert(const_iterator position, const value_type &value)
+	JASEL_CXX14_CONSTEXPR iterator insert(const_iterator position, const value_type &value)
 	{
 		return insert(position, length_tag_t{}, size_type(1), value);
 	}
 
-	constexpr iterator insert(const_iterator position, value_type &&value)
+	JASEL_CXX14_CONSTEXPR iterator insert(const_iterator position, value_type &&value)
 	{
 		return move_insert(position, &value, &value + 1);
 	}
 
+	//! Effects: Constructs the elements at the end, then rotates them into position.
+	//! Throws: When a constructor throws nothing is changed. When a move of T throws during the rotation, the
+	//! elements, the inserted ones included, are left valid but in an unspecified order.
 	JASEL_CXX14_CONSTEXPR iterator insert(const_iterator position, length_tag_t, size_type n, const value_type &x)
 	{
 		JASEL_EXPECTS(n <= capacity() - size() && "try to insert beyond capacity");
 		// memorize the new first
 		auto new_first = end();
-		// emplace back the elements to insert
-		while (n != 0)
-		{
-			push_back(x);
-			--n;
-		}
+		// construct the elements to insert at the end
+		uninitialized_fill_n(new_first, n, x);
+		size_ += n;
 		// make the pointer writable
 		auto writable_position = begin() + (position - begin());
 		// rotate the added elements
 		rotate(writable_position, new_first, end());
 		return writable_position;
 	}
+	//! Effects: Constructs the elements of [first, last) at the end, then rotates them into position.
+	//! Throws: As insert(position, length_tag_t{}, n, x).
 	template <class InputIterator>
 	JASEL_CXX14_CONSTEXPR iterator insert(const_iterator position, InputIterator first, InputIterator last)
 	{
 		JASEL_EXPECTS(iterator_in_range(position) && "try to insert in position out of range");
-		JASEL_EXPECTS(valid_iterator_range(first, last) && "try to insert invalid iterator");
-		JASEL_EXPECTS(distance(first, last) <= capacity() - size() && "try to insert beyond capacity");
 		// memorize the new first
 		auto new_first = end();
-		// emplace back the elements to insert
-		for (; first < last; ++first)
-		{
-			emplace_back(*first);
-		}
+		// construct the elements to insert at the end
+		append(first, last, typename iterator_traits<InputIterator>::iterator_category{});
 		// make the pointer writable
 		auto writable_position = begin() + (position - begin());
 		// rotate the added elements
@@ -379,21 +497,7 @@ public:
 	template <class InputIterator>
 	JASEL_CXX14_CONSTEXPR iterator move_insert(const_iterator position, InputIterator first, InputIterator last)
 	{
-		JASEL_EXPECTS(iterator_in_range(position) && "try to insert in position out of range");
-		JASEL_EXPECTS(valid_iterator_range(first, last) && "try to insert invalid iterator");
-		JASEL_EXPECTS(distance(first, last) <= capacity() - size() && "try to insert beyond capacity");
-		// memorize the new first
-		auto new_first = end();
-		// emplace back the elements to insert
-		for (; first < last; ++first)
-		{
-			emplace_back(move(*first));
-		}
-		// make the pointer writable
-		auto writable_position = begin() + (position - begin());
-		// rotate the added elements
-		rotate(writable_position, new_first, end());
-		return writable_position;
+		return insert(position, make_move_iterator(first), make_move_iterator(last));
 	}
 	JASEL_CXX14_CONSTEXPR iterator insert(const_iterator position, initializer_list<value_type> il)
 	{
@@ -439,6 +543,44 @@ public:
 		++size_;
 	}
 
+	//! Expects: !full().
+	//! Effects: As emplace_back(args...), for the loops whose capacity is known. The precondition is an audit one,
+	//! not checked when NDEBUG is defined.
+	template <class... Args>
+	JASEL_CXX14_CONSTEXPR reference unchecked_emplace_back(Args &&... args)
+	{
+		JASEL_EXPECTS_AUDIT(!full() && "try to emplace_back in a full collection");
+		T *p = new (data_ptr(size_)) T(forward<Args>(args)...);
+		++size_;
+		return *p;
+	}
+	JASEL_CXX14_CONSTEXPR reference unchecked_push_back(const value_type &x)
+	{
+		return unchecked_emplace_back(x);
+	}
+	JASEL_CXX14_CONSTEXPR reference unchecked_push_back(value_type &&x)
+	{
+		return unchecked_emplace_back(move(x));
+	}
+
+	//! Effects: As emplace_back(args...) if !full(), nothing otherwise.
+	//! Returns: A pointer to the element emplaced, nullptr if full().
+	template <class... Args>
+	JASEL_CXX14_CONSTEXPR pointer try_emplace_back(Args &&... args)
+	{
+		if (full())
+			return nullptr;
+		return &unchecked_emplace_back(forward<Args>(args)...);
+	}
+	JASEL_CXX14_CONSTEXPR pointer try_push_back(const value_type &x)
+	{
+		return try_emplace_back(x);
+	}
+	JASEL_CXX14_CONSTEXPR pointer try_push_back(value_type &&x)
+	{
+		return try_emplace_back(move(x));
+	}
+
 	JASEL_CXX14_CONSTEXPR void pop_back()
 	{
 		JASEL_EXPECTS(!empty() && "try to pop_back in an empty collection");
@@ -470,10 +612,8 @@ public:
 
 	JASEL_CXX14_CONSTEXPR void clear() noexcept
 	{
-		for (; size_ > 0; size_--)
-		{
-			destruct(size_ - 1);
-		}
+		destruct(begin(), end());
+		size_ = 0;
 	}
 
 	JASEL_CXX14_CONSTEXPR void swap(static_vector &other)
@@ -0,0 +1,34 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Vicente J. Botet Escriba 2019.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file // LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//see http://www.open-std.org/jtc1/sc22/wg21/docs/papers/2019/p1144r3.html
+
+#ifndef JASEL_STD_IS_TRIVIALLY_RELOCATABLE_HPP
+#define JASEL_STD_IS_TRIVIALLY_RELOCATABLE_HPP
+
+// fixme: adapt as soon as this trait is implemented
+#if __cplusplus <= 202303L
+
+#include <type_traits>
+
+namespace std
+{
+
+// Whether moving a T to a new address and destroying the source can be done by copying its bytes, the source
+// being then left as raw memory.
+// The trivially copyable types are trivially relocatable. The types owning their resources through a pointer, as
+// unique_ptr, usually are too, and may specialize this trait.
+template <typename T>
+struct is_trivially_relocatable : is_trivially_copyable<T>
+{
+};
+
+} // namespace std
+
+#endif
+#endif // header
@@ -0,0 +1,188 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Vicente J. Botet Escriba 2019.
+// Distributed under the Boost
+// Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or
+// copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//////////////////////////////////////////////////////////////////////////////
+
+/*
+ \file
+ \brief
+ The header \c <experimental/.../word/packed_blocks.hpp> defines the layout shared by \c compact_array and
+ \c packed_vector and the functions packing and unpacking their values a block at a time.
+
+ The value \c k is stored in the bits \c [Bits*(k%per_block), Bits*(k%per_block+1)) of the block \c k/per_block, where
+ \c per_block is \c digits(Block)/Bits. The values don't straddle two blocks, so that they can be accessed through a
+ \c subword_reference; the \c digits(Block)%Bits high bits of each block, and the slots past the size, are kept to 0.
+
+ When BMI2 is enabled and the blocks have 64 bits the values are unpacked and packed by lanes of 8 bytes with \c pdep
+ and \c pext. Defining JASEL_NO_BMI2 disables these paths, as well as the one of \c rank_select_bitvector.
+ */
+
+#ifndef JASEL_FUNDAMENTAL_V3_WORD_PACKED_BLOCKS_HPP
+#define JASEL_FUNDAMENTAL_V3_WORD_PACKED_BLOCKS_HPP
+
+#include <experimental/fundamental/v2/config.hpp>
+#include <experimental/fundamental/v3/bits/binary_digits.hpp>
+#include <experimental/fundamental/v3/bits/bit_ops.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined __BMI2__ && !defined JASEL_NO_BMI2
+#define JASEL_SUBWORD_BMI2
+#include <immintrin.h>
+#endif
+
+namespace std
+{
+namespace experimental
+{
+inline namespace fundamental_v3
+{
+  namespace packed_detail
+  {
+    //! The smallest unsigned type having at least Bits digits.
+    template <int Bits>
+    using uint_least_t = conditional_t<(Bits <= 8), uint8_t,
+                         conditional_t<(Bits <= 16), uint16_t,
+                         conditional_t<(Bits <= 32), uint32_t, uint64_t>>>;
+
+    template <int Bits, class Block>
+    struct layout
+    {
+      static_assert(is_unsigned<Block>::value, "A Block must be unsigned");
+      static_assert(0 < Bits && Bits <= int(binary_digits<Block>::value), "Bits must be in [1, digits(Block)]");
+
+      static constexpr int block_digits = binary_digits<Block>::value;
+      static constexpr size_t per_block = size_t(block_digits / Bits);
+      static constexpr Block mask = bit_ops::up_to<Bits, Block>();
+
+      //! @par Returns:
+      //!   The number of blocks needed to store n values.
+      static constexpr size_t blocks(size_t n) noexcept
+      {
+        return (n + per_block - 1) / per_block;
+      }
+      //! @par Returns:
+      //!   The value at the position pos of the block b.
+      template <class T>
+      static constexpr T get(Block b, size_t pos) noexcept
+      {
+        return T((b >> (size_t(Bits) * pos)) & mask);
+      }
+    };
+
+#if defined JASEL_SUBWORD_BMI2
+    //! @par Returns:
+    //!   The mask selecting the Bits low bits of each lane of sizeof(T) bytes of a 64-bit word.
+    template <int Bits, class T>
+    constexpr uint64_t lanes_mask() noexcept
+    {
+      return uint64_t(bit_ops::up_to<Bits, uint64_t>()) * (~uint64_t(0) / uint64_t(bit_ops::up_to<binary_digits<T>::value, uint64_t>()));
+    }
+
+    // pdep spreads the consecutive values of the block to the lanes of a 64-bit word, which is the little endian
+    // representation of 8/sizeof(T) consecutive T; pext does the opposite.
+    template <int Bits, class T>
+    struct use_bmi2 : integral_constant<bool, sizeof(T) < 8 && Bits <= int(binary_digits<T>::value)> {};
+
+    template <int Bits, class Block, class T>
+    void unpack_block(Block b, T* out, size_t count, true_type) noexcept
+    {
+      constexpr size_t lanes = 8 / sizeof(T);
+      constexpr uint64_t m = lanes_mask<Bits, T>();
+      size_t i = 0;
+      for (; i + lanes <= count; i += lanes)
+      {
+        uint64_t const v = _pdep_u64(b >> (size_t(Bits) * i), m);
+        memcpy(out + i, &v, sizeof(v));
+      }
+      if (i < count)
+      {
+        uint64_t const v = _pdep_u64(b >> (size_t(Bits) * i), m);
+        memcpy(out + i, &v, (count - i) * sizeof(T));
+      }
+    }
+    template <int Bits, class Block, class T>
+    Block pack_block(T const* in, size_t count, true_type) noexcept
+    {
+      constexpr size_t lanes = 8 / sizeof(T);
+      constexpr uint64_t m = lanes_mask<Bits, T>();
+      uint64_t b = 0;
+      size_t i = 0;
+      for (; i + lanes <= count; i += lanes)
+      {
+        uint64_t v;
+        memcpy(&v, in + i, sizeof(v));
+        b |= _pext_u64(v, m) << (size_t(Bits) * i);
+      }
+      if (i < count)
+      {
+        uint64_t v = 0;
+        memcpy(&v, in + i, (count - i) * sizeof(T));
+        b |= _pext_u64(v, m) << (size_t(Bits) * i);
+      }
+      return b;
+    }
+#else
+    template <int Bits, class T>
+    struct use_bmi2 : false_type {};
+#endif
+
+    template <int Bits, class Block, class T>
+    void unpack_block(Block b, T* out, size_t count, false_type) noexcept
+    {
+      for (size_t i = 0; i < count; ++i)
+        out[i] = layout<Bits, Block>::template get<T>(b, i);
+    }
+    template <int Bits, class Block, class T>
+    Block pack_block(T const* in, size_t count, false_type) noexcept
+    {
+      Block b = 0;
+      for (size_t i = 0; i < count; ++i)
+        b |= Block((Block(in[i]) & layout<Bits, Block>::mask) << (size_t(Bits) * i));
+      return b;
+    }
+
+    template <int Bits, class Block, class T>
+    using bmi2_tag = integral_constant<bool, is_same<Block, uint64_t>::value && use_bmi2<Bits, T>::value>;
+
+    //! @par Effects:
+    //!   Writes the n values stored in the blocks to out.
+    template <int Bits, class Block, class T>
+    void unpack(Block const* blocks, size_t n, T* out) noexcept
+    {
+      constexpr size_t per_block = layout<Bits, Block>::per_block;
+      size_t const full = n / per_block;
+      // the count is a constant for the full blocks, so that their loops can be unrolled
+      for (size_t i = 0; i < full; ++i)
+        unpack_block<Bits, Block>(blocks[i], out + i * per_block, per_block, bmi2_tag<Bits, Block, T>());
+      if (n % per_block != 0)
+        unpack_block<Bits, Block>(blocks[full], out + full * per_block, n % per_block, bmi2_tag<Bits, Block, T>());
+    }
+
+    //! @par Effects:
+    //!   Stores the Bits low bits of the n values of in to the blocks(n) first blocks. The unused bits of these
+    //!   blocks are set to 0.
+    template <int Bits, class Block, class T>
+    void pack(T const* in, size_t n, Block* blocks) noexcept
+    {
+      constexpr size_t per_block = layout<Bits, Block>::per_block;
+      size_t const full = n / per_block;
+      for (size_t i = 0; i < full; ++i)
+        blocks[i] = pack_block<Bits, Block>(in + i * per_block, per_block, bmi2_tag<Bits, Block, T>());
+      if (n % per_block != 0)
+        blocks[full] = pack_block<Bits, Block>(in + full * per_block, n % per_block, bmi2_tag<Bits, Block, T>());
+    }
+  }
+}
+}
+} // std
+
+#endif // header
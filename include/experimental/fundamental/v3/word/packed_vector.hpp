@@ -0,0 +1,293 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Vicente J. Botet Escriba 2019.
+// Distributed under the Boost
+// Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or
+// copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Based on the <vector> interface
+//
+//////////////////////////////////////////////////////////////////////////////
+
+/*!
+\file
+\brief
+The header \c <experimental/packed_vector.hpp> defines a class template \c packed_vector<Bits, T, Block, Allocator>,
+the dynamically sized sibling of \c compact_array: a sequence of unsigned values of \c Bits bits packed in a vector of
+blocks.
+*/
+
+#ifndef JASEL_FUNDAMENTAL_V3_WORD_PACKED_VECTOR_HPP
+#define JASEL_FUNDAMENTAL_V3_WORD_PACKED_VECTOR_HPP
+
+#include <experimental/fundamental/v3/word/packed_blocks.hpp>
+#include <experimental/contract.hpp>
+#include <experimental/span.hpp>
+#include <experimental/subword.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace std
+{
+namespace experimental
+{
+inline namespace fundamental_v3
+{
+
+    /**
+    A `packed_vector<Bits, T, Block, Allocator>` stores a sequence of values of the unsigned type `T`, using only `Bits`
+    bits for each one. The layout of the blocks is the one of `compact_array`: `binary_digits_v<Block> / Bits` values
+    in each block, accessed in constant time through a `subword_reference`.
+    When assigned, the bits of a value that don't fit in `Bits` bits are discarded.
+
+    @tparam Bits the number of significant bits of the elements
+    @tparam T the element type, by default the smallest unsigned type having `Bits` digits
+    @tparam Block the unsigned type of the blocks storing the elements
+    @tparam Allocator the allocator of the blocks
+  */
+    template<int Bits, class T=packed_detail::uint_least_t<Bits>, class Block=uint64_t, class Allocator=allocator<Block>>
+    class packed_vector {
+    private:
+        using layout = packed_detail::layout<Bits, Block>;
+        static_assert(is_unsigned<T>::value, "T must be unsigned");
+        static_assert(Bits <= int(binary_digits<T>::value), "The number of significant bits of T must be LE the digits of T");
+
+        static constexpr size_t per_block = layout::per_block;
+
+    public:
+        // type definitions
+        typedef T                 value_type;
+        typedef Block             block_type;
+        typedef Allocator         allocator_type;
+        typedef std::size_t       size_type;
+        typedef std::ptrdiff_t    difference_type;
+        typedef subword_reference<Bits, Block, T>        reference;
+        typedef T                                        const_reference;
+        typedef subword_iterator<Block*, Bits, T>        iterator;
+        typedef subword_iterator<Block const*, Bits, T>  const_iterator;
+        typedef std::reverse_iterator<iterator>          reverse_iterator;
+        typedef std::reverse_iterator<const_iterator>    const_reverse_iterator;
+        static const int          element_digits = Bits;
+
+        // construct/copy/destroy
+        packed_vector() = default;
+
+        explicit packed_vector(const Allocator& a)
+          : blocks_(a), size_(0)
+        {}
+
+        //! \n<b>Effects:</b> Constructs a vector with n elements set to 0.
+        explicit packed_vector(size_type n, const Allocator& a = Allocator())
+          : blocks_(layout::blocks(n), Block(0), a), size_(n)
+        {}
+
+        //! \n<b>Effects:</b> Constructs a vector with n elements set to value.
+        packed_vector(size_type n, const T& value, const Allocator& a = Allocator())
+          : blocks_(layout::blocks(n), Block(0), a), size_(n)
+        {
+            fill(0, n, value);
+        }
+
+        packed_vector(std::initializer_list<T> il, const Allocator& a = Allocator())
+          : blocks_(layout::blocks(il.size()), Block(0), a), size_(il.size())
+        {
+            packed_detail::pack<Bits>(il.begin(), il.size(), blocks_.data());
+        }
+
+        template <class InputIterator, class = typename iterator_traits<InputIterator>::iterator_category>
+        packed_vector(InputIterator first, InputIterator last, const Allocator& a = Allocator())
+          : blocks_(a), size_(0)
+        {
+            for (; first != last; ++first)
+                push_back(T(*first));
+        }
+
+        allocator_type get_allocator() const noexcept
+        {
+            return blocks_.get_allocator();
+        }
+
+        // iterators
+        iterator        begin() noexcept        { return iterator(blocks_.data(), 0); }
+        const_iterator  begin() const noexcept  { return const_iterator(blocks_.data(), 0); }
+        const_iterator  cbegin() const noexcept { return begin(); }
+        iterator        end() noexcept          { return iterator(blocks_.data() + size_ / per_block, size_ % per_block); }
+        const_iterator  end() const noexcept    { return const_iterator(blocks_.data() + size_ / per_block, size_ % per_block); }
+        const_iterator  cend() const noexcept   { return end(); }
+
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+
+        // capacity
+        size_type size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+        size_type max_size() const noexcept
+        {
+            return std::min(blocks_.max_size(), size_type(-1) / per_block) * per_block;
+        }
+        //! \n<b>Returns:</b> The number of elements the blocks already allocated can store.
+        size_type capacity() const noexcept { return blocks_.capacity() * per_block; }
+        void reserve(size_type n) { blocks_.reserve(layout::blocks(n)); }
+        void shrink_to_fit() { blocks_.shrink_to_fit(); }
+
+        //! \n<b>Effects:</b> Appends or erases elements at the end so that size() == n; the appended ones are 0.
+        void resize(size_type n)
+        {
+            if (n < size_)
+                clear_tail(n);
+            blocks_.resize(layout::blocks(n), Block(0));
+            size_ = n;
+        }
+        //! \n<b>Effects:</b> Appends or erases elements at the end so that size() == n; the appended ones are value.
+        void resize(size_type n, const T& value)
+        {
+            size_type const old = size_;
+            resize(n);
+            if (old < n)
+                fill(old, n, value);
+        }
+
+        // element access
+        //! \n<b>Pre-condition:</b> `k < size()`
+        reference operator[](size_type k) noexcept
+        {
+            return JASEL_EXPECTS(k < size_), reference(blocks_[k / per_block], k % per_block);
+        }
+        //! \n<b>Pre-condition:</b> `k < size()`
+        const_reference operator[](size_type k) const noexcept
+        {
+            return JASEL_EXPECTS(k < size_), layout::template get<T>(blocks_[k / per_block], k % per_block);
+        }
+        //! \n<b>Throws:</b> std::out_of_range if k >= size()
+        reference at(size_type k)
+        {
+            return (*this)[rangecheck(k)];
+        }
+        const_reference at(size_type k) const
+        {
+            return (*this)[rangecheck(k)];
+        }
+        reference front() noexcept { return (*this)[0]; }
+        const_reference front() const noexcept { return (*this)[0]; }
+        reference back() noexcept { return (*this)[size_ - 1]; }
+        const_reference back() const noexcept { return (*this)[size_ - 1]; }
+
+        //! direct access to the blocks
+        Block* data() noexcept { return blocks_.data(); }
+        const Block* data() const noexcept { return blocks_.data(); }
+        //! \n<b>Returns:</b> The number of blocks storing the elements.
+        size_type block_count() const noexcept { return blocks_.size(); }
+
+        // modifiers
+        void push_back(const T& value)
+        {
+            if (size_ % per_block == 0)
+                blocks_.push_back(Block(0));
+            ++size_;
+            back() = value;
+        }
+        //! \n<b>Pre-condition:</b> `! empty()`
+        void pop_back() noexcept
+        {
+            JASEL_EXPECTS(size_ > 0);
+            resize(size_ - 1);
+        }
+        void clear() noexcept
+        {
+            blocks_.clear();
+            size_ = 0;
+        }
+        void swap(packed_vector& other) noexcept
+        {
+            blocks_.swap(other.blocks_);
+            std::swap(size_, other.size_);
+        }
+
+        // bulk conversions
+        //! \n<b>Pre-condition:</b> `out.size() == size()`
+        //! \n<b>Effects:</b> Copies the elements to out, unpacking a block at a time.
+        void unpack_to(span<T> out) const noexcept
+        {
+            JASEL_EXPECTS(size_type(out.size()) == size_);
+            packed_detail::unpack<Bits>(blocks_.data(), size_, out.data());
+        }
+
+        //! \n<b>Effects:</b> Replaces the elements by the ones of in, packing a block at a time.
+        void pack_from(span<T const> in)
+        {
+            size_type const n = size_type(in.size());
+            blocks_.resize(layout::blocks(n));
+            packed_detail::pack<Bits>(in.data(), n, blocks_.data());
+            size_ = n;
+        }
+
+    private:
+        //! Sets the slots [n, size()) of the block containing the element n to 0
+        //! The block index is checked against the block count, which the optimizer cannot derive from n < size().
+        void clear_tail(size_type n) noexcept
+        {
+            size_type const k = n / per_block;
+            if (n % per_block != 0 && k < blocks_.size())
+                blocks_[k] &= bit_ops::up_to<Block>(size_t(Bits) * (n % per_block));
+        }
+        //! Assigns value to the elements [first, last).
+        void fill(size_type first, size_type last, const T& value) noexcept
+        {
+            for (; first != last && first % per_block != 0; ++first)
+                (*this)[first] = value;
+            Block b = 0;
+            for (size_t i = 0; i < per_block; ++i)
+                b |= Block((Block(value) & layout::mask) << (size_t(Bits) * i));
+            for (; last - first >= per_block; first += per_block)
+                blocks_[first / per_block] = b;
+            for (; first != last; ++first)
+                (*this)[first] = value;
+        }
+        size_type rangecheck(size_type k) const
+        {
+            if (k >= size_)
+                throw std::out_of_range("packed_vector<>: index out of range");
+            return k;
+        }
+
+        vector<Block, Allocator> blocks_;
+        size_type size_ = 0;
+    };
+
+    template<int Bits, class T, class B, class A>
+    const int packed_vector<Bits, T, B, A>::element_digits;
+
+    // comparisons
+    template<int Bits, class T, class B, class A>
+    bool operator== (const packed_vector<Bits, T, B, A>& x, const packed_vector<Bits, T, B, A>& y)
+    {
+        // the unused bits are always 0
+        return x.size() == y.size() && std::equal(x.data(), x.data() + x.block_count(), y.data());
+    }
+    template<int Bits, class T, class B, class A>
+    bool operator!= (const packed_vector<Bits, T, B, A>& x, const packed_vector<Bits, T, B, A>& y)
+    {
+        return !(x==y);
+    }
+
+    template<int Bits, class T, class B, class A>
+    inline void swap (packed_vector<Bits, T, B, A>& x, packed_vector<Bits, T, B, A>& y) noexcept
+    {
+        x.swap(y);
+    }
+
+}}
+}
+
+
+#endif // header
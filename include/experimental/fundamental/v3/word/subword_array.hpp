@@ -10,12 +10,10 @@
 //
 //////////////////////////////////////////////////////////////////////////////
 
-#error "Not ready yet"
-
 /*!
 \file
 \brief
-The header \c <experimantal/compact_array.hpp> defines a class template for storing
+The header \c <experimental/compact_array.hpp> defines a class template for storing
 sequences of objects fixed by the number of significant bits of the mapped type.
 We can say that
 \c compact_array is a generalization of std::bitset and \c std::array
@@ -26,12 +24,14 @@ and  number of significant bits is enough to use only a compact form with the si
 #ifndef JASEL_FUNDAMENTAL_V3_BITS_COMPACT_ARRAY_HPP
 #define JASEL_FUNDAMENTAL_V3_BITS_COMPACT_ARRAY_HPP
 
-#include <experimental/swappable.hpp>
-#include <experimental/bit.hpp>
+#include <experimental/fundamental/v3/word/packed_blocks.hpp>
+#include <experimental/contract.hpp>
+#include <experimental/span.hpp>
 #include <experimental/subword.hpp>
-#include <cassert>
-#include <iterator>
 #include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
 #include <stdexcept>
 
 namespace std
@@ -41,59 +41,16 @@ namespace experimental
 inline namespace fundamental_v3
 {
 
-  template<class T, class WordType>
-  class nbits_reference
-  {
-    static_assert(binary_digits<WordType>::value, "");
-
-  public:
-    using word_type = WordType;
-    using value_type = T;
-    using index_type = size_t;
-
-    constexpr reference() noexcept = delete;
-    constexpr reference(reference const&) noexcept = default;
-    reference& operator=(reference const&) noexcept = default;
-    ~reference() noexcept = default;
-
-    constexpr reference(word_type& ref, index_type pos) noexcept
-      : ptr_(&ref), pos_(pos)
-    { }
-
-    //! assignment from T
-    JASEL_MUTABLE_CONSTEXPR reference& operator=(T const& x) noexcept
-    {
-      ptr_->set_value(pos_, x);
-      return *this;
-    }
-
-    //! implicit conversion to T
-    constexpr operator T() const noexcept
-    {
-      return ptr_->get_value(pos_);
-    }
-
-    constexpr nbits_pointer<T, WordType> operator&() const noexcept;
-
-    void swap(nbits_reference other);
-    void swap(T& other);
-
-    constexpr word_type* address() const noexcept;
-    constexpr size_type position() const noexcept;
-    constexpr word_type mask1() const noexcept;
-    constexpr word_type mask2() const noexcept;
-
-  private:
-    word_type* ptr_;
-    index_type pos_;
-  };
-
     /**
-    An `compact_array` supports random access iterators. An instance of `compact_array<T, N, B>`
-    stores `N` elements of a trivial type `T` using the significant bits of `T` defined by binary_digits_v<T>.
+    An `compact_array` supports random access iterators. An instance of `compact_array<T, N, Block, Bits>`
+    stores `N` elements of an unsigned type `T` using only `Bits` bits for each one, `binary_digits_v<T>` by default.
+
+    The elements are stored in an array of `Block`, `binary_digits_v<Block> / Bits` elements in each block; an element
+    doesn't straddle two blocks, so that it is accessed in constant time through a `subword_reference`.
+    When assigned, the bits of a value that don't fit in `Bits` bits are discarded.
 
     The elements of an `compact_array` are stored contiguously, but at the bit level, not at the address level,
-    meaning that if `a` is a `compact_array<T, N, B>`, then it doesn' obeys the identity
+    meaning that if `a` is a `compact_array<T, N, Block, Bits>`, then it doesn' obeys the identity
 
      \code
      &a[n] == &a[0] + n for all 0 <= n <  N().
@@ -102,144 +59,80 @@ inline namespace fundamental_v3
     An `compact_array` is not an aggregate but can be initialized using the syntax
 
      \code
-      compact_array<T, N, B> a = { initializer-list };
+      compact_array<T, N, Block, Bits> a = { initializer-list };
      \endcode
 
     where \e initializer-list is a comma separated list of up to `N`
-    elements of type `U` convertible to `T`.
+    elements of type `T`.
 
     An `compact_array` satisfies some of the requirements of a container and of a
     reversible container, except
     - that a default constructed array object is not empty and that swap does not have constant complexity.
-
-    An `compact_array` satisfies some of the requirements of a sequence container. Descriptions are provided
-    here only for operations on `compact_array` that are not described in one of these tables and for operations
-    where there is additional semantic information.
-
-    The conditions for an aggregate are met. Class `compact_array` relies on
-    the implicitly-declared special member functions to conform to the
-    container requirements
-
-    @par Note:
-    The member variable `elems` is shown for exposition only, to emphasize
-    that `compact_array` is a class aggregate. The name elems is not part of
-    compact_array's interface.
+    - that its iterators are proxy iterators as the ones of `vector<bool>`.
 
     @tparam T array's element type
-    @tparam N array's numlber of elements
+    @tparam N array's number of elements
+    @tparam Block the unsigned type of the blocks storing the elements
+    @tparam Bits the number of significant bits of the elements
   */
 
-    template<class T, size_t N, class Block=uint64_t>
+    template<class T, size_t N, class Block=uint64_t, int Bits=int(binary_digits<T>::value)>
     class compact_array {
     private:
-        constexpr unsigned element_digits = binary_digits<T>::value;
-        constexpr unsigned block_digits = sizeof(Block);
-        static_assert(is_integral<Block>::value, "Block must be integral");
-        static_assert(is_same<Block, bool>::value, "Block can not be bool");
-        static_assert(is_signed<Block>::value, "Block must be signed");
-        static_assert(element_digits<= sizeof(Block)), "The number of significant bits of T must be LT the size of the Block");
+        using layout = packed_detail::layout<Bits, Block>;
+        static_assert(is_unsigned<T>::value, "T must be unsigned");
+        static_assert(Bits <= int(binary_digits<T>::value), "The number of significant bits of T must be LE the digits of T");
 
-        constexpr size_type num_of_blocks = (element_digits*N) / block_digits;
-        constexpr index_type period = static_mcm<element_digits, 2*block_digits>/element_digits;
+        static constexpr size_t per_block = layout::per_block;
+        static constexpr size_t num_of_blocks = N == 0 ? 1 : layout::blocks(N);
 
         Block blocks[num_of_blocks];   //! storage
 
     public:
-
-        //! proxy class representing a reference to an compressed element
-        //!
-        //! It contains an assignment operator, a conversion to @c T,
-        //! It exists only as a helper class for @c compact_array's @c operator[].
-        class reference {
-          using compact_array_type = compact_array<T, N, Block>;
-          friend class compact_array<T, N, Block>;
-          compact_array_type* ref_;
-          T pos_;
-          constexpr reference(compact_array_type& ref, T pos) noexcept
-            : ref_(&ref), pos_(pos)
-          { }
-        public:
-          constexpr reference() noexcept = delete;
-          constexpr reference(reference const&) noexcept = default;
-          reference& operator=(reference const&) noexcept = default;
-          ~reference() noexcept = default;
-
-          //! assignment from T
-          JASEL_MUTABLE_CONSTEXPR reference& operator=(T const& x) noexcept
-          {
-            ref_->set_value(pos_, x);
-            return *this;
-          }
-
-          //! implicit conversion to T
-          constexpr operator T() const noexcept
-          {
-            return T(ref_->get_value(pos_));
-          }
-
-          // fixme do we want reference to behave like a bitmask<bitsof<T>, Block>?
-        };
-        //! proxy class representing a const reference to an compressed element
-        //!
-        //! It contains an assignment operator, a conversion to @c T,
-        //! It exists only as a helper class for @c compact_array's @c operator[].
-        class const_reference {
-          using compact_array_type = compact_array<T, N, Block>;
-          friend class compact_array<T, N, Block>;
-          compact_array_type const* ref_;
-          T pos_;
-          constexpr reference(compact_array_type const& ref, T pos) noexcept
-            : ref_(&ref), pos_(pos)
-          { }
-        public:
-          constexpr reference() noexcept = delete;
-          constexpr reference(reference const&) noexcept = default;
-          reference& operator=(reference const&) noexcept = default;
-          ~reference() noexcept = default;
-
-          //! implicit conversion to T
-          constexpr operator T() const noexcept
-          {
-            return T(ref_->get_value(pos_));
-          }
-        };
         // type definitions
         typedef T                 value_type;
-
-        //typedef value_type*       pointer;
-        //typedef const value_type* const_pointer;
-        typedef int               key_type;
+        typedef Block             block_type;
         typedef std::size_t       size_type;
-        typedef std::size_t       index_type;
         typedef std::ptrdiff_t    difference_type;
+        typedef subword_reference<Bits, Block, T>        reference;
+        typedef T                                        const_reference;
+        typedef subword_iterator<Block*, Bits, T>        iterator;
+        typedef subword_iterator<Block const*, Bits, T>  const_iterator;
+        typedef std::reverse_iterator<iterator>          reverse_iterator;
+        typedef std::reverse_iterator<const_iterator>    const_reverse_iterator;
         static const std::size_t  static_size = N;
-
-        JASEL_MUTABLE_CONSTEXPR iterator        elems_ptr(key_type k) noexcept { return iterator(this, k); }
-        JASEL_MUTABLE_CONSTEXPR const_iterator  elems_ptr(key_type k) const noexcept { return const_iterator(this, k); }
-
-        JASEL_MUTABLE_CONSTEXPR reference        elems_ref(key_type k) noexcept { return reference(this, k); }
-        JASEL_MUTABLE_CONSTEXPR const_reference  elems_ref(key_type k) const noexcept { return const_reference(this, k); }
-
+        static const int          element_digits = Bits;
+        static const std::size_t  block_count = num_of_blocks;
+
+        //! \n<b>Effects:</b> Constructs an array with all the elements set to 0.
+        constexpr compact_array() noexcept
+          : blocks{}
+        {}
+
+        //! \n<b>Pre-condition:</b> `il.size() <= N`
+        //! \n<b>Effects:</b> Constructs an array with the elements of il followed by 0s.
+        compact_array(std::initializer_list<T> il) noexcept
+          : blocks{}
+        {
+            JASEL_EXPECTS(il.size() <= N);
+            packed_detail::pack<Bits>(il.begin(), il.size(), blocks);
+        }
 
         // iterator support
         //! \n<b>Returns:</b> iterator for the first element
         //! \n<b>Throws:</b> Nothing
-        JASEL_MUTABLE_CONSTEXPR iterator        begin() noexcept     { return elems_ptr(0); }
+        JASEL_MUTABLE_CONSTEXPR iterator        begin() noexcept     { return iterator(blocks, 0); }
 
         //! \n<b>Returns:</b> const iterator for the first element
-        constexpr const_iterator  begin() const noexcept { return elems_ptr(0); }
-        constexpr const_iterator cbegin() const noexcept { return elems_ptr(0); }
+        constexpr const_iterator  begin() const noexcept { return const_iterator(blocks, 0); }
+        constexpr const_iterator cbegin() const noexcept { return begin(); }
 
         //! \n<b>Returns:</b> iterator for position after the last element
-        JASEL_MUTABLE_CONSTEXPR iterator        end() noexcept      { return elems_ptr(N); }
+        JASEL_MUTABLE_CONSTEXPR iterator        end() noexcept      { return iterator(blocks + N / per_block, N % per_block); }
 
         //! \n<b>Returns:</b> const iterator for position after the last element
-        constexpr const_iterator  end() const noexcept { return elems_ptr(N); }
-        constexpr const_iterator cend() const noexcept { return elems_ptr(N); }
-
-        // reverse iterator support
-        typedef std::reverse_iterator<iterator> reverse_iterator;
-        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+        constexpr const_iterator  end() const noexcept { return const_iterator(blocks + N / per_block, N % per_block); }
+        constexpr const_iterator cend() const noexcept { return end(); }
 
         //! \n<b>Returns:</b> reverse iterator for the first element of reverse iteration
         JASEL_MUTABLE_CONSTEXPR reverse_iterator rbegin() noexcept {
@@ -265,169 +158,31 @@ inline namespace fundamental_v3
 
         // operator[]
         //! \n<b>Pre-condition:</b> `k < static_size`
-        //! \n<b>Returns:</b> reference to the element with key `k`
+        //! \n<b>Returns:</b> reference to the element `k`
         //! \n<b>Throws:</b> Nothing.
-        JASEL_MUTABLE_CONSTEXPR reference operator[](key_type k)
+        JASEL_MUTABLE_CONSTEXPR reference operator[](size_type k) noexcept
         {
-            assert( k < static_size && "out of range" );
-            return elems_ref(k);
+            return JASEL_EXPECTS(k < static_size), reference(blocks[k / per_block], k % per_block);
         }
 
         //! \n<b>Pre-condition:</b> <tt>k < static_size</tt>
-        //! \n<b>Returns:</b> constant reference to the element with key k
+        //! \n<b>Returns:</b> the value of the element k
         //! \n<b>Throws:</b> Nothing.
-        JASEL_CXX14_CONSTEXPR const_reference operator[](key_type k) const
+        constexpr const_reference operator[](size_type k) const noexcept
         {
-            assert( k < static_size && "out of range" );
-            return elems_ref(k);
-        }
-
-
-        // |xxxxxxxx|xxxxxxxx|xxxxxxxx|xxxxxxxx|xxxxxxxx|xxxxxxxx|xxxxxxxx|xxxxxxxx|
-        // |xxxxxxxx|xx000000|00000000|00000000|00000000|00000000|00000000|00000000|
-        // |00000000|00xxxxxx|xxxx0000|00000000|00000000|00000000|00000000|00000000|
-        // |00000000|00000000|0000xxxx|xxxxxx00|00000000|00000000|00000000|00000000|
-        // |00000000|00000000|00000000|000000xx|xxxxxxxx|00000000|00000000|00000000|
-        // |00000000|00000000|00000000|00000000|00000000|xxxxxxxx|xx000000|00000000|
-        // |00000000|00000000|00000000|00000000|00000000|00000000|00xxxxxx|xxxx0000|
-
-        // |00000000|00000000|00000000|00000000|00000000|00000000|00000000|0000xxxx|
-        // |xxxxxx00|00000000|00000000|00000000|00000000|00000000|00000000|00000000|
-        // |000000xx|xxxxxxxx|00000000|00000000|00000000|00000000|00000000|00000000|
-        // |00000000|00000000|xxxxxxxx|xx000000|00000000|00000000|00000000|00000000|
-        // |00000000|00000000|00000000|00xxxxxx|xxxx0000|00000000|00000000|00000000|
-        // |00000000|00000000|00000000|00000000|0000xxxx|xxxxxx00|00000000|00000000|
-        // |00000000|00000000|00000000|00000000|00000000|000000xx|xxxxxxxx|00000000|
-
-        // |00000000|00000000|00000000|00000000|00000000|00000000|00000000|xxxxxxxx|
-        // |xx000000|00000000|00000000|00000000|00000000|00000000|00000000|00000000|
-        // |00xxxxxx|xxxx0000|00000000|00000000|00000000|00000000|00000000|00000000|
-        // |00000000|0000xxxx|xxxxxx00|00000000|00000000|00000000|00000000|00000000|
-        // |00000000|00000000|000000xx|xxxxxxxx|00000000|00000000|00000000|00000000|
-        // |00000000|00000000|00000000|00000000|xxxxxxxx|xx000000|00000000|00000000|
-        // |00000000|00000000|00000000|00000000|00000000|00xxxxxx|xxxx0000|00000000|
-        // |00000000|00000000|00000000|00000000|00000000|00000000|0000xxxx|xxxxxx00|
-
-        // |00000000|00000000|00000000|00000000|00000000|00000000|00000000|000000xx|
-        // |xxxxxxxx|00000000|00000000|00000000|00000000|00000000|00000000|00000000|
-        // |00000000|xxxxxxxx|xx000000|00000000|00000000|00000000|00000000|00000000|
-        // |00000000|00000000|00xxxxxx|xxxx0000|00000000|00000000|00000000|00000000|
-        // |00000000|00000000|00000000|0000xxxx|xxxxxx00|00000000|00000000|00000000|
-        // |00000000|00000000|00000000|00000000|000000xx|xxxxxxxx|00000000|00000000|
-        // |00000000|00000000|00000000|00000000|00000000|00000000|xxxxxxxx|xx000000|
-
-        // |00000000|00000000|00000000|00000000|00000000|00000000|00000000|00xxxxxx|
-        // |xxxx0000|00000000|00000000|00000000|00000000|00000000|00000000|00000000|
-        // |0000xxxx|xxxxxx00|00000000|00000000|00000000|00000000|00000000|00000000|
-        // |00000000|000000xx|xxxxxxxx|00000000|00000000|00000000|00000000|00000000|
-        // |00000000|00000000|00000000|xxxxxxxx|xx000000|00000000|00000000|00000000|
-        // |00000000|00000000|00000000|00000000|00xxxxxx|xxxx0000|00000000|00000000|
-        // |00000000|00000000|00000000|00000000|00000000|0000xxxx|xxxxxx00|00000000|
-        // |00000000|00000000|00000000|00000000|00000000|00000000|000000xx|xxxxxxxx|
-
-        class indexes_masks {
-          constexpr unsigned element_digits = binary_digits<T>::value;
-          constexpr unsigned block_digits = sizeof(Block);
-          constexpr index_type period = static_mcm<element_digits, 2*block_digits>::value/element_digits;
-
-          class cache_type {
-          public:
-            // @par Pre-condition k < cache_size
-            cache_type(key_type k)
-              : m_first_leading_zeros(element_digits*k - (element_digits*k)/block_digits*block_digits)
-            {
-              //00 - 00= 00- 00 - 8 2
-              //01 - 10= 10- 00 - 0 6 4
-              //02 - 20= 20- 00 - 0 0 4 6
-              //03 - 30= 30- 00 + 0 0 0 2 | 8
-              //04 - 08= 40- 32 - 0 8 2
-              //05 - 18= 50- 32 - 0 0 6 4
-              //06 - 28= 60- 32 + 0 0 0 4 | 6
-              //07 - 06= 70- 64 - 2 8
-              //08 - 16= 80- 64 - 0 0 8 2
-              //09 - 26= 90- 64 + 0 0 0 6 | 4
-              //10 - 04=100- 96 - 4 6
-              //11 - 14=110- 96 - 0 2 8
-              //12 - 24=120- 96 + 0 0 0 8 | 2
-              //13 - 02=130-128 - 6 4
-            }
-
-            index_type first_leading_zeros() const { return m_first_leading_zeros(); }
-            index_type first_last_one() const { return first_leading_zeros() + element_digits -1; }
-            bool only_one() const { return first_last_one > block_digits; }
-            index_type first_trailing_ones() const { return block_digits - first_last_one(); }
-            Block mask() const { return bit_ops::up_to<element_digits, Block>(); }
-            Block first_mask() const { return mask() << first_leading_zeros(); }
-            Block second_mask() const { return mask() >> first_trailing_ones(); }
-          private:
-            index_type m_first_leading_zeros;
-          };
-
-        public:
-          indexes_masks(key_type k)
-          {
-            assert( k < static_size && "out of range" );
-
-            const index_type bits = (element_digits*(k+1));
-            m_first_index = bits / block_digits;
-
-            const index_type cache_index = k % period;
-            m_cache = cache_type(cache_index);
-          }
-
-          index_type first_index() const { return m_first_index; }
-          //index_type second_index() const  { return m_first_index + only_one()?0:1; }
-          index_type second_index() const  { return m_first_index + 1; }
-
-          index_type first_leading_zeros() const { return m_cache->first_leading_zeros(); }
-          index_type first_last_one() const { return m_cache->first_last_one(); }
-          bool only_one() const { return only_one() ; }
-          index_type first_trailing_ones() const { return m_cache->first_trailing_ones(); }
-          Block first_mask() const { return m_cache->first_mask(); }
-          Block second_mask() const { return m_cache->second_mask(); }
-
-        private:
-          index_type m_first_index;
-          cache_type m_cache;
-        };
-
-        // set
-        //! \n<b>Pre-condition:</b> `k < static_size`
-        //! \n<b>Returns:</b> reference to the element with key `k`
-        //! \n<b>Throws:</b> Nothing.
-        JASEL_MUTABLE_CONSTEXPR void set_value(key_type k, value_type value)
-        {
-            const indexes_masks ctx(k);
-
-            blocks[ctx.first_index()] |= (value >> ctx.first_leading_zeros()) & ~ctx.first_mask();
-            if ( ctx.only_one() ) return;
-            blocks[ctx.second_index()] |= (value << ctx.first_trailing_ones() ) & ~ctx.second_mask();
-        }
-
-        // get()
-        //! \n<b>Pre-condition:</b> `k < static_size`
-        //! \n<b>Returns:</b> element with key k
-        JASEL_MUTABLE_CONSTEXPR value_type get_value(key_type k) const
-        {
-          const indexes_masks ctx(k);
-
-          const Block first = (blocks[ctx.first_index()] & ctx.first_mask()) << ctx.first_leading_zeros() ;
-          if ( ctx.only_one() ) return first;
-
-          const Block second = (blocks[ctx.second_index()] & ctx.second_mask()) >> ctx.first_trailing_ones() ;
-          return first | second;
+            return JASEL_EXPECTS(k < static_size), layout::template get<T>(blocks[k / per_block], k % per_block);
         }
 
         // at() with range check
-        //! \n<b>Returns:</b> reference element with key k
-        //! \n<b>Throws:</b> std::out_of_range if i >= static_size
-        JASEL_MUTABLE_CONSTEXPR reference at(key_type k)
+        //! \n<b>Returns:</b> reference element k
+        //! \n<b>Throws:</b> std::out_of_range if k >= static_size
+        JASEL_MUTABLE_CONSTEXPR reference at(size_type k)
         {
-          return elems_ref(rangecheck(k));
+          return (*this)[rangecheck(k)];
         }
-        constexpr const_reference at(key_type k) const
+        constexpr const_reference at(size_type k) const
         {
-          return elems_ref(rangecheck(k));
+          return (*this)[rangecheck(k)];
         }
 
         // front() and back()
@@ -435,28 +190,28 @@ inline namespace fundamental_v3
         //! \n<b>Throws:</b> Nothing
         JASEL_MUTABLE_CONSTEXPR reference front() noexcept
         {
-          return elems_ref(0);
+          return (*this)[0];
         }
 
-        //! \n<b>Returns:</b> const reference to the first element
+        //! \n<b>Returns:</b> the value of the first element
         //! \n<b>Throws:</b> Nothing
         constexpr const_reference front() const noexcept
         {
-          return elems_ref(0);
+          return (*this)[0];
         }
 
         //! \n<b>Returns:</b> reference to the last element
         //! \n<b>Throws:</b> Nothing
         JASEL_MUTABLE_CONSTEXPR reference back() noexcept
         {
-          return elems_ref(static_size-1);
+          return (*this)[static_size-1];
         }
 
-        //! \n<b>Returns:</b> const reference to the last element
+        //! \n<b>Returns:</b> the value of the last element
         //! \n<b>Throws:</b> Nothing
         constexpr const_reference back() const noexcept
         {
-            return elems_ref(static_size-1);
+            return (*this)[static_size-1];
         }
 
         // size is constant
@@ -465,11 +220,11 @@ inline namespace fundamental_v3
         {
           return static_size;
         }
-        //! \n<b>Returns:</b> false
+        //! \n<b>Returns:</b> N == 0
         //! \n<b>Throws:</b> Nothing
         constexpr  bool empty() const noexcept
         {
-          return false;
+          return static_size == 0;
         }
 
         //! \n<b>Returns:</b> N.
@@ -478,103 +233,111 @@ inline namespace fundamental_v3
           return static_size;
         }
 
-
-        /*! \n<b>Effects:</b> <tt>swap_ranges(begin(), end(), y.begin())</tt>
-            \n<b>Throws:</b> Nothing unless one of the element-wise swap calls throws an exception.
+        /*! \n<b>Effects:</b> Swaps the blocks.
             \n<b>Note:</b> Unlike the @c swap function for other containers, @c compact_array::swap
-            takes linear time, may exit via an exception, and does not cause
-            iterators to become associated with the other container.
+            takes linear time, and does not cause iterators to become associated with the other container.
          */
-        void swap (compact_array& y) // noexcept(std::is_nothrow_swappable_v<T>)
+        void swap (compact_array& y) noexcept
         {
-            for (size_type i = 0; i < num_of_blocks; ++i)
-            {
-              std::swap(blocks[i],y.blocks[i]);
-            }
+            std::swap_ranges(blocks, blocks + num_of_blocks, y.blocks);
         }
 
-        //! direct access to block (read-only)
+        //! direct access to the blocks
         //! \n<b>Returns:</b> blocks.
-        JASEL_CXX14_CONSTEXPR const Block* block_begin() const {
+        constexpr const Block* data() const noexcept {
           return blocks;
         }
         //! \n<b>Returns:</b> blocks.
-        JASEL_CXX14_CONSTEXPR Block* block_begin() {
+        JASEL_MUTABLE_CONSTEXPR Block* data() noexcept {
           return blocks;
         }
-        JASEL_CXX14_CONSTEXPR const Block* block_end() const {
-          return blocks+num_of_blocks;
-        }
-        JASEL_CXX14_CONSTEXPR Block* block_end() {
-          return blocks+num_of_blocks;
-        }
 
-        //! assignment with type conversion
-        template <typename T2>
-        compact_array& operator= (const compact_array<T2, N, Block>& rhs) {
-            std::copy(rhs.begin(),rhs.end(), begin());
-            return *this;
+        //! \n<b>Effects:</b> Assigns value to all the elements.
+        void fill (const T& value) noexcept
+        {
+            Block b = 0;
+            for (size_t i = 0; i < per_block; ++i)
+              b |= Block((Block(value) & layout::mask) << (size_t(Bits) * i));
+            std::fill(blocks, blocks + N / per_block, b);
+            if (N % per_block != 0)
+              blocks[N / per_block] = Block(b & bit_ops::up_to<Block>(size_t(Bits) * (N % per_block)));
         }
 
-        //! A synonym for fill - Assigns one value to all elements
-        //! \n<b>Effects:</b> <tt>std::fill_n(begin(), static_size, value)</tt>
-        void assign (const T& value) {
-          fill ( value );
+        // bulk conversions
+        //! \n<b>Pre-condition:</b> `out.size() == size()`
+        //! \n<b>Effects:</b> Copies the elements to out, unpacking a block at a time.
+        void unpack_to(span<T> out) const noexcept
+        {
+            JASEL_EXPECTS(size_type(out.size()) == static_size);
+            packed_detail::unpack<Bits>(blocks, static_size, out.data());
         }
 
-        //! \n<b>Effects:</b> <tt>fill_n(begin(), static_size, u)</tt>
-        void fill   (const T& value)
+        //! \n<b>Pre-condition:</b> `in.size() == size()`
+        //! \n<b>Effects:</b> Assigns the elements of in, packing a block at a time.
+        void pack_from(span<T const> in) noexcept
         {
-            std::fill_n(begin(),size(),value);
+            JASEL_EXPECTS(size_type(in.size()) == static_size);
+            packed_detail::pack<Bits>(in.data(), static_size, blocks);
         }
 
         //! check range (may be private because it is static)
-        static size_type rangecheck (key_type k) {
-            if (k >= static_size) {
-                std::out_of_range e("compact_array<>: index out of range");
-                throw (e);
-            }
-            return k;
+        static constexpr size_type rangecheck (size_type k) {
+            return (k >= static_size)
+              ? throw std::out_of_range("compact_array<>: index out of range")
+              : k;
         }
     };
 
+    template<class T, size_t N, class B, int Bits>
+    const std::size_t compact_array<T, N, B, Bits>::static_size;
+    template<class T, size_t N, class B, int Bits>
+    const int compact_array<T, N, B, Bits>::element_digits;
+    template<class T, size_t N, class B, int Bits>
+    const std::size_t compact_array<T, N, B, Bits>::block_count;
+
     // comparisons
     //! \n<b>Returns:</b> <tt>std::equal(x.begin(), x.end(), y.begin())</tt>
-    template<class T, size_t N, class B>
-    bool operator== (const compact_array<T, N, B>& x, const compact_array<T, N, B>& y)
+    template<class T, size_t N, class B, int Bits>
+    bool operator== (const compact_array<T, N, B, Bits>& x, const compact_array<T, N, B, Bits>& y)
     {
-        return std::equal(x.block_begin(), x.block_end(), y.block_begin());
+        // the unused bits are always 0
+        return std::equal(x.data(), x.data() + x.block_count, y.data());
     }
 
     //! \n<b>Returns:</b> <tt>std::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end())</tt>
-    template<class T, size_t N, class B>
-    bool operator< (const compact_array<T, N, B>& x, const compact_array<T, N, B>& y)
+    template<class T, size_t N, class B, int Bits>
+    bool operator< (const compact_array<T, N, B, Bits>& x, const compact_array<T, N, B, Bits>& y)
     {
-        return std::lexicographical_compare(x.begin(),x.end(),y.begin(),y.end());
+        for (size_t k = 0; k < N; ++k)
+        {
+            if (x[k] != y[k])
+                return x[k] < y[k];
+        }
+        return false;
     }
 
     //! \n<b>Returns:</b> <tt>!(x == y)</tt>
-    template<class T, size_t N, class B>
-    bool operator!= (const compact_array<T, N, B>& x, const compact_array<T, N, B>& y)
+    template<class T, size_t N, class B, int Bits>
+    bool operator!= (const compact_array<T, N, B, Bits>& x, const compact_array<T, N, B, Bits>& y)
     {
         return !(x==y);
     }
 
     //! \n<b>Returns:</b> <tt>y < x</tt>
-    template<class T, size_t N, class B>
-    bool operator> (const compact_array<T, N, B>& x, const compact_array<T, N, B>& y)
+    template<class T, size_t N, class B, int Bits>
+    bool operator> (const compact_array<T, N, B, Bits>& x, const compact_array<T, N, B, Bits>& y)
     {
         return y<x;
     }
     //! \n<b>Returns:</b> <tt>!(y<x)</tt>
-    template<class T, size_t N, class B>
-    bool operator<= (const compact_array<T, N, B>& x, const compact_array<T, N, B>& y)
+    template<class T, size_t N, class B, int Bits>
+    bool operator<= (const compact_array<T, N, B, Bits>& x, const compact_array<T, N, B, Bits>& y)
     {
         return !(y<x);
     }
     //! \n<b>Returns:</b> <tt>!(x<y)</tt>
-    template<class T, size_t N, class B>
-    bool operator>= (const compact_array<T, N, B>& x, const compact_array<T, N, B>& y)
+    template<class T, size_t N, class B, int Bits>
+    bool operator>= (const compact_array<T, N, B, Bits>& x, const compact_array<T, N, B, Bits>& y)
     {
         return !(x<y);
     }
@@ -587,49 +350,13 @@ inline namespace fundamental_v3
     //! \endcode
     //! \n<b>Complexity:</b> linear in \c N.
 
-    template<class T, size_t N, class B>
-    inline void swap (compact_array<T, N, B>& x, compact_array<T, N, B>& y)
+    template<class T, size_t N, class B, int Bits>
+    inline void swap (compact_array<T, N, B, Bits>& x, compact_array<T, N, B, Bits>& y) noexcept
     {
         x.swap(y);
     }
 
 }}
-
-// todo add specialization for tuple-like type
-#if 0
-
-    template <class T, size_t N, class B>
-    class  tuple_size<compact_array<T, N, B> >
-        : public integral_constant<size_t, N>
-          {};
-
-
-    template <class T, size_t N, class B, size_t K>
-    class  tuple_element<compact_array<T, N, B>, K >
-    {
-    public:
-        typedef T type;
-    };
-
-    template <class T, size_t N, class B, size_t K>
-    inline    T&    get(compact_array<T, N, B>& a)
-    {
-        return a[K];
-    }
-
-    template <class T, size_t N, class B, size_t K>
-    inline    T&    get(compact_array<T, N, B> const& a)
-    {
-        return a[K];
-    }
-
-    template <class T, size_t N, class B, size_t K>
-    inline    T&&    get(compact_array<T, N, B>&& a)
-    {
-        return a[K];
-    }
-
-#endif
 }
 
 
@@ -28,6 +28,7 @@
 #include <experimental/fundamental/v2/config.hpp>
 
 #include <iosfwd>
+#include <iterator>
 
 namespace std
 {
@@ -47,15 +48,19 @@ inline namespace fundamental_v3
       using iterator_type = Iterator;
       using word_type = typename _traits_t::value_type;
       using subword_type = T;
+      // the words are const when the iterator is a constant one
+      using _word_ref_t = remove_reference_t<typename _traits_t::reference>;
 
       static_assert(binary_digits<word_type>::value, "");
+      static constexpr int subword_digits = Bits;
+      static constexpr int subwords_per_word = binary_digits<word_type>::value / Bits;
       using iterator_category = typename _traits_t::iterator_category;
       using value_type = subword_value<Bits, T>;
       using index_type = typename value_type::index_type;
       using size_type = typename value_type::size_type;
-      using pointer = subword_pointer<Bits, word_type, T>;
+      using pointer = subword_pointer<Bits, _word_ref_t, T>;
       using difference_type = typename pointer::difference_type;
-      using reference = subword_reference<Bits, word_type, T>;
+      using reference = subword_reference<Bits, _word_ref_t, T>;
 
 
       // Lifecycle
@@ -68,8 +73,8 @@ inline namespace fundamental_v3
       constexpr subword_iterator(const subword_iterator& other) = default;
       template <class It>
       constexpr subword_iterator(const subword_iterator<It, Bits, T>& other)
-      : _current(other._current)
-      , _position(other._position)
+      : _current(other.base())
+      , _position(other.position())
       {
       }
       explicit constexpr subword_iterator(iterator_type i)
@@ -79,7 +84,7 @@ inline namespace fundamental_v3
       }
       constexpr subword_iterator(iterator_type i, size_type pos)
       : _current(i)
-      , _position((JASEL_ASSERT(pos < binary_digits<word_type>::value), pos))
+      , _position((JASEL_ASSERT(pos < subwords_per_word), pos))
       {
       }
 
@@ -88,8 +93,8 @@ inline namespace fundamental_v3
       template <class It>
       JASEL_MUTABLE_CONSTEXPR subword_iterator& operator=(const subword_iterator<It, Bits, T>& other)
       {
-          _current = other._current;
-          _position = other._position;
+          _current = other.base();
+          _position = other.position();
           return *this;
       }
 
@@ -105,23 +110,14 @@ inline namespace fundamental_v3
       }
       JASEL_CXX14_CONSTEXPR reference operator[](difference_type n) const
       {
-        constexpr difference_type word_digits = binary_digits<word_type>::value;
-        constexpr difference_type subword_digits = binary_digits<subword_type>::value;
-        const difference_type sum = subword_digits * (_position + n);
-        difference_type diff = sum / word_digits;
-        if (sum < 0 && diff * word_digits != sum) {
-            --diff;
-        }
-        return reference(std::next(_current, diff), sum - diff * word_digits);
+          return *(*this + n);
       }
 
       // Increment and decrement operators
       public:
       JASEL_MUTABLE_CONSTEXPR subword_iterator& operator++()
       {
-        constexpr size_type word_digits = binary_digits<word_type>::value;
-        constexpr size_type subword_digits = binary_digits<word_type>::value;
-          if (_position + subword_digits < word_digits) {
+          if (_position + 1 < subwords_per_word) {
               ++_position;
           } else {
               ++_current;
@@ -131,12 +127,11 @@ inline namespace fundamental_v3
       }
       JASEL_MUTABLE_CONSTEXPR subword_iterator& operator--()
       {
-          constexpr size_type word_digits = binary_digits<word_type>::value;
           if (_position) {
               --_position;
           } else {
               --_current;
-              _position = word_digits - 1;
+              _position = subwords_per_word - 1;
           }
           return *this;
       }
@@ -152,25 +147,20 @@ inline namespace fundamental_v3
           --(*this);
           return old;
       }
+      // The positions are counted in subwords, subwords_per_word in each word.
       JASEL_CXX14_CONSTEXPR subword_iterator operator+(difference_type n) const
       {
-          constexpr difference_type digits = binary_digits<word_type>::value;
-          const difference_type sum = _position + n;
-          difference_type diff = sum / digits;
-          if (sum < 0 && diff * digits != sum) {
+          constexpr difference_type per_word = subwords_per_word;
+          const difference_type sum = static_cast<difference_type>(_position) + n;
+          difference_type diff = sum / per_word;
+          if (sum < 0 && diff * per_word != sum) {
               --diff;
           }
-          return subword_iterator(std::next(_current, diff), sum - diff * digits);
+          return subword_iterator(std::next(_current, diff), static_cast<size_type>(sum - diff * per_word));
       }
       JASEL_CXX14_CONSTEXPR subword_iterator operator-(difference_type n) const
       {
-          constexpr difference_type digits = binary_digits<word_type>::value;
-          const difference_type sum = _position - n;
-          difference_type diff = sum / digits;
-          if (sum < 0 && diff * digits != sum) {
-              --diff;
-          }
-          return subword_iterator(std::next(_current, diff), sum - diff * digits);
+          return *this + (-n);
       }
       JASEL_MUTABLE_CONSTEXPR subword_iterator& operator+=(difference_type n)
       {
@@ -196,102 +186,99 @@ inline namespace fundamental_v3
       }
       constexpr word_type mask() const noexcept
       {
-          return static_cast<word_type>(1) << _position;
+          return static_cast<word_type>(bit_ops::up_to<Bits, word_type>() << (Bits * _position));
       }
 
       // Implementation details: data members
       private:
       iterator_type _current;
       size_type _position;
-
-      // Non-member arithmetic operators
-      template <class It>
-      friend constexpr subword_iterator<It, Bits, T> operator+(
-          typename subword_iterator<It, Bits, T>::difference_type n,
-          const subword_iterator<It, Bits, T>& i
-      )
-      {
-          return i + n;
-      }
-      template <class It1, class It2>
-      friend JASEL_CXX14_CONSTEXPR typename std::common_type<
-          typename subword_iterator<It1, Bits, T>::difference_type,
-          typename subword_iterator<It2, Bits, T>::difference_type
-      >::type operator-(
-          const subword_iterator<It1, Bits, T>& lhs,
-          const subword_iterator<It2, Bits, T>& rhs
-      )
-      {
-          using lhs_utype = typename subword_iterator<It1, Bits, T>::word_type;
-          using rhs_utype = typename subword_iterator<It2, Bits, T>::word_type;
-          using lhs_type = typename subword_iterator<It1, Bits, T>::difference_type;
-          using rhs_type = typename subword_iterator<It2, Bits, T>::difference_type;
-          using difference_type = typename std::common_type<lhs_type, rhs_type>::type;
-          constexpr difference_type lhs_digits = binary_digits<lhs_utype>::value;
-          constexpr difference_type rhs_digits = binary_digits<rhs_utype>::value;
-          constexpr difference_type digits = rhs_digits;
-          static_assert(lhs_digits == rhs_digits, "");
-          const difference_type main = lhs._current - rhs._current;
-          return main * digits + (lhs._position - rhs._position);
-      }
-
-      // Comparison operators
-      public:
-      template <class It1, class It2>
-      friend constexpr bool operator==(
-          const subword_iterator<It1, Bits, T>& lhs,
-          const subword_iterator<It2, Bits, T>& rhs
-      )
-      {
-          return lhs._current == rhs._current && lhs._position == rhs._position;
-      }
-      template <class It1, class It2>
-      friend constexpr bool operator!=(
-          const subword_iterator<It1, Bits, T>& lhs,
-          const subword_iterator<It2, Bits, T>& rhs
-      )
-      {
-          return lhs._current != rhs._current || lhs._position != rhs._position;
-      }
-      template <class It1, class It2>
-      friend constexpr bool operator<(
-          const subword_iterator<It1, Bits, T>& lhs,
-          const subword_iterator<It2, Bits, T>& rhs
-      )
-      {
-          return lhs._current < rhs._current
-              || (lhs._current == rhs._current && lhs._position < rhs._position);
-      }
-      template <class It1, class It2>
-      friend constexpr bool operator<=(
-          const subword_iterator<It1, Bits, T>& lhs,
-          const subword_iterator<It2, Bits, T>& rhs
-      )
-      {
-          return lhs._current < rhs._current
-              || (lhs._current == rhs._current && lhs._position <= rhs._position);
-      }
-      template <class It1, class It2>
-      friend constexpr bool operator>(
-          const subword_iterator<It1, Bits, T>& lhs,
-          const subword_iterator<It2, Bits, T>& rhs
-      )
-      {
-          return lhs._current > rhs._current
-              || (lhs._current == rhs._current && lhs._position > rhs._position);
-      }
-      template <class It1, class It2>
-      friend constexpr bool operator>=(
-          const subword_iterator<It1, Bits, T>& lhs,
-          const subword_iterator<It2, Bits, T>& rhs
-      )
-      {
-          return lhs._current > rhs._current
-              || (lhs._current == rhs._current && lhs._position >= rhs._position);
-      }
   };
 
+  // Non-member arithmetic operators
+  template <class It, int Bits, class T>
+  constexpr subword_iterator<It, Bits, T> operator+(
+      typename subword_iterator<It, Bits, T>::difference_type n,
+      const subword_iterator<It, Bits, T>& i
+  )
+  {
+      return i + n;
+  }
+  template <class It1, class It2, int Bits, class T>
+  JASEL_CXX14_CONSTEXPR typename std::common_type<
+      typename subword_iterator<It1, Bits, T>::difference_type,
+      typename subword_iterator<It2, Bits, T>::difference_type
+  >::type operator-(
+      const subword_iterator<It1, Bits, T>& lhs,
+      const subword_iterator<It2, Bits, T>& rhs
+  )
+  {
+      using lhs_type = typename subword_iterator<It1, Bits, T>::difference_type;
+      using rhs_type = typename subword_iterator<It2, Bits, T>::difference_type;
+      using difference_type = typename std::common_type<lhs_type, rhs_type>::type;
+      constexpr difference_type lhs_per_word = subword_iterator<It1, Bits, T>::subwords_per_word;
+      constexpr difference_type rhs_per_word = subword_iterator<It2, Bits, T>::subwords_per_word;
+      static_assert(lhs_per_word == rhs_per_word, "");
+      const difference_type main = difference_type(std::distance(rhs.base(), lhs.base()));
+      return main * rhs_per_word
+           + (static_cast<difference_type>(lhs.position()) - static_cast<difference_type>(rhs.position()));
+  }
 
+  // Comparison operators
+  // The positions are compared before the words: at end() the word may be the one past the last, and testing the
+  // position first lets the optimizer see that this word is never read (GCC -Warray-bounds at -O3).
+  template <class It1, class It2, int Bits, class T>
+  constexpr bool operator==(
+      const subword_iterator<It1, Bits, T>& lhs,
+      const subword_iterator<It2, Bits, T>& rhs
+  )
+  {
+      return lhs.position() == rhs.position() && lhs.base() == rhs.base();
+  }
+  template <class It1, class It2, int Bits, class T>
+  constexpr bool operator!=(
+      const subword_iterator<It1, Bits, T>& lhs,
+      const subword_iterator<It2, Bits, T>& rhs
+  )
+  {
+      return lhs.position() != rhs.position() || lhs.base() != rhs.base();
+  }
+  template <class It1, class It2, int Bits, class T>
+  constexpr bool operator<(
+      const subword_iterator<It1, Bits, T>& lhs,
+      const subword_iterator<It2, Bits, T>& rhs
+  )
+  {
+      return lhs.base() < rhs.base()
+          || (lhs.base() == rhs.base() && lhs.position() < rhs.position());
+  }
+  template <class It1, class It2, int Bits, class T>
+  constexpr bool operator<=(
+      const subword_iterator<It1, Bits, T>& lhs,
+      const subword_iterator<It2, Bits, T>& rhs
+  )
+  {
+      return lhs.base() < rhs.base()
+          || (lhs.base() == rhs.base() && lhs.position() <= rhs.position());
+  }
+  template <class It1, class It2, int Bits, class T>
+  constexpr bool operator>(
+      const subword_iterator<It1, Bits, T>& lhs,
+      const subword_iterator<It2, Bits, T>& rhs
+  )
+  {
+      return lhs.base() > rhs.base()
+          || (lhs.base() == rhs.base() && lhs.position() > rhs.position());
+  }
+  template <class It1, class It2, int Bits, class T>
+  constexpr bool operator>=(
+      const subword_iterator<It1, Bits, T>& lhs,
+      const subword_iterator<It2, Bits, T>& rhs
+  )
+  {
+      return lhs.base() > rhs.base()
+          || (lhs.base() == rhs.base() && lhs.position() >= rhs.position());
+  }
 
 }}
 } // std
@@ -50,6 +50,7 @@ inline namespace fundamental_v3
       using subword_type = T;
       static constexpr int subword_digits = Bits;
       static constexpr int word_digits = binary_digits<word_type>::value;
+      static constexpr int subwords_per_word = word_digits / subword_digits;
       using subword = subword_value<subword_digits, T>;
 
       using index_type = typename subword::index_type;
@@ -58,7 +59,7 @@ inline namespace fundamental_v3
 
       static_assert(is_trivially_copyable<subword_type>::value, "A subword must be trivially copyable");
       static_assert(subword_digits <= binary_digits<subword_type>::value, "");
-      static_assert(word_digits % subword_digits == 0, "");
+      static_assert(subword_digits <= word_digits, "");
       //static_assert(alignof(T) <= alignof(WordType), ""); // it is not clear yet if this will be needed
 
 
@@ -129,14 +130,7 @@ inline namespace fundamental_v3
       }
       JASEL_CXX14_CONSTEXPR subword_reference<Bits, WordType, T> operator[](difference_type n) const
       {
-          //constexpr difference_type word_digits = binary_digits<word_type>::value;
-        //constexpr difference_type subword_digits = binary_digits<subword_type>::value;
-          const difference_type sum = subword_digits * (_ref.position() + n);
-          difference_type diff = sum / word_digits;
-          if (sum < 0 && diff * word_digits != sum) {
-              --diff;
-          }
-          return subword_reference<Bits, WordType, T>(_ref._ptr + diff, sum - diff * word_digits);
+          return *(*this + n);
       }
 
       // Increment and decrement operators
@@ -163,27 +157,20 @@ inline namespace fundamental_v3
           --(*this);
           return old;
       }
+      // The positions are counted in subwords, subwords_per_word in each word.
       JASEL_CXX14_CONSTEXPR subword_pointer operator+(difference_type n) const
       {
-        //constexpr difference_type word_digits = binary_digits<word_type>::value;
-        //constexpr difference_type subword_digits = binary_digits<subword_type>::value;
-        const difference_type sum = subword_digits * (static_cast<difference_type>(_ref.position()) + n);
-        difference_type diff = sum / word_digits;
-        if (sum < 0 && diff * word_digits != sum) {
+          constexpr difference_type per_word = subwords_per_word;
+          const difference_type sum = static_cast<difference_type>(_ref.position()) + n;
+          difference_type diff = sum / per_word;
+          if (sum < 0 && diff * per_word != sum) {
               --diff;
           }
-          return subword_pointer(_ref._ptr + diff, static_cast<size_type>(sum - diff * static_cast<difference_type>(word_digits)));
+          return subword_pointer(_ref._ptr + diff, static_cast<size_type>(sum - diff * per_word));
       }
       JASEL_CXX14_CONSTEXPR subword_pointer operator-(difference_type n) const
       {
-        //constexpr difference_type word_digits = binary_digits<word_type>::value;
-        //constexpr difference_type subword_digits = binary_digits<subword_type>::value;
-        const difference_type sum = subword_digits * (_ref.position() - n);
-        difference_type diff = sum / word_digits;
-        if (sum < 0 && diff * word_digits != sum) {
-              --diff;
-          }
-          return subword_pointer(_ref._ptr + diff, sum - diff * word_digits);
+          return *this + (-n);
       }
       JASEL_MUTABLE_CONSTEXPR subword_pointer& operator+=(difference_type n)
       {
@@ -199,98 +186,89 @@ inline namespace fundamental_v3
       // Implementation details: data members
       private:
       subword_reference<Bits, WordType, T> _ref;
-
-      // Non-member arithmetic operators
-      template <class W>
-      friend constexpr subword_pointer<Bits,W,T> operator+(
-          typename subword_pointer<Bits,W,T>::difference_type n,
-          subword_pointer<Bits,W,T> x
-      )
-      {
-          return x + n;
-      }
-      template <int B, class W1, class W2, class U>
-      friend JASEL_CXX14_CONSTEXPR typename std::common_type<
-          typename subword_pointer<B, W1, U>::difference_type,
-          typename subword_pointer<B, W2, U>::difference_type
-      >::type operator-(
-          subword_pointer<B, W1, U> lhs,
-          subword_pointer<B, W2, U> rhs
-      )
-      {
-          using lhs_type = typename subword_pointer<B, W1, U>::difference_type;
-          using rhs_type = typename subword_pointer<B, W2, U>::difference_type;
-          using difference_type = typename std::common_type<lhs_type, rhs_type>::type;
-          constexpr difference_type lhs_digits = binary_digits<W1>::value;
-          constexpr difference_type rhs_digits = binary_digits<W2>::value;
-          constexpr difference_type tword_digits = rhs_digits;
-          //constexpr difference_type subword_digits = binary_digits<T>::value;
-          static_assert(lhs_digits == rhs_digits, "");
-          const difference_type main = lhs._ref.address() - rhs._ref.address();
-          return main * (tword_digits/subword_digits) + (lhs._ref.position() - rhs._ref.position());
-      }
-
-      // Comparison operators
-      template <int B, class W1, class W2, class U>
-      friend constexpr bool operator==(
-          subword_pointer<B, W1, U> lhs,
-          subword_pointer<B, W2, U> rhs
-      ) noexcept
-      {
-          return lhs._ref.address() == rhs._ref.address()
-              && lhs._ref.position() == rhs._ref.position();
-      }
-      template <int B, class W1, class W2, class U>
-      friend constexpr bool operator!=(
-          subword_pointer<B, W1, U> lhs,
-          subword_pointer<B, W2, U> rhs
-      ) noexcept
-      {
-          return lhs._ref.address() != rhs._ref.address()
-              || lhs._ref.position() != rhs._ref.position();
-      }
-      template <int B, class W1, class W2, class U>
-      friend constexpr bool operator<(
-          subword_pointer<B, W1, U> lhs,
-          subword_pointer<B, W2, U> rhs
-      ) noexcept
-      {
-          return lhs._ref.address() < rhs._ref.address()
-              || (lhs._ref.address() == rhs._ref.address()
-                  && lhs._ref.position() < rhs._ref.position());
-      }
-      template <int B, class W1, class W2, class U>
-      friend constexpr bool operator<=(
-          subword_pointer<B, W1, U> lhs,
-          subword_pointer<B, W2, U> rhs
-      ) noexcept
-      {
-          return lhs._ref.address() < rhs._ref.address()
-              || (lhs._ref.address() == rhs._ref.address()
-                  && lhs._ref.position() <= rhs._ref.position());
-      }
-      template <int B, class W1, class W2, class U>
-      friend constexpr bool operator>(
-          subword_pointer<B, W1, U> lhs,
-          subword_pointer<B, W2, U> rhs
-      ) noexcept
-      {
-          return lhs._ref.address() > rhs._ref.address()
-              || (lhs._ref.address() == rhs._ref.address()
-                  && lhs._ref.position() > rhs._ref.position());
-      }
-      template <int B, class W1, class W2, class U>
-      friend constexpr bool operator>=(
-          subword_pointer<B, W1, U> lhs,
-          subword_pointer<B, W2, U> rhs
-      ) noexcept
-      {
-          return lhs._ref.address() > rhs._ref.address()
-              || (lhs._ref.address() == rhs._ref.address()
-                  && lhs._ref.position() >= rhs._ref.position());
-      }
   };
 
+  // Non-member arithmetic operators
+  template <int B, class W, class T>
+  constexpr subword_pointer<B,W,T> operator+(
+      typename subword_pointer<B,W,T>::difference_type n,
+      subword_pointer<B,W,T> x
+  )
+  {
+      return x + n;
+  }
+  template <int B, class W1, class W2, class U>
+  JASEL_CXX14_CONSTEXPR typename std::common_type<
+      typename subword_pointer<B, W1, U>::difference_type,
+      typename subword_pointer<B, W2, U>::difference_type
+  >::type operator-(
+      subword_pointer<B, W1, U> lhs,
+      subword_pointer<B, W2, U> rhs
+  )
+  {
+      using lhs_type = typename subword_pointer<B, W1, U>::difference_type;
+      using rhs_type = typename subword_pointer<B, W2, U>::difference_type;
+      using difference_type = typename std::common_type<lhs_type, rhs_type>::type;
+      constexpr difference_type lhs_per_word = subword_pointer<B, W1, U>::subwords_per_word;
+      constexpr difference_type rhs_per_word = subword_pointer<B, W2, U>::subwords_per_word;
+      static_assert(lhs_per_word == rhs_per_word, "");
+      const difference_type main = (*lhs).address() - (*rhs).address();
+      return main * rhs_per_word
+           + (static_cast<difference_type>((*lhs).position()) - static_cast<difference_type>((*rhs).position()));
+  }
+
+  // Comparison operators
+  template <int B, class W1, class W2, class U>
+  constexpr bool operator==(
+      subword_pointer<B, W1, U> lhs,
+      subword_pointer<B, W2, U> rhs
+  ) noexcept
+  {
+      return (*lhs).address() == (*rhs).address()
+          && (*lhs).position() == (*rhs).position();
+  }
+  template <int B, class W1, class W2, class U>
+  constexpr bool operator!=(
+      subword_pointer<B, W1, U> lhs,
+      subword_pointer<B, W2, U> rhs
+  ) noexcept
+  {
+      return !(lhs == rhs);
+  }
+  template <int B, class W1, class W2, class U>
+  constexpr bool operator<(
+      subword_pointer<B, W1, U> lhs,
+      subword_pointer<B, W2, U> rhs
+  ) noexcept
+  {
+      return (*lhs).address() < (*rhs).address()
+          || ((*lhs).address() == (*rhs).address()
+              && (*lhs).position() < (*rhs).position());
+  }
+  template <int B, class W1, class W2, class U>
+  constexpr bool operator<=(
+      subword_pointer<B, W1, U> lhs,
+      subword_pointer<B, W2, U> rhs
+  ) noexcept
+  {
+      return !(rhs < lhs);
+  }
+  template <int B, class W1, class W2, class U>
+  constexpr bool operator>(
+      subword_pointer<B, W1, U> lhs,
+      subword_pointer<B, W2, U> rhs
+  ) noexcept
+  {
+      return rhs < lhs;
+  }
+  template <int B, class W1, class W2, class U>
+  constexpr bool operator>=(
+      subword_pointer<B, W1, U> lhs,
+      subword_pointer<B, W2, U> rhs
+  ) noexcept
+  {
+      return !(lhs < rhs);
+  }
 
 }}
 } // std
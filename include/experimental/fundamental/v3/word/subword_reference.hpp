@@ -55,6 +55,8 @@ inline namespace fundamental_v3
 
       static constexpr int subword_digits = Bits;
       static constexpr int word_digits = binary_digits<word_type>::value;
+      // The subwords don't straddle two words: the word_digits % subword_digits high bits of a word are not used.
+      static constexpr int subwords_per_word = word_digits / subword_digits;
 
       // fixme: this works only for T that are unsigned integral types.
       // But we want to store here any trivial type that has Bits significant bits
@@ -70,7 +72,7 @@ inline namespace fundamental_v3
       //static_assert(is_multiword<word_type>::value, "");
       static_assert(is_trivially_copyable<subword_type>::value, "A subword must be trivially copyable");
       static_assert(subword_digits <= binary_digits<T>::value, "");
-      static_assert(word_digits % subword_digits == 0, "");
+      static_assert(subword_digits <= word_digits, "");
 
       // Friendship
   private:
@@ -92,7 +94,7 @@ inline namespace fundamental_v3
       {
       }
       constexpr subword_reference(word_type& ref, index_type pos)
-      : _ptr((JASEL_ASSERT(pos < binary_digits<word_type>::value), &ref))
+      : _ptr((JASEL_ASSERT(pos < subwords_per_word), &ref))
       , _pos(pos)
       {
       }
@@ -110,13 +112,11 @@ inline namespace fundamental_v3
           set(other.value());
           return *this;
       }
-      // fixme: We can not define a assignment from word_type and value_type if both are the same.
-      //
-//      constexpr subword_reference& operator=(value_type const& val) noexcept
-//      {
-//          set(val);
-//          return *this;
-//      }
+      // There is no assignment from word_type, as it can be the same type as T.
+      JASEL_CXX14_CONSTEXPR subword_reference& operator=(T const& val) noexcept
+      {
+          return set(val);
+      }
       JASEL_CXX14_CONSTEXPR subword_reference& operator=(subword const& val) noexcept
       {
           set(val);
@@ -141,7 +141,7 @@ inline namespace fundamental_v3
       }
       JASEL_CXX14_CONSTEXPR subword_reference& operator|=(subword const& other) noexcept
       {
-          *_ptr |= ~mask() | mask(other,_pos);
+          *_ptr |= mask(other,_pos);
           return *this;
       }
       JASEL_CXX14_CONSTEXPR subword_reference& operator^=(subword const& other) noexcept
@@ -160,11 +160,11 @@ inline namespace fundamental_v3
       // what name for retrieving the word_type?
       word_type value() const noexcept
       {
-          return subword(*this).value();
+          return word_type(subword(*_ptr, _pos).value());
       }
       public:
       // fixme: cannot be constexpr because the function is declaring a variable uninitialized and using memcpy?
-      explicit operator T() const noexcept
+      operator T() const noexcept
       {
         //return T(subword(*this)); // if explicitly convertible
         subword s(*_ptr , _pos); // if trivially_copiable
@@ -201,8 +201,7 @@ inline namespace fundamental_v3
       public:
       JASEL_CXX14_CONSTEXPR subword_reference& set(subword other) noexcept
       {
-          reset();
-          *_ptr |= ~mask() | mask(other, _pos);
+          *_ptr = (*_ptr & ~mask()) | mask(other, _pos);
           return *this;
       }
       JASEL_CXX14_CONSTEXPR subword_reference& set(T other) noexcept
@@ -232,11 +231,11 @@ inline namespace fundamental_v3
       static constexpr word_type static_mask = bit_ops::up_to<subword_digits, word_type>();
       constexpr word_type mask() const noexcept
       {
-          return static_mask << (subword_digits * _pos);
+          return word_type(static_mask << (subword_digits * _pos));
       }
       constexpr word_type mask(subword sw, size_type pos) const noexcept
       {
-          return word_type(sw.value()) << (subword_digits * pos);
+          return word_type(word_type(sw.value()) << (subword_digits * pos));
       }
 
       // Implementation details: function members
@@ -253,7 +252,7 @@ inline namespace fundamental_v3
       {
       }
       constexpr subword_reference(word_type* ptr, index_type pos)
-      : _ptr((JASEL_ASSERT(pos < binary_digits<word_type>::value), ptr))
+      : _ptr((JASEL_ASSERT(pos < subwords_per_word), ptr))
       , _pos(pos)
       {
       }
@@ -276,25 +275,21 @@ inline namespace fundamental_v3
 
       JASEL_CXX14_CONSTEXPR void inc_as_pointer()
       {
-          //constexpr size_type word_digits = binary_digits<word_type>::value;
-          if ((_pos*subword_digits) + subword_digits < word_digits) {
+          if (_pos + 1 < subwords_per_word) {
               ++_pos;
           } else {
               ++_ptr;
               _pos = 0;
           }
-          //return *this;
       }
       JASEL_CXX14_CONSTEXPR void dec_as_pointer()
       {
-          //constexpr size_type word_digits = binary_digits<word_type>::value;
-          if ((_pos*subword_digits) > subword_digits) {
+          if (_pos > 0) {
               --_pos ;
           } else {
               --_ptr;
-              _pos = (word_digits / subword_digits)-1;
+              _pos = subwords_per_word - 1;
           }
-          //return *this;
       }
       // Implementation details: data members
       private:
@@ -0,0 +1,14 @@
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// (C) Copyright 2019 Vicente J. Botet Escriba
+
+#ifndef JASEL_EXPERIMENTAL_OBJECT_POOL_HPP
+#define JASEL_EXPERIMENTAL_OBJECT_POOL_HPP
+
+#include <experimental/fundamental/v3/object_pool/static_pool.hpp>
+#include <experimental/fundamental/v3/object_pool/object_pool.hpp>
+#include <experimental/fundamental/v3/object_pool/pool_resource.hpp>
+
+#endif // header
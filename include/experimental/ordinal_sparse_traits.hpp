@@ -0,0 +1,12 @@
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// (C) Copyright 2019 Vicente J. Botet Escriba
+
+#ifndef JASEL_EXPERIMENTAL_ORDINAL_SPARSE_TRAITS_HPP
+#define JASEL_EXPERIMENTAL_ORDINAL_SPARSE_TRAITS_HPP
+
+#include <experimental/fundamental/v3/ordinal/sparse_traits.hpp>
+
+#endif // header
@@ -0,0 +1,12 @@
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// (C) Copyright 2019 Vicente J. Botet Escriba
+
+#ifndef JASEL_EXPERIMENTAL_ROARING_BITMAP_HPP
+#define JASEL_EXPERIMENTAL_ROARING_BITMAP_HPP
+
+#include <experimental/fundamental/v3/bits/roaring_bitmap.hpp>
+
+#endif // header
@@ -0,0 +1,12 @@
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// (C) Copyright 2019 Vicente J. Botet Escriba
+
+#ifndef JASEL_EXPERIMENTAL_SMALL_VECTOR_HPP
+#define JASEL_EXPERIMENTAL_SMALL_VECTOR_HPP
+
+#include <experimental/fundamental/v3/small_vector/small_vector.hpp>
+
+#endif // header
@@ -16,6 +16,7 @@
 #include <experimental/fundamental/v3/type_traits/detection.hpp>
 #include <experimental/fundamental/v3/type_traits/disjunction.hpp>
 #include <experimental/fundamental/v3/type_traits/integer_sequence.hpp>
+#include <experimental/fundamental/v3/type_traits/is_trivially_relocatable.hpp>
 #include <experimental/fundamental/v3/type_traits/negation.hpp>
 #include <experimental/fundamental/v3/type_traits/remove_cvref.hpp>
 #include <experimental/fundamental/v3/type_traits/type_identity.hpp>
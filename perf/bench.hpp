@@ -0,0 +1,65 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Minimal timing support shared by the benchmarks.
+
+#ifndef JASEL_PERF_BENCH_HPP
+#define JASEL_PERF_BENCH_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+namespace bench
+{
+
+// Prevents the compiler from optimizing away the computation of x.
+template <class T>
+void do_not_optimize(T const &x)
+{
+#if defined __GNUC__ || defined __clang__
+	asm volatile("" : : "g"(&x) : "memory");
+#else
+	static T const *volatile sink;
+	sink = &x;
+#endif
+}
+
+// Runs f() `repetitions` times and returns the best time in nanoseconds per operation, f performing `ops` operations.
+template <class F>
+double measure(std::size_t ops, F f, int repetitions = 5)
+{
+	double best = 0;
+	for (int r = 0; r < repetitions; ++r)
+	{
+		auto const start = std::chrono::steady_clock::now();
+		f();
+		auto const stop = std::chrono::steady_clock::now();
+		double const ns = std::chrono::duration<double, std::nano>(stop - start).count() / double(ops);
+		if (r == 0 || ns < best)
+			best = ns;
+	}
+	return best;
+}
+
+inline void print_header(char const *title, char const *const *columns, std::size_t n)
+{
+	std::printf("%s\n%12s", title, "size");
+	for (std::size_t i = 0; i < n; ++i)
+		std::printf("%14s", columns[i]);
+	std::printf("\n");
+}
+
+inline void print_row(std::size_t size, double const *values, std::size_t n)
+{
+	std::printf("%12zu", size);
+	for (std::size_t i = 0; i < n; ++i)
+		std::printf("%14.2f", values[i]);
+	std::printf("\n");
+}
+
+} // namespace bench
+
+#endif
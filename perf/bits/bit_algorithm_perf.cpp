@@ -0,0 +1,108 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares the standard algorithms, which go through a bit_reference for each bit, with the word algorithms found by
+// argument dependent lookup on bit_iterator ranges.
+// The ranges start and end in the middle of a word; copy and equal use a second range with a different alignment.
+// Prints the time per bit in nanoseconds.
+
+#include <experimental/bit.hpp>
+#include "../bench.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace stde = std::experimental;
+
+using word     = std::uint64_t;
+using iterator = stde::bit_iterator<word *>;
+
+// bit_reference has no operator==, which std::equal needs
+bool naive_equal(iterator first, iterator last, iterator first2)
+{
+	for (; first != last; ++first, ++first2)
+		if (bool(*first) != bool(*first2))
+			return false;
+	return true;
+}
+
+struct data
+{
+	std::size_t       n;
+	std::vector<word> src, dst, sparse;
+	iterator          first, last, d_first, s_first, s_last;
+
+	explicit data(std::size_t size, std::mt19937_64 &gen)
+	        : n(size), src(n / 64 + 2), dst(n / 64 + 2), sparse(n / 64 + 2, 0)
+	{
+		for (auto &w : src)
+			w = gen();
+		first   = iterator(src.data(), 3);
+		last    = first + std::ptrdiff_t(n);
+		d_first = iterator(dst.data(), 17);
+		copy(first, last, d_first);
+		// a single bit set at the end, so that find scans the whole range
+		s_first = iterator(sparse.data(), 3);
+		s_last  = s_first + std::ptrdiff_t(n);
+		*(s_last - 1) = stde::bit_on;
+	}
+};
+
+template <class F, class G>
+void table(char const *title, std::vector<data> &work, F naive, G words)
+{
+	static char const *const columns[] = {"std", "word"};
+	bench::print_header(title, columns, 2);
+	for (auto &d : work)
+	{
+		double r[2];
+		r[0] = bench::measure(d.n, [&] { naive(d); });
+		r[1] = bench::measure(d.n, [&] { words(d); });
+		bench::print_row(d.n, r, 2);
+	}
+}
+
+int main()
+{
+	std::mt19937_64   gen(42);
+	std::vector<data> work;
+	for (std::size_t n : {std::size_t(1) << 10, std::size_t(1) << 16, std::size_t(1) << 20})
+		work.emplace_back(n, gen);
+
+	table("count, ns per bit", work,
+	      [](data &d) { bench::do_not_optimize(std::count(d.first, d.last, stde::bit_on)); },
+	      [](data &d) { bench::do_not_optimize(count(d.first, d.last, stde::bit_on)); });
+	table("find, ns per bit", work,
+	      [](data &d) { bench::do_not_optimize(std::find(d.s_first, d.s_last, stde::bit_on)); },
+	      [](data &d) { bench::do_not_optimize(find(d.s_first, d.s_last, stde::bit_on)); });
+	table("equal, ns per bit", work,
+	      [](data &d) { bench::do_not_optimize(naive_equal(d.first, d.last, d.d_first)); },
+	      [](data &d) { bench::do_not_optimize(equal(d.first, d.last, d.d_first)); });
+	table("copy, ns per bit", work,
+	      [](data &d) { bench::do_not_optimize(std::copy(d.first, d.last, d.d_first)); },
+	      [](data &d) { bench::do_not_optimize(copy(d.first, d.last, d.d_first)); });
+	table("reverse, ns per bit", work,
+	      [](data &d) {
+		      std::reverse(d.first, d.last);
+		      bench::do_not_optimize(d.src);
+	      },
+	      [](data &d) {
+		      reverse(d.first, d.last);
+		      bench::do_not_optimize(d.src);
+	      });
+	table("fill, ns per bit", work,
+	      [](data &d) {
+		      std::fill(d.d_first, d.d_first + std::ptrdiff_t(d.n), stde::bit_on);
+		      bench::do_not_optimize(d.dst);
+	      },
+	      [](data &d) {
+		      fill(d.d_first, d.d_first + std::ptrdiff_t(d.n), stde::bit_on);
+		      bench::do_not_optimize(d.dst);
+	      });
+	return 0;
+}
@@ -0,0 +1,71 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares the kernels of the bulk popcounts, and the dispatched functions, on spans of 64-bit words from the L1 cache
+// size to main memory. The kernels the CPU doesn't support print nan.
+// Prints the time per word in nanoseconds.
+
+#include <experimental/bit_ops.hpp>
+#include "../bench.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace bit_ops = std::experimental::bit_ops;
+using namespace bit_ops::popcount_detail;
+
+template <op Op, class F>
+void table(char const *title, F dispatched)
+{
+	static char const *const columns[] = {"scalar", "popcnt", "avx2", "avx512", "dispatched"};
+	static kernel const      kernels[] = {kernel::scalar, kernel::popcnt, kernel::avx2, kernel::avx512};
+	bench::print_header(title, columns, 5);
+	std::mt19937_64 gen(42);
+	for (std::size_t n : {std::size_t(1) << 9, std::size_t(1) << 14, std::size_t(1) << 20, std::size_t(1) << 23})
+	{
+		std::vector<std::uint64_t> a(n), b(n);
+		for (auto &w : a)
+			w = gen();
+		for (auto &w : b)
+			w = gen();
+		// enough passes over the small spans to measure something
+		int const passes = int((std::size_t(1) << 24) / n);
+		double    r[5];
+		for (int k = 0; k < 4; ++k)
+		{
+			if (!supported(kernels[k]))
+			{
+				r[k] = std::nan("");
+				continue;
+			}
+			kernel_fn const fn = select<Op>(kernels[k]);
+			r[k] = bench::measure(n * std::size_t(passes), [&] {
+				for (int p = 0; p < passes; ++p)
+					bench::do_not_optimize(fn(a.data(), b.data(), n));
+			});
+		}
+		r[4] = bench::measure(n * std::size_t(passes), [&] {
+			for (int p = 0; p < passes; ++p)
+				bench::do_not_optimize(dispatched(a, b));
+		});
+		bench::print_row(n, r, 5);
+	}
+}
+
+int main()
+{
+	table<op::first>("popcount, ns per word", [](std::vector<std::uint64_t> const &a, std::vector<std::uint64_t> const &) {
+		return bit_ops::popcount(a);
+	});
+	table<op::and_>("popcount_and, ns per word", [](std::vector<std::uint64_t> const &a, std::vector<std::uint64_t> const &b) {
+		return bit_ops::popcount_and(a, b);
+	});
+	table<op::xor_>("popcount_xor, ns per word", [](std::vector<std::uint64_t> const &a, std::vector<std::uint64_t> const &b) {
+		return bit_ops::popcount_xor(a, b);
+	});
+	return 0;
+}
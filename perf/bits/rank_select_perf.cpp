@@ -0,0 +1,69 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures the queries of a rank_select_bitvector at random positions, on vectors up to 1e9 bits, dense (half the bits
+// set) and sparse (one bit in 64 set). Build with -mbmi2 -mpopcnt to select in a word with pdep.
+// Prints the time per query in nanoseconds, the time per bit to build the index and the size of the index relative
+// to the size of the bits.
+
+#include <experimental/rank_select_bitvector.hpp>
+#include "../bench.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace stde = std::experimental;
+
+void table(char const *title, bool sparse)
+{
+	static char const *const columns[] = {"rank1", "select1", "select0", "build/bit", "overhead %"};
+	bench::print_header(title, columns, 5);
+	std::size_t const queries = 1 << 20;
+	std::mt19937_64 gen(sparse);
+	for (std::size_t n : {std::size_t(1000000), std::size_t(100000000), std::size_t(1000000000)})
+	{
+		std::vector<std::uint64_t> words((n + 63) / 64);
+		for (auto &w : words)
+			w = sparse ? std::uint64_t(1) << (gen() % 64) : gen();
+		double r[5];
+		r[3] = bench::measure(n, [&] {
+			stde::rank_select_bitvector rs(words, n);
+			bench::do_not_optimize(rs);
+		}, 1);
+		stde::rank_select_bitvector const rs(words, n);
+		r[4] = 100.0 * double(rs.directory_bytes()) / double(words.size() * sizeof(std::uint64_t));
+
+		std::vector<std::size_t> pos(queries), ones(queries), zeros(queries);
+		for (std::size_t i = 0; i < queries; ++i)
+		{
+			pos[i] = gen() % n;
+			ones[i] = gen() % rs.count();
+			zeros[i] = gen() % (n - rs.count());
+		}
+		std::size_t sum = 0;
+		r[0] = bench::measure(queries, [&] {
+			for (std::size_t i : pos)
+				sum += rs.rank1(i);
+		});
+		r[1] = bench::measure(queries, [&] {
+			for (std::size_t k : ones)
+				sum += rs.select1(k);
+		});
+		r[2] = bench::measure(queries, [&] {
+			for (std::size_t k : zeros)
+				sum += rs.select0(k);
+		});
+		bench::do_not_optimize(sum);
+		bench::print_row(n, r, 5);
+	}
+}
+
+int main()
+{
+	table("dense bits, ns per query", false);
+	table("sparse bits, ns per query", true);
+	return 0;
+}
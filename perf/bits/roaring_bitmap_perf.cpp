@@ -0,0 +1,91 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures the set operations of roaring_bitmap against the standard algorithms on sorted vectors of uint32_t, for
+// sparse sets (arrays), dense sets (bitmaps) and sets of long sequences (runs).
+// Prints the time per value of the operands in nanoseconds and the size of the serialized bitmap per value in bytes.
+
+#include <experimental/roaring_bitmap.hpp>
+#include "../bench.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+
+namespace stde = std::experimental;
+
+std::vector<std::uint32_t> make_values(std::size_t n, int distribution, std::mt19937 &gen)
+{
+	std::vector<std::uint32_t> v;
+	v.reserve(n);
+	switch (distribution)
+	{
+	case 0: // sparse
+		for (std::size_t i = 0; i < n; ++i)
+			v.push_back(std::uint32_t(gen() % (std::uint64_t(n) * 256)));
+		break;
+	case 1: // dense
+		for (std::size_t i = 0; i < n; ++i)
+			v.push_back(std::uint32_t(gen() % (n * 2)));
+		break;
+	default: // runs of 1000 values
+		while (v.size() < n)
+		{
+			std::uint32_t const first = std::uint32_t(gen() % (std::uint64_t(n) * 4));
+			for (std::uint32_t x = first; x < first + 1000; ++x)
+				v.push_back(x);
+		}
+		break;
+	}
+	std::sort(v.begin(), v.end());
+	v.erase(std::unique(v.begin(), v.end()), v.end());
+	return v;
+}
+
+void table(char const *title, int distribution)
+{
+	static char const *const columns[] = {"and", "or", "xor", "andnot", "vector and", "vector or", "bytes/value"};
+	bench::print_header(title, columns, 7);
+	std::mt19937 gen(distribution);
+	for (std::size_t n : {std::size_t(100000), std::size_t(1000000)})
+	{
+		std::vector<std::uint32_t> const vx = make_values(n, distribution, gen);
+		std::vector<std::uint32_t> const vy = make_values(n, distribution, gen);
+		stde::roaring_bitmap x(vx.begin(), vx.end());
+		stde::roaring_bitmap y(vy.begin(), vy.end());
+		x.run_optimize();
+		y.run_optimize();
+		std::size_t const values = vx.size() + vy.size();
+		double r[7];
+		r[0] = bench::measure(values, [&] { bench::do_not_optimize(x & y); });
+		r[1] = bench::measure(values, [&] { bench::do_not_optimize(x | y); });
+		r[2] = bench::measure(values, [&] { bench::do_not_optimize(x ^ y); });
+		r[3] = bench::measure(values, [&] { bench::do_not_optimize(x - y); });
+		std::vector<std::uint32_t> out;
+		out.reserve(values);
+		r[4] = bench::measure(values, [&] {
+			out.clear();
+			std::set_intersection(vx.begin(), vx.end(), vy.begin(), vy.end(), std::back_inserter(out));
+			bench::do_not_optimize(out);
+		});
+		r[5] = bench::measure(values, [&] {
+			out.clear();
+			std::set_union(vx.begin(), vx.end(), vy.begin(), vy.end(), std::back_inserter(out));
+			bench::do_not_optimize(out);
+		});
+		r[6] = double(x.serialized_size()) / double(vx.size());
+		bench::print_row(vx.size(), r, 7);
+	}
+}
+
+int main()
+{
+	table("sparse sets, ns per value", 0);
+	table("dense sets, ns per value", 1);
+	table("runs, ns per value", 2);
+	return 0;
+}
@@ -0,0 +1,66 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares the ways to visit the bits set in a bit_mask: testing every position, find_first/find_next, the set_bits()
+// iterators and for_each_set, for masks of one and of several blocks with a few or many bits set.
+// Prints the time per mask visited in nanoseconds.
+
+#include <experimental/bit_mask.hpp>
+#include "../bench.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace stde = std::experimental;
+
+template <std::size_t N>
+void table(char const *title)
+{
+	using mask_t = stde::bit_mask<N, std::uint64_t>;
+	static char const *const columns[] = {"test", "find_next", "set_bits", "for_each_set"};
+	bench::print_header(title, columns, 4);
+	std::size_t const masks = 1024;
+	std::mt19937_64 gen(N);
+	// the first column is the number of bits set in each mask
+	for (std::size_t bits : {std::size_t(2), N / 8, N / 2})
+	{
+		std::vector<mask_t> v(masks);
+		for (auto &m : v)
+			for (std::size_t i = 0; i < bits; ++i)
+				m.set(gen() % N);
+		std::size_t sum = 0;
+		double r[4];
+		r[0] = bench::measure(masks, [&] {
+			for (auto const &m : v)
+				for (std::size_t pos = 0; pos < N; ++pos)
+					if (m[pos])
+						sum += pos;
+		});
+		r[1] = bench::measure(masks, [&] {
+			for (auto const &m : v)
+				for (std::size_t pos = m.find_first(); pos < N; pos = m.find_next(pos))
+					sum += pos;
+		});
+		r[2] = bench::measure(masks, [&] {
+			for (auto const &m : v)
+				for (std::size_t pos : m.set_bits())
+					sum += pos;
+		});
+		r[3] = bench::measure(masks, [&] {
+			for (auto const &m : v)
+				m.for_each_set([&](std::size_t pos) { sum += pos; });
+		});
+		bench::do_not_optimize(sum);
+		bench::print_row(bits, r, 4);
+	}
+}
+
+int main()
+{
+	table<64>("bit_mask<64>, ns per mask");
+	table<1024>("bit_mask<1024>, ns per mask");
+	return 0;
+}
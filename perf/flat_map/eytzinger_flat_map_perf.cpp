@@ -0,0 +1,60 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares the lookups of flat_map (sorted keys) and eytzinger_flat_map (keys in BFS order) from 16 to 10M keys.
+// Prints the time per find in nanoseconds.
+
+#include <experimental/flat_map.hpp>
+#include "../bench.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace stdex = std::experimental;
+
+template <class Map, class T>
+double run(Map const &m, std::vector<T> const &probes)
+{
+	return bench::measure(probes.size(), [&] {
+		std::size_t sum = 0;
+		for (auto const &x : probes)
+			sum += m.contains(x) ? 1 : 0;
+		bench::do_not_optimize(sum);
+	});
+}
+
+template <class T>
+void run_all(char const *title)
+{
+	static char const *const columns[] = {"flat_map", "eytzinger"};
+	bench::print_header(title, columns, 2);
+
+	std::mt19937_64 gen(42);
+	std::size_t const sizes[] = {16, 64, 256, 1024, 4096, 16384, 65536, 262144, 1048576, 4194304, 10000000};
+	for (auto n : sizes)
+	{
+		std::vector<T> keys(n);
+		for (std::size_t i = 0; i < n; ++i)
+			keys[i] = static_cast<T>(2 * i);
+		std::vector<T> probes(1000000);
+		for (auto &x : probes)
+			x = static_cast<T>(gen() % (2 * n));
+
+		stdex::flat_map<T, std::uint32_t> const m(stdex::sorted_unique_t{}, std::vector<T>(keys),
+		                                           std::vector<std::uint32_t>(n));
+		stdex::eytzinger_flat_map<T, std::uint32_t> const e(m);
+
+		double const r[] = {run(m, probes), run(e, probes)};
+		bench::print_row(n, r, 2);
+	}
+}
+
+int main()
+{
+	run_all<std::uint32_t>("uint32_t keys, ns per find");
+	run_all<std::uint64_t>("uint64_t keys, ns per find");
+	return 0;
+}
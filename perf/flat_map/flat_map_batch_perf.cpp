@@ -0,0 +1,66 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares resolving a batch of keys with one find per key and with find_index_batch, on unsorted and sorted keys.
+// Prints the time per key in nanoseconds.
+
+#include <experimental/flat_map.hpp>
+#include "../bench.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace stdex = std::experimental;
+
+using map_type = stdex::flat_map<std::uint64_t, std::uint32_t>;
+
+double run_find(map_type const &m, std::vector<std::uint64_t> const &xs, std::vector<std::size_t> &out)
+{
+	return bench::measure(xs.size(), [&] {
+		for (std::size_t i = 0; i < xs.size(); ++i)
+			out[i] = static_cast<std::size_t>(m.find(xs[i]) - m.begin());
+		bench::do_not_optimize(out.front());
+	});
+}
+
+double run_batch(map_type const &m, std::vector<std::uint64_t> const &xs, std::vector<std::size_t> &out)
+{
+	return bench::measure(xs.size(), [&] {
+		m.find_index_batch(xs, out.begin());
+		bench::do_not_optimize(out.front());
+	});
+}
+
+int main()
+{
+	static char const *const columns[] = {"find", "batch", "sorted find", "sorted batch"};
+	bench::print_header("uint64_t keys, 100000 lookups, ns per key", columns, 4);
+
+	std::mt19937_64   gen(42);
+	std::size_t const sizes[] = {1024, 16384, 262144, 1048576, 4194304, 10000000};
+	for (auto n : sizes)
+	{
+		std::vector<std::uint64_t> keys(n);
+		for (std::size_t i = 0; i < n; ++i)
+			keys[i] = 2 * i;
+		map_type const m(stdex::sorted_unique_t{}, std::move(keys), std::vector<std::uint32_t>(n));
+
+		std::vector<std::uint64_t> xs(100000);
+		for (auto &x : xs)
+			x = gen() % (2 * n);
+		std::vector<std::size_t> out(xs.size());
+
+		double r[4];
+		r[0] = run_find(m, xs, out);
+		r[1] = run_batch(m, xs, out);
+		std::sort(xs.begin(), xs.end());
+		r[2] = run_find(m, xs, out);
+		r[3] = run_batch(m, xs, out);
+		bench::print_row(n, r, 4);
+	}
+	return 0;
+}
@@ -0,0 +1,115 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Simulates the per-request churn of short-lived maps: each request builds a flat_map by inserting unsorted keys,
+// looks all of them up and destroys the map.
+// Compares the default allocator, pmr containers on the default resource and pmr containers on a monotonic buffer
+// released at the end of each request.
+// Prints the time per request in nanoseconds.
+
+#include <experimental/flat_map.hpp>
+#include "../bench.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#define JASEL_BENCH_PMR
+#endif
+#endif
+
+#ifdef JASEL_BENCH_PMR
+
+namespace stdex = std::experimental;
+
+using std_map = stdex::flat_map<std::uint64_t, std::uint32_t>;
+using pmr_map = stdex::flat_map<std::uint64_t, std::uint32_t, std::less<std::uint64_t>,
+                                std::pmr::vector<std::uint64_t>, std::pmr::vector<std::uint32_t>>;
+
+constexpr std::size_t requests = 1000;
+
+template <class Map>
+std::uint32_t one_request(Map &m, std::vector<std::uint64_t> const &keys)
+{
+	for (std::size_t i = 0; i < keys.size(); ++i)
+		m.emplace(keys[i], std::uint32_t(i));
+	std::uint32_t sum = 0;
+	for (auto k : keys)
+		sum += m.find(k)->second;
+	return sum;
+}
+
+double run_std(std::vector<std::vector<std::uint64_t>> const &work)
+{
+	return bench::measure(requests, [&] {
+		for (std::size_t r = 0; r < requests; ++r)
+		{
+			std_map m;
+			bench::do_not_optimize(one_request(m, work[r % work.size()]));
+		}
+	});
+}
+
+double run_pmr(std::vector<std::vector<std::uint64_t>> const &work)
+{
+	return bench::measure(requests, [&] {
+		for (std::size_t r = 0; r < requests; ++r)
+		{
+			pmr_map m(std::allocator_arg, std::pmr::get_default_resource());
+			bench::do_not_optimize(one_request(m, work[r % work.size()]));
+		}
+	});
+}
+
+double run_monotonic(std::vector<std::vector<std::uint64_t>> const &work, std::vector<char> &buffer)
+{
+	return bench::measure(requests, [&] {
+		for (std::size_t r = 0; r < requests; ++r)
+		{
+			std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+			pmr_map                             m(std::allocator_arg, &arena);
+			bench::do_not_optimize(one_request(m, work[r % work.size()]));
+		}
+	});
+}
+
+int main()
+{
+	static char const *const columns[] = {"std", "pmr default", "monotonic"};
+	bench::print_header("uint64_t -> uint32_t, 1000 requests, ns per request", columns, 3);
+
+	std::mt19937_64   gen(42);
+	std::size_t const sizes[] = {8, 32, 128, 512, 2048};
+	for (auto n : sizes)
+	{
+		std::vector<std::vector<std::uint64_t>> work(16);
+		for (auto &keys : work)
+			for (std::size_t i = 0; i < n; ++i)
+				keys.push_back(gen());
+		// room for all the geometric reallocations of both containers
+		std::vector<char> buffer(64 * n * sizeof(std::uint64_t) + 4096);
+
+		double r[3];
+		r[0] = run_std(work);
+		r[1] = run_pmr(work);
+		r[2] = run_monotonic(work, buffer);
+		bench::print_row(n, r, 3);
+	}
+	return 0;
+}
+
+#else
+
+int main()
+{
+	std::printf("flat_map_pmr_perf requires C++17 and <memory_resource>: configure with -DJASEL_CXX_STD=17\n");
+	return 0;
+}
+
+#endif
@@ -0,0 +1,59 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares the flat_map search policies on sorted key columns from 16 to 10M keys.
+// Prints the time per lower_bound in nanoseconds.
+
+#include <experimental/flat_map.hpp>
+#include "../bench.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace stdex = std::experimental;
+
+template <class Policy, class T>
+double run(std::vector<T> const &keys, std::vector<T> const &probes)
+{
+	return bench::measure(probes.size(), [&] {
+		std::size_t sum = 0;
+		for (auto const &x : probes)
+			sum += static_cast<std::size_t>(Policy::lower_bound(keys.begin(), keys.end(), x, std::less<T>()) - keys.begin());
+		bench::do_not_optimize(sum);
+	});
+}
+
+template <class T>
+void run_all(char const *title)
+{
+	static char const *const columns[] = {"std", "branchless", "simd"};
+	bench::print_header(title, columns, 3);
+
+	std::mt19937_64 gen(42);
+	std::size_t const sizes[] = {16, 64, 256, 1024, 4096, 16384, 65536, 262144, 1048576, 4194304, 10000000};
+	for (auto n : sizes)
+	{
+		std::vector<T> keys(n);
+		for (std::size_t i = 0; i < n; ++i)
+			keys[i] = static_cast<T>(2 * i);
+		std::vector<T> probes(1000000);
+		for (auto &x : probes)
+			x = static_cast<T>(gen() % (2 * n));
+
+		double const r[] = {run<stdex::std_search_policy>(keys, probes), run<stdex::branchless_search_policy>(keys, probes),
+		                    run<stdex::simd_search_policy>(keys, probes)};
+		bench::print_row(n, r, 3);
+	}
+}
+
+int main()
+{
+	run_all<std::uint32_t>("uint32_t keys, ns per lower_bound");
+	run_all<std::int64_t>("int64_t keys, ns per lower_bound");
+	run_all<double>("double keys, ns per lower_bound");
+	return 0;
+}
@@ -0,0 +1,130 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Simulates the churn of short-lived 64-byte orders: the first column is the number of orders alive; each step
+// destroys a random one and creates a new one in its place.
+// Compares new/delete, static_pool, object_pool and, in C++17, pmr::unsynchronized_pool_resource and pool_resource
+// over an object_pool. Prints the time per step in nanoseconds.
+
+#include <experimental/object_pool.hpp>
+#include "../bench.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#define JASEL_BENCH_PMR
+#endif
+#endif
+
+namespace stdex = std::experimental;
+
+struct order
+{
+	std::uint64_t id;
+	std::uint64_t price;
+	std::uint64_t quantity;
+	std::uint64_t fields[5];
+
+	explicit order(std::uint64_t i)
+	        : id(i), price(i * 3), quantity(i & 0xFF), fields()
+	{
+	}
+};
+
+constexpr std::size_t max_alive = 16384;
+constexpr std::size_t steps     = 1 << 20;
+
+// create(i) returns a new order, destroy(p) destroys it.
+template <class Create, class Destroy>
+double run(std::size_t alive, std::vector<std::uint32_t> const &victims, Create create, Destroy destroy)
+{
+	std::vector<order *> orders;
+	for (std::size_t i = 0; i < alive; ++i)
+		orders.push_back(create(i));
+	double const ns = bench::measure(steps, [&] {
+		std::uint64_t sum = 0;
+		for (std::size_t s = 0; s < steps; ++s)
+		{
+			order *&o = orders[victims[s] % alive];
+			sum += o->price;
+			destroy(o);
+			o = create(s);
+		}
+		bench::do_not_optimize(sum);
+	});
+	for (order *o : orders)
+		destroy(o);
+	return ns;
+}
+
+int main()
+{
+#ifdef JASEL_BENCH_PMR
+	static char const *const columns[] = {"new/delete", "static_pool", "object_pool", "pmr pool", "pool_resource"};
+	std::size_t const        ncolumns  = 5;
+#else
+	static char const *const columns[] = {"new/delete", "static_pool", "object_pool"};
+	std::size_t const        ncolumns  = 3;
+#endif
+	bench::print_header("order churn, ns per destroy and create", columns, ncolumns);
+
+	std::mt19937               gen(7);
+	std::vector<std::uint32_t> victims(steps);
+	for (auto &v : victims)
+		v = std::uint32_t(gen());
+
+	for (std::size_t alive : {64, 1024, 16384})
+	{
+		double r[5];
+		r[0] = run(alive, victims, [](std::size_t i) { return new order(i); }, [](order *o) { delete o; });
+		{
+			auto pool = std::unique_ptr<stdex::static_pool<order, max_alive>>(new stdex::static_pool<order, max_alive>);
+			r[1]      = run(alive, victims, [&](std::size_t i) { return pool->create(i); },
+                       [&](order *o) { pool->destroy(o); });
+		}
+		{
+			stdex::object_pool<order> pool;
+			r[2] = run(alive, victims, [&](std::size_t i) { return pool.create(i); }, [&](order *o) { pool.destroy(o); });
+		}
+#ifdef JASEL_BENCH_PMR
+		{
+			std::pmr::unsynchronized_pool_resource    resource;
+			std::pmr::polymorphic_allocator<order> alloc(&resource);
+			r[3] = run(alive, victims,
+			           [&](std::size_t i) {
+				           order *o = alloc.allocate(1);
+				           return ::new (static_cast<void *>(o)) order(i);
+			           },
+			           [&](order *o) {
+				           o->~order();
+				           alloc.deallocate(o, 1);
+			           });
+		}
+		{
+			stdex::object_pool<order>                      pool;
+			stdex::pool_resource<stdex::object_pool<order>> resource(pool);
+			std::pmr::polymorphic_allocator<order>         alloc(&resource);
+			r[4] = run(alive, victims,
+			           [&](std::size_t i) {
+				           order *o = alloc.allocate(1);
+				           return ::new (static_cast<void *>(o)) order(i);
+			           },
+			           [&](order *o) {
+				           o->~order();
+				           alloc.deallocate(o, 1);
+			           });
+		}
+#endif
+		bench::print_row(alive, r, ncolumns);
+	}
+	return 0;
+}
@@ -0,0 +1,77 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares ordinal_map, the dense map, with ordinal_ordered_map, the std::map, keyed by the 256 ordinals of
+// unsigned char: random finds, an insert followed by an erase of random keys, and the iteration over all the elements.
+// The first column is the number of elements. Prints the time per operation (per element for the iteration) in
+// nanoseconds.
+
+#include <experimental/ordinal_map.hpp>
+#include <experimental/ordinal_ordered_map.hpp>
+#include "../bench.hpp"
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace stde = std::experimental;
+
+template <class Map>
+void fill(Map &m, std::vector<unsigned char> const &keys)
+{
+	for (unsigned char k : keys)
+		m[k] = int(k);
+}
+
+template <class Map>
+void run(Map &m, std::vector<unsigned char> const &keys, std::vector<unsigned char> const &probes, double *r)
+{
+	fill(m, keys);
+	long sum = 0;
+	r[0] = bench::measure(probes.size(), [&] {
+		for (unsigned char k : probes)
+		{
+			auto it = m.find(k);
+			if (it != m.end())
+				sum += it->second;
+		}
+	});
+	r[1] = bench::measure(probes.size(), [&] {
+		for (unsigned char k : probes)
+			if (m.insert(std::make_pair(k, 1)).second)
+				m.erase(k);
+	});
+	r[2] = bench::measure(keys.size() * 100, [&] {
+		for (int i = 0; i < 100; ++i)
+			for (auto const &e : m)
+				sum += e.second;
+	});
+	bench::do_not_optimize(sum);
+}
+
+int main()
+{
+	static char const *const columns[] = {"find dense", "find map", "ins/era dense", "ins/era map",
+	                                      "iter dense", "iter map"};
+	bench::print_header("ordinal_map vs ordinal_ordered_map<unsigned char, int>, ns per operation", columns, 6);
+	std::mt19937 gen(1);
+	std::vector<unsigned char> probes(1 << 16);
+	for (auto &k : probes)
+		k = static_cast<unsigned char>(gen());
+	for (std::size_t n : {16, 64, 256})
+	{
+		std::vector<unsigned char> keys;
+		for (std::size_t i = 0; i < n; ++i)
+			keys.push_back(static_cast<unsigned char>(i * 256 / n));
+		stde::ordinal_map<unsigned char, int> dense;
+		stde::ordinal_ordered_map<unsigned char, int> tree;
+		double d[3], t[3];
+		run(dense, keys, probes, d);
+		run(tree, keys, probes, t);
+		double r[6] = {d[0], t[0], d[1], t[1], d[2], t[2]};
+		bench::print_row(n, r, 6);
+	}
+	return 0;
+}
@@ -0,0 +1,113 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares ordinal::sparse_traits<T, Values...>::pos with the switch a user would write, for enums of 10, 100 and
+// 1000 enumerators whose values are either gappy (i*3, a direct table) or spread over 32 bits (a perfect hash).
+// The enumerators are looked up in a random order. Prints the time per pos() in nanoseconds.
+
+#if __cplusplus >= 201402L
+
+#include <experimental/ordinal_sparse_traits.hpp>
+#include "../bench.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace stde = std::experimental;
+
+enum class gappy : std::uint32_t {};
+enum class spread : std::uint32_t {};
+
+constexpr std::uint32_t value(gappy, std::size_t i) { return std::uint32_t(i) * 3u; }
+constexpr std::uint32_t value(spread, std::size_t i) { return std::uint32_t(i) * 2654435761u; }
+
+template <class E, class Seq>
+struct traits_of;
+template <class E, std::size_t... I>
+struct traits_of<E, std::index_sequence<I...>>
+{
+	using type = stde::ordinal::sparse_traits<E, E(value(E{}, I))...>;
+};
+
+// the switch is generated with the same values
+#define JASEL_CASE(E, i) \
+	case E(value(E{}, (i))): return (i);
+#define JASEL_CASES10(E, b) \
+	JASEL_CASE(E, (b) + 0) JASEL_CASE(E, (b) + 1) JASEL_CASE(E, (b) + 2) JASEL_CASE(E, (b) + 3) \
+	JASEL_CASE(E, (b) + 4) JASEL_CASE(E, (b) + 5) JASEL_CASE(E, (b) + 6) JASEL_CASE(E, (b) + 7) \
+	JASEL_CASE(E, (b) + 8) JASEL_CASE(E, (b) + 9)
+#define JASEL_CASES100(E, b) \
+	JASEL_CASES10(E, (b) + 0) JASEL_CASES10(E, (b) + 10) JASEL_CASES10(E, (b) + 20) JASEL_CASES10(E, (b) + 30) \
+	JASEL_CASES10(E, (b) + 40) JASEL_CASES10(E, (b) + 50) JASEL_CASES10(E, (b) + 60) JASEL_CASES10(E, (b) + 70) \
+	JASEL_CASES10(E, (b) + 80) JASEL_CASES10(E, (b) + 90)
+#define JASEL_CASES1000(E, b) \
+	JASEL_CASES100(E, (b) + 0) JASEL_CASES100(E, (b) + 100) JASEL_CASES100(E, (b) + 200) \
+	JASEL_CASES100(E, (b) + 300) JASEL_CASES100(E, (b) + 400) JASEL_CASES100(E, (b) + 500) \
+	JASEL_CASES100(E, (b) + 600) JASEL_CASES100(E, (b) + 700) JASEL_CASES100(E, (b) + 800) \
+	JASEL_CASES100(E, (b) + 900)
+
+#define JASEL_SWITCH_POS(E, N)                         \
+	long switch_pos(E v, std::integral_constant<int, N>) \
+	{                                                  \
+		switch (v)                                     \
+		{                                              \
+			JASEL_CASES##N(E, 0)                       \
+		}                                              \
+		return -1;                                     \
+	}
+JASEL_SWITCH_POS(gappy, 10)
+JASEL_SWITCH_POS(gappy, 100)
+JASEL_SWITCH_POS(gappy, 1000)
+JASEL_SWITCH_POS(spread, 10)
+JASEL_SWITCH_POS(spread, 100)
+JASEL_SWITCH_POS(spread, 1000)
+
+template <class E, int N>
+void row(std::vector<std::size_t> const &order)
+{
+	using Tr = typename traits_of<E, std::make_index_sequence<N>>::type;
+	std::vector<E> v;
+	for (std::size_t i : order)
+		v.push_back(E(value(E{}, i % N)));
+	long   sum = 0;
+	double r[2];
+	r[0] = bench::measure(v.size(), [&] {
+		for (E e : v)
+			sum += switch_pos(e, std::integral_constant<int, N>{});
+	});
+	r[1] = bench::measure(v.size(), [&] {
+		for (E e : v)
+			sum += Tr::pos(e);
+	});
+	bench::do_not_optimize(sum);
+	bench::print_row(N, r, 2);
+}
+
+int main()
+{
+	std::mt19937             gen(1);
+	std::vector<std::size_t> order(1 << 16);
+	for (auto &i : order)
+		i = gen();
+	static char const *const columns[] = {"switch", "sparse_traits"};
+	bench::print_header("gappy enumerators (i*3), ns per pos()", columns, 2);
+	row<gappy, 10>(order);
+	row<gappy, 100>(order);
+	row<gappy, 1000>(order);
+	bench::print_header("spread enumerators (i*2654435761), ns per pos()", columns, 2);
+	row<spread, 10>(order);
+	row<spread, 100>(order);
+	row<spread, 1000>(order);
+	return 0;
+}
+
+#else
+int main()
+{
+}
+#endif
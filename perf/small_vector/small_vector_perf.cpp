@@ -0,0 +1,52 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// The life of a per-request list of std::uint32_t: construct it, push_back the first column number of elements, sum
+// them and destroy it. Compares std::vector, small_vector<std::uint32_t, 8> and, as the bound of what no allocation
+// costs, static_vector<std::uint32_t, 1024>. Prints the time per list in nanoseconds.
+
+#include <experimental/small_vector.hpp>
+#include <experimental/static_vector.hpp>
+#include "../bench.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace stde = std::experimental;
+
+template <class Vector>
+double run(std::size_t n, std::size_t rounds)
+{
+	return bench::measure(rounds, [&] {
+		for (std::size_t r = 0; r < rounds; ++r)
+		{
+			Vector v;
+			for (std::size_t i = 0; i < n; ++i)
+				v.push_back(std::uint32_t(i + r));
+			bench::do_not_optimize(v);
+			std::uint32_t sum = 0;
+			for (std::uint32_t x : v)
+				sum += x;
+			bench::do_not_optimize(sum);
+		}
+	});
+}
+
+int main()
+{
+	static char const *const columns[] = {"std::vector", "small_vector", "static_vector"};
+	bench::print_header("push_back n elements, sum and destroy, ns per list", columns, 3);
+	for (std::size_t n : {0, 4, 8, 64, 1000})
+	{
+		std::size_t const rounds = 2000000 / (n + 8);
+		double            r[3];
+		r[0] = run<std::vector<std::uint32_t>>(n, rounds);
+		r[1] = run<stde::small_vector<std::uint32_t, 8>>(n, rounds);
+		r[2] = run<stde::static_vector<std::uint32_t, 1024>>(n, rounds);
+		bench::print_row(n, r, 3);
+	}
+	return 0;
+}
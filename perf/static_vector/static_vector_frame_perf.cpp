@@ -0,0 +1,104 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Fills 4 KiB frames, as a staging buffer does.
+// - A static_vector<char, 4096> receives the bytes of a memcpy standing for a read(), after resize, which zeroes the
+//   frame, resize_default_init, or within resize_and_overwrite.
+// - A static_vector<std::uint32_t, 1024> receives the words of a decoder loop by push_back, unchecked_emplace_back or
+//   try_emplace_back.
+// The first column is the number of bytes received. Prints the time per frame in nanoseconds.
+//
+// The contract violations throw, so that push_back checks the capacity even when NDEBUG is defined; the audit
+// precondition of unchecked_emplace_back is not checked then.
+
+#define JASEL_CONFIG_CONTRACT_VIOLATION_THROWS_V 1
+#include <experimental/static_vector.hpp>
+#include "../bench.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace stde = std::experimental;
+
+int main()
+{
+	static char const *const columns[] = {"resize", "default_init", "overwrite",
+	                                      "push_back", "unchecked", "try"};
+	bench::print_header("static_vector 4 KiB frames, ns per frame", columns, 6);
+	std::vector<char> src(4096);
+	for (std::size_t i = 0; i < src.size(); ++i)
+		src[i] = char(i * 31);
+	int const frames = 20000;
+	for (std::size_t n : {512, 2048, 4096})
+	{
+		stde::static_vector<char, 4096> bytes;
+		stde::static_vector<std::uint32_t, 1024> words;
+		std::size_t const nwords = n / 4;
+		double r[6];
+		r[0] = bench::measure(frames, [&] {
+			for (int i = 0; i < frames; ++i)
+			{
+				bytes.clear();
+				bytes.resize(bytes.capacity());
+				std::memcpy(bytes.data(), src.data(), n);
+				bytes.resize(n);
+				bench::do_not_optimize(bytes);
+			}
+		});
+		r[1] = bench::measure(frames, [&] {
+			for (int i = 0; i < frames; ++i)
+			{
+				bytes.clear();
+				bytes.resize_default_init(bytes.capacity());
+				std::memcpy(bytes.data(), src.data(), n);
+				bytes.resize(n);
+				bench::do_not_optimize(bytes);
+			}
+		});
+		r[2] = bench::measure(frames, [&] {
+			for (int i = 0; i < frames; ++i)
+			{
+				bytes.clear();
+				bytes.resize_and_overwrite(bytes.capacity(), [&](char *p, std::size_t) {
+					std::memcpy(p, src.data(), n);
+					return n;
+				});
+				bench::do_not_optimize(bytes);
+			}
+		});
+		r[3] = bench::measure(frames, [&] {
+			for (int i = 0; i < frames; ++i)
+			{
+				words.clear();
+				for (std::size_t w = 0; w < nwords; ++w)
+					words.push_back(std::uint32_t(w * 2654435761u));
+				bench::do_not_optimize(words);
+			}
+		});
+		r[4] = bench::measure(frames, [&] {
+			for (int i = 0; i < frames; ++i)
+			{
+				words.clear();
+				for (std::size_t w = 0; w < nwords; ++w)
+					words.unchecked_emplace_back(std::uint32_t(w * 2654435761u));
+				bench::do_not_optimize(words);
+			}
+		});
+		r[5] = bench::measure(frames, [&] {
+			for (int i = 0; i < frames; ++i)
+			{
+				words.clear();
+				for (std::size_t w = 0; w < nwords; ++w)
+					if (!words.try_emplace_back(std::uint32_t(w * 2654435761u)))
+						break;
+				bench::do_not_optimize(words);
+			}
+		});
+		bench::print_row(n, r, 6);
+	}
+	return 0;
+}
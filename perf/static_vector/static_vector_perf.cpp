@@ -0,0 +1,75 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Bulk operations of a static_vector<std::uint32_t, 1024>: assign a range, insert a range at the front of a
+// static_vector having as many elements, insert n copies of a value, clear, and copy construct. The first column is
+// the number of elements assigned, inserted, cleared or copied. Prints the time per element in nanoseconds.
+
+#include <experimental/static_vector.hpp>
+#include "../bench.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace stde = std::experimental;
+
+using vector_type = stde::static_vector<std::uint32_t, 1024>;
+
+int main()
+{
+	static char const *const columns[] = {"assign", "insert front", "insert n x", "clear", "copy"};
+	bench::print_header("static_vector<uint32_t, 1024>, ns per element", columns, 5);
+	std::vector<std::uint32_t> src(1024);
+	for (std::size_t i = 0; i < src.size(); ++i)
+		src[i] = std::uint32_t(i * 2654435761u);
+	int const rounds = 10000;
+	for (std::size_t n : {16, 64, 256, 512})
+	{
+		vector_type sv;
+		double r[5];
+		r[0] = bench::measure(n * rounds, [&] {
+			for (int i = 0; i < rounds; ++i)
+			{
+				sv.assign(src.begin(), src.begin() + n);
+				bench::do_not_optimize(sv);
+			}
+		});
+		r[1] = bench::measure(n * rounds, [&] {
+			for (int i = 0; i < rounds; ++i)
+			{
+				sv.assign(src.begin(), src.begin() + n);
+				sv.insert(sv.begin(), src.end() - n, src.end());
+				bench::do_not_optimize(sv);
+			}
+		});
+		r[2] = bench::measure(n * rounds, [&] {
+			for (int i = 0; i < rounds; ++i)
+			{
+				sv.clear();
+				sv.insert(sv.end(), stde::length_tag_t{}, n, std::uint32_t(i));
+				bench::do_not_optimize(sv);
+			}
+		});
+		r[3] = bench::measure(n * rounds, [&] {
+			for (int i = 0; i < rounds; ++i)
+			{
+				sv.insert(sv.end(), src.begin(), src.begin() + n);
+				sv.clear();
+				bench::do_not_optimize(sv);
+			}
+		});
+		sv.assign(src.begin(), src.begin() + n);
+		r[4] = bench::measure(n * rounds, [&] {
+			for (int i = 0; i < rounds; ++i)
+			{
+				vector_type copy(sv);
+				bench::do_not_optimize(copy);
+			}
+		});
+		bench::print_row(n, r, 5);
+	}
+	return 0;
+}
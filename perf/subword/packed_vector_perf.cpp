@@ -0,0 +1,66 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares the element by element access to a packed_vector through subword_reference with the bulk unpack_to and
+// pack_from, that work a block at a time. Build with -mbmi2 to use pdep and pext.
+// Prints the time per element in nanoseconds.
+
+#include <experimental/packed_vector.hpp>
+#include "../bench.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace stde = std::experimental;
+
+template <int Bits>
+void table()
+{
+	using vector_t = stde::packed_vector<Bits>;
+	using T        = typename vector_t::value_type;
+	static char const *const columns[] = {"get", "unpack_to", "set", "pack_from"};
+	char title[64];
+	std::snprintf(title, sizeof(title), "%d bits in %d-bit values, ns per element", Bits, int(sizeof(T) * 8));
+	bench::print_header(title, columns, 4);
+	std::mt19937_64 gen(Bits);
+	for (std::size_t n : {std::size_t(1) << 10, std::size_t(1) << 16, std::size_t(1) << 22})
+	{
+		std::vector<T> values(n), out(n);
+		for (auto &v : values)
+			v = T(gen() & stde::bit_ops::up_to<Bits, std::uint64_t>());
+		vector_t v;
+		v.pack_from(values);
+		double r[4];
+		r[0] = bench::measure(n, [&] {
+			for (std::size_t k = 0; k < n; ++k)
+				out[k] = v[k];
+			bench::do_not_optimize(out);
+		});
+		r[1] = bench::measure(n, [&] {
+			v.unpack_to(out);
+			bench::do_not_optimize(out);
+		});
+		r[2] = bench::measure(n, [&] {
+			for (std::size_t k = 0; k < n; ++k)
+				v[k] = values[k];
+			bench::do_not_optimize(v);
+		});
+		r[3] = bench::measure(n, [&] {
+			v.pack_from(values);
+			bench::do_not_optimize(v);
+		});
+		bench::print_row(n, r, 4);
+	}
+}
+
+int main()
+{
+	table<3>();
+	table<12>();
+	table<20>();
+	return 0;
+}
@@ -0,0 +1,240 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <experimental/bit.hpp>
+
+// The word algorithms on bit_iterator ranges are checked against a vector<bool> for all the alignments of the ends.
+
+#include <experimental/bit.hpp>
+#include <experimental/static_vector.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <random>
+#include <vector>
+
+#include <boost/detail/lightweight_test.hpp>
+
+namespace stde = std::experimental;
+
+template <class Word>
+struct fixture
+{
+  static constexpr std::size_t digits = std::numeric_limits<Word>::digits;
+  using iterator = stde::bit_iterator<Word*>;
+  using const_iterator = stde::bit_iterator<Word const*>;
+
+  std::vector<Word> words;
+
+  explicit fixture(std::size_t n, unsigned seed)
+  : words(n)
+  {
+    std::mt19937_64 gen(seed);
+    for (auto& w : words)
+      w = Word(gen());
+  }
+
+  iterator at(std::size_t pos)
+  {
+    return iterator(words.data() + pos / digits, pos % digits);
+  }
+  const_iterator cat(std::size_t pos) const
+  {
+    return const_iterator(words.data() + pos / digits, pos % digits);
+  }
+  std::vector<bool> bits() const
+  {
+    std::vector<bool> r;
+    for (auto w : words)
+      for (std::size_t i = 0; i < digits; ++i)
+        r.push_back((w >> i) & 1);
+    return r;
+  }
+};
+
+template <class Word>
+void test_read(std::size_t first, std::size_t last)
+{
+  fixture<Word> f(6, unsigned(first * 1000 + last));
+  std::vector<bool> const b = f.bits();
+  auto const bf = b.begin() + std::ptrdiff_t(first);
+  auto const bl = b.begin() + std::ptrdiff_t(last);
+
+  BOOST_TEST_EQ( count(f.cat(first), f.cat(last), stde::bit_on), std::count(bf, bl, true) );
+  BOOST_TEST_EQ( count(f.cat(first), f.cat(last), stde::bit_off), std::count(bf, bl, false) );
+  BOOST_TEST( find(f.cat(first), f.cat(last), stde::bit_on) - f.cat(0) == std::find(bf, bl, true) - b.begin() );
+  BOOST_TEST( find(f.cat(first), f.cat(last), stde::bit_off) - f.cat(0) == std::find(bf, bl, false) - b.begin() );
+  BOOST_TEST( find_first_not(f.cat(first), f.cat(last), stde::bit_on) - f.cat(0) ==
+              std::find(bf, bl, false) - b.begin() );
+
+  // a run of 0s ending at last
+  fixture<Word> z(f);
+  fill(z.at(first), z.at(last), stde::bit_off);
+  BOOST_TEST( find(z.cat(first), z.cat(last), stde::bit_on) == z.cat(last) );
+  BOOST_TEST_EQ( count(z.cat(first), z.cat(last), stde::bit_on), 0 );
+}
+
+template <class Word>
+void test_fill(std::size_t first, std::size_t last)
+{
+  for (bool v : {false, true})
+  {
+    fixture<Word> f(6, unsigned(first + last));
+    std::vector<bool> b = f.bits();
+    fill(f.at(first), f.at(last), v ? stde::bit_on : stde::bit_off);
+    std::fill(b.begin() + std::ptrdiff_t(first), b.begin() + std::ptrdiff_t(last), v);
+    BOOST_TEST( f.bits() == b );
+  }
+}
+
+template <class Word>
+void test_copy(std::size_t first, std::size_t last, std::size_t d_first)
+{
+  std::ptrdiff_t const n = std::ptrdiff_t(last - first);
+  {
+    fixture<Word> s(6, unsigned(first + 7 * last));
+    fixture<Word> d(6, unsigned(d_first));
+    std::vector<bool> const sb = s.bits();
+    std::vector<bool> db = d.bits();
+    auto r = copy(s.cat(first), s.cat(last), d.at(d_first));
+    std::copy(sb.begin() + std::ptrdiff_t(first), sb.begin() + std::ptrdiff_t(last), db.begin() + std::ptrdiff_t(d_first));
+    BOOST_TEST( d.bits() == db );
+    BOOST_TEST( r == d.at(d_first) + n );
+    BOOST_TEST( equal(s.cat(first), s.cat(last), d.cat(d_first)) );
+    if (n > 0)
+    {
+      (*d.at(d_first + std::size_t(n) - 1)).flip();
+      BOOST_TEST( ! equal(s.cat(first), s.cat(last), d.cat(d_first)) );
+    }
+  }
+  {
+    fixture<Word> s(6, unsigned(first + 7 * last));
+    fixture<Word> d(6, unsigned(d_first));
+    std::vector<bool> const sb = s.bits();
+    std::vector<bool> db = d.bits();
+    auto r = copy_backward(s.cat(first), s.cat(last), d.at(d_first) + n);
+    std::copy(sb.begin() + std::ptrdiff_t(first), sb.begin() + std::ptrdiff_t(last), db.begin() + std::ptrdiff_t(d_first));
+    BOOST_TEST( d.bits() == db );
+    BOOST_TEST( r == d.at(d_first) );
+  }
+  {
+    fixture<Word> a(6, unsigned(first + 7 * last));
+    fixture<Word> b(6, unsigned(d_first));
+    std::vector<bool> ab = a.bits();
+    std::vector<bool> bb = b.bits();
+    auto r = swap_ranges(a.at(first), a.at(last), b.at(d_first));
+    std::swap_ranges(ab.begin() + std::ptrdiff_t(first), ab.begin() + std::ptrdiff_t(last), bb.begin() + std::ptrdiff_t(d_first));
+    BOOST_TEST( a.bits() == ab );
+    BOOST_TEST( b.bits() == bb );
+    BOOST_TEST( r == b.at(d_first) + n );
+  }
+}
+
+template <class Word>
+void test_permutations(std::size_t first, std::size_t last)
+{
+  {
+    fixture<Word> f(6, unsigned(3 * first + last));
+    std::vector<bool> b = f.bits();
+    reverse(f.at(first), f.at(last));
+    std::reverse(b.begin() + std::ptrdiff_t(first), b.begin() + std::ptrdiff_t(last));
+    BOOST_TEST( f.bits() == b );
+  }
+  for (std::size_t middle = first; middle <= last; middle += 5)
+  {
+    fixture<Word> f(6, unsigned(3 * first + last));
+    std::vector<bool> b = f.bits();
+    auto r = rotate(f.at(first), f.at(middle), f.at(last));
+    std::rotate(b.begin() + std::ptrdiff_t(first), b.begin() + std::ptrdiff_t(middle), b.begin() + std::ptrdiff_t(last));
+    BOOST_TEST( f.bits() == b );
+    BOOST_TEST( r == f.at(first + (last - middle)) );
+  }
+  for (std::ptrdiff_t n : {0, 1, 7, 64, 65, 200})
+  {
+    std::ptrdiff_t const len = std::ptrdiff_t(last - first);
+    {
+      fixture<Word> f(6, unsigned(first));
+      std::vector<bool> b = f.bits();
+      auto r = shift_left(f.at(first), f.at(last), n);
+      if (n < len)
+      {
+        std::copy(b.begin() + std::ptrdiff_t(first) + n, b.begin() + std::ptrdiff_t(last), b.begin() + std::ptrdiff_t(first));
+        std::vector<bool> const fb = f.bits();
+        BOOST_TEST( std::equal(b.begin() + std::ptrdiff_t(first), b.begin() + std::ptrdiff_t(last) - n, fb.begin() + std::ptrdiff_t(first)) );
+        BOOST_TEST( r == f.at(last) - (n > 0 ? n : 0) );
+      }
+      else
+      {
+        BOOST_TEST( r == f.at(first) );
+      }
+    }
+    {
+      fixture<Word> f(6, unsigned(last));
+      std::vector<bool> b = f.bits();
+      auto r = shift_right(f.at(first), f.at(last), n);
+      if (n < len)
+      {
+        std::copy_backward(b.begin() + std::ptrdiff_t(first), b.begin() + std::ptrdiff_t(last) - n, b.begin() + std::ptrdiff_t(last));
+        std::vector<bool> const fb = f.bits();
+        BOOST_TEST( std::equal(b.begin() + std::ptrdiff_t(first) + n, b.begin() + std::ptrdiff_t(last), fb.begin() + std::ptrdiff_t(first) + n) );
+        BOOST_TEST( r == f.at(first) + (n > 0 ? n : 0) );
+      }
+      else
+      {
+        BOOST_TEST( r == f.at(last) );
+      }
+    }
+  }
+}
+
+template <class Word>
+void test_all()
+{
+  constexpr std::size_t digits = std::numeric_limits<Word>::digits;
+  std::size_t const total = 5 * digits;
+  std::size_t const step = digits / 8 + 2;
+  for (std::size_t first = 0; first <= total; first += step)
+    for (std::size_t last = first; last <= total; last += step)
+    {
+      test_read<Word>(first, last);
+      test_fill<Word>(first, last);
+      test_permutations<Word>(first, last);
+      for (std::size_t d_first = 0; d_first + (last - first) <= total; d_first += 3 * step)
+        test_copy<Word>(first, last, d_first);
+    }
+}
+
+int main()
+{
+  test_all<std::uint8_t>();
+  test_all<std::uint32_t>();
+  test_all<std::uint64_t>();
+
+  { // overlapping copies move the bits like the shifts
+    fixture<std::uint64_t> f(4, 1);
+    std::vector<bool> b = f.bits();
+    copy(f.at(70), f.at(250), f.at(3));
+    std::copy(b.begin() + 70, b.begin() + 250, b.begin() + 3);
+    BOOST_TEST( f.bits() == b );
+    copy_backward(f.at(3), f.at(200), f.at(255));
+    std::copy_backward(b.begin() + 3, b.begin() + 200, b.begin() + 255);
+    BOOST_TEST( f.bits() == b );
+  }
+  { // the underlying iterators need only be forward ones
+    std::list<std::uint8_t> l(4, 0);
+    using iterator = stde::bit_iterator<std::list<std::uint8_t>::iterator>;
+    fill(iterator(l.begin(), 3), iterator(std::next(l.begin(), 3), 2), stde::bit_on);
+    BOOST_TEST_EQ( count(iterator(l.begin()), iterator(l.end()), stde::bit_on), 23 );
+    BOOST_TEST( find(iterator(l.begin()), iterator(l.end()), stde::bit_on) == iterator(l.begin(), 3) );
+    reverse(iterator(l.begin()), iterator(l.end()));
+    BOOST_TEST_EQ( int(l.back()), 0x1F );
+  }
+  { // the algorithms don't hide the standard ones used unqualified by the library
+    stde::static_vector<int, 3> v{1, 2};
+    v.insert(v.begin(), 0);
+    BOOST_TEST( v == (stde::static_vector<int, 3>{0, 1, 2}) );
+  }
+  return ::boost::report_errors();
+}
@@ -0,0 +1,181 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <experimental/bit_mask.hpp>
+
+// bit_mask stored in several blocks
+
+#include <experimental/bit_mask.hpp>
+#include <cstdint>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/detail/lightweight_test.hpp>
+
+namespace stde = std::experimental;
+
+template <class BitMask>
+std::vector<std::size_t> positions(BitMask const& bm)
+{
+  std::vector<std::size_t> r;
+  for (std::size_t pos = bm.find_first(); pos < bm.size(); pos = bm.find_next(pos))
+    r.push_back(pos);
+  return r;
+}
+
+template <class BitMask>
+void test_blocks()
+{
+  using Block = typename BitMask::block_type;
+  constexpr std::size_t N = BitMask{}.size();
+  constexpr std::size_t digits = std::numeric_limits<Block>::digits;
+
+  static_assert(sizeof(BitMask) == BitMask::block_count * sizeof(Block), "Bad sizeof");
+  static_assert(alignof(BitMask) == alignof(Block), "Bad alignof");
+  static_assert(BitMask::block_count == (N + digits - 1) / digits, "Bad block_count");
+
+  {
+    BitMask bm{};
+    BOOST_TEST( bm.none() );
+    BOOST_TEST( ! bm.any() );
+    BOOST_TEST_EQ( bm.find_first(), N );
+    BOOST_TEST( bm.set_bits().begin() == bm.set_bits().end() );
+    bm.set(0);
+    bm.set(digits - 1);
+    bm.set(digits);
+    bm.set(N - 1);
+    BOOST_TEST_EQ( bm.count(), 4u );
+    BOOST_TEST( bm.any() );
+    BOOST_TEST( ! bm.all() );
+    BOOST_TEST( bm.test(digits) );
+    BOOST_TEST( ! bm.test(digits + 1) );
+    BOOST_TEST( bm[N - 1] );
+    BOOST_TEST_THROWS( bm.set(N), std::out_of_range );
+    std::vector<std::size_t> expected{0, digits - 1, digits, N - 1};
+    BOOST_TEST( positions(bm) == expected );
+    std::vector<std::size_t> visited;
+    bm.for_each_set([&](std::size_t pos) { visited.push_back(pos); });
+    BOOST_TEST( visited == expected );
+    BOOST_TEST( std::vector<std::size_t>(bm.set_bits().begin(), bm.set_bits().end()) == expected );
+    BOOST_TEST_EQ( bm.find_next(N - 1), N );
+
+    bm[digits] = stde::bit_off;
+    bm.flip(N - 2);
+    expected = {0, digits - 1, N - 2, N - 1};
+    BOOST_TEST( positions(bm) == expected );
+    bm.reset(0);
+    BOOST_TEST_EQ( bm.find_first(), digits - 1 );
+  }
+  { // set, flip and ~ keep the bits beyond N to zero
+    BitMask bm{};
+    bm.set();
+    BOOST_TEST( bm.all() );
+    BOOST_TEST_EQ( bm.count(), N );
+    BOOST_TEST( (~bm).none() );
+    bm.flip();
+    BOOST_TEST( bm.none() );
+    BOOST_TEST( BitMask(stde::fill_tag_t{}, true) == ~bm );
+    BOOST_TEST_EQ( BitMask(stde::fill_tag_t{}, true).count(), N );
+  }
+  { // &=, |=, ^=
+    BitMask a(stde::pos_tag_t{}, 1);
+    BitMask b(stde::pos_tag_t{}, N - 1);
+    BitMask c = a | b;
+    BOOST_TEST_EQ( c.count(), 2u );
+    BOOST_TEST( (c & a) == a );
+    BOOST_TEST( (c ^ a) == b );
+    BOOST_TEST( (a & b).none() );
+    c ^= c;
+    BOOST_TEST( c.none() );
+  }
+  { // shifts across the blocks
+    BitMask bm(stde::pos_tag_t{}, 1);
+    bm.set(digits - 1);
+    BitMask l = bm << (digits + 3);
+    std::vector<std::size_t> expected{digits + 4, 2 * digits + 2};
+    BOOST_TEST( positions(l) == expected );
+    BOOST_TEST( (l >> (digits + 3)) == bm );
+    BOOST_TEST( (bm << (N - 2)) == BitMask(stde::pos_tag_t{}, N - 1) );
+    BOOST_TEST( (bm << N).none() );
+    BOOST_TEST( (BitMask(stde::pos_tag_t{}, N - 1) >> (N - 1)) == BitMask(stde::pos_tag_t{}, 0) );
+    BOOST_TEST( (bm >> N).none() );
+
+    BitMask all(stde::fill_tag_t{}, true);
+    BOOST_TEST_EQ( (all << 5).count(), N - 5 );
+    BOOST_TEST_EQ( (all >> 5).count(), N - 5 );
+    BOOST_TEST( ! (all >> 5)[N - 5] );
+    BOOST_TEST( (all >> 5)[N - 6] );
+  }
+  { // equality and hash see all the blocks
+    BitMask a(stde::pos_tag_t{}, N - 1);
+    BitMask b(stde::pos_tag_t{}, N - 2);
+    BOOST_TEST( a != b );
+    BOOST_TEST( a == BitMask(stde::pos_tag_t{}, N - 1) );
+    std::hash<BitMask> h;
+    BOOST_TEST( h(a) == h(BitMask(stde::pos_tag_t{}, N - 1)) );
+    BOOST_TEST( h(a) != h(b) );
+  }
+  { // conversions
+    BitMask bm(stde::mask_tag_t{}, Block(5));
+    BOOST_TEST_EQ( bm.to_ullong(), 5u );
+    BOOST_TEST_EQ( bm.to_integer(), Block(5) );
+    bm.set(N - 1);
+    BOOST_TEST_THROWS( bm.to_integer(), std::overflow_error );
+    BOOST_TEST_THROWS( bm.to_ullong(), std::overflow_error );
+    BOOST_TEST_THROWS( bm.to_ulong(), std::overflow_error );
+  }
+}
+
+int main()
+{
+  test_blocks<stde::bit_mask<256, std::uint64_t>>();
+  test_blocks<stde::bit_mask<4096, std::uint64_t>>();
+  test_blocks<stde::bit_mask<200, std::uint64_t>>();
+  test_blocks<stde::bit_mask<100, std::uint8_t>>();
+  test_blocks<stde::bit_mask<70, std::uint32_t>>();
+
+  { // the bits of several blocks can be converted while they fit
+    stde::bit_mask<24, std::uint8_t> bm{};
+    bm.set(0);
+    bm.set(17);
+    BOOST_TEST_EQ( bm.to_ulong(), 0x20001ul );
+    BOOST_TEST_EQ( bm.to_ullong(), 0x20001ull );
+  }
+  { // a block can be used completely
+    stde::bit_mask<64, std::uint64_t> bm(stde::fill_tag_t{}, true);
+    BOOST_TEST_EQ( bm.count(), 64u );
+    std::size_t expected = 0;
+    for (std::size_t pos : bm.set_bits())
+      BOOST_TEST_EQ( pos, expected++ );
+    BOOST_TEST_EQ( expected, 64u );
+    BOOST_TEST( bm.all() );
+    BOOST_TEST_EQ( (bm << 63).find_first(), 63u );
+  }
+  { // the blocks are written from the most significant bit
+    stde::bit_mask<70, std::uint32_t> bm(stde::pos_tag_t{}, 68);
+    bm.set(1);
+    std::ostringstream os;
+    os << bm;
+    BOOST_TEST_EQ( os.str(), "01" + std::string(66, '0') + "10" );
+  }
+#if __cplusplus >= 201402L
+  {
+    using BitMask = stde::bit_mask<256, std::uint64_t>;
+    constexpr BitMask bm(stde::pos_tag_t{}, 130);
+    static_assert( bm.count() == 1, "" );
+    static_assert( bm.any(), "" );
+    static_assert( bm[130], "" );
+    static_assert( bm.find_first() == 130, "" );
+    static_assert( *bm.set_bits().begin() == 130, "" );
+    static_assert( bm != BitMask{}, "" );
+    static_assert( (bm << 100) == BitMask(stde::pos_tag_t{}, 230), "" );
+    static_assert( (~BitMask{}).all(), "" );
+  }
+#endif
+  return ::boost::report_errors();
+}
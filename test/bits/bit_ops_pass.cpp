@@ -0,0 +1,113 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <experimental/bit_ops.hpp>
+
+// The bit scans and popcount for all the widths, and the bulk popcounts with each of the kernels the CPU supports.
+
+#include <experimental/bit_ops.hpp>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <boost/detail/lightweight_test.hpp>
+
+namespace bit_ops = std::experimental::bit_ops;
+
+template <class T>
+void test_scans()
+{
+  constexpr int digits = std::numeric_limits<T>::digits;
+  BOOST_TEST_EQ( bit_ops::countl_zero(T(0)), digits );
+  BOOST_TEST_EQ( bit_ops::countr_zero(T(0)), digits );
+  BOOST_TEST_EQ( bit_ops::countl_one(T(~T(0))), digits );
+  BOOST_TEST_EQ( bit_ops::countr_one(T(~T(0))), digits );
+  BOOST_TEST_EQ( bit_ops::popcount(T(~T(0))), digits );
+  for (int i = 0; i < digits; ++i)
+  {
+    T const x = T(T(1) << i);
+    BOOST_TEST_EQ( bit_ops::countl_zero(x), digits - 1 - i );
+    BOOST_TEST_EQ( bit_ops::countr_zero(x), i );
+    BOOST_TEST_EQ( bit_ops::countl_one(T(~x)), digits - 1 - i );
+    BOOST_TEST_EQ( bit_ops::countr_one(T(~x)), i );
+    BOOST_TEST_EQ( bit_ops::popcount(T(x | 1u)), i == 0 ? 1 : 2 );
+  }
+}
+
+std::size_t naive_popcount(std::uint64_t x)
+{
+  std::size_t r = 0;
+  for (; x != 0; x &= x - 1)
+    ++r;
+  return r;
+}
+
+void test_bulk(std::size_t n)
+{
+  using namespace bit_ops::popcount_detail;
+  std::mt19937_64 gen(n);
+  std::vector<std::uint64_t> a(n), b(n);
+  for (auto& w : a)
+    w = gen();
+  for (auto& w : b)
+    w = gen();
+  if (n > 2)
+  {
+    a[1] = ~std::uint64_t(0);
+    b[1] = ~std::uint64_t(0);
+  }
+  std::size_t count = 0, count_and = 0, count_xor = 0;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    count += naive_popcount(a[i]);
+    count_and += naive_popcount(a[i] & b[i]);
+    count_xor += naive_popcount(a[i] ^ b[i]);
+  }
+
+  BOOST_TEST_EQ( bit_ops::popcount(a), count );
+  BOOST_TEST_EQ( bit_ops::popcount_and(a, b), count_and );
+  BOOST_TEST_EQ( bit_ops::popcount_xor(a, b), count_xor );
+  BOOST_TEST_EQ( bit_ops::popcount_xor(a, a), 0u );
+  BOOST_TEST_EQ( bit_ops::popcount_and(a, a), count );
+
+  for (kernel k : {kernel::scalar, kernel::popcnt, kernel::avx2, kernel::avx512})
+  {
+    if (! supported(k))
+      continue;
+    BOOST_TEST_EQ( select<op::first>(k)(a.data(), a.data(), n), count );
+    BOOST_TEST_EQ( select<op::and_>(k)(a.data(), b.data(), n), count_and );
+    BOOST_TEST_EQ( select<op::xor_>(k)(a.data(), b.data(), n), count_xor );
+  }
+}
+
+int main()
+{
+  test_scans<unsigned char>();
+  test_scans<unsigned short>();
+  test_scans<unsigned>();
+  test_scans<unsigned long>();
+  test_scans<unsigned long long>();
+  {
+    static_assert( bit_ops::countl_zero(std::uint8_t(1)) == 7, "" );
+    static_assert( bit_ops::countr_zero(std::uint64_t(1) << 40) == 40, "" );
+    static_assert( bit_ops::popcount(~std::uint64_t(0)) == 64, "" );
+  }
+  // the Harley-Seal loop works on 64 words, the tails on vectors of 4 or 8 words, and then on words
+  for (std::size_t n : {0, 1, 3, 4, 7, 8, 9, 63, 64, 65, 100, 128, 200, 1000, 4099})
+    test_bulk(n);
+  { // the all ones and all zeros words
+    std::vector<std::uint64_t> ones(1000, ~std::uint64_t(0));
+    std::vector<std::uint64_t> zeros(1000, 0);
+    BOOST_TEST_EQ( bit_ops::popcount(ones), 64000u );
+    BOOST_TEST_EQ( bit_ops::popcount(zeros), 0u );
+    BOOST_TEST_EQ( bit_ops::popcount_xor(ones, zeros), 64000u );
+    BOOST_TEST_EQ( bit_ops::popcount_and(ones, zeros), 0u );
+  }
+  { // a subspan
+    std::vector<std::uint64_t> v{1, 3, 7, 15};
+    BOOST_TEST_EQ( bit_ops::popcount(std::experimental::span<std::uint64_t const>(v).subspan(1, 2)), 5u );
+  }
+  return ::boost::report_errors();
+}
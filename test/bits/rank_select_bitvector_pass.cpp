@@ -0,0 +1,98 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <experimental/rank_select_bitvector.hpp>
+
+// The ranks and selects are checked against a scan of the bits, for several densities and sizes crossing the blocks
+// and the superblocks.
+
+#include <experimental/rank_select_bitvector.hpp>
+#include <experimental/bit.hpp>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <boost/detail/lightweight_test.hpp>
+
+namespace stde = std::experimental;
+
+// Returns n bits, each one set with the probability 1/one_in (or all set if one_in == 1, none if one_in == 0), and
+// some garbage past n in the last word.
+std::vector<std::uint64_t> make_words(std::size_t n, unsigned one_in, unsigned seed)
+{
+  std::vector<std::uint64_t> words((n + 63) / 64);
+  std::mt19937_64 gen(seed);
+  for (std::size_t i = 0; i < n; ++i)
+    if (one_in != 0 && gen() % one_in == 0)
+      words[i / 64] |= std::uint64_t(1) << (i % 64);
+  if (n % 64 != 0)
+    words.back() |= std::uint64_t(0xA5A5A5A5A5A5A5A5ULL) << (n % 64);
+  return words;
+}
+
+void test(std::size_t n, unsigned one_in, unsigned seed)
+{
+  std::vector<std::uint64_t> const words = make_words(n, one_in, seed);
+  stde::rank_select_bitvector const rs(words, n);
+  BOOST_TEST_EQ( rs.size(), n );
+
+  std::vector<std::size_t> ones, zeros;
+  std::size_t rank = 0;
+  bool ranks_ok = true;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    ranks_ok = ranks_ok && rs.rank1(i) == rank && rs.rank0(i) == i - rank;
+    bool const b = (words[i / 64] >> (i % 64)) & 1;
+    ranks_ok = ranks_ok && rs[i] == b;
+    (b ? ones : zeros).push_back(i);
+    rank += b;
+  }
+  BOOST_TEST( ranks_ok );
+  BOOST_TEST_EQ( rs.rank1(n), rank );
+  BOOST_TEST_EQ( rs.rank0(n), n - rank );
+  BOOST_TEST_EQ( rs.count(), ones.size() );
+
+  bool selects_ok = true;
+  for (std::size_t k = 0; k < ones.size(); ++k)
+    selects_ok = selects_ok && rs.select1(k) == ones[k];
+  for (std::size_t k = 0; k < zeros.size(); ++k)
+    selects_ok = selects_ok && rs.select0(k) == zeros[k];
+  BOOST_TEST( selects_ok );
+  if (! selects_ok)
+    std::printf("n=%zu one_in=%u\n", n, one_in);
+}
+
+int main()
+{
+  for (std::size_t n : {0, 1, 63, 64, 65, 511, 512, 513, 5000, 65535, 65536, 65537, 300000})
+    for (unsigned one_in : {0, 1, 2, 7, 1000})
+      test(n, one_in, unsigned(n + one_in));
+  // the samples of the sparse bits are far apart, the dense ones cross the superblocks
+  test(2000000, 5000, 1);
+  test(2000000, 1, 2);
+  {
+    std::vector<std::uint64_t> const words = make_words(1000, 3, 4);
+    stde::rank_select_bitvector const a(words, 1000);
+    stde::rank_select_bitvector const b(stde::bit_iterator<std::uint64_t const*>(words.data()),
+                                        stde::bit_iterator<std::uint64_t const*>(words.data()) + 1000);
+    BOOST_TEST_EQ( b.size(), 1000u );
+    BOOST_TEST_EQ( b.count(), a.count() );
+    BOOST_TEST_EQ( b.select1(100), a.select1(100) );
+    BOOST_TEST_EQ( b.words().size(), 16 );
+  }
+  {
+    stde::rank_select_bitvector const rs;
+    BOOST_TEST( rs.empty() );
+    BOOST_TEST_EQ( rs.rank1(0), 0u );
+    BOOST_TEST_EQ( rs.count(), 0u );
+  }
+  { // the directory takes about 4% of the bits
+    std::vector<std::uint64_t> const words = make_words(1 << 24, 2, 5);
+    stde::rank_select_bitvector const rs(words);
+    double const overhead = double(rs.directory_bytes()) / double(words.size() * sizeof(std::uint64_t));
+    BOOST_TEST( overhead > 0.03 && overhead < 0.06 );
+  }
+  return ::boost::report_errors();
+}
@@ -0,0 +1,266 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <experimental/roaring_bitmap.hpp>
+
+// The sets are checked against std::set, mixing chunks stored as arrays, bitmaps and runs.
+
+#include <experimental/roaring_bitmap.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/detail/lightweight_test.hpp>
+
+namespace stde = std::experimental;
+using reference = std::set<std::uint32_t>;
+
+// A set having, for each of its chunks, a few values, many values or long sequences of consecutive values.
+reference make_values(unsigned seed)
+{
+  std::mt19937 gen(seed);
+  reference r;
+  for (std::uint32_t key : {0u, 1u, 7u, 0xFFFFu})
+  {
+    std::uint32_t const base = key << 16;
+    switch (gen() % 4)
+    {
+    case 0: // array
+      for (int i = 0; i < 100; ++i)
+        r.insert(base + gen() % 65536);
+      break;
+    case 1: // bitmap
+      for (int i = 0; i < 20000; ++i)
+        r.insert(base + gen() % 65536);
+      break;
+    case 2: // runs
+      for (int i = 0; i < 5; ++i)
+      {
+        std::uint32_t const first = gen() % 60000;
+        for (std::uint32_t x = first; x < first + gen() % 5000; ++x)
+          r.insert(base + x);
+      }
+      break;
+    default: // empty
+      break;
+    }
+  }
+  return r;
+}
+
+void check(stde::roaring_bitmap const& b, reference const& r)
+{
+  BOOST_TEST_EQ( b.count(), r.size() );
+  BOOST_TEST_EQ( b.empty(), r.empty() );
+  BOOST_TEST( std::equal(b.begin(), b.end(), r.begin()) && std::distance(b.begin(), b.end()) == std::ptrdiff_t(r.size()) );
+  std::vector<std::uint32_t> v;
+  b.for_each([&](std::uint32_t x) { v.push_back(x); });
+  BOOST_TEST( std::equal(v.begin(), v.end(), r.begin()) && v.size() == r.size() );
+  bool ok = true;
+  for (std::uint32_t x : r)
+    ok = ok && b.contains(x) && b.contains(x + 70000) == (r.count(x + 70000) != 0);
+  for (std::uint32_t x : {0u, 65535u, 65536u, 0xFFFFFFFFu})
+    ok = ok && b.contains(x) == (r.count(x) != 0);
+  BOOST_TEST( ok );
+}
+
+template <class Op>
+reference apply(reference const& x, reference const& y, Op op)
+{
+  reference r;
+  op(x.begin(), x.end(), y.begin(), y.end(), std::inserter(r, r.end()));
+  return r;
+}
+
+void test_operations(unsigned seed, bool optimize_x, bool optimize_y)
+{
+  reference const rx = make_values(seed);
+  reference const ry = make_values(seed + 1000);
+  stde::roaring_bitmap x(rx.begin(), rx.end());
+  stde::roaring_bitmap y(ry.begin(), ry.end());
+  if (optimize_x) x.run_optimize();
+  if (optimize_y) y.run_optimize();
+  check(x, rx);
+  check(y, ry);
+  using It = reference::const_iterator;
+  using Out = std::insert_iterator<reference>;
+  check(x & y, apply(rx, ry, std::set_intersection<It, It, Out>));
+  check(x | y, apply(rx, ry, std::set_union<It, It, Out>));
+  check(x ^ y, apply(rx, ry, std::set_symmetric_difference<It, It, Out>));
+  check(x - y, apply(rx, ry, std::set_difference<It, It, Out>));
+  check(y - x, apply(ry, rx, std::set_difference<It, It, Out>));
+  stde::roaring_bitmap z = x;
+  z |= y;
+  z -= y;
+  BOOST_TEST( z == x - y );
+  z ^= z;
+  BOOST_TEST( z.empty() );
+
+  // serialization
+  std::vector<std::uint64_t> buffer((x.serialized_size() + 7) / 8);
+  stde::span<char> bytes(reinterpret_cast<char*>(buffer.data()), std::ptrdiff_t(x.serialized_size()));
+  BOOST_TEST_EQ( x.serialize(bytes), x.serialized_size() );
+  stde::roaring_bitmap const d = stde::roaring_bitmap::deserialize(bytes);
+  check(d, rx);
+  BOOST_TEST( d == x );
+  stde::roaring_view const view(bytes);
+  BOOST_TEST_EQ( view.count(), rx.size() );
+  bool ok = true;
+  for (std::uint32_t v : rx)
+    ok = ok && view.contains(v) && view.contains(v + 70000) == (rx.count(v + 70000) != 0);
+  BOOST_TEST( ok );
+  BOOST_TEST( stde::roaring_bitmap(view) == x );
+}
+
+// The serialization of a bitmap of one chunk, whose descriptor and payload can be altered.
+struct serialized
+{
+  std::vector<std::uint64_t> buffer;
+  std::size_t size;
+
+  explicit serialized(stde::roaring_bitmap const& b)
+    : buffer((b.serialized_size() + 7) / 8), size(b.serialized_size())
+  {
+    b.serialize(stde::span<char>(data(), std::ptrdiff_t(size)));
+  }
+  char* data() { return reinterpret_cast<char*>(buffer.data()); }
+  stde::span<char const> bytes() { return stde::span<char const>(data(), std::ptrdiff_t(size)); }
+  void set_card(std::uint32_t card) { std::memcpy(data() + 8 + 4, &card, sizeof(card)); }
+  //! Overwrites the uint16_t i of the payload.
+  void set_value(std::size_t i, std::uint16_t v)
+  {
+    std::uint32_t offset;
+    std::memcpy(&offset, data() + 8 + 12, sizeof(offset));
+    std::memcpy(data() + offset + 2 * i, &v, sizeof(v));
+  }
+  bool rejected()
+  {
+    bool deserialize = false, view = false;
+    try { stde::roaring_bitmap::deserialize(bytes()); } catch (std::invalid_argument const&) { deserialize = true; }
+    try { stde::roaring_view v(bytes()); } catch (std::invalid_argument const&) { view = true; }
+    return deserialize && view;
+  }
+};
+
+stde::roaring_bitmap make_range(std::uint32_t first, std::uint32_t last)
+{
+  stde::roaring_bitmap b;
+  for (std::uint32_t x = first; x != last; ++x)
+    b.add(x);
+  return b;
+}
+
+int main()
+{
+  for (unsigned seed = 0; seed < 6; ++seed)
+  {
+    test_operations(seed, false, false);
+    test_operations(seed, true, false);
+    test_operations(seed, true, true);
+  }
+  { // add and remove through the representations
+    stde::roaring_bitmap b{1, 2, 3};
+    reference r{1, 2, 3};
+    BOOST_TEST( ! b.add(2) );
+    for (std::uint32_t x = 10; x < 10000; ++x)
+    {
+      b.add(x);
+      r.insert(x);
+    }
+    check(b, r);
+    BOOST_TEST( b.run_optimize() );
+    BOOST_TEST_EQ( b.serialized_size(), 8u + 16u + 8u );
+    check(b, r);
+    BOOST_TEST( b.add(5) );
+    r.insert(5);
+    check(b, r);
+    for (std::uint32_t x = 10; x < 9000; ++x)
+    {
+      b.remove(x);
+      r.erase(x);
+    }
+    BOOST_TEST( ! b.remove(100) );
+    check(b, r);
+    for (std::uint32_t x : reference(r))
+      BOOST_TEST( b.remove(x) );
+    BOOST_TEST( b.empty() );
+  }
+  { // a sparse chunk takes 2 bytes by value, plus its descriptor
+    stde::roaring_bitmap b;
+    std::mt19937 gen(3);
+    for (int i = 0; i < 100000; ++i)
+      b.add(std::uint32_t(gen() % (1u << 24)));
+    BOOST_TEST( b.serialized_size() <= 8 + 256 * (16 + 8) + 2 * b.count() );
+  }
+  { // bad serializations are rejected
+    std::uint64_t buffer[4] = {};
+    stde::span<char const> bytes(reinterpret_cast<char const*>(buffer), 32);
+    BOOST_TEST_THROWS( stde::roaring_bitmap::deserialize(bytes), std::invalid_argument );
+    stde::roaring_bitmap b{1, 70000};
+    std::vector<std::uint64_t> good((b.serialized_size() + 7) / 8);
+    stde::span<char> out(reinterpret_cast<char*>(good.data()), std::ptrdiff_t(b.serialized_size()));
+    b.serialize(out);
+    BOOST_TEST_THROWS( stde::roaring_view(out.first(20)), std::invalid_argument );
+    BOOST_TEST( stde::roaring_view(out).contains(70000) );
+  }
+  { // the payloads are checked too
+    serialized array(stde::roaring_bitmap{1, 2, 3});
+    BOOST_TEST( ! array.rejected() );
+    array.set_value(1, 7);
+    BOOST_TEST( array.rejected() ); // not increasing
+    array.set_value(1, 1);
+    BOOST_TEST( array.rejected() ); // duplicated
+
+    stde::roaring_bitmap sparse;
+    for (std::uint32_t x = 0; x < 10000; x += 2)
+      sparse.add(x);
+    serialized bitmap(sparse);
+    BOOST_TEST( ! bitmap.rejected() );
+    bitmap.set_card(4999);
+    BOOST_TEST( bitmap.rejected() ); // card mismatch
+    bitmap.set_card(5000);
+    for (std::size_t i = 0; i < 4 * 1024; ++i)
+      bitmap.set_value(i, 0);
+    BOOST_TEST( bitmap.rejected() ); // no bit set
+
+    stde::roaring_bitmap two = make_range(0, 100) | make_range(200, 300);
+    BOOST_TEST( two.run_optimize() );
+    serialized runs(two);
+    BOOST_TEST( ! runs.rejected() );
+    runs.set_value(2, 50);
+    BOOST_TEST( runs.rejected() ); // overlapping
+    runs.set_value(2, 100);
+    BOOST_TEST( ! runs.rejected() ); // adjacent
+    runs.set_value(0, 150);
+    BOOST_TEST( runs.rejected() ); // unordered
+    runs.set_value(0, 0);
+    runs.set_card(201);
+    BOOST_TEST( runs.rejected() ); // card mismatch
+
+    stde::roaring_bitmap one = make_range(10, 10010);
+    BOOST_TEST( one.run_optimize() );
+    serialized range(one);
+    range.set_value(0, 65000);
+    range.set_value(1, 4999);
+    range.set_card(5000);
+    BOOST_TEST( range.rejected() ); // past the chunk
+    range.set_value(0, 60536);
+    BOOST_TEST( ! range.rejected() );
+    stde::roaring_bitmap d = stde::roaring_bitmap::deserialize(range.bytes());
+    BOOST_TEST( d.add(3) );
+    BOOST_TEST_EQ( d.count(), 5001u );
+
+    serialized truncated(stde::roaring_bitmap{1, 2, 3});
+    truncated.size -= 2;
+    BOOST_TEST( truncated.rejected() );
+  }
+  return ::boost::report_errors();
+}
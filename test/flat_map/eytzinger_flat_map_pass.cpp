@@ -0,0 +1,176 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <experimental/flat_map.hpp>
+
+#include <experimental/flat_map.hpp>
+#include <string>
+
+#include <boost/detail/lightweight_test.hpp>
+
+namespace stdex = std::experimental;
+
+struct string_less
+{
+	using is_transparent = void;
+	bool operator()(std::string const &x, std::string const &y) const { return x < y; }
+	bool operator()(std::string const &x, char const *y) const { return x.compare(y) < 0; }
+	bool operator()(char const *x, std::string const &y) const { return y.compare(x) > 0; }
+};
+
+// Compares a char with the first character of the strings, so that it can be equivalent to several keys.
+struct prefix_less
+{
+	using is_transparent = void;
+	bool operator()(std::string const &x, std::string const &y) const { return x < y; }
+	bool operator()(std::string const &x, char y) const { return x.empty() || x[0] < y; }
+	bool operator()(char x, std::string const &y) const { return !y.empty() && x < y[0]; }
+};
+
+// Checks the lookups of an eytzinger_flat_map built from the keys 0, 2, ..., 2 * (n - 1) against the sorted flat_map.
+void check_size(int n)
+{
+	stdex::flat_map<int, int> m;
+	for (int i = 0; i < n; ++i)
+		m.emplace(2 * i, i);
+	stdex::eytzinger_flat_map<int, int> const e(m);
+	BOOST_TEST(e.size() == m.size());
+	BOOST_TEST(e.empty() == (n == 0));
+
+	// in-order iteration, both directions
+	int i = 0;
+	for (auto it = e.begin(); it != e.end(); ++it, ++i)
+	{
+		BOOST_TEST((*it).first == 2 * i);
+		BOOST_TEST(it->second == i);
+		BOOST_TEST(e.keys()[it.index()] == 2 * i);
+	}
+	BOOST_TEST(i == n);
+	for (auto it = e.rbegin(); it != e.rend(); ++it)
+		BOOST_TEST((*it).first == 2 * --i);
+	BOOST_TEST(i == 0);
+
+	for (int x = -1; x <= 2 * n; ++x)
+	{
+		auto lb = e.lower_bound(x);
+		auto ub = e.upper_bound(x);
+		auto mlb = m.lower_bound(x);
+		auto mub = m.upper_bound(x);
+		BOOST_TEST((lb == e.end()) == (mlb == m.end()));
+		BOOST_TEST((ub == e.end()) == (mub == m.end()));
+		if (lb != e.end() && mlb != m.end())
+			BOOST_TEST((*lb).first == (*mlb).first);
+		if (ub != e.end() && mub != m.end())
+			BOOST_TEST((*ub).first == (*mub).first);
+		BOOST_TEST(e.contains(x) == m.contains(x));
+		BOOST_TEST(e.count(x) == m.count(x));
+		auto rng = e.equal_range(x);
+		BOOST_TEST(rng.first == lb);
+		BOOST_TEST(rng.second == ub);
+		if (e.contains(x))
+		{
+			BOOST_TEST(e.find(x) == lb);
+			BOOST_TEST(e.at(x) == x / 2);
+		}
+		else
+			BOOST_TEST(e.find(x) == e.end());
+	}
+}
+
+int main()
+{
+	{
+		for (int n = 0; n < 70; ++n)
+			check_size(n);
+		check_size(1000);
+	}
+	{
+		stdex::eytzinger_flat_map<int, int> e;
+		BOOST_TEST(e.empty());
+		BOOST_TEST(e.begin() == e.end());
+		BOOST_TEST(e.find(1) == e.end());
+	}
+	{
+		// built from a moved flat_map, values are mutable
+		stdex::flat_map<int, std::string> m({3, 1, 2}, {"c", "a", "b"});
+		stdex::eytzinger_flat_map<int, std::string> e(std::move(m));
+		BOOST_TEST(e.size() == 3);
+		BOOST_TEST(e.keys()[0] == 2);
+		e.find(3)->second = "C";
+		e.at(1) += "A";
+		stdex::eytzinger_flat_map<int, std::string>::const_iterator cit = e.find(3);
+		BOOST_TEST(cit->second == "C");
+
+		// extract restores the sorted order
+		auto c = std::move(e).extract();
+		BOOST_TEST(e.empty());
+		BOOST_TEST((c.keys == std::vector<int>{1, 2, 3}));
+		BOOST_TEST((c.values == std::vector<std::string>{"aA", "b", "C"}));
+	}
+	{
+		// built from extracted containers
+		stdex::eytzinger_flat_map<int, int> e(stdex::sorted_unique_t{}, {1, 2, 3, 4, 5}, {10, 20, 30, 40, 50});
+		BOOST_TEST((e.keys() == std::vector<int>{4, 2, 5, 1, 3}));
+		BOOST_TEST((e.values() == std::vector<int>{40, 20, 50, 10, 30}));
+		auto m = std::move(e).to_flat_map();
+		BOOST_TEST(m.size() == 5);
+		BOOST_TEST((m.keys() == std::vector<int>{1, 2, 3, 4, 5}));
+		BOOST_TEST(m.at(3) == 30);
+	}
+	{
+		bool thrown = false;
+		stdex::eytzinger_flat_map<int, int> e(stdex::sorted_unique_t{}, {1}, {10});
+		try
+		{
+			e.at(2);
+		}
+		catch (std::out_of_range const &)
+		{
+			thrown = true;
+		}
+		BOOST_TEST(thrown);
+	}
+	{
+		// transparent comparator
+		stdex::flat_map<std::string, int, string_less> m({"a", "b", "c"}, {1, 2, 3});
+		stdex::eytzinger_flat_map<std::string, int, string_less> e(m);
+		BOOST_TEST(e.contains("b"));
+		BOOST_TEST(!e.contains("bb"));
+		BOOST_TEST(e.find("c")->second == 3);
+		BOOST_TEST(e.lower_bound("bb")->first == "c");
+	}
+	{
+		// a heterogeneous key equivalent to several keys
+		for (int n = 0; n < 12; ++n)
+		{
+			// n keys "a0", "a1", ... between "0" and "b"
+			stdex::flat_map<std::string, int, prefix_less> m;
+			m["0"] = -1;
+			m["b"] = -2;
+			for (int i = 0; i < n; ++i)
+				m[std::string("a") + char('0' + i)] = i;
+			stdex::eytzinger_flat_map<std::string, int, prefix_less> e(m);
+			BOOST_TEST(e.count('a') == std::size_t(n));
+			BOOST_TEST(e.count('b') == 1);
+			BOOST_TEST(e.count('c') == 0);
+			auto rng = e.equal_range('a');
+			BOOST_TEST(rng.first == e.lower_bound('a'));
+			BOOST_TEST(rng.second == e.find("b"));
+			int i = 0;
+			for (auto it = rng.first; it != rng.second; ++it, ++i)
+				BOOST_TEST(it->second == i);
+			BOOST_TEST(i == n);
+		}
+	}
+	{
+		// greater comparator
+		stdex::flat_map<int, int, std::greater<int>> m({1, 2, 3, 4}, {1, 2, 3, 4});
+		stdex::eytzinger_flat_map<int, int, std::greater<int>> e(m);
+		BOOST_TEST(e.begin()->first == 4);
+		BOOST_TEST(e.lower_bound(5)->first == 4);
+		BOOST_TEST(e.upper_bound(2)->first == 1);
+	}
+	return ::boost::report_errors();
+}
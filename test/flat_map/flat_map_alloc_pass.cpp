@@ -0,0 +1,198 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <experimental/flat_map.hpp>
+
+#include <experimental/flat_map.hpp>
+#include <experimental/flat_set.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#define JASEL_TEST_PMR
+#endif
+#endif
+
+#include <boost/detail/lightweight_test.hpp>
+
+namespace stdex = std::experimental;
+
+// A stateful allocator counting the allocations done through it.
+template <class T>
+struct counting_allocator
+{
+	using value_type = T;
+
+	int *count;
+
+	explicit counting_allocator(int *c)
+	        : count(c)
+	{
+	}
+	template <class U>
+	counting_allocator(counting_allocator<U> const &a)
+	        : count(a.count)
+	{
+	}
+	T *allocate(std::size_t n)
+	{
+		++*count;
+		return std::allocator<T>().allocate(n);
+	}
+	void deallocate(T *p, std::size_t n)
+	{
+		std::allocator<T>().deallocate(p, n);
+	}
+};
+template <class T, class U>
+bool operator==(counting_allocator<T> const &x, counting_allocator<U> const &y)
+{
+	return x.count == y.count;
+}
+template <class T, class U>
+bool operator!=(counting_allocator<T> const &x, counting_allocator<U> const &y)
+{
+	return !(x == y);
+}
+
+using key_container    = std::vector<int, counting_allocator<int>>;
+using mapped_container = std::vector<std::string, counting_allocator<std::string>>;
+using map_type         = stdex::flat_map<int, std::string, std::less<int>, key_container, mapped_container>;
+
+bool uses(map_type const &m, int *count)
+{
+	return m.keys().get_allocator().count == count && m.values().get_allocator().count == count;
+}
+
+int main()
+{
+	{
+		int                        n = 0;
+		counting_allocator<int>    a(&n);
+		map_type                   m(std::allocator_arg, a);
+		m.emplace(2, "b");
+		m.emplace(1, "a");
+		BOOST_TEST(uses(m, &n));
+		BOOST_TEST(n > 0);
+		BOOST_TEST(m.begin()->first == 1);
+	}
+	{
+		int                     n = 0;
+		counting_allocator<int> a(&n);
+		map_type                m(std::allocator_arg, a, std::less<int>());
+		m.emplace(1, "a");
+		BOOST_TEST(uses(m, &n));
+	}
+	{
+		int                     n = 0, n2 = 0;
+		counting_allocator<int> a(&n), a2(&n2);
+		key_container           keys({3, 1, 2, 1}, a2);
+		mapped_container        values({"c", "a", "b", "x"}, a2);
+		map_type                m(std::allocator_arg, a, std::move(keys), std::move(values));
+		BOOST_TEST(uses(m, &n));
+		BOOST_TEST(m.size() == 3);
+		BOOST_TEST(m.at(1) == "a");
+		BOOST_TEST(m.at(3) == "c");
+	}
+	{
+		int                     n = 0;
+		counting_allocator<int> a(&n);
+		map_type m(std::allocator_arg, a, stdex::sorted_unique_t{}, key_container({1, 2}, a), mapped_container({"a", "b"}, a));
+		BOOST_TEST(uses(m, &n));
+		BOOST_TEST(m.at(2) == "b");
+	}
+	{
+		int                                      n = 0;
+		counting_allocator<int>                  a(&n);
+		std::vector<std::pair<int, std::string>> v{{2, "b"}, {1, "a"}, {2, "x"}};
+		map_type                                 m1(std::allocator_arg, a, v.begin(), v.end());
+		map_type                                 m2(std::allocator_arg, a, v);
+		map_type                                 m3(std::allocator_arg, a, {{2, "b"}, {1, "a"}});
+		BOOST_TEST(uses(m1, &n) && uses(m2, &n) && uses(m3, &n));
+		BOOST_TEST(m1.size() == 2 && m2.size() == 2 && m3.size() == 2);
+		BOOST_TEST(m1.at(2) == "b" && m2.at(2) == "b" && m3.at(2) == "b");
+
+		std::vector<std::pair<int, std::string>> s{{1, "a"}, {2, "b"}};
+		map_type                                 m4(std::allocator_arg, a, stdex::sorted_unique_t{}, s.begin(), s.end());
+		map_type                                 m5(std::allocator_arg, a, stdex::sorted_unique_t{}, s);
+		map_type                                 m6(std::allocator_arg, a, stdex::sorted_unique_t{}, {{1, "a"}, {2, "b"}});
+		BOOST_TEST(uses(m4, &n) && uses(m5, &n) && uses(m6, &n));
+		BOOST_TEST(m4.size() == 2 && m5.size() == 2 && m6.size() == 2);
+	}
+	{
+		int                     n = 0, n2 = 0;
+		counting_allocator<int> a(&n), a2(&n2);
+		map_type                m(std::allocator_arg, a);
+		m.emplace(1, "a");
+		map_type c(std::allocator_arg, a2, m);
+		BOOST_TEST(uses(c, &n2));
+		BOOST_TEST(c.at(1) == "a");
+		map_type mv(std::allocator_arg, a, std::move(c));
+		BOOST_TEST(uses(mv, &n));
+		BOOST_TEST(mv.at(1) == "a");
+	}
+	{
+		// the extracted containers keep their allocator
+		int                     n = 0;
+		counting_allocator<int> a(&n);
+		map_type                m(std::allocator_arg, a, {{1, "a"}, {2, "b"}});
+		auto                    c = std::move(m).extract();
+		BOOST_TEST(c.keys.get_allocator().count == &n);
+		BOOST_TEST(c.keys.size() == 2);
+		BOOST_TEST(m.empty());
+	}
+	{
+		// the other flat containers have the same allocator-extended constructors
+		int                     n = 0;
+		counting_allocator<int> a(&n);
+		stdex::flat_multimap<int, std::string, std::less<int>, key_container, mapped_container> mm(
+		        std::allocator_arg, a, {{2, "b"}, {1, "a"}, {2, "c"}});
+		BOOST_TEST(mm.size() == 3);
+		BOOST_TEST(mm.keys().get_allocator().count == &n && mm.values().get_allocator().count == &n);
+		BOOST_TEST(mm.begin()->first == 1);
+
+		stdex::flat_set<int, std::less<int>, key_container> fs(std::allocator_arg, a, {3, 1, 3});
+		BOOST_TEST(fs.size() == 2 && *fs.begin() == 1);
+		stdex::flat_set<int, std::less<int>, key_container> fc(std::allocator_arg, a, fs);
+		BOOST_TEST(fc.size() == 2);
+		stdex::flat_multiset<int, std::less<int>, key_container> ms(std::allocator_arg, a, key_container({3, 1, 3}, a));
+		BOOST_TEST(ms.size() == 3 && *ms.begin() == 1);
+		BOOST_TEST(std::move(fc).extract().get_allocator().count == &n);
+		BOOST_TEST(std::move(ms).extract().get_allocator().count == &n);
+	}
+#ifdef JASEL_TEST_PMR
+	{
+		using pmr_map = stdex::flat_map<int, std::pmr::string, std::less<int>, std::pmr::vector<int>,
+		                                std::pmr::vector<std::pmr::string>>;
+		char                                buffer[4096];
+		std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+		pmr_map                             m(std::allocator_arg, &arena);
+		m.emplace(2, "b");
+		m.emplace(1, "a");
+		m[3] = "c";
+		BOOST_TEST(m.keys().get_allocator().resource() == &arena);
+		BOOST_TEST(m.values().get_allocator().resource() == &arena);
+		// the elements uses-allocator construction propagates the arena to the mapped strings
+		BOOST_TEST(m.begin()->second.get_allocator().resource() == &arena);
+		BOOST_TEST(m.size() == 3);
+		BOOST_TEST(m.at(1) == "a");
+
+		pmr_map e(std::allocator_arg, &arena, m.begin(), m.end());
+		BOOST_TEST(e.size() == 3);
+		e.erase(2);
+		BOOST_TEST(e.size() == 2);
+		BOOST_TEST(e.keys().get_allocator().resource() == &arena);
+
+		stdex::eytzinger_flat_map<int, std::pmr::string, std::less<int>, std::pmr::vector<int>,
+		                          std::pmr::vector<std::pmr::string>>
+		        ey(std::move(e));
+		BOOST_TEST(ey.keys().get_allocator().resource() == &arena);
+		BOOST_TEST(ey.at(3) == "c");
+	}
+#endif
+	return ::boost::report_errors();
+}
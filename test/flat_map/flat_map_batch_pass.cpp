@@ -0,0 +1,112 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <experimental/flat_map.hpp>
+
+#include <experimental/flat_map.hpp>
+#include <experimental/span.hpp>
+#include <array>
+#include <iterator>
+#include <random>
+#include <string>
+
+#include <boost/detail/lightweight_test.hpp>
+
+namespace stdex = std::experimental;
+
+struct string_less
+{
+	using is_transparent = void;
+	bool operator()(std::string const &x, std::string const &y) const { return x < y; }
+	bool operator()(std::string const &x, char const *y) const { return x.compare(y) < 0; }
+	bool operator()(char const *x, std::string const &y) const { return y.compare(x) > 0; }
+};
+
+using map_type = stdex::flat_map<int, int>;
+
+// Checks the four batched lookups of m against the single ones.
+void check_batch(map_type const &m, std::vector<int> const &xs)
+{
+	std::vector<map_type::const_iterator> its;
+	std::vector<size_t>                   idx(xs.size());
+
+	m.lower_bound_batch(xs, std::back_inserter(its));
+	auto last = m.lower_bound_index_batch(xs, idx.begin());
+	BOOST_TEST(last == idx.end());
+	BOOST_TEST(its.size() == xs.size());
+	for (size_t i = 0; i < xs.size(); ++i)
+	{
+		BOOST_TEST(its[i] == m.lower_bound(xs[i]));
+		BOOST_TEST(idx[i] == size_t(m.lower_bound(xs[i]) - m.begin()));
+	}
+
+	its.clear();
+	m.find_batch(xs, std::back_inserter(its));
+	m.find_index_batch(xs, idx.begin());
+	for (size_t i = 0; i < xs.size(); ++i)
+	{
+		BOOST_TEST(its[i] == m.find(xs[i]));
+		BOOST_TEST(idx[i] == size_t(m.find(xs[i]) - m.begin()));
+	}
+}
+
+int main()
+{
+	std::mt19937 gen(42);
+	for (int n : {0, 1, 2, 7, 16, 100, 1000})
+	{
+		map_type m;
+		for (int i = 0; i < n; ++i)
+			m.emplace(3 * i, i);
+		for (size_t q : {0, 1, 5, 16, 17, 100, 2000})
+		{
+			std::vector<int> xs(q);
+			for (auto &x : xs)
+				x = int(gen() % size_t(3 * n + 4)) - 2;
+			// unsorted
+			check_batch(m, xs);
+			// sorted, with duplicates
+			std::sort(xs.begin(), xs.end());
+			check_batch(m, xs);
+		}
+	}
+	{
+		// found values are reachable through the output
+		map_type m({1, 2, 3}, {10, 20, 30});
+		std::array<int, 4>   xs{{3, 0, 2, 4}};
+		std::array<size_t, 4> idx;
+		m.find_index_batch(xs, idx.begin());
+		BOOST_TEST(idx[0] == 2);
+		BOOST_TEST(idx[1] == 3);
+		BOOST_TEST(idx[2] == 1);
+		BOOST_TEST(idx[3] == 3);
+		BOOST_TEST(m.values()[idx[0]] == 30);
+	}
+	{
+		// the keys viewed by a span
+		map_type m({1, 2, 3}, {10, 20, 30});
+		std::vector<int>           keys{3, 0, 2, 4};
+		stdex::span<const int>     xs(keys.data(), keys.size());
+		std::vector<size_t>        idx;
+		m.find_index_batch(xs, std::back_inserter(idx));
+		BOOST_TEST(idx == (std::vector<size_t>{2, 3, 1, 3}));
+		std::vector<map_type::const_iterator> its;
+		m.lower_bound_batch(xs, std::back_inserter(its));
+		BOOST_TEST(its.size() == 4);
+		BOOST_TEST(its[0] == m.lower_bound(3) && its[3] == m.end());
+	}
+	{
+		// heterogeneous keys
+		stdex::flat_map<std::string, int, string_less> m({"a", "b", "c"}, {1, 2, 3});
+		std::vector<char const *> xs{"c", "bb", "a"};
+		std::vector<size_t>       idx;
+		m.find_index_batch(xs, std::back_inserter(idx));
+		BOOST_TEST(idx == (std::vector<size_t>{2, 3, 0}));
+		idx.clear();
+		m.lower_bound_index_batch(xs, std::back_inserter(idx));
+		BOOST_TEST(idx == (std::vector<size_t>{2, 2, 0}));
+	}
+	return ::boost::report_errors();
+}
@@ -12,6 +12,43 @@
 
 namespace stdex = std::experimental;
 
+struct counted_key
+{
+	static int conversions;
+	int        value;
+	explicit counted_key(int v)
+	        : value(v)
+	{
+		++conversions;
+	}
+};
+int counted_key::conversions = 0;
+
+struct counted_key_less
+{
+	using is_transparent = void;
+	bool operator()(counted_key const &x, counted_key const &y) const { return x.value < y.value; }
+	bool operator()(counted_key const &x, int y) const { return x.value < y; }
+	bool operator()(int x, counted_key const &y) const { return x < y.value; }
+};
+
+struct string_less
+{
+	using is_transparent = void;
+	bool operator()(std::string const &x, std::string const &y) const { return x < y; }
+	bool operator()(std::string const &x, char const *y) const { return x.compare(y) < 0; }
+	bool operator()(char const *x, std::string const &y) const { return y.compare(x) > 0; }
+};
+
+// Compares a char with the first character of the strings, so that it can be equivalent to several keys.
+struct prefix_less
+{
+	using is_transparent = void;
+	bool operator()(std::string const &x, std::string const &y) const { return x < y; }
+	bool operator()(std::string const &x, char y) const { return x.empty() || x[0] < y; }
+	bool operator()(char x, std::string const &y) const { return !y.empty() && x < y[0]; }
+};
+
 int main()
 {
 	{
@@ -379,7 +416,194 @@ int main()
 		fm.insert(cont.begin(), cont.end());
 		BOOST_TEST_EQ(2, fm.size());
 	}
+	{
+		std::vector<std::pair<int, short>> cont = {std::make_pair(3, short(1)), std::make_pair(1, short(2)), std::make_pair(3, short(3)), std::make_pair(2, short(4))};
+		stdex::flat_map<int, short>        fm;
+		fm.insert(cont.begin(), cont.end());
+		std::vector<int>   keys2   = {1, 2, 3};
+		std::vector<short> values2 = {2, 4, 1};
+		BOOST_TEST(fm.keys() == keys2);
+		BOOST_TEST(fm.values() == values2);
+	}
+	{
+		stdex::flat_map<int, short>        fm(stdex::sorted_unique_t{}, {std::make_pair(2, short(2)), std::make_pair(4, short(4)), std::make_pair(6, short(6))});
+		std::vector<std::pair<int, short>> cont = {std::make_pair(5, short(50)), std::make_pair(4, short(40)), std::make_pair(1, short(10)), std::make_pair(7, short(70)), std::make_pair(5, short(55))};
+		fm.insert(cont.begin(), cont.end());
+		std::vector<int>   keys2   = {1, 2, 4, 5, 6, 7};
+		std::vector<short> values2 = {10, 2, 4, 50, 6, 70};
+		BOOST_TEST(fm.keys() == keys2);
+		BOOST_TEST(fm.values() == values2);
+	}
+	{
+		stdex::flat_map<int, short> fm(stdex::sorted_unique_t{}, {std::make_pair(1, short(1)), std::make_pair(3, short(3))});
+		fm.insert(stdex::sorted_unique_t{}, {std::make_pair(0, short(0)), std::make_pair(3, short(30)), std::make_pair(4, short(4))});
+		std::vector<int>   keys2   = {0, 1, 3, 4};
+		std::vector<short> values2 = {0, 1, 3, 4};
+		BOOST_TEST(fm.keys() == keys2);
+		BOOST_TEST(fm.values() == values2);
+	}
+	{
+		stdex::flat_map<int, short> fm(stdex::sorted_unique_t{}, {std::make_pair(1, short(1))});
+		fm.insert(stdex::sorted_unique_t{}, {std::make_pair(2, short(2)), std::make_pair(3, short(3))});
+		std::vector<int> keys2 = {1, 2, 3};
+		BOOST_TEST(fm.keys() == keys2);
+	}
+	{
+		std::vector<int>          keys   = {3, 1, 3, 2, 1};
+		std::vector<int>          values = {1, 2, 3, 4, 5};
+		stdex::flat_map<int, int> fm(std::move(keys), std::move(values));
+		std::vector<int>          keys2   = {1, 2, 3};
+		std::vector<int>          values2 = {2, 4, 1};
+		BOOST_TEST(fm.keys() == keys2);
+		BOOST_TEST(fm.values() == values2);
+	}
+	{
+		std::vector<std::pair<int, int>>               cont = {std::make_pair(1, 1), std::make_pair(3, 3), std::make_pair(2, 2)};
+		stdex::flat_map<int, int, std::greater<int>> fm(cont.begin(), cont.end());
+		std::vector<int>                               keys2 = {3, 2, 1};
+		BOOST_TEST(fm.keys() == keys2);
+	}
 
+	{
+		stdex::flat_map<counted_key, int, counted_key_less> fm;
+		fm.try_emplace(counted_key(1), 10);
+		fm.try_emplace(counted_key(3), 30);
+		counted_key::conversions = 0;
+		BOOST_TEST(fm.contains(1));
+		BOOST_TEST(!fm.contains(2));
+		BOOST_TEST_EQ(1, fm.count(3));
+		BOOST_TEST(fm.find(3) != fm.end());
+		BOOST_TEST_EQ(30, (*fm.find(3)).second);
+		BOOST_TEST(fm.find(2) == fm.end());
+		BOOST_TEST(fm.lower_bound(2) == fm.find(3));
+		BOOST_TEST(fm.upper_bound(1) == fm.find(3));
+		BOOST_TEST(fm.equal_range(1).first == fm.find(1));
+		BOOST_TEST(fm.equal_range(1).second == fm.find(3));
+		auto const &cfm = fm;
+		BOOST_TEST(cfm.find(1) == cfm.begin());
+		BOOST_TEST(cfm.lower_bound(4) == cfm.end());
+		BOOST_TEST(cfm.upper_bound(0) == cfm.begin());
+		BOOST_TEST(cfm.equal_range(2).first == cfm.equal_range(2).second);
+		BOOST_TEST_EQ(0, counted_key::conversions);
+		BOOST_TEST(!fm.try_emplace(1, 11).second);
+		BOOST_TEST_EQ(10, fm[1]);
+		BOOST_TEST_EQ(0, counted_key::conversions);
+		BOOST_TEST(fm.try_emplace(2, 20).second);
+		BOOST_TEST_EQ(1, counted_key::conversions);
+		fm[4] = 40;
+		BOOST_TEST_EQ(2, counted_key::conversions);
+		BOOST_TEST_EQ(4, fm.size());
+		BOOST_TEST_EQ(40, (*fm.find(4)).second);
+		auto it = fm.try_emplace(fm.cbegin(), 5, 50);
+		BOOST_TEST_EQ(5, (*it).first.value);
+		BOOST_TEST_EQ(3, counted_key::conversions);
+	}
+	{
+		// a heterogeneous key equivalent to several keys
+		stdex::flat_map<std::string, int, prefix_less> fm = {{"aa", 1}, {"ab", 2}, {"ac", 3}, {"b", 4}};
+		BOOST_TEST_EQ(3, fm.count('a'));
+		BOOST_TEST_EQ(1, fm.count('b'));
+		BOOST_TEST_EQ(0, fm.count('c'));
+		BOOST_TEST_EQ(1, fm.count(std::string("ab")));
+		auto rng = fm.equal_range('a');
+		BOOST_TEST(rng.first == fm.begin());
+		BOOST_TEST(rng.second == fm.find("b"));
+		auto const &cfm  = fm;
+		auto        crng = cfm.equal_range('b');
+		BOOST_TEST(crng.first == cfm.find("b"));
+		BOOST_TEST(crng.second == cfm.end());
+	}
+	{
+		stdex::flat_map<std::string, int, string_less> fm;
+		fm[std::string("a")] = 1;
+		fm["b"]              = 2;
+		BOOST_TEST_EQ(2, fm.size());
+		BOOST_TEST(fm.contains("a"));
+		BOOST_TEST(fm.contains(std::string("b")));
+		BOOST_TEST(!fm.contains("c"));
+		BOOST_TEST_EQ(2, (*fm.find("b")).second);
+	}
+	{
+		// erase of a single element and of a range
+		stdex::flat_map<int, int> fm({1, 2, 3, 4, 5}, {10, 20, 30, 40, 50});
+		auto                      it = fm.erase(fm.find(2));
+		BOOST_TEST_EQ(3, (*it).first);
+		it = fm.erase(fm.find(3), fm.find(5));
+		BOOST_TEST_EQ(5, (*it).first);
+		BOOST_TEST((fm.keys() == std::vector<int>{1, 5}));
+		BOOST_TEST((fm.values() == std::vector<int>{10, 50}));
+		BOOST_TEST(fm.erase(fm.begin(), fm.begin()) == fm.begin());
+		BOOST_TEST_EQ(1u, fm.erase(5));
+		BOOST_TEST_EQ(0u, fm.erase(5));
+	}
+	{
+		// erase_if keeps the order and both columns aligned
+		stdex::flat_map<int, std::string> fm({1, 2, 3, 4, 5, 6}, {"a", "b", "c", "d", "e", "f"});
+		auto n = erase_if(fm, [](stdex::flat_map<int, std::string>::const_reference e) {
+			return e.first % 2 == 0 || e.second == "e";
+		});
+		BOOST_TEST_EQ(4u, n);
+		BOOST_TEST((fm.keys() == std::vector<int>{1, 3}));
+		BOOST_TEST((fm.values() == std::vector<std::string>{"a", "c"}));
+		BOOST_TEST_EQ(0u, erase_if(fm, [](stdex::flat_map<int, std::string>::const_reference) { return false; }));
+	}
+	{
+		// erase_if keeps the elements not erased yet when the predicate throws
+		stdex::flat_map<int, std::string> fm({1, 2, 3, 4, 5, 6}, {"a", "b", "c", "d", "e", "f"});
+		bool                              thrown = false;
+		try
+		{
+			erase_if(fm, [](stdex::flat_map<int, std::string>::const_reference e) {
+				if (e.first == 5)
+					throw 0;
+				return e.first % 2 == 0;
+			});
+		}
+		catch (int)
+		{
+			thrown = true;
+		}
+		BOOST_TEST(thrown);
+		BOOST_TEST((fm.keys() == std::vector<int>{1, 3, 5, 6}));
+		BOOST_TEST((fm.values() == std::vector<std::string>{"a", "c", "e", "f"}));
+	}
+	{
+		// erase_keys with sorted, unsorted and absent keys
+		stdex::flat_map<int, int> fm({1, 2, 3, 4, 5, 6}, {10, 20, 30, 40, 50, 60});
+		BOOST_TEST_EQ(2u, fm.erase_keys(std::vector<int>{2, 4, 7}));
+		BOOST_TEST((fm.keys() == std::vector<int>{1, 3, 5, 6}));
+		BOOST_TEST_EQ(2u, fm.erase_keys(std::vector<int>{6, 0, 1, 6}));
+		BOOST_TEST((fm.keys() == std::vector<int>{3, 5}));
+		BOOST_TEST((fm.values() == std::vector<int>{30, 50}));
+		BOOST_TEST_EQ(0u, fm.erase_keys(std::vector<int>{}));
+		BOOST_TEST_EQ(1u, fm.erase_keys(std::vector<int>{5, 5, 9}));
+		BOOST_TEST((fm.keys() == std::vector<int>{3}));
+		BOOST_TEST((fm.values() == std::vector<int>{30}));
+	}
+	{
+		// merge leaves the elements with an existing key in the source
+		stdex::flat_map<int, int> fm({1, 3, 5}, {10, 30, 50});
+		stdex::flat_map<int, int> src({2, 3, 4, 5, 6}, {2, 3, 4, 5, 6});
+		fm.merge(src);
+		BOOST_TEST((fm.keys() == std::vector<int>{1, 2, 3, 4, 5, 6}));
+		BOOST_TEST((fm.values() == std::vector<int>{10, 2, 30, 4, 50, 6}));
+		BOOST_TEST((src.keys() == std::vector<int>{3, 5}));
+		BOOST_TEST((src.values() == std::vector<int>{3, 5}));
+		fm.merge(fm);
+		BOOST_TEST_EQ(6u, fm.size());
+		fm.merge(stdex::flat_map<int, int>({0, 7}, {0, 7}));
+		BOOST_TEST_EQ(8u, fm.size());
+	}
+	{
+		// merge from a map ordered by another comparator
+		stdex::flat_map<int, int>                    fm({2, 4}, {20, 40});
+		stdex::flat_map<int, int, std::greater<int>> src({1, 2, 3, 4, 5}, {1, 2, 3, 4, 5});
+		fm.merge(src);
+		BOOST_TEST((fm.keys() == std::vector<int>{1, 2, 3, 4, 5}));
+		BOOST_TEST((fm.values() == std::vector<int>{1, 20, 3, 40, 5}));
+		BOOST_TEST((src.keys() == std::vector<int>{4, 2}));
+		BOOST_TEST(src.contains(4));
+	}
 	{
 		const int                     i = 0;
 		int                           j = 0;
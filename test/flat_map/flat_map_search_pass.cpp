@@ -0,0 +1,120 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <experimental/flat_map.hpp>
+
+#include <experimental/flat_map.hpp>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <random>
+#include <string>
+
+#include <boost/detail/lightweight_test.hpp>
+
+namespace stdex = std::experimental;
+
+// Checks Policy against the std algorithms for all the values of the sorted range and their neighbours.
+template <class Policy, class Container, class Compare = std::less<typename Container::value_type>>
+void check_policy(Container const &c, Compare comp = Compare())
+{
+	using T = typename Container::value_type;
+	std::vector<T> probes(c.begin(), c.end());
+	for (auto const &x : c)
+	{
+		if (x < std::numeric_limits<T>::max())
+			probes.push_back(T(x + 1));
+		if (std::numeric_limits<T>::lowest() < x)
+			probes.push_back(T(x - 1));
+	}
+	for (auto const &x : probes)
+	{
+		BOOST_TEST(Policy::lower_bound(c.begin(), c.end(), x, comp) == std::lower_bound(c.begin(), c.end(), x, comp));
+		BOOST_TEST(Policy::upper_bound(c.begin(), c.end(), x, comp) == std::upper_bound(c.begin(), c.end(), x, comp));
+	}
+}
+
+template <class T>
+void check_all_policies()
+{
+	std::mt19937 gen(42);
+	for (size_t n = 0; n < 150; n += (n < 40 ? 1 : 13))
+	{
+		std::vector<T> v;
+		for (size_t i = 0; i < n; ++i)
+			v.push_back(T(gen() % 64) - T(gen() % 32));
+		std::sort(v.begin(), v.end());
+		check_policy<stdex::std_search_policy>(v);
+		check_policy<stdex::branchless_search_policy>(v);
+		check_policy<stdex::simd_search_policy>(v);
+	}
+}
+
+int main()
+{
+	{
+		check_all_policies<int>();
+		check_all_policies<unsigned>();
+		check_all_policies<std::int64_t>();
+		check_all_policies<std::uint64_t>();
+		check_all_policies<short>();
+		check_all_policies<float>();
+		check_all_policies<double>();
+	}
+	{
+		// the sign bit of unsigned keys
+		std::vector<unsigned> v{0u, 1u, 0x7fffffffu, 0x80000000u, 0x80000001u, 0xfffffffeu, 0xffffffffu};
+		check_policy<stdex::simd_search_policy>(v);
+		std::vector<std::uint64_t> v64{0u, 1u, 0x7fffffffffffffffu, 0x8000000000000000u, 0xffffffffffffffffu};
+		check_policy<stdex::simd_search_policy>(v64);
+		std::vector<int> vi{std::numeric_limits<int>::min(), -1, 0, 1, std::numeric_limits<int>::max()};
+		check_policy<stdex::simd_search_policy>(vi);
+	}
+	{
+		// non contiguous containers and other comparators fall back to the branchless search
+		std::deque<int> d{1, 3, 3, 5, 7, 9, 11, 13, 15, 17, 19};
+		check_policy<stdex::simd_search_policy>(d);
+		std::vector<int> v{19, 17, 15, 13, 11, 9, 7, 5, 3, 3, 1};
+		check_policy<stdex::simd_search_policy>(v, std::greater<int>());
+		check_policy<stdex::branchless_search_policy>(v, std::greater<int>());
+	}
+	{
+		std::vector<std::string> v{"a", "b", "bb", "c", "d", "e"};
+		using P = stdex::branchless_search_policy;
+		BOOST_TEST(P::lower_bound(v.begin(), v.end(), std::string("bb"), std::less<std::string>()) == v.begin() + 2);
+		BOOST_TEST(P::upper_bound(v.begin(), v.end(), std::string("bb"), std::less<std::string>()) == v.begin() + 3);
+		BOOST_TEST(P::lower_bound(v.begin(), v.end(), std::string("z"), std::less<std::string>()) == v.end());
+	}
+	{
+		static_assert(std::is_same<stdex::flat_map<int, int>::search_policy, stdex::simd_search_policy>::value, "");
+		static_assert(
+		        std::is_same<stdex::flat_map<std::string, int>::search_policy, stdex::branchless_search_policy>::value,
+		        "");
+		static_assert(std::is_same<stdex::flat_map<int, int, std::greater<int>>::search_policy,
+		                           stdex::branchless_search_policy>::value,
+		              "");
+	}
+	{
+		stdex::flat_map<int, int> m;
+		for (int i = 0; i < 1000; ++i)
+			m.emplace(3 * i, i);
+		for (int i = -1; i < 3001; ++i)
+		{
+			auto it = m.find(i);
+			if (i % 3 == 0 && i >= 0 && i < 3000)
+			{
+				BOOST_TEST(it != m.end());
+				BOOST_TEST((*it).second == i / 3);
+			}
+			else
+				BOOST_TEST(it == m.end());
+			BOOST_TEST(m.lower_bound(i) - m.begin() == (i + 2) / 3);
+			auto rng = m.equal_range(i);
+			BOOST_TEST(rng.second - rng.first == (m.contains(i) ? 1 : 0));
+		}
+	}
+	return ::boost::report_errors();
+}
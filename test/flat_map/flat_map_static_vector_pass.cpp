@@ -0,0 +1,139 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <experimental/flat_map.hpp>
+
+#include <experimental/flat_map.hpp>
+#include <experimental/static_vector.hpp>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/detail/lightweight_test.hpp>
+
+namespace stdex = std::experimental;
+
+template <class T>
+using inline_vector = stdex::static_vector<T, 4>;
+
+using map_type      = stdex::flat_map<int, int, std::less<int>, inline_vector<int>, inline_vector<int>>;
+using multimap_type = stdex::flat_multimap<int, int, std::less<int>, inline_vector<int>, inline_vector<int>>;
+
+static_assert(std::is_trivially_copyable<map_type>::value, "");
+static_assert(std::is_trivially_copyable<multimap_type>::value, "");
+static_assert(!std::is_trivially_copyable<
+                      stdex::flat_map<int, std::string, std::less<int>, inline_vector<int>, inline_vector<std::string>>>::value,
+              "");
+
+bool is_0_to_3(map_type const &m)
+{
+	if (m.size() != 4)
+		return false;
+	int i = 0;
+	for (auto const &x : m)
+	{
+		if (x.first != i || x.second != 10 * i)
+			return false;
+		++i;
+	}
+	return true;
+}
+
+int main()
+{
+	{
+		map_type m;
+		m.emplace(2, 20);
+		m.insert(std::make_pair(0, 0));
+		m[3] = 30;
+		m.try_emplace(1, 10);
+		BOOST_TEST(is_0_to_3(m));
+		BOOST_TEST(m.find(2) != m.end());
+		BOOST_TEST(m.at(3) == 30);
+		BOOST_TEST(m.max_size() == 4);
+
+		// the map is full: the existing keys can still be found and assigned
+		BOOST_TEST(!m.emplace(2, 0).second);
+		BOOST_TEST(!m.insert_or_assign(2, 20).second);
+		BOOST_TEST(m[1] == 10);
+
+		// but new keys are rejected, leaving the map unchanged
+		BOOST_TEST_THROWS(m.emplace(4, 40), std::length_error);
+		BOOST_TEST_THROWS(m.insert(m.begin(), std::make_pair(-1, 0)), std::length_error);
+		BOOST_TEST_THROWS(m[5], std::length_error);
+		BOOST_TEST_THROWS(m.try_emplace(6, 0), std::length_error);
+		BOOST_TEST_THROWS(m.insert_or_assign(7, 0), std::length_error);
+		BOOST_TEST(is_0_to_3(m));
+
+		m.erase(1);
+		BOOST_TEST(m.size() == 3);
+		BOOST_TEST(m.emplace(1, 10).second);
+		BOOST_TEST(is_0_to_3(m));
+	}
+	{
+		// the elements of a range are checked one by one, the appended ones being removed on failure
+		map_type                         m{{0, 0}, {1, 10}};
+		std::vector<std::pair<int, int>> v{{3, 30}, {2, 20}, {4, 40}};
+		BOOST_TEST_THROWS(m.insert(v.begin(), v.end()), std::length_error);
+		BOOST_TEST(m.size() == 2);
+		BOOST_TEST(m.at(1) == 10);
+		v.pop_back();
+		m.insert(v.begin(), v.end());
+		BOOST_TEST(is_0_to_3(m));
+
+		v.push_back({4, 40});
+		v.push_back({5, 50});
+		v.push_back({6, 60});
+		BOOST_TEST_THROWS(map_type(v.begin(), v.end()), std::length_error);
+		BOOST_TEST_THROWS(map_type(stdex::sorted_unique_t{}, v.begin(), v.end()), std::length_error);
+	}
+	{
+		map_type m{{0, 0}, {1, 10}, {2, 20}};
+		map_type s{{2, 0}, {3, 30}};
+		BOOST_TEST_THROWS(m.merge(s), std::length_error);
+		BOOST_TEST(m.size() == 3);
+		BOOST_TEST(s.size() == 2);
+		s.erase(3);
+		m.merge(s);
+		BOOST_TEST(m.size() == 3);
+		BOOST_TEST(s.size() == 1);
+	}
+	{
+		map_type m{{0, 0}, {1, 10}, {2, 20}, {3, 30}};
+		map_type c;
+		std::memcpy(static_cast<void *>(&c), &m, sizeof(m));
+		BOOST_TEST(is_0_to_3(c));
+		map_type d = c;
+		d.erase(0);
+		BOOST_TEST(d.size() == 3);
+		BOOST_TEST(is_0_to_3(c));
+		swap(c, d);
+		BOOST_TEST(d.size() == 4 && c.size() == 3);
+	}
+	{
+		multimap_type m{{1, 10}, {1, 11}, {0, 0}, {2, 20}};
+		BOOST_TEST(m.size() == 4);
+		BOOST_TEST(m.count(1) == 2);
+		BOOST_TEST_THROWS(m.emplace(1, 12), std::length_error);
+		std::vector<std::pair<int, int>> v{{3, 30}};
+		BOOST_TEST_THROWS(m.insert(v.begin(), v.end()), std::length_error);
+		BOOST_TEST(m.size() == 4);
+		m.erase(m.begin());
+		m.emplace(1, 12);
+		BOOST_TEST(m.count(1) == 3);
+	}
+	{
+		stdex::flat_map<int, std::string, std::less<int>, inline_vector<int>, inline_vector<std::string>> m;
+		m.emplace(1, "one");
+		m.emplace(0, "zero");
+		auto c = m;
+		BOOST_TEST(c.at(0) == "zero");
+		BOOST_TEST(c.at(1) == "one");
+	}
+	return ::boost::report_errors();
+}
@@ -0,0 +1,141 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <experimental/flat_map.hpp>
+
+#include <experimental/flat_map.hpp>
+
+#include <boost/detail/lightweight_test.hpp>
+
+namespace stdex = std::experimental;
+
+int main()
+{
+	{
+		stdex::flat_multimap<int, int> fm;
+		BOOST_TEST(fm.empty());
+		BOOST_TEST_EQ(fm.size(), 0);
+		BOOST_TEST(fm.begin() == fm.end());
+	}
+	{
+		std::vector<int>               keys   = {3, 1, 3, 2, 1};
+		std::vector<int>               values = {1, 2, 3, 4, 5};
+		stdex::flat_multimap<int, int> fm(std::move(keys), std::move(values));
+		std::vector<int>               keys2   = {1, 1, 2, 3, 3};
+		std::vector<int>               values2 = {2, 5, 4, 1, 3};
+		BOOST_TEST(fm.keys() == keys2);
+		BOOST_TEST(fm.values() == values2);
+		BOOST_TEST_EQ(2, fm.count(1));
+		BOOST_TEST_EQ(0, fm.count(4));
+		BOOST_TEST(fm.contains(2));
+		BOOST_TEST(!fm.contains(4));
+		BOOST_TEST_EQ(2, (*fm.find(1)).second);
+		BOOST_TEST(fm.find(4) == fm.end());
+	}
+	{
+		std::vector<int>               keys   = {1, 1, 2};
+		std::vector<int>               values = {3, 2, 1};
+		stdex::flat_multimap<int, int> fm(stdex::sorted_equivalent_t{}, std::move(keys), std::move(values));
+		std::vector<int>               values2 = {3, 2, 1};
+		BOOST_TEST(fm.values() == values2);
+	}
+	{
+		stdex::flat_multimap<int, short> fm(stdex::sorted_equivalent_t{}, {std::make_pair(1, short(1)), std::make_pair(1, short(2))});
+		BOOST_TEST_EQ(2, fm.size());
+		auto it = fm.emplace(1, short(3));
+		BOOST_TEST(it == fm.begin() + 2);
+		fm.emplace(0, short(0));
+		fm.insert(std::make_pair(2, short(4)));
+		std::vector<int>   keys2   = {0, 1, 1, 1, 2};
+		std::vector<short> values2 = {0, 1, 2, 3, 4};
+		BOOST_TEST(fm.keys() == keys2);
+		BOOST_TEST(fm.values() == values2);
+		auto rng = fm.equal_range(1);
+		BOOST_TEST_EQ(3, rng.second - rng.first);
+		BOOST_TEST(rng.first == fm.lower_bound(1));
+		BOOST_TEST(rng.second == fm.upper_bound(1));
+	}
+	{
+		stdex::flat_multimap<int, short> fm(stdex::sorted_equivalent_t{}, {std::make_pair(1, short(1)), std::make_pair(3, short(3))});
+		auto                             it = fm.emplace_hint(fm.cbegin() + 1, 2, short(2));
+		BOOST_TEST_EQ(2, (*it).first);
+		it = fm.emplace_hint(fm.cbegin(), 4, short(4));
+		BOOST_TEST(it == fm.end() - 1);
+		std::vector<int> keys2 = {1, 2, 3, 4};
+		BOOST_TEST(fm.keys() == keys2);
+	}
+	{
+		stdex::flat_multimap<int, short>   fm(stdex::sorted_equivalent_t{}, {std::make_pair(2, short(2)), std::make_pair(4, short(4))});
+		std::vector<std::pair<int, short>> cont = {std::make_pair(4, short(40)), std::make_pair(1, short(10)), std::make_pair(2, short(20)), std::make_pair(4, short(41))};
+		fm.insert(cont.begin(), cont.end());
+		std::vector<int>   keys2   = {1, 2, 2, 4, 4, 4};
+		std::vector<short> values2 = {10, 2, 20, 4, 40, 41};
+		BOOST_TEST(fm.keys() == keys2);
+		BOOST_TEST(fm.values() == values2);
+		fm.insert(stdex::sorted_equivalent_t{}, {std::make_pair(0, short(0)), std::make_pair(4, short(42))});
+		BOOST_TEST_EQ(8, fm.size());
+		BOOST_TEST_EQ(42, (*(fm.end() - 1)).second);
+		BOOST_TEST_EQ(0, (*fm.begin()).second);
+	}
+	{
+		stdex::flat_multimap<int, int> fm = {std::make_pair(1, 1), std::make_pair(2, 2), std::make_pair(1, 3), std::make_pair(3, 3)};
+		BOOST_TEST_EQ(2, fm.erase(1));
+		BOOST_TEST_EQ(0, fm.erase(1));
+		BOOST_TEST_EQ(2, fm.size());
+		auto it = fm.erase(fm.begin());
+		BOOST_TEST(it == fm.begin());
+		BOOST_TEST_EQ(3, (*it).first);
+		fm.insert({std::make_pair(5, 5), std::make_pair(6, 6)});
+		it = fm.erase(fm.cbegin() + 1, fm.cend());
+		BOOST_TEST(it == fm.end());
+		BOOST_TEST_EQ(1, fm.size());
+	}
+	{
+		stdex::flat_multimap<int, int> fm = {std::make_pair(1, 1), std::make_pair(3, 3)};
+		auto                           c  = std::move(fm).extract();
+		BOOST_TEST(fm.empty());
+		BOOST_TEST_EQ(2, c.keys.size());
+		c.keys.push_back(3);
+		c.values.push_back(4);
+		fm.replace(std::move(c.keys), std::move(c.values));
+		BOOST_TEST_EQ(2, fm.count(3));
+	}
+	{
+		stdex::flat_multimap<int, int> fm  = {std::make_pair(1, 1), std::make_pair(3, 3)};
+		stdex::flat_multimap<int, int> fm2 = {std::make_pair(3, 30), std::make_pair(0, 0), std::make_pair(2, 2)};
+		fm.merge(fm2);
+		BOOST_TEST(fm2.empty());
+		std::vector<int> keys2   = {0, 1, 2, 3, 3};
+		std::vector<int> values2 = {0, 1, 2, 3, 30};
+		BOOST_TEST(fm.keys() == keys2);
+		BOOST_TEST(fm.values() == values2);
+	}
+	{
+		stdex::flat_multimap<int, int>                    fm  = {std::make_pair(1, 1), std::make_pair(3, 3)};
+		stdex::flat_multimap<int, int, std::greater<int>> fm2 = {std::make_pair(2, 2), std::make_pair(4, 4)};
+		fm.merge(std::move(fm2));
+		std::vector<int> keys2 = {1, 2, 3, 4};
+		BOOST_TEST(fm.keys() == keys2);
+	}
+	{
+		stdex::flat_multimap<int, int> fm  = {std::make_pair(1, 1)};
+		stdex::flat_multimap<int, int> fm2 = {std::make_pair(2, 2), std::make_pair(3, 3)};
+		swap(fm, fm2);
+		BOOST_TEST_EQ(2, fm.size());
+		BOOST_TEST_EQ(1, fm2.size());
+		fm = {std::make_pair(5, 5)};
+		BOOST_TEST_EQ(1, fm.size());
+		BOOST_TEST_EQ(5, (*fm.rbegin()).first);
+	}
+
+	{
+		stdex::flat_multimap<int, int> fm({1, 1, 2, 3, 3}, {1, 2, 3, 4, 5});
+		auto n = erase_if(fm, [](stdex::flat_multimap<int, int>::const_reference e) { return e.second % 2 == 0; });
+		BOOST_TEST_EQ(2u, n);
+		BOOST_TEST((fm.keys() == std::vector<int>{1, 2, 3}));
+		BOOST_TEST((fm.values() == std::vector<int>{1, 3, 5}));
+	}
+	return ::boost::report_errors();
+}
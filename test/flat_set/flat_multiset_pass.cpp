@@ -0,0 +1,83 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <experimental/flat_set.hpp>
+
+#include <experimental/flat_set.hpp>
+
+#include <boost/detail/lightweight_test.hpp>
+
+namespace stdex = std::experimental;
+
+int main()
+{
+	{
+		stdex::flat_multiset<int> fs;
+		BOOST_TEST(fs.empty());
+		BOOST_TEST(fs.begin() == fs.end());
+	}
+	{
+		stdex::flat_multiset<int> fs    = {3, 1, 2, 3, 1};
+		std::vector<int>          cont2 = {1, 1, 2, 3, 3};
+		BOOST_TEST_EQ(5, fs.size());
+		BOOST_TEST(std::equal(fs.begin(), fs.end(), cont2.begin()));
+		BOOST_TEST_EQ(2, fs.count(3));
+		BOOST_TEST(fs.contains(2));
+		BOOST_TEST(!fs.contains(0));
+		BOOST_TEST(fs.find(3) == fs.begin() + 3);
+		BOOST_TEST_EQ(2, fs.equal_range(1).second - fs.equal_range(1).first);
+	}
+	{
+		std::vector<int>          cont = {1, 2, 2};
+		stdex::flat_multiset<int> fs(stdex::sorted_equivalent_t{}, std::move(cont));
+		auto                      it = fs.insert(2);
+		BOOST_TEST(it == fs.begin() + 3);
+		it = fs.insert(fs.cbegin(), 2);
+		BOOST_TEST(it == fs.begin() + 1);
+		it = fs.insert(fs.cend(), 1);
+		BOOST_TEST(it == fs.begin() + 1);
+		it = fs.emplace(0);
+		BOOST_TEST(it == fs.begin());
+		BOOST_TEST_EQ(4, fs.count(2));
+		BOOST_TEST_EQ(2, fs.count(1));
+		BOOST_TEST(std::is_sorted(fs.begin(), fs.end()));
+	}
+	{
+		stdex::flat_multiset<int> fs = {2, 4};
+		fs.insert({4, 1, 2});
+		fs.insert(stdex::sorted_equivalent_t{}, {0, 4});
+		std::vector<int> cont2 = {0, 1, 2, 2, 4, 4, 4};
+		BOOST_TEST(std::equal(fs.begin(), fs.end(), cont2.begin()));
+		BOOST_TEST_EQ(cont2.size(), fs.size());
+		BOOST_TEST_EQ(3, fs.erase(4));
+		BOOST_TEST_EQ(4, fs.size());
+	}
+	{
+		stdex::flat_multiset<int>                    fs  = {1, 3};
+		stdex::flat_multiset<int>                    fs2 = {3, 0};
+		stdex::flat_multiset<int, std::greater<int>> fs3 = {1, 5};
+		fs.merge(fs2);
+		fs.merge(fs3);
+		BOOST_TEST(fs2.empty());
+		BOOST_TEST(fs3.empty());
+		std::vector<int> cont2 = {0, 1, 1, 3, 3, 5};
+		BOOST_TEST(std::equal(fs.begin(), fs.end(), cont2.begin()));
+		BOOST_TEST_EQ(cont2.size(), fs.size());
+	}
+	{
+		stdex::flat_multiset<int> fs   = {1, 1};
+		auto                      cont = std::move(fs).extract();
+		BOOST_TEST(fs.empty());
+		fs.replace(std::move(cont));
+		BOOST_TEST_EQ(2, fs.count(1));
+	}
+
+	{
+		stdex::flat_multiset<int> fs{2, 1, 2, 3, 2};
+		BOOST_TEST_EQ(3u, erase_if(fs, [](int x) { return x == 2; }));
+		BOOST_TEST((std::vector<int>(fs.begin(), fs.end()) == std::vector<int>{1, 3}));
+	}
+	return ::boost::report_errors();
+}
@@ -0,0 +1,153 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <experimental/flat_set.hpp>
+
+#include <experimental/flat_set.hpp>
+#include <string>
+
+#include <boost/detail/lightweight_test.hpp>
+
+namespace stdex = std::experimental;
+
+struct string_less
+{
+	using is_transparent = void;
+	bool operator()(std::string const &x, std::string const &y) const { return x < y; }
+	bool operator()(std::string const &x, char const *y) const { return x.compare(y) < 0; }
+	bool operator()(char const *x, std::string const &y) const { return y.compare(x) > 0; }
+};
+
+int main()
+{
+	{
+		stdex::flat_set<int> fs;
+		BOOST_TEST(fs.empty());
+		BOOST_TEST_EQ(fs.size(), 0);
+		BOOST_TEST(fs.begin() == fs.end());
+	}
+	{
+		stdex::flat_set<int> fs = {3, 1, 2, 3, 1};
+		std::vector<int>     cont2 = {1, 2, 3};
+		BOOST_TEST_EQ(3, fs.size());
+		BOOST_TEST(std::equal(fs.begin(), fs.end(), cont2.begin()));
+		BOOST_TEST(fs.contains(2));
+		BOOST_TEST(!fs.contains(4));
+		BOOST_TEST_EQ(1, fs.count(3));
+		BOOST_TEST(fs.find(4) == fs.end());
+		BOOST_TEST(fs.lower_bound(2) == fs.begin() + 1);
+		BOOST_TEST(fs.upper_bound(2) == fs.begin() + 2);
+		BOOST_TEST(fs.equal_range(0).first == fs.begin());
+		BOOST_TEST_EQ(3, *fs.rbegin());
+	}
+	{
+		std::vector<int>     cont = {1, 2, 3};
+		stdex::flat_set<int> fs(stdex::sorted_unique_t{}, std::move(cont));
+		BOOST_TEST_EQ(3, fs.size());
+		auto r = fs.insert(2);
+		BOOST_TEST(!r.second);
+		BOOST_TEST(r.first == fs.begin() + 1);
+		r = fs.insert(0);
+		BOOST_TEST(r.second);
+		BOOST_TEST(r.first == fs.begin());
+		auto it = fs.insert(fs.cend(), 5);
+		BOOST_TEST_EQ(5, *it);
+		it = fs.emplace_hint(fs.cbegin(), 4);
+		BOOST_TEST_EQ(4, *it);
+		BOOST_TEST(std::is_sorted(fs.begin(), fs.end()));
+		BOOST_TEST_EQ(6, fs.size());
+	}
+	{
+		stdex::flat_set<int> fs = {2, 4, 6};
+		fs.insert({5, 4, 1, 7, 5});
+		std::vector<int> cont2 = {1, 2, 4, 5, 6, 7};
+		BOOST_TEST(std::equal(fs.begin(), fs.end(), cont2.begin()));
+		BOOST_TEST_EQ(cont2.size(), fs.size());
+		fs.insert(stdex::sorted_unique_t{}, {0, 3, 8});
+		BOOST_TEST_EQ(9, fs.size());
+		BOOST_TEST(std::is_sorted(fs.begin(), fs.end()));
+	}
+	{
+		stdex::flat_set<int> fs = {1, 2, 3, 4};
+		BOOST_TEST_EQ(1, fs.erase(2));
+		BOOST_TEST_EQ(0, fs.erase(2));
+		auto it = fs.erase(fs.begin());
+		BOOST_TEST_EQ(3, *it);
+		it = fs.erase(fs.begin(), fs.end());
+		BOOST_TEST(it == fs.end());
+		BOOST_TEST(fs.empty());
+	}
+	{
+		stdex::flat_set<int> fs   = {1, 3};
+		auto                 cont = std::move(fs).extract();
+		BOOST_TEST(fs.empty());
+		cont.push_back(4);
+		fs.replace(std::move(cont));
+		BOOST_TEST_EQ(3, fs.size());
+	}
+	{
+		stdex::flat_set<int> fs  = {1, 3, 5};
+		stdex::flat_set<int> fs2 = {0, 3, 4, 5};
+		fs.merge(fs2);
+		std::vector<int> cont2 = {0, 1, 3, 4, 5};
+		BOOST_TEST(std::equal(fs.begin(), fs.end(), cont2.begin()));
+		BOOST_TEST_EQ(cont2.size(), fs.size());
+		std::vector<int> rest = {3, 5};
+		BOOST_TEST(std::equal(fs2.begin(), fs2.end(), rest.begin()));
+		BOOST_TEST_EQ(rest.size(), fs2.size());
+	}
+	{
+		stdex::flat_set<int>                    fs  = {1, 3};
+		stdex::flat_set<int, std::greater<int>> fs2 = {4, 3, 2, 1};
+		fs.merge(std::move(fs2));
+		std::vector<int> cont2 = {1, 2, 3, 4};
+		BOOST_TEST(std::equal(fs.begin(), fs.end(), cont2.begin()));
+		std::vector<int> rest = {3, 1};
+		BOOST_TEST(std::equal(fs2.begin(), fs2.end(), rest.begin()));
+		BOOST_TEST_EQ(rest.size(), fs2.size());
+	}
+	{
+		stdex::flat_set<std::string, string_less> fs = {"b", "a"};
+		BOOST_TEST(fs.contains("a"));
+		BOOST_TEST(!fs.contains("c"));
+		BOOST_TEST_EQ(1, fs.count("b"));
+		BOOST_TEST(fs.find("b") == fs.begin() + 1);
+	}
+	{
+		stdex::flat_set<int> fs  = {1};
+		stdex::flat_set<int> fs2 = {2, 3};
+		swap(fs, fs2);
+		BOOST_TEST_EQ(2, fs.size());
+		fs = {7};
+		BOOST_TEST_EQ(1, fs.size());
+		BOOST_TEST_EQ(7, *fs.begin());
+	}
+
+	{
+		stdex::flat_set<int> fs{5, 1, 4, 2, 3};
+		BOOST_TEST_EQ(2u, erase_if(fs, [](int x) { return x % 2 == 0; }));
+		BOOST_TEST((std::vector<int>(fs.begin(), fs.end()) == std::vector<int>{1, 3, 5}));
+	}
+	{
+		// erase_if keeps the elements not erased yet when the predicate throws
+		stdex::flat_set<std::string> fs{"a", "b", "c", "d", "e"};
+		bool                         thrown = false;
+		try
+		{
+			erase_if(fs, [](std::string const &x) {
+				if (x == "d")
+					throw 0;
+				return x == "b";
+			});
+		}
+		catch (int)
+		{
+			thrown = true;
+		}
+		BOOST_TEST(thrown);
+		BOOST_TEST((std::vector<std::string>(fs.begin(), fs.end()) == std::vector<std::string>{"a", "c", "d", "e"}));
+	}
+	return ::boost::report_errors();
+}
@@ -0,0 +1,76 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <experimental/flat_set.hpp>
+
+#include <experimental/flat_set.hpp>
+#include <experimental/static_vector.hpp>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <boost/detail/lightweight_test.hpp>
+
+namespace stdex = std::experimental;
+
+using set_type      = stdex::flat_set<int, std::less<int>, stdex::static_vector<int, 4>>;
+using multiset_type = stdex::flat_multiset<int, std::less<int>, stdex::static_vector<int, 4>>;
+
+static_assert(std::is_trivially_copyable<set_type>::value, "");
+static_assert(std::is_trivially_copyable<multiset_type>::value, "");
+
+int main()
+{
+	{
+		set_type s{3, 1, 2, 0};
+		BOOST_TEST(s.size() == 4);
+		BOOST_TEST(*s.begin() == 0);
+		BOOST_TEST(!s.insert(2).second);
+		BOOST_TEST(s.insert(s.begin(), 1) == s.begin() + 1);
+		BOOST_TEST_THROWS(s.insert(4), std::length_error);
+		BOOST_TEST_THROWS(s.insert(s.end(), 4), std::length_error);
+		BOOST_TEST_THROWS(s.emplace(-1), std::length_error);
+		BOOST_TEST(s.size() == 4);
+
+		set_type c;
+		std::memcpy(static_cast<void *>(&c), &s, sizeof(s));
+		BOOST_TEST(c.size() == s.size() && std::equal(c.begin(), c.end(), s.begin()));
+	}
+	{
+		// forward ranges are checked before inserting anything
+		std::vector<int> v{5, 6, 7, 8, 9};
+		BOOST_TEST_THROWS(set_type(v.begin(), v.end()), std::length_error);
+		set_type s{1, 2};
+		BOOST_TEST_THROWS(s.insert(v.begin(), v.end()), std::length_error);
+		BOOST_TEST(s.size() == 2);
+
+		// input ranges are checked element by element and the appended ones removed
+		std::istringstream                in("3 4 5");
+		std::istream_iterator<int> const first(in), last;
+		BOOST_TEST_THROWS(s.insert(first, last), std::length_error);
+		BOOST_TEST(s.size() == 2);
+		BOOST_TEST(*s.rbegin() == 2);
+
+		set_type t{2, 3};
+		s.merge(t);
+		BOOST_TEST(s.size() == 3);
+		BOOST_TEST(t.size() == 1);
+	}
+	{
+		multiset_type s{1, 1, 0, 2};
+		BOOST_TEST(s.count(1) == 2);
+		BOOST_TEST_THROWS(s.insert(1), std::length_error);
+		BOOST_TEST_THROWS(s.insert(s.begin(), 1), std::length_error);
+		multiset_type t{1};
+		BOOST_TEST_THROWS(s.merge(t), std::length_error);
+		BOOST_TEST(s.size() == 4);
+		BOOST_TEST(t.size() == 1);
+	}
+	return ::boost::report_errors();
+}
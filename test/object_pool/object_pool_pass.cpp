@@ -0,0 +1,116 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <experimental/object_pool.hpp>
+
+#include <experimental/object_pool.hpp>
+
+#include <boost/detail/lightweight_test.hpp>
+#include <set>
+#include <string>
+#include <vector>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#define JASEL_TEST_PMR
+#endif
+#endif
+
+#if __cplusplus >= 201103L
+namespace stdex = std::experimental;
+
+int main()
+{
+	{
+		stdex::object_pool<int> pool(2);
+		BOOST_TEST(pool.empty());
+		BOOST_TEST_EQ(0u, pool.capacity());
+		std::vector<int *> v;
+		std::set<int *>    distinct;
+		for (int i = 0; i < 100; ++i)
+		{
+			v.push_back(pool.create(i));
+			distinct.insert(v.back());
+		}
+		BOOST_TEST_EQ(100u, pool.size());
+		BOOST_TEST_EQ(100u, distinct.size());
+		// chunks of 2, 4, 8, 16, 32 and 64 slots
+		BOOST_TEST_EQ(126u, pool.capacity());
+		for (int i = 0; i < 100; ++i)
+		{
+			BOOST_TEST_EQ(i, *v[i]);
+			BOOST_TEST(pool.owns(v[i]));
+		}
+		int x = 0;
+		BOOST_TEST(!pool.owns(&x));
+		for (int i = 0; i < 100; i += 2)
+			pool.destroy(v[i]);
+		BOOST_TEST_EQ(50u, pool.size());
+		// the slots given back are reused before the chunks grow
+		for (int i = 0; i < 50; ++i)
+			pool.create(i);
+		BOOST_TEST_EQ(126u, pool.capacity());
+	}
+	{
+		stdex::object_pool<std::string> pool(4);
+		pool.reserve(10);
+		BOOST_TEST_EQ(10u, pool.capacity());
+		auto a = pool.make_unique("a");
+		auto b = pool.make_unique(2, 'b');
+		BOOST_TEST(*a == "a");
+		BOOST_TEST(*b == "bb");
+		BOOST_TEST_EQ(2u, pool.size());
+		b.reset();
+		BOOST_TEST_EQ(1u, pool.size());
+		pool.reserve(9);
+		BOOST_TEST_EQ(10u, pool.capacity());
+		// the slots left in a chunk are not lost when a chunk is added
+		pool.reserve(20);
+		BOOST_TEST_EQ(21u, pool.capacity());
+		std::vector<stdex::object_pool<std::string>::unique_ptr_type> v;
+		for (int i = 0; i < 20; ++i)
+			v.push_back(pool.make_unique(1, 'c'));
+		BOOST_TEST_EQ(21u, pool.capacity());
+		BOOST_TEST_EQ(21u, pool.size());
+	}
+#ifdef JASEL_TEST_PMR
+	{
+		stdex::static_pool<std::pmr::string, 2> pool;
+		stdex::pool_resource<decltype(pool)>    resource(pool);
+		std::pmr::polymorphic_allocator<std::pmr::string> alloc(&resource);
+		std::pmr::string *s = alloc.allocate(1);
+		BOOST_TEST(pool.owns(s));
+		BOOST_TEST_EQ(1u, pool.size());
+		alloc.deallocate(s, 1);
+		BOOST_TEST(pool.empty());
+		// the blocks that don't fit in a slot come from the upstream resource
+		std::pmr::string *t = alloc.allocate(2);
+		BOOST_TEST(!pool.owns(t));
+		alloc.deallocate(t, 2);
+		BOOST_TEST(resource.is_equal(resource));
+	}
+	{
+		stdex::object_pool<std::pmr::string> pool;
+		stdex::pool_resource<decltype(pool)> resource(pool);
+		std::pmr::vector<std::pmr::string *> v(std::pmr::new_delete_resource());
+		std::pmr::polymorphic_allocator<std::pmr::string> alloc(&resource);
+		for (int i = 0; i < 64; ++i)
+			v.push_back(alloc.allocate(1));
+		BOOST_TEST_EQ(64u, pool.size());
+		for (auto p : v)
+			alloc.deallocate(p, 1);
+		BOOST_TEST(pool.empty());
+	}
+#endif
+	return ::boost::report_errors();
+}
+
+#else
+int main()
+{
+	return ::boost::report_errors();
+}
+#endif
@@ -0,0 +1,95 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <experimental/object_pool.hpp>
+
+#include <experimental/object_pool.hpp>
+
+#include <boost/detail/lightweight_test.hpp>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#if __cplusplus >= 201103L
+namespace stdex = std::experimental;
+
+struct throwing
+{
+	explicit throwing(bool b)
+	{
+		if (b)
+			throw std::runtime_error("throwing");
+	}
+};
+
+int main()
+{
+	{
+		stdex::static_pool<int, 3> pool;
+		BOOST_TEST(pool.empty());
+		BOOST_TEST_EQ(3u, pool.capacity());
+		int *a = pool.allocate();
+		int *b = pool.allocate();
+		int *c = pool.allocate();
+		BOOST_TEST(a != nullptr && b != nullptr && c != nullptr);
+		BOOST_TEST(a != b && b != c && a != c);
+		BOOST_TEST(pool.full());
+		BOOST_TEST(pool.allocate() == nullptr);
+		BOOST_TEST(pool.owns(b));
+		int x = 0;
+		BOOST_TEST(!pool.owns(&x));
+		pool.deallocate(b);
+		BOOST_TEST_EQ(2u, pool.size());
+		// the slot given back is the next one allocated
+		BOOST_TEST(pool.allocate() == b);
+		pool.deallocate(a);
+		pool.deallocate(b);
+		pool.deallocate(c);
+		BOOST_TEST(pool.empty());
+	}
+	{
+		stdex::static_pool<std::string, 2> pool;
+		std::string *s = pool.create(3, 'a');
+		BOOST_TEST(*s == "aaa");
+		{
+			auto p = pool.make_unique("unique");
+			BOOST_TEST(*p == "unique");
+			BOOST_TEST(pool.full());
+			BOOST_TEST(p.get_deleter().pool() == &pool);
+			try
+			{
+				pool.create("none");
+				BOOST_TEST(false);
+			}
+			catch (std::bad_alloc &)
+			{
+			}
+		}
+		BOOST_TEST_EQ(1u, pool.size());
+		pool.destroy(s);
+		BOOST_TEST(pool.empty());
+	}
+	{
+		stdex::static_pool<throwing, 1> pool;
+		try
+		{
+			pool.create(true);
+			BOOST_TEST(false);
+		}
+		catch (std::runtime_error &)
+		{
+		}
+		BOOST_TEST(pool.empty());
+		pool.destroy(pool.create(false));
+	}
+	return ::boost::report_errors();
+}
+
+#else
+int main()
+{
+	return ::boost::report_errors();
+}
+#endif
@@ -8,6 +8,7 @@
 #define JASEL_EXPERIMENTAL_TEST_ORDINAL_BOUNDED_HPP
 
 #include <experimental/ordinal.hpp>
+#include <cstdint>
 
 template <std::intmax_t F, std::intmax_t L, class T>
 struct Bounded {
@@ -18,7 +18,7 @@ int main()
   using Indx = Bounded<1,3,unsigned char>;
 
   {
-    stde::ordinal_array<int,Indx> arr;
+    stde::ordinal_array<int,Indx> arr{};
     BOOST_TEST(arr.size() == 3);
   }
   // fixme: shouldn't {1, 2, 3.5} work?
@@ -29,5 +29,40 @@ int main()
     BOOST_TEST(c[Indx{2}] == 2);
     BOOST_TEST(c[Indx{3}] == 3);
   }
+  {
+    stde::ordinal_array<int,Indx> c {{1, 2, 3}};
+    c.fill(Indx{2}, Indx{3}, 0);
+    BOOST_TEST(c[Indx{1}] == 1);
+    BOOST_TEST(c[Indx{2}] == 0);
+    BOOST_TEST(c[Indx{3}] == 0);
+    c.fill(Indx{1}, Indx{1}, 5);
+    BOOST_TEST(c[Indx{1}] == 5);
+  }
+  {
+    auto c = stde::tabulate<int, Indx>([](Indx k) { return 10 * k.value; });
+    BOOST_TEST(c[Indx{1}] == 10);
+    BOOST_TEST(c[Indx{2}] == 20);
+    BOOST_TEST(c[Indx{3}] == 30);
+  }
+  {
+    stde::ordinal_array<int,Indx> c {{1, 2, 3}};
+    stde::ordinal_array<double,Indx> h = stde::transform(c, [](int x) { return x / 2.0; });
+    BOOST_TEST(h[Indx{1}] == 0.5);
+    BOOST_TEST(h[Indx{3}] == 1.5);
+    stde::ordinal_array<long,Indx> s = stde::transform(c, c, [](int x, int y) { return long(x) * y; });
+    BOOST_TEST(s[Indx{2}] == 4);
+    BOOST_TEST(s[Indx{3}] == 9);
+  }
+  {
+    stde::ordinal_array<int,Indx> c {{1, 2, 3}};
+    BOOST_TEST(stde::reduce(c, 0) == 6);
+    BOOST_TEST(stde::reduce(c, 1, [](int x, int y) { return x * y; }) == 6);
+  }
+#if __cplusplus >= 201402L
+  {
+    constexpr stde::ordinal_array<int,Indx> c {{1, 2, 3}};
+    static_assert(stde::reduce(c, 0) == 6, "");
+  }
+#endif
   return ::boost::report_errors();
 }
@@ -0,0 +1,79 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <experimental/ordinal_dense_set.hpp>
+
+#include <experimental/ordinal_dense_set.hpp>
+#include "../../Bool.hpp"
+#include "../../Bounded.hpp"
+
+#include <vector>
+
+#include <boost/detail/lightweight_test.hpp>
+
+int main()
+{
+
+  namespace stde = std::experimental;
+  using Indx = Bounded<1,4,unsigned char>;
+  using OSet = stde::ordinal_dense_set<Indx>;
+
+  {// Default Constructor
+    OSet os;
+    BOOST_TEST( 0 == os.size() );
+    BOOST_TEST( os.empty() );
+    BOOST_TEST( os.begin() == os.end() );
+    static_assert(sizeof(OSet) == 1, "");
+  }
+  {// insert
+    OSet os;
+    BOOST_TEST( os.insert(Indx{1}).second );
+    BOOST_TEST( ! os.insert(Indx{1}).second );
+    BOOST_TEST( 1 == os.size() );
+    BOOST_TEST( os.find(Indx{2}) == os.end() );
+    BOOST_TEST( *os.find(Indx{1}) == Indx{1} );
+    BOOST_TEST( os.emplace(Indx{3}).second );
+    BOOST_TEST( os.count(Indx{3}) == 1 && os.contains(Indx{3}) && ! os.contains(Indx{2}) );
+  }
+  {// iteration visits the keys in increasing position
+    OSet os{ Indx{4}, Indx{2}, Indx{4} };
+    std::vector<int> v;
+    for (Indx e : os)
+      v.push_back(e.value);
+    BOOST_TEST( v == (std::vector<int>{2, 4}) );
+    BOOST_TEST( os.keys() == stde::ordinal_set<Indx>(0xA) );
+  }
+  {// erase
+    OSet os{ Indx{1}, Indx{2}, Indx{3} };
+    BOOST_TEST( os.erase(Indx{2}) == 1 );
+    BOOST_TEST( os.erase(Indx{2}) == 0 );
+    auto it = os.erase(os.begin());
+    BOOST_TEST( *it == Indx{3} );
+    BOOST_TEST( os.erase(os.begin(), os.end()) == os.end() );
+    BOOST_TEST( os.empty() );
+  }
+  {// inserting doesn't invalidate the iterators
+    OSet os{ Indx{1} };
+    auto it = os.begin();
+    os.insert(Indx{2});
+    ++it;
+    BOOST_TEST( it != os.end() && *it == Indx{2} );
+  }
+  {// swap and comparisons
+    OSet a{ Indx{1} };
+    OSet b{ Indx{2}, Indx{3} };
+    BOOST_TEST( a != b );
+    swap(a, b);
+    BOOST_TEST( a.size() == 2 && b.size() == 1 );
+    b = { Indx{2}, Indx{3} };
+    BOOST_TEST( a == b );
+  }
+  {// constexpr
+    constexpr OSet os(stde::ordinal_set<Indx>(Indx{2}));
+    static_assert(os.size() == 1 && os.contains(Indx{2}) && ! os.contains(Indx{1}), "");
+    static_assert(os.find(Indx{1}) == os.end(), "");
+  }
+  return ::boost::report_errors();
+}
@@ -0,0 +1,148 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <experimental/ordinal_map.hpp>
+
+#include <experimental/ordinal_map.hpp>
+#include "../../Bool.hpp"
+#include "../../Bounded.hpp"
+
+#include <map>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/detail/lightweight_test.hpp>
+
+int main()
+{
+
+  namespace stde = std::experimental;
+  using Indx = Bounded<1,4,unsigned char>;
+  using OMap = stde::ordinal_map<Indx, int>;
+
+  {// Default Constructor
+    OMap om;
+    BOOST_TEST( 0 == om.size() );
+    BOOST_TEST( om.empty() );
+    BOOST_TEST( om.begin() == om.end() );
+    BOOST_TEST( 4 == om.max_size() );
+  }
+  {// insert
+    OMap om;
+    auto r = om.insert(std::make_pair(Indx{1}, 123));
+    BOOST_TEST( r.second );
+    BOOST_TEST( r.first->second == 123 );
+    BOOST_TEST( 1 == om.size() );
+    BOOST_TEST( om.find(Indx{1}) != om.end() );
+    BOOST_TEST( om.find(Indx{1})->second == 123 );
+    BOOST_TEST( om.find(Indx{2}) == om.end() );
+    r = om.insert(std::make_pair(Indx{1}, 456));
+    BOOST_TEST( ! r.second );
+    BOOST_TEST( r.first->second == 123 );
+    BOOST_TEST( 1 == om.size() );
+  }
+  {// operator[], at, count and contains
+    OMap om;
+    om[Indx{3}] = 3;
+    BOOST_TEST( om[Indx{2}] == 0 );
+    BOOST_TEST( 2 == om.size() );
+    BOOST_TEST( om.at(Indx{3}) == 3 );
+    BOOST_TEST( om.count(Indx{3}) == 1 && om.count(Indx{4}) == 0 );
+    BOOST_TEST( om.contains(Indx{2}) && ! om.contains(Indx{1}) );
+    BOOST_TEST_THROWS( om.at(Indx{4}), std::out_of_range );
+  }
+  {// try_emplace and insert_or_assign
+    OMap om;
+    BOOST_TEST( om.try_emplace(Indx{2}, 2).second );
+    BOOST_TEST( ! om.try_emplace(Indx{2}, 3).second );
+    BOOST_TEST( om[Indx{2}] == 2 );
+    BOOST_TEST( ! om.insert_or_assign(Indx{2}, 4).second );
+    BOOST_TEST( om[Indx{2}] == 4 );
+    BOOST_TEST( om.insert_or_assign(Indx{4}, 5).second );
+    BOOST_TEST( om.emplace(Indx{1}, 6).second );
+    BOOST_TEST( 3 == om.size() );
+  }
+  {// iteration visits the keys in increasing position
+    OMap om{ {Indx{4}, 40}, {Indx{1}, 10}, {Indx{3}, 30} };
+    std::vector<int> v;
+    for (auto const& e : om)
+      v.push_back(e.first.value * 100 + e.second);
+    BOOST_TEST( v == (std::vector<int>{110, 330, 440}) );
+    OMap const& com = om;
+    OMap::const_iterator it = om.begin();
+    BOOST_TEST( it == com.begin() );
+    BOOST_TEST( com.keys().count() == 3 );
+  }
+  {// erase
+    OMap om{ {Indx{1}, 10}, {Indx{2}, 20}, {Indx{3}, 30}, {Indx{4}, 40} };
+    BOOST_TEST( om.erase(Indx{2}) == 1 );
+    BOOST_TEST( om.erase(Indx{2}) == 0 );
+    auto it = om.erase(om.find(Indx{3}));
+    BOOST_TEST( it->first == Indx{4} );
+    it = om.erase(om.begin(), om.end());
+    BOOST_TEST( it == om.end() );
+    BOOST_TEST( om.empty() );
+  }
+  {// inserting doesn't invalidate the iterators
+    OMap om{ {Indx{1}, 10} };
+    auto it = om.begin();
+    om[Indx{2}] = 20;
+    ++it;
+    BOOST_TEST( it != om.end() && it->second == 20 );
+  }
+  {// copy, move, swap and comparisons
+    using SMap = stde::ordinal_map<Indx, std::string>;
+    SMap a{ {Indx{1}, "one"}, {Indx{4}, "four"} };
+    SMap b = a;
+    BOOST_TEST( a == b );
+    b[Indx{4}] = "FOUR";
+    BOOST_TEST( a != b );
+    SMap c = std::move(b);
+    BOOST_TEST( c.at(Indx{4}) == "FOUR" );
+    swap(a, c);
+    BOOST_TEST( a.at(Indx{4}) == "FOUR" && c.at(Indx{4}) == "four" );
+    a = c;
+    BOOST_TEST( a == c );
+    a.clear();
+    BOOST_TEST( a.empty() && a != c );
+  }
+  {// no default constructor is needed and the elements are destroyed
+    auto p = std::make_shared<int>(1);
+    {
+      stde::ordinal_map<Indx, std::shared_ptr<int>> om;
+      om.try_emplace(Indx{1}, p);
+      om.try_emplace(Indx{3}, p);
+      BOOST_TEST( p.use_count() == 3 );
+      om.erase(Indx{1});
+      BOOST_TEST( p.use_count() == 2 );
+    }
+    BOOST_TEST( p.use_count() == 1 );
+  }
+  {// behaves as std::map
+    using Big = Bounded<0,199,int>;
+    stde::ordinal_map<Big, int> om;
+    std::map<int, int> ref;
+    std::mt19937 gen(7);
+    for (int i = 0; i < 2000; ++i)
+    {
+      int const k = int(gen() % 200);
+      if (gen() % 3 == 0)
+        BOOST_TEST( om.erase(Big{k}) == ref.erase(k) );
+      else
+        BOOST_TEST( om.insert(std::make_pair(Big{k}, i)).second == ref.insert(std::make_pair(k, i)).second );
+    }
+    BOOST_TEST( om.size() == ref.size() );
+    auto it = ref.begin();
+    for (auto const& e : om)
+    {
+      BOOST_TEST( it != ref.end() && e.first.value == it->first && e.second == it->second );
+      ++it;
+    }
+  }
+  return ::boost::report_errors();
+}
@@ -10,6 +10,12 @@
 #include "../../Bounded.hpp"
 
 #include <boost/detail/lightweight_test.hpp>
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+
+#include <functional>
 
 int main()
 {
@@ -23,5 +29,48 @@ int main()
     auto b = rng.begin();
     BOOST_TEST(b->value==1);
   }
+  {
+    using It = decltype(stde::ordinal_range<Indx>().begin());
+    static_assert(std::is_same<std::iterator_traits<It>::iterator_category, std::random_access_iterator_tag>::value, "");
+    stde::ordinal_range<Indx> rng;
+    auto b = rng.begin();
+    auto e = rng.end();
+    BOOST_TEST(e - b == 4);
+    BOOST_TEST(std::distance(b, e) == 4);
+    BOOST_TEST(b[2].value == 3);
+    BOOST_TEST((b + 3)->value == 4);
+    BOOST_TEST((e - 1)->value == 4);
+    auto it = b;
+    it += 2;
+    BOOST_TEST((*it).value == 3);
+    BOOST_TEST(it - b == 2);
+    BOOST_TEST(b - it == -2);
+    it -= 1;
+    BOOST_TEST(it->value == 2);
+    BOOST_TEST(b < it && it <= e && e > it && b >= b);
+    BOOST_TEST((it++)->value == 2);
+    BOOST_TEST((it--)->value == 3);
+    BOOST_TEST((--it)->value == 1);
+    BOOST_TEST(it == b);
+  }
+  {
+    auto rng = stde::make_range(Indx{2}, Indx{4});
+    BOOST_TEST(rng.size() == 3);
+    BOOST_TEST(std::accumulate(rng.begin(), rng.end(), 0, [](int s, Indx x) { return s + x.value; }) == 9);
+    BOOST_TEST(std::lower_bound(rng.begin(), rng.end(), Indx{3}, [](Indx x, Indx y) { return x.value < y.value; })->value == 3);
+    auto rit = std::reverse_iterator<decltype(rng.begin())>(rng.end());
+    BOOST_TEST(rit->value == 4);
+  }
+#if __cplusplus >= 201703L
+  {
+    // the algorithms that the execution policies parallelize; <execution> is not used, as libstdc++ runs them on TBB
+    // when its headers are found, which would require linking with it
+    stde::ordinal_range<Indx> rng;
+    BOOST_TEST(std::transform_reduce(rng.begin(), rng.end(), 0, std::plus<>(), [](Indx x) { return int(x.value); }) == 10);
+    int v[4] = {};
+    std::for_each(rng.begin(), rng.end(), [&v](Indx x) { v[x.value - 1] = x.value; });
+    BOOST_TEST(v[0] == 1 && v[3] == 4);
+  }
+#endif
   return ::boost::report_errors();
 }
@@ -9,6 +9,9 @@
 #include "../../Bool.hpp"
 #include "../../Bounded.hpp"
 
+#include <sstream>
+#include <vector>
+
 #include <boost/detail/lightweight_test.hpp>
 
 int main()
@@ -193,5 +196,94 @@ int main()
     auto x = ~os[Indx{1}];
     BOOST_TEST( ! x );
   }
+  { // hash
+    OSet os(Indx{3});
+    BOOST_TEST( std::hash<OSet>()(os) == std::hash<OSet>()(OSet(Indx{3})) );
+  }
+  { // set_bits and for_each_set visit the ordinals set in increasing position
+    OSet os;
+    BOOST_TEST( os.set_bits().begin() == os.set_bits().end() );
+    os.set(Indx{4});
+    os.set(Indx{2});
+    std::vector<int> v;
+    for (Indx e : os.set_bits())
+      v.push_back(e.value);
+    BOOST_TEST( v == (std::vector<int>{2, 4}) );
+    v.clear();
+    os.for_each_set([&](Indx e) { v.push_back(e.value); });
+    BOOST_TEST( v == (std::vector<int>{2, 4}) );
+  }
+  { // the bits are visited word by word
+    using Big = Bounded<0,199,int>;
+    stde::ordinal_set<Big> os;
+    std::vector<int> expected{0, 5, 63, 64, 127, 130, 199};
+    for (int i : expected)
+      os.set(Big{i});
+    std::vector<int> v;
+    for (Big e : os.set_bits())
+      v.push_back(e.value);
+    BOOST_TEST( v == expected );
+    v.clear();
+    os.for_each_set([&](Big e) { v.push_back(e.value); });
+    BOOST_TEST( v == expected );
+  }
+  { // the bits are stored in the smallest word
+    static_assert(sizeof(OSet) == 1, "");
+    static_assert(std::is_same<OSet::word_type, std::uint8_t>::value, "");
+    static_assert(sizeof(stde::ordinal_set<Bounded<0,15,int>>) == 2, "");
+    static_assert(sizeof(stde::ordinal_set<Bounded<0,63,int>>) == 8, "");
+    static_assert(sizeof(stde::ordinal_set<Bounded<0,199,int>>) == 32, "");
+  }
+  { // constexpr
+    constexpr OSet os(Indx{2});
+    static_assert(os[Indx{2}] && ! os[Indx{1}], "");
+    static_assert(os.count() == 1 && os.any() && ! os.all(), "");
+    static_assert(os == OSet(0x2) && os != OSet(), "");
+    static_assert(OSet::from_words({{0xFF}}).all(), "");
+    static_assert(OSet(0xF0).none(), "");
+#if __cplusplus >= 201402L
+    constexpr OSet os2 = OSet(Indx{1}) | OSet(Indx{4});
+    static_assert(os2.to_ulong() == 0x9, "");
+    static_assert((*os2.set_bits().begin()).value == 1, "");
+    static_assert((~os2).count() == 2, "");
+#endif
+  }
+  { // to_words and from_words
+    OSet os;
+    os.set(Indx{1});
+    os.set(Indx{3});
+    BOOST_TEST( os.to_words()[0] == 0x5 );
+    BOOST_TEST( OSet::from_words(os.to_words()) == os );
+    // the bits beyond size() are ignored
+    BOOST_TEST( OSet::from_words({{0xF5}}) == os );
+    BOOST_TEST( OSet::from_words({{0xF5}}).to_words()[0] == 0x5 );
+
+    using Big = Bounded<0,199,int>;
+    using BigSet = stde::ordinal_set<Big>;
+    BigSet big;
+    big.set(Big{0});
+    big.set(Big{64});
+    big.set(Big{199});
+    BigSet::words_type w = big.to_words();
+    BOOST_TEST( w.size() == 4u );
+    BOOST_TEST( w[0] == 1u && w[1] == 1u && w[2] == 0u && w[3] == (std::uint64_t(1) << 7) );
+    w[3] |= ~std::uint64_t(0xFF);
+    BOOST_TEST( BigSet::from_words(w) == big );
+    BOOST_TEST( (~big).count() == 197 );
+    BOOST_TEST( (big << 1).to_words()[3] == 0u );
+    BOOST_TEST( BigSet(0x3).count() == 2 );
+  }
+  { // stream output and input
+    OSet os;
+    os.set(Indx{1});
+    os.set(Indx{2});
+    std::ostringstream out;
+    out << os;
+    BOOST_TEST( out.str() == "0011" );
+    std::istringstream in("1001");
+    OSet is;
+    in >> is;
+    BOOST_TEST( is == OSet(0x9) );
+  }
   return ::boost::report_errors();
 }
@@ -0,0 +1,108 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <experimental/ordinal_sparse_traits.hpp>
+
+#if __cplusplus >= 201402L
+
+#include <experimental/ordinal_sparse_traits.hpp>
+#include <experimental/ordinal_set.hpp>
+
+#include <cstdint>
+#include <utility>
+
+#include <boost/detail/lightweight_test.hpp>
+
+enum class color { red = 1, green = 10, blue = 50 };
+enum class code : std::int32_t { low = -2000000000, zero = 0, mid = 12345, high = 2000000000 };
+
+namespace std
+{
+namespace experimental
+{
+inline namespace fundamental_v3
+{
+  namespace ordinal {
+    template <>
+    struct traits<color> : sparse_traits<color, color::red, color::green, color::blue> {};
+    template <>
+    struct traits<code> : sparse_traits<code, code::high, code::low, code::zero, code::mid> {};
+  }
+}}
+}
+
+namespace stde = std::experimental;
+
+// n values spread over the 32 bits, so that a perfect hash is needed
+constexpr std::uint32_t spread(std::size_t i) { return std::uint32_t(i) * 2654435761u; }
+
+template <class Seq>
+struct spread_traits;
+template <std::size_t... I>
+struct spread_traits<std::index_sequence<I...>>
+{
+  using type = stde::ordinal::sparse_traits<std::uint32_t, spread(I)...>;
+};
+
+template <std::size_t N>
+void test_spread()
+{
+  using Tr = typename spread_traits<std::make_index_sequence<N>>::type;
+  static_assert(N == 1 || ! Tr::direct, "");
+  static_assert(Tr::size_v == N, "");
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    BOOST_TEST( Tr::pos(spread(i)) == stde::ordinal::index_t(i) );
+    BOOST_TEST( Tr::val(Tr::pos(spread(i))) == spread(i) );
+    BOOST_TEST( Tr::contains(spread(i)) );
+  }
+  for (std::size_t i = N; i < 2 * N + 10; ++i)
+    BOOST_TEST( ! Tr::contains(spread(i)) );
+}
+
+int main()
+{
+  { // direct table
+    using Tr = stde::ordinal::traits<color>;
+    static_assert(Tr::direct, "");
+    static_assert(stde::ordinal::size<color>() == 3, "");
+    static_assert(stde::ordinal::pos(color::red) == 0, "");
+    static_assert(stde::ordinal::pos(color::green) == 1, "");
+    static_assert(stde::ordinal::pos(color::blue) == 2, "");
+    static_assert(stde::ordinal::val<color>(1) == color::green, "");
+    static_assert(Tr::contains(color::blue) && ! Tr::contains(color(2)) && ! Tr::contains(color(1000)), "");
+    BOOST_TEST( stde::ordinal::succ(color::red) == color::green );
+    color c = color::blue;
+    BOOST_TEST( stde::ordinal::pos(c) == 2 );
+  }
+  { // perfect hash of signed values
+    using Tr = stde::ordinal::traits<code>;
+    static_assert(! Tr::direct, "");
+    static_assert(stde::ordinal::pos(code::high) == 0, "");
+    static_assert(stde::ordinal::pos(code::low) == 1, "");
+    static_assert(stde::ordinal::pos(code::zero) == 2, "");
+    static_assert(stde::ordinal::pos(code::mid) == 3, "");
+    static_assert(! Tr::contains(code(1)), "");
+    code c = code::mid;
+    BOOST_TEST( stde::ordinal::pos(c) == 3 );
+    BOOST_TEST( stde::ordinal::val<code>(1) == code::low );
+  }
+  { // usable by the ordinal containers
+    stde::ordinal_set<color> s(color::blue);
+    BOOST_TEST( s[color::blue] && ! s[color::red] );
+  }
+  test_spread<1>();
+  test_spread<10>();
+  test_spread<100>();
+  test_spread<1000>();
+  return ::boost::report_errors();
+}
+
+#else
+int main()
+{
+
+}
+#endif
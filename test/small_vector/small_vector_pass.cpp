@@ -0,0 +1,388 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <experimental/small_vector.hpp>
+
+#include <experimental/small_vector.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <boost/detail/lightweight_test.hpp>
+
+#if __cplusplus >= 201103L
+namespace stdex = std::experimental;
+
+// Counts its moves, so that the relocations done by a memcpy can be told apart.
+struct relocatable
+{
+	static int moves;
+	int        value;
+	std::unique_ptr<int> owned;
+
+	explicit relocatable(int v)
+	        : value(v), owned(new int(v)) {}
+	relocatable(relocatable &&other) noexcept
+	        : value(other.value), owned(std::move(other.owned))
+	{
+		++moves;
+	}
+	relocatable &operator=(relocatable &&other) noexcept
+	{
+		value = other.value;
+		owned = std::move(other.owned);
+		++moves;
+		return *this;
+	}
+};
+int relocatable::moves = 0;
+
+namespace std
+{
+template <>
+struct is_trivially_relocatable<relocatable> : true_type
+{
+};
+} // namespace std
+
+// Counts the live allocations.
+template <class T>
+struct counting_allocator
+{
+	using value_type = T;
+	static int live;
+
+	counting_allocator() = default;
+	template <class U>
+	counting_allocator(counting_allocator<U> const &) noexcept
+	{
+	}
+	T *allocate(std::size_t n)
+	{
+		++live;
+		return std::allocator<T>().allocate(n);
+	}
+	void deallocate(T *p, std::size_t n) noexcept
+	{
+		--live;
+		std::allocator<T>().deallocate(p, n);
+	}
+	friend bool operator==(counting_allocator const &, counting_allocator const &) noexcept
+	{
+		return true;
+	}
+	friend bool operator!=(counting_allocator const &, counting_allocator const &) noexcept
+	{
+		return false;
+	}
+};
+template <class T>
+int counting_allocator<T>::live = 0;
+
+// Its move constructor may throw, so that the growths copy it. The copies throw once their count reaches limit.
+struct throwing_move
+{
+	static int copies;
+	static int limit;
+	int        value;
+
+	explicit throwing_move(int v)
+	        : value(v) {}
+	throwing_move(throwing_move const &other)
+	        : value(other.value)
+	{
+		if (++copies == limit)
+			throw 0;
+	}
+	throwing_move(throwing_move &&other)
+	        : value(other.value)
+	{
+		other.value = -1;
+	}
+	throwing_move &operator=(throwing_move const &) = default;
+};
+int throwing_move::copies = 0;
+int throwing_move::limit  = 0;
+
+// Its constructor from int throws on the negative values.
+struct non_negative
+{
+	int value;
+
+	explicit non_negative(int v)
+	        : value(v)
+	{
+		if (v < 0)
+			throw 0;
+	}
+};
+
+// An allocator propagated on move assignment, equal to the allocators having the same id.
+template <class T>
+struct tagged_allocator
+{
+	using value_type                             = T;
+	using propagate_on_container_move_assignment = std::true_type;
+	int id;
+
+	explicit tagged_allocator(int i) noexcept
+	        : id(i) {}
+	template <class U>
+	tagged_allocator(tagged_allocator<U> const &other) noexcept
+	        : id(other.id)
+	{
+	}
+	T *allocate(std::size_t n)
+	{
+		return std::allocator<T>().allocate(n);
+	}
+	void deallocate(T *p, std::size_t n) noexcept
+	{
+		std::allocator<T>().deallocate(p, n);
+	}
+	friend bool operator==(tagged_allocator const &x, tagged_allocator const &y) noexcept
+	{
+		return x.id == y.id;
+	}
+	friend bool operator!=(tagged_allocator const &x, tagged_allocator const &y) noexcept
+	{
+		return x.id != y.id;
+	}
+};
+
+int sum(stdex::span<int const> s)
+{
+	int r = 0;
+	for (int x : s)
+		r += x;
+	return r;
+}
+
+int main()
+{
+	{
+		stdex::small_vector<int, 4> const v;
+		BOOST_TEST(v.empty());
+		BOOST_TEST(v.size() == 0);
+		BOOST_TEST(v.capacity() == 4);
+		BOOST_TEST(v.inline_capacity() == 4);
+		BOOST_TEST(v.is_inline());
+	}
+	{
+		// spill to the heap and shrink back
+		using vector_type = stdex::small_vector<int, 4, counting_allocator<int>>;
+		{
+			vector_type v;
+			for (int i = 0; i < 4; ++i)
+				v.push_back(i);
+			BOOST_TEST(v.is_inline());
+			BOOST_TEST(counting_allocator<int>::live == 0);
+			v.push_back(4);
+			BOOST_TEST(!v.is_inline());
+			BOOST_TEST(v.capacity() == 8);
+			BOOST_TEST(counting_allocator<int>::live == 1);
+			for (int i = 0; i < 5; ++i)
+				BOOST_TEST(v[i] == i);
+			for (int i = 5; i < 100; ++i)
+				v.push_back(i);
+			BOOST_TEST(v.size() == 100);
+			BOOST_TEST(v.capacity() == 128);
+			BOOST_TEST(counting_allocator<int>::live == 1);
+			BOOST_TEST(sum(v.as_span()) == 4950);
+			v.resize(3);
+			v.shrink_to_fit();
+			BOOST_TEST(v.is_inline());
+			BOOST_TEST(v.capacity() == 4);
+			BOOST_TEST(counting_allocator<int>::live == 0);
+			BOOST_TEST(v == (vector_type{0, 1, 2}));
+			v.reserve(10);
+			BOOST_TEST(v.capacity() == 10);
+			BOOST_TEST(v == (vector_type{0, 1, 2}));
+		}
+		BOOST_TEST(counting_allocator<int>::live == 0);
+	}
+	{
+		// the element added can be one of the elements moved
+		stdex::small_vector<std::string, 2> v{"a long enough string not to be inline", "b"};
+		v.push_back(v[0]);
+		BOOST_TEST(v.size() == 3);
+		BOOST_TEST(v[2] == v[0]);
+		v.emplace_back(v[1]);
+		BOOST_TEST(v[3] == "b");
+		v.insert(v.begin() + 1, stdex::length_tag_t{}, 5, v[3]);
+		BOOST_TEST(v.size() == 9);
+		BOOST_TEST(v[1] == "b" && v[5] == "b" && v[6] == "b");
+		BOOST_TEST(v[7] == v[0]);
+		v.insert(v.begin(), v.begin() + 6, v.end());
+		BOOST_TEST(v.size() == 12);
+		BOOST_TEST(v[0] == "b" && v[1] == v[10] && v[2] == "b");
+	}
+	{
+		// insertions and erasures
+		stdex::small_vector<int, 4> v{1, 5};
+		v.insert(v.begin() + 1, {2, 3, 4});
+		BOOST_TEST((v == stdex::small_vector<int, 4>{1, 2, 3, 4, 5}));
+		std::list<int> l{7, 8};
+		v.insert(v.end(), l.begin(), l.end());
+		v.emplace(v.begin() + 5, 6);
+		BOOST_TEST((v == stdex::small_vector<int, 4>{1, 2, 3, 4, 5, 6, 7, 8}));
+		BOOST_TEST(*v.erase(v.begin() + 1, v.begin() + 3) == 4);
+		v.pop_back();
+		BOOST_TEST((v == stdex::small_vector<int, 4>{1, 4, 5, 6, 7}));
+		v.assign(stdex::length_tag_t{}, 2, 9);
+		BOOST_TEST((v == stdex::small_vector<int, 4>{9, 9}));
+		BOOST_TEST(!v.is_inline());
+		BOOST_TEST((stdex::small_vector<int, 4>{1, 2} < stdex::small_vector<int, 4>{1, 3}));
+		BOOST_TEST((stdex::small_vector<int, 4>{1, 2} != stdex::small_vector<int, 4>{1, 2, 3}));
+	}
+	{
+		// copy, move and swap, inline and on the heap
+		using vector_type = stdex::small_vector<std::string, 2>;
+		vector_type small{"a"};
+		vector_type large{"b", "c", "d"};
+		vector_type c1(small);
+		vector_type c2(large);
+		BOOST_TEST(c1 == small && c1.is_inline());
+		BOOST_TEST(c2 == large && !c2.is_inline());
+		std::string const *data = c2.data();
+		vector_type m2(std::move(c2));
+		BOOST_TEST(m2.data() == data);
+		BOOST_TEST(c2.empty() && c2.is_inline());
+		vector_type m1(std::move(c1));
+		BOOST_TEST(m1 == small && c1.empty());
+		m1 = std::move(m2);
+		BOOST_TEST(m1 == large && m1.data() == data);
+		m2 = small;
+		BOOST_TEST(m2 == small);
+		m1 = m2;
+		BOOST_TEST(m1 == small && !m1.is_inline());
+		vector_type s1{"x"};
+		vector_type s2{"y", "z", "w"};
+		swap(s1, s2);
+		BOOST_TEST((s1 == vector_type{"y", "z", "w"}));
+		BOOST_TEST((s2 == vector_type{"x"}));
+		s1.swap(s2);
+		BOOST_TEST((s1 == vector_type{"x"}));
+	}
+	{
+		// move only elements
+		stdex::small_vector<std::unique_ptr<int>, 2> v;
+		for (int i = 0; i < 5; ++i)
+			v.emplace_back(new int(i));
+		v.insert(v.begin(), std::unique_ptr<int>(new int(-1)));
+		BOOST_TEST(v.size() == 6);
+		BOOST_TEST(*v[0] == -1 && *v[5] == 4);
+		auto w = std::move(v);
+		BOOST_TEST(*w[1] == 0);
+	}
+	{
+		// the trivially relocatable elements are relocated by a memcpy
+		stdex::small_vector<relocatable, 2> v;
+		v.emplace_back(1);
+		v.emplace_back(2);
+		relocatable::moves = 0;
+		v.emplace_back(3);
+		v.reserve(100);
+		BOOST_TEST(relocatable::moves == 0);
+		v.pop_back();
+		v.shrink_to_fit();
+		BOOST_TEST(v.is_inline());
+		auto w = std::move(v);
+		BOOST_TEST(relocatable::moves == 0);
+		BOOST_TEST(w.size() == 2 && *w[0].owned == 1 && *w[1].owned == 2);
+	}
+	{
+		// the growths copy the elements whose move may throw: the elements are unchanged when a copy throws
+		stdex::small_vector<throwing_move, 2> v;
+		v.emplace_back(1);
+		v.emplace_back(2);
+		throwing_move::copies = 0;
+		throwing_move::limit  = 2;
+		bool thrown           = false;
+		try
+		{
+			v.emplace_back(3);
+		}
+		catch (int)
+		{
+			thrown = true;
+		}
+		BOOST_TEST(thrown);
+		BOOST_TEST(v.size() == 2 && v.is_inline());
+		BOOST_TEST(v[0].value == 1 && v[1].value == 2);
+		throwing_move::limit = 0;
+		v.emplace_back(3);
+		BOOST_TEST(v.size() == 3 && v[0].value == 1 && v[1].value == 2 && v[2].value == 3);
+		v.pop_back();
+		throwing_move::copies = 0;
+		v.shrink_to_fit();
+		BOOST_TEST(v.is_inline() && throwing_move::copies == 2);
+	}
+	{
+		// the elements read from input iterators are removed when the construction of one of them throws
+		stdex::small_vector<non_negative, 2> v;
+		v.emplace_back(1);
+		v.emplace_back(5);
+		std::istringstream is("2 3 4 -1 6");
+		bool thrown = false;
+		try
+		{
+			v.insert(v.begin() + 1, std::istream_iterator<int>(is), std::istream_iterator<int>());
+		}
+		catch (int)
+		{
+			thrown = true;
+		}
+		BOOST_TEST(thrown);
+		BOOST_TEST(v.size() == 2);
+		BOOST_TEST(v[0].value == 1 && v[1].value == 5);
+	}
+	{
+		// the allocator propagated on move assignment is propagated when the elements are inline too
+		using vector_type = stdex::small_vector<int, 2, tagged_allocator<int>>;
+		vector_type heap(tagged_allocator<int>(1));
+		heap.assign({1, 2, 3});
+		vector_type small(tagged_allocator<int>(2));
+		small.push_back(4);
+		heap = std::move(small);
+		BOOST_TEST(heap.get_allocator().id == 2);
+		BOOST_TEST(heap.is_inline() && heap.size() == 1 && heap[0] == 4);
+		vector_type large(tagged_allocator<int>(3));
+		large.assign({5, 6, 7});
+		heap = std::move(large);
+		BOOST_TEST(heap.get_allocator().id == 3);
+		BOOST_TEST((heap == vector_type({5, 6, 7}, tagged_allocator<int>(3))));
+	}
+	{
+		// resize
+		stdex::small_vector<int, 4> v(stdex::length_tag_t{}, 3);
+		BOOST_TEST((v == stdex::small_vector<int, 4>{0, 0, 0}));
+		v.resize(6, 1);
+		BOOST_TEST((v == stdex::small_vector<int, 4>{0, 0, 0, 1, 1, 1}));
+		v.resize_and_overwrite(10, [](int *p, std::size_t n) {
+			for (std::size_t i = 0; i < n; ++i)
+				p[i] = int(i);
+			return n / 2;
+		});
+		BOOST_TEST((v == stdex::small_vector<int, 4>{0, 1, 2, 3, 4}));
+		v.resize_default_init(7);
+		BOOST_TEST(v.size() == 7);
+		stdex::span<int> s = v;
+		BOOST_TEST(s.size() == 7 && s.data() == v.data());
+	}
+	return ::boost::report_errors();
+}
+#else
+int main()
+{
+	return ::boost::report_errors();
+}
+#endif
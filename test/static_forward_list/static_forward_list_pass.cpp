@@ -10,10 +10,20 @@
 #include <experimental/static_forward_list.hpp>
 
 #include <boost/detail/lightweight_test.hpp>
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
 
 #if __cplusplus >= 201103L
 namespace stdex = std::experimental;
 
+template <class List>
+std::vector<typename List::value_type> elements(List const &l)
+{
+	return std::vector<typename List::value_type>(l.begin(), l.end());
+}
+
 int main()
 {
 	std::cout << ">>>>> " << __LINE__ << std::endl;
@@ -242,6 +252,192 @@ int main()
 		BOOST_TEST_EQ(*it2, 2);
 		BOOST_TEST_EQ(4, cont.size());
 	}
+	std::cout << ">>>>> " << __LINE__ << std::endl;
+	{
+		//Arrange
+		stdex::static_forward_list<int, 5> cont = {1, 2, 3};
+		//Action
+		stdex::static_forward_list<int, 5> copy(cont);
+		cont.clear();
+		cont.push_front(4);
+		//Assert
+		BOOST_TEST(elements(copy) == (std::vector<int>{1, 2, 3}));
+		BOOST_TEST(elements(cont) == (std::vector<int>{4}));
+	}
+	std::cout << ">>>>> " << __LINE__ << std::endl;
+	{
+		//Arrange
+		stdex::static_forward_list<int, 5> cont = {1, 2, 3, 4};
+		//Action
+		auto it = cont.erase_after(cont.begin());
+		//Assert
+		BOOST_TEST_EQ(*it, 3);
+		BOOST_TEST(elements(cont) == (std::vector<int>{1, 3, 4}));
+		//Action
+		cont.erase_after(cont.before_begin(), ++cont.begin());
+		cont.push_front(5);
+		cont.push_front(6);
+		//Assert
+		BOOST_TEST(elements(cont) == (std::vector<int>{6, 5, 3, 4}));
+		BOOST_TEST_EQ(4, cont.size());
+	}
+	std::cout << ">>>>> " << __LINE__ << std::endl;
+	{
+		//Arrange
+		int const                           a[] = {5, 3, 9, 1, 3, 7, 2, 8, 6, 3, 0, 4};
+		stdex::static_forward_list<int, 16> cont(a, a + 12);
+		int *                               first = &cont.front();
+		//Action
+		cont.sort();
+		//Assert
+		BOOST_TEST(elements(cont) == (std::vector<int>{0, 1, 2, 3, 3, 3, 4, 5, 6, 7, 8, 9}));
+		BOOST_TEST_EQ(12, cont.size());
+		// the nodes are relinked, the values don't move
+		BOOST_TEST_EQ(*first, 5);
+		//Action
+		cont.sort([](int x, int y) { return x > y; });
+		//Assert
+		BOOST_TEST(elements(cont) == (std::vector<int>{9, 8, 7, 6, 5, 4, 3, 3, 3, 2, 1, 0}));
+	}
+	std::cout << ">>>>> " << __LINE__ << std::endl;
+	{
+		// the elements are kept when the comparison throws, whichever comparison it is
+		std::vector<std::string> const a = {"e", "c", "i", "a", "c", "g", "b", "h", "f", "c", "0", "d"};
+		for (int limit = 1; limit < 60; ++limit)
+		{
+			//Arrange
+			stdex::static_forward_list<std::string, 16> cont(a.begin(), a.end());
+			int                                          compared = 0;
+			bool                                         thrown   = false;
+			//Action
+			try
+			{
+				cont.sort([&](std::string const &x, std::string const &y) {
+					if (++compared == limit)
+						throw 0;
+					return x < y;
+				});
+			}
+			catch (int)
+			{
+				thrown = true;
+			}
+			//Assert
+			BOOST_TEST_EQ(12, cont.size());
+			std::vector<std::string> e = elements(cont);
+			BOOST_TEST_EQ(12u, e.size());
+			if (!thrown)
+				BOOST_TEST(std::is_sorted(e.begin(), e.end()));
+			std::sort(e.begin(), e.end());
+			std::vector<std::string> sorted = a;
+			std::sort(sorted.begin(), sorted.end());
+			BOOST_TEST(e == sorted);
+			cont.clear();
+			BOOST_TEST(cont.empty());
+		}
+	}
+	{
+		// the sort is stable
+		//Arrange
+		using P = std::pair<int, int>;
+		stdex::static_forward_list<P, 8> cont = {{2, 0}, {1, 1}, {2, 2}, {1, 3}, {0, 4}, {2, 5}};
+		//Action
+		cont.sort([](P const &x, P const &y) { return x.first < y.first; });
+		//Assert
+		BOOST_TEST(elements(cont) == (std::vector<P>{{0, 4}, {1, 1}, {1, 3}, {2, 0}, {2, 2}, {2, 5}}));
+	}
+	std::cout << ">>>>> " << __LINE__ << std::endl;
+	{
+		//Arrange
+		stdex::static_forward_list<std::string, 8> cont  = {"a", "c", "e"};
+		stdex::static_forward_list<std::string, 8> other = {"b", "c", "f", "g"};
+		//Action
+		cont.merge(other);
+		//Assert
+		BOOST_TEST(elements(cont) == (std::vector<std::string>{"a", "b", "c", "c", "e", "f", "g"}));
+		BOOST_TEST(other.empty());
+		BOOST_TEST_EQ(7, cont.size());
+		//Action
+		other.push_front("z");
+		//Assert
+		BOOST_TEST_EQ(1, other.size());
+	}
+	std::cout << ">>>>> " << __LINE__ << std::endl;
+	{
+		//Arrange
+		stdex::static_forward_list<int, 4> cont  = {1, 2};
+		stdex::static_forward_list<int, 4> other = {3, 4, 5};
+		//Action
+		try
+		{
+			cont.merge(other);
+			BOOST_TEST(false);
+		}
+		catch (...)
+		{
+			//Assert
+			BOOST_TEST_EQ(2, cont.size());
+			BOOST_TEST_EQ(3, other.size());
+		}
+	}
+	std::cout << ">>>>> " << __LINE__ << std::endl;
+	{
+		//Arrange
+		stdex::static_forward_list<int, 8> cont  = {1, 5};
+		stdex::static_forward_list<int, 8> other = {2, 3, 4};
+		//Action
+		cont.splice_after(cont.begin(), other);
+		//Assert
+		BOOST_TEST(elements(cont) == (std::vector<int>{1, 2, 3, 4, 5}));
+		BOOST_TEST(other.empty());
+		//Action
+		other.splice_after(other.before_begin(), cont, cont.begin());
+		//Assert
+		BOOST_TEST(elements(cont) == (std::vector<int>{1, 3, 4, 5}));
+		BOOST_TEST(elements(other) == (std::vector<int>{2}));
+		//Action
+		auto last = cont.begin();
+		++++last;
+		other.splice_after(other.begin(), cont, cont.before_begin(), last);
+		//Assert
+		BOOST_TEST(elements(cont) == (std::vector<int>{4, 5}));
+		BOOST_TEST(elements(other) == (std::vector<int>{2, 1, 3}));
+		BOOST_TEST_EQ(2, cont.size());
+		BOOST_TEST_EQ(3, other.size());
+	}
+	std::cout << ">>>>> " << __LINE__ << std::endl;
+	{
+		// splice within a list relinks the nodes
+		//Arrange
+		stdex::static_forward_list<int, 8> cont = {1, 2, 3, 4, 5};
+		int *                              three = &*++++cont.begin();
+		//Action
+		cont.splice_after(cont.before_begin(), cont, ++cont.begin());
+		//Assert
+		BOOST_TEST(elements(cont) == (std::vector<int>{3, 1, 2, 4, 5}));
+		BOOST_TEST_EQ(&cont.front(), three);
+		//Action
+		auto last = cont.begin();
+		++++++last;
+		cont.splice_after(last, cont, cont.before_begin(), last);
+		//Assert
+		BOOST_TEST(elements(cont) == (std::vector<int>{4, 3, 1, 2, 5}));
+		BOOST_TEST_EQ(5, cont.size());
+	}
+	std::cout << ">>>>> " << __LINE__ << std::endl;
+	{
+		//Arrange
+		stdex::static_forward_list<int, 8> cont = {1, 1, 2, 3, 3, 3, 4, 1};
+		//Action & Assert
+		BOOST_TEST_EQ(3, cont.unique());
+		BOOST_TEST(elements(cont) == (std::vector<int>{1, 2, 3, 4, 1}));
+		BOOST_TEST_EQ(2, cont.remove(1));
+		BOOST_TEST(elements(cont) == (std::vector<int>{2, 3, 4}));
+		BOOST_TEST_EQ(1, cont.remove_if([](int x) { return x % 2 != 0; }));
+		cont.reverse();
+		BOOST_TEST(elements(cont) == (std::vector<int>{4, 2}));
+		BOOST_TEST_EQ(2, cont.size());
+	}
 
 	std::cout << ">>>>> " << __LINE__ << std::endl;
 	return ::boost::report_errors();
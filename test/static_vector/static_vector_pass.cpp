@@ -8,6 +8,14 @@
 #define JASEL_CONFIG_CONTRACT_VIOLATION_THROWS_V 1
 #include <experimental/static_vector.hpp>
 
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
 #include <boost/detail/lightweight_test.hpp>
 
 #if __cplusplus >= 201103L
@@ -338,6 +346,142 @@ int main()
 		std::cout << ex.what() << std::endl;
 		BOOST_TEST(false);
 	}
+	{
+		static_assert(std::is_trivially_copyable<stdex::static_vector<int, 5>>::value, "");
+		static_assert(!std::is_trivially_copyable<stdex::static_vector<std::string, 5>>::value, "");
+		stdex::static_vector<int, 5> sv = {1, 2, 3};
+		stdex::static_vector<int, 5> sw;
+		std::memcpy(static_cast<void *>(&sw), &sv, sizeof(sv));
+		BOOST_TEST(sw == sv);
+	}
+	{
+		// the size is stored in the smallest unsigned type holding the capacity
+		static_assert(sizeof(stdex::static_vector<char, 15>) == 16, "");
+		static_assert(sizeof(stdex::static_vector<std::uint16_t, 255>) == 512, "");
+		static_assert(sizeof(stdex::static_vector<std::uint32_t, 1024>) == 4 * 1024 + 4, "");
+		stdex::static_vector<char, 255> sv(stdex::length_tag_t{}, 255, 'a');
+		BOOST_TEST(sv.size() == 255);
+		BOOST_TEST(sv.full());
+		sv.clear();
+		BOOST_TEST(sv.empty());
+	}
+	{
+		std::list<int> l = {3, 4, 5};
+		stdex::static_vector<int, 8> sv = {1, 2, 6};
+		auto it = sv.insert(sv.begin() + 2, l.begin(), l.end());
+		BOOST_TEST(it == sv.begin() + 2);
+		BOOST_TEST(sv.size() == 6);
+		for (int i = 0; i < 6; ++i)
+			BOOST_TEST(sv[i] == i + 1);
+		std::istringstream is("7 8");
+		sv.insert(sv.end(), std::istream_iterator<int>(is), std::istream_iterator<int>());
+		BOOST_TEST(sv.size() == 8);
+		BOOST_TEST(sv[7] == 8);
+	}
+	{
+		// the elements read from input iterators are removed when one of them does not fit
+		stdex::static_vector<std::string, 4> sv = {"a", "d"};
+		std::istringstream is("b c e");
+		bool thrown = false;
+		try
+		{
+			sv.insert(sv.begin() + 1, std::istream_iterator<std::string>(is), std::istream_iterator<std::string>());
+		}
+		catch (...)
+		{
+			thrown = true;
+		}
+		BOOST_TEST(thrown);
+		BOOST_TEST(sv.size() == 2);
+		BOOST_TEST(sv[0] == "a" && sv[1] == "d");
+	}
+	{
+		stdex::static_vector<std::string, 8> sv = {"a", "d"};
+		std::string const s[] = {"b", "c"};
+		sv.insert(sv.begin() + 1, s, s + 2);
+		sv.insert(sv.end(), stdex::length_tag_t{}, 2, "e");
+		BOOST_TEST(sv.size() == 6);
+		BOOST_TEST(sv[1] == "b");
+		BOOST_TEST(sv[2] == "c");
+		BOOST_TEST(sv[3] == "d");
+		BOOST_TEST(sv[5] == "e");
+		std::string m = "m";
+		sv.insert(sv.begin(), std::move(m));
+		BOOST_TEST(sv[0] == "m");
+		sv.clear();
+		BOOST_TEST(sv.empty());
+		sv.push_back("z");
+		BOOST_TEST(sv.size() == 1);
+	}
+	{
+		stdex::static_vector<std::string, 5> sv = {"a", "b", "c"};
+		stdex::static_vector<std::string, 5> sw(sv);
+		BOOST_TEST(sw == sv);
+		stdex::static_vector<std::string, 5> sx(std::move(sw));
+		BOOST_TEST(sx == sv);
+		sx = {"x"};
+		BOOST_TEST(sx.size() == 1);
+		sx = sv;
+		BOOST_TEST(sx == sv);
+		auto &self = sx;
+		sx = self;
+		BOOST_TEST(sx == sv);
+	}
+	{
+		stdex::static_vector<int, 8> sv = {1, 2};
+		sv.resize(4, 7);
+		BOOST_TEST(sv.size() == 4);
+		BOOST_TEST(sv[3] == 7);
+		sv.resize(1);
+		BOOST_TEST(sv.size() == 1);
+		sv.resize(3);
+		BOOST_TEST(sv[2] == 0);
+	}
+	{
+		stdex::static_vector<char, 16> sv = {'a'};
+		sv.resize_default_init(5);
+		BOOST_TEST(sv.size() == 5);
+		BOOST_TEST(sv[0] == 'a');
+		sv.resize_default_init(2);
+		BOOST_TEST(sv.size() == 2);
+		sv.resize_and_overwrite(sv.capacity(), [](char *p, std::size_t n) {
+			BOOST_TEST(n == 16);
+			std::memcpy(p, "frame", 5);
+			return 5;
+		});
+		BOOST_TEST(sv.size() == 5);
+		BOOST_TEST(std::string(sv.begin(), sv.end()) == "frame");
+	}
+	{
+		stdex::static_vector<std::string, 4> sv;
+		sv.resize_default_init(2);
+		BOOST_TEST(sv.size() == 2);
+		BOOST_TEST(sv[1].empty());
+		sv.resize_and_overwrite(3, [](std::string *p, std::size_t) {
+			p[0] = "x";
+			return 1;
+		});
+		BOOST_TEST(sv.size() == 1);
+		BOOST_TEST(sv[0] == "x");
+	}
+	{
+		stdex::static_vector<std::string, 2> sv;
+		BOOST_TEST(sv.unchecked_emplace_back(3, 'a') == "aaa");
+		std::string *p = sv.try_emplace_back("b");
+		BOOST_TEST(p == &sv.back());
+		BOOST_TEST(*p == "b");
+		BOOST_TEST(sv.try_emplace_back("c") == nullptr);
+		BOOST_TEST(sv.try_push_back(std::string("d")) == nullptr);
+		BOOST_TEST(sv.size() == 2);
+		sv.pop_back();
+		BOOST_TEST(sv.unchecked_push_back(std::string("e")) == "e");
+		BOOST_TEST(sv.full());
+#if !defined NDEBUG
+		// the audit precondition is checked in the debug builds
+		BOOST_TEST_THROWS(sv.unchecked_emplace_back("f"), stdex::contract_violation);
+		BOOST_TEST(sv.size() == 2);
+#endif
+	}
 	return ::boost::report_errors();
 }
 
@@ -0,0 +1,128 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <experimental/compact_array.hpp>
+
+#include <experimental/compact_array.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/detail/lightweight_test.hpp>
+
+namespace stde = std::experimental;
+
+template <class T, std::size_t N, class Block, int Bits>
+void test_compact_array()
+{
+  using array_t = stde::compact_array<T, N, Block, Bits>;
+  constexpr std::size_t per_block = std::numeric_limits<Block>::digits / Bits;
+  constexpr T mask = T(stde::bit_ops::up_to<Bits, std::uint64_t>());
+
+  static_assert(sizeof(array_t) == (N + per_block - 1) / per_block * sizeof(Block), "Bad sizeof");
+  static_assert(array_t::block_count == (N + per_block - 1) / per_block, "Bad block_count");
+
+  std::mt19937_64 gen(N * Bits);
+  std::vector<T> model(N);
+  for (auto& v : model)
+    v = T(gen() & mask);
+
+  array_t a;
+  BOOST_TEST_EQ( a.size(), N );
+  BOOST_TEST( std::all_of(a.begin(), a.end(), [](T v) { return v == 0; }) );
+  for (std::size_t k = 0; k < N; ++k)
+    a[k] = model[k];
+  array_t const& ca = a;
+  for (std::size_t k = 0; k < N; ++k)
+  {
+    BOOST_TEST_EQ( ca[k], model[k] );
+    BOOST_TEST_EQ( T(a[k]), model[k] );
+  }
+  BOOST_TEST_EQ( ca.front(), model.front() );
+  BOOST_TEST_EQ( ca.back(), model.back() );
+  BOOST_TEST_EQ( ca.at(N - 1), model.back() );
+  BOOST_TEST_THROWS( ca.at(N), std::out_of_range );
+
+  { // iterators
+    BOOST_TEST_EQ( std::size_t(ca.end() - ca.begin()), N );
+    BOOST_TEST( std::equal(ca.begin(), ca.end(), model.begin()) );
+    BOOST_TEST( std::equal(a.rbegin(), a.rend(), model.rbegin()) );
+    BOOST_TEST_EQ( T(ca.begin()[N / 2]), model[N / 2] );
+    BOOST_TEST_EQ( T(*(ca.end() - 1)), model.back() );
+    auto it = a.begin() + std::ptrdiff_t(N / 2);
+    *it = T(mask - 1);
+    BOOST_TEST_EQ( ca[N / 2], T(mask - 1) );
+    a[N / 2] = model[N / 2];
+  }
+  { // bulk conversions
+    std::vector<T> out(N);
+    ca.unpack_to(out);
+    BOOST_TEST( out == model );
+
+    array_t b;
+    b.pack_from(model);
+    BOOST_TEST( b == a );
+    std::reverse(model.begin(), model.end());
+    b.pack_from(model);
+    for (std::size_t k = 0; k < N; ++k)
+      BOOST_TEST_EQ( b[k], model[k] );
+    BOOST_TEST( b != a );
+    std::reverse(model.begin(), model.end());
+  }
+  { // the bits that don't fit are discarded, and don't change the neighbours
+    array_t b;
+    b[1] = T(~T(0));
+    BOOST_TEST_EQ( b[1], mask );
+    BOOST_TEST_EQ( b[0], 0u );
+    BOOST_TEST_EQ( b[2], 0u );
+    b[1] = T(0);
+    BOOST_TEST( b == array_t() );
+  }
+  { // fill, swap and ordering
+    array_t b;
+    b.fill(T(5 & mask));
+    BOOST_TEST( std::all_of(b.begin(), b.end(), [](T v) { return v == T(5 & mask); }) );
+    array_t c;
+    c.fill(T(5 & mask));
+    BOOST_TEST( b == c );
+    array_t z;
+    BOOST_TEST( z < b );
+    BOOST_TEST( b > z );
+    BOOST_TEST( z <= b );
+    BOOST_TEST( b >= b );
+    swap(z, b);
+    BOOST_TEST( b == array_t() );
+    BOOST_TEST( z == c );
+  }
+}
+
+int main()
+{
+  test_compact_array<std::uint8_t, 100, std::uint64_t, 3>();
+  test_compact_array<std::uint16_t, 777, std::uint64_t, 13>();
+  test_compact_array<std::uint32_t, 1000, std::uint64_t, 20>();
+  test_compact_array<std::uint32_t, 64, std::uint32_t, 7>();
+  test_compact_array<std::uint8_t, 33, std::uint8_t, 1>();
+  test_compact_array<std::uint8_t, 10, std::uint16_t, 8>();
+  test_compact_array<std::uint64_t, 10, std::uint64_t, 64>();
+
+  { // the initializer list sets the first elements
+    stde::compact_array<std::uint32_t, 8, std::uint64_t, 20> a = {1, 2, 3};
+    BOOST_TEST_EQ( a[0], 1u );
+    BOOST_TEST_EQ( a[2], 3u );
+    BOOST_TEST_EQ( a[3], 0u );
+  }
+  { // 20-bit ids take 5/8 of the space of uint32_t
+    static_assert(sizeof(stde::compact_array<std::uint32_t, 3000, std::uint64_t, 20>) == 8000, "");
+  }
+  { // the elements of a constant array are values
+    constexpr stde::compact_array<std::uint8_t, 4, std::uint8_t, 2> a{};
+    static_assert(a[3] == 0, "");
+    static_assert(a.size() == 4, "");
+  }
+  return ::boost::report_errors();
+}
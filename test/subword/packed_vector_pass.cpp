@@ -0,0 +1,115 @@
+// Copyright (C) 2019 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <experimental/packed_vector.hpp>
+
+#include <experimental/packed_vector.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <boost/detail/lightweight_test.hpp>
+
+namespace stde = std::experimental;
+
+template <int Bits, class Block>
+void test_packed_vector()
+{
+  using vector_t = stde::packed_vector<Bits, stde::packed_detail::uint_least_t<Bits>, Block>;
+  using T = typename vector_t::value_type;
+  constexpr std::size_t per_block = std::numeric_limits<Block>::digits / Bits;
+  constexpr T mask = T(stde::bit_ops::up_to<Bits, std::uint64_t>());
+
+  std::mt19937_64 gen(Bits);
+  std::vector<T> model;
+  vector_t v;
+  BOOST_TEST( v.empty() );
+  for (std::size_t k = 0; k < 1000; ++k)
+  {
+    T const x = T(gen() & mask);
+    v.push_back(x);
+    model.push_back(x);
+  }
+  BOOST_TEST_EQ( v.size(), model.size() );
+  BOOST_TEST_EQ( v.block_count(), (model.size() + per_block - 1) / per_block );
+  BOOST_TEST( std::equal(v.begin(), v.end(), model.begin()) );
+  vector_t const& cv = v;
+  BOOST_TEST( std::equal(cv.rbegin(), cv.rend(), model.rbegin()) );
+  BOOST_TEST_EQ( cv.back(), model.back() );
+  BOOST_TEST_EQ( cv.at(999), model[999] );
+  BOOST_TEST_THROWS( cv.at(1000), std::out_of_range );
+
+  { // bulk conversions
+    std::vector<T> out(v.size());
+    v.unpack_to(out);
+    BOOST_TEST( out == model );
+    vector_t w;
+    w.pack_from(model);
+    BOOST_TEST( w == v );
+    w.pack_from(stde::span<T const>(model).first(10));
+    BOOST_TEST_EQ( w.size(), 10u );
+    BOOST_TEST( std::equal(w.begin(), w.end(), model.begin()) );
+  }
+  { // erasing clears the bits, so that equality can compare the blocks
+    vector_t w(v.begin(), v.end());
+    BOOST_TEST( w == v );
+    w.resize(3);
+    w.resize(1000);
+    BOOST_TEST_EQ( w[3], 0u );
+    BOOST_TEST_EQ( w[999], 0u );
+    w.pop_back();
+    w.push_back(0);
+    vector_t z(1000);
+    std::copy(v.begin(), v.begin() + 3, z.begin());
+    BOOST_TEST( w == z );
+    w.clear();
+    BOOST_TEST( w.empty() );
+    BOOST_TEST( w != v );
+  }
+  { // resize and construction with a value
+    vector_t w(5, T(2 & mask));
+    w.resize(5 + 3 * per_block + 2, T(1));
+    BOOST_TEST_EQ( std::count(w.begin(), w.end(), T(1)), std::ptrdiff_t(3 * per_block + 2) );
+    BOOST_TEST_EQ( w[4], T(2 & mask) );
+    BOOST_TEST_EQ( w[5], T(1) );
+    BOOST_TEST_EQ( w.back(), T(1) );
+  }
+  { // the bits that don't fit are discarded
+    vector_t w(3);
+    w[1] = T(~T(0));
+    BOOST_TEST_EQ( w[1], mask );
+    BOOST_TEST_EQ( w[0], 0u );
+    BOOST_TEST_EQ( w[2], 0u );
+  }
+}
+
+int main()
+{
+  test_packed_vector<3, std::uint64_t>();
+  test_packed_vector<5, std::uint64_t>();
+  test_packed_vector<12, std::uint64_t>();
+  test_packed_vector<17, std::uint64_t>();
+  test_packed_vector<20, std::uint64_t>();
+  test_packed_vector<33, std::uint64_t>();
+  test_packed_vector<7, std::uint32_t>();
+  test_packed_vector<1, std::uint8_t>();
+
+  static_assert(std::is_same<stde::packed_vector<12>::value_type, std::uint16_t>::value, "");
+  { // the initializer list
+    stde::packed_vector<4> v = {1, 2, 15};
+    BOOST_TEST_EQ( v.size(), 3u );
+    BOOST_TEST_EQ( v[2], 15u );
+    swap(v, v);
+    BOOST_TEST( v == (stde::packed_vector<4>{1, 2, 15}) );
+  }
+  { // a million 20-bit ids take 5/8 of the space of uint32_t
+    stde::packed_vector<20, std::uint32_t> v(1000000);
+    BOOST_TEST_EQ( v.block_count() * sizeof(std::uint64_t), 2666672u );
+  }
+  return ::boost::report_errors();
+}